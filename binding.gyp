@@ -13,7 +13,11 @@
                 "src/parser.c",
             ],
             "variables": {
-                "has_scanner": "<!(node -p \"fs.existsSync('src/scanner.c')\")"
+                "has_scanner": "<!(node -p \"fs.existsSync('src/scanner.c')\")",
+                # The native helpers link the shared libtree-sitter, see
+                # script/install-runtime. Without it the build stops, unless
+                # TREE_SITTER_ELM_NO_LIB asks for the grammar alone.
+                "has_runtime": "<!(node -p \"!process.env.TREE_SITTER_ELM_NO_LIB && (child_process.spawnSync('pkg-config', ['--exists', 'tree-sitter >= 0.25']).status === 0 || (console.error('libtree-sitter >= 0.25 not found by pkg-config, run script/install-runtime or set TREE_SITTER_ELM_NO_LIB=1 to build the grammar alone'), process.exit(1)))\")",
             },
             "conditions": [
                 [
@@ -22,6 +26,21 @@
                         "sources+": ["src/scanner.c"],
                     },
                 ],
+                [
+                    "has_runtime=='true'",
+                    {
+                        "defines": ["TREE_SITTER_ELM_LIB"],
+                        "include_dirs+": ["lib/include", "lib/src", "bindings/c"],
+                        "sources+": [
+                            "<!@(node -p \"fs.readdirSync('lib/src').filter((f) => f.endsWith('.c')).map((f) => 'lib/src/' + f).join(' ')\")",
+                        ],
+                        "cflags": ["<!@(pkg-config --cflags tree-sitter)"],
+                        "xcode_settings": {
+                            "OTHER_CFLAGS": ["<!@(pkg-config --cflags tree-sitter)"],
+                        },
+                        "libraries": ["<!@(pkg-config --libs tree-sitter)"],
+                    },
+                ],
                 [
                     "OS!='win'",
                     {
@@ -33,6 +52,8 @@
                         "cflags_c": [
                             "/std:c11",
                             "/utf-8",
+                            # <stdatomic.h>, used by lib/src/batch.c
+                            "/experimental:c11atomics",
                         ],
                     },
                 ],
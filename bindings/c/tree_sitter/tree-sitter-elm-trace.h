@@ -0,0 +1,69 @@
+#ifndef TREE_SITTER_ELM_TRACE_H_
+#define TREE_SITTER_ELM_TRACE_H_
+
+// Layout events of the external scanner, recorded into an in-process ring
+// buffer when the grammar is built with TREE_SITTER_ELM_TRACE_RING. The
+// same events are USDT probes of the `tree_sitter_elm` provider when it is
+// built with TREE_SITTER_ELM_USDT, see script/trace-layout.bt. Builds
+// without either define have neither the probes nor these functions.
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * What happened, and what the two arguments of the event are. `depth` is
+ * the length of the indent stack, `indent` the indentation of the current
+ * line and `runback` the number of queued tokens.
+ */
+typedef enum {
+    /** A `scan` call starts: depth, runback. */
+    TSElmTraceScanStart,
+    /** A `scan` call ends: whether it found a token, the token. */
+    TSElmTraceScanEnd,
+    /** VIRTUAL_END_DECL is emitted: depth, indent. */
+    TSElmTraceEndDecl,
+    /** VIRTUAL_OPEN_SECTION is emitted: depth, indent. */
+    TSElmTraceOpenSection,
+    /** VIRTUAL_END_SECTION is emitted: depth, indent. */
+    TSElmTraceEndSection,
+    /** A token is queued, 0 for an end of declaration, 1 for an end of section: token, runback. */
+    TSElmTraceRunbackPush,
+    /** A queued token is emitted: token, runback. */
+    TSElmTraceRunbackPop,
+    /** A section is not opened because the stack is MAX_INDENT_DEPTH deep: depth, indent. */
+    TSElmTraceIndentLimit,
+    /** The state is serialized: bytes written, depth. */
+    TSElmTraceSerialize,
+    /** The state is deserialized: bytes read, depth. */
+    TSElmTraceDeserialize,
+} TSElmTraceKind;
+
+typedef struct {
+    /** Counts events from 1 across all threads. */
+    uint64_t sequence;
+    uint32_t kind;
+    uint32_t arg0;
+    uint32_t arg1;
+} TSElmTraceEvent;
+
+/**
+ * Copy the retained events, oldest first, into `events` and return how
+ * many were copied. Events written concurrently may be skipped.
+ */
+uint32_t tree_sitter_elm_trace_read(TSElmTraceEvent *events, uint32_t capacity);
+
+/** Print the retained events to `file`, one per line. */
+void tree_sitter_elm_trace_dump(FILE *file);
+
+/** Drop the retained events. */
+void tree_sitter_elm_trace_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_TRACE_H_
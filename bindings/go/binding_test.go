@@ -1,7 +1,11 @@
 package tree_sitter_elm_test
 
 import (
+	"context"
+	"slices"
+	"strings"
 	"testing"
+	"time"
 
 	tree_sitter "github.com/tree-sitter/go-tree-sitter"
 	tree_sitter_elm "github.com/elm-tooling/tree-sitter-elm/bindings/go"
@@ -13,3 +17,79 @@ func TestCanLoadGrammar(t *testing.T) {
 		t.Errorf("Error loading Elm grammar")
 	}
 }
+
+func newParser(t *testing.T) *tree_sitter.Parser {
+	parser := tree_sitter.NewParser()
+	t.Cleanup(parser.Close)
+	if err := parser.SetLanguage(tree_sitter.NewLanguage(tree_sitter_elm.Language())); err != nil {
+		t.Fatal(err)
+	}
+	return parser
+}
+
+// Unclosed brackets keep error recovery busy for far longer than the budgets
+var stressSource = []byte("main =\n" + strings.Repeat("    ( [ { x | y = f (g [ 1, \"a\", 'b' ] \n", 40000))
+
+func TestParseWithBudgetCompleted(t *testing.T) {
+	source := []byte("main =\n    \"\"\"multi\n    line\"\"\"\n")
+	tree, metrics := tree_sitter_elm.ParseWithBudget(context.Background(), newParser(t), source, nil, true)
+	if tree == nil || metrics.Status != tree_sitter_elm.Completed {
+		t.Fatalf("expected a tree, got %+v", metrics)
+	}
+	defer tree.Close()
+	if metrics.BytesConsumed != uint32(len(source)) || metrics.ScannerCalls == 0 || metrics.Scanner > metrics.Total {
+		t.Errorf("unexpected metrics %+v", metrics)
+	}
+}
+
+func TestParseWithBudgetTimeout(t *testing.T) {
+	ctx, cancel := context.WithTimeout(context.Background(), 2*time.Millisecond)
+	defer cancel()
+	parser := newParser(t)
+	tree, metrics := tree_sitter_elm.ParseWithBudget(ctx, parser, stressSource, nil, false)
+	if tree != nil || metrics.Status != tree_sitter_elm.TimedOut {
+		t.Fatalf("expected a timeout, got %+v", metrics)
+	}
+	if metrics.BytesConsumed >= uint32(len(stressSource)) || metrics.Total > 200*time.Millisecond {
+		t.Errorf("the deadline was not respected: %+v", metrics)
+	}
+	if after := parser.Parse([]byte("main = 1\n"), nil); after == nil {
+		t.Error("the parser cannot be reused")
+	} else {
+		after.Close()
+	}
+}
+
+func TestParseWithBudgetCancelled(t *testing.T) {
+	ctx, cancel := context.WithCancel(context.Background())
+	time.AfterFunc(10*time.Millisecond, cancel)
+	tree, metrics := tree_sitter_elm.ParseWithBudget(ctx, newParser(t), stressSource, nil, false)
+	if tree != nil || metrics.Status != tree_sitter_elm.Cancelled {
+		t.Fatalf("expected a cancellation, got %+v", metrics)
+	}
+}
+
+func TestOutline(t *testing.T) {
+	source := []byte("type alias Model =\n    { count : Int }\n\n\n" +
+		"update model =\n    let\n        step n =\n            n + 1\n    in\n    step model\n")
+	tree := newParser(t).Parse(source, nil)
+	defer tree.Close()
+	type symbol struct {
+		kind   tree_sitter_elm.OutlineKind
+		name   string
+		parent int
+	}
+	var actual []symbol
+	for _, s := range tree_sitter_elm.Outline(tree) {
+		actual = append(actual, symbol{s.Kind, string(source[s.NameStartByte:s.NameEndByte]), s.Parent})
+	}
+	expected := []symbol{
+		{tree_sitter_elm.OutlineTypeAlias, "Model", -1},
+		{tree_sitter_elm.OutlineField, "count", 0},
+		{tree_sitter_elm.OutlineFunction, "update", -1},
+		{tree_sitter_elm.OutlineLetFunction, "step", 2},
+	}
+	if !slices.Equal(actual, expected) {
+		t.Errorf("expected %v, got %v", expected, actual)
+	}
+}
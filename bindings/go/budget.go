@@ -0,0 +1,103 @@
+package tree_sitter_elm
+
+// #if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+// #define _POSIX_C_SOURCE 199309L // clock_gettime, for elm_nanos
+// #endif
+// #include "../../lib/src/timing.h"
+// #include <stdlib.h>
+//
+// static void elm_timing_begin(ElmScannerTiming *timing) {
+//     timing->clock = elm_nanos;
+//     tree_sitter_elm_scanner_timing_begin(timing);
+// }
+import "C"
+
+import (
+	"context"
+	"errors"
+	"runtime"
+	"time"
+	"unsafe"
+
+	tree_sitter "github.com/tree-sitter/go-tree-sitter"
+)
+
+// Status says whether a budgeted parse completed.
+type Status int
+
+const (
+	Completed Status = iota
+	TimedOut
+	Cancelled
+)
+
+// Metrics describes a budgeted parse.
+type Metrics struct {
+	Status Status
+	// How far into the source the parser got, all of it when completed.
+	BytesConsumed uint32
+	Total         time.Duration
+	// Time in the external scanner when it was measured, the rest of Total
+	// went to the lexer and the parse table.
+	Scanner      time.Duration
+	ScannerCalls uint64
+}
+
+// ParseWithBudget parses source until ctx is done, checked from the
+// runtime's progress callback, so that a deadline or a cancellation stops
+// one pathological file instead of stalling a batch. It returns no tree
+// when the parse was stopped, in which case the parser is reset and the
+// metrics say how far it got.
+//
+// With timeScanner the parse measures the time spent in the external
+// scanner of Language(). Parsers with another language report no scanner
+// time.
+func ParseWithBudget(ctx context.Context, parser *tree_sitter.Parser, source []byte, oldTree *tree_sitter.Tree, timeScanner bool) (*tree_sitter.Tree, Metrics) {
+	start := time.Now()
+	var metrics Metrics
+	if err := ctx.Err(); err != nil {
+		metrics.Status = statusOf(err)
+		return nil, metrics
+	}
+
+	if timeScanner {
+		// The scanner adds to counters kept per OS thread
+		runtime.LockOSThread()
+		defer runtime.UnlockOSThread()
+		timing := (*C.ElmScannerTiming)(C.calloc(1, C.sizeof_ElmScannerTiming))
+		defer C.free(unsafe.Pointer(timing))
+		C.elm_timing_begin(timing)
+		defer func() {
+			C.tree_sitter_elm_scanner_timing_end()
+			metrics.Scanner = time.Duration(timing.nanos)
+			metrics.ScannerCalls = uint64(timing.calls)
+		}()
+	}
+
+	tree := parser.ParseWithOptions(func(offset int, _ tree_sitter.Point) []byte {
+		if offset >= len(source) {
+			return nil
+		}
+		return source[offset:]
+	}, oldTree, &tree_sitter.ParseOptions{
+		ProgressCallback: func(state tree_sitter.ParseState) bool {
+			metrics.BytesConsumed = max(metrics.BytesConsumed, state.CurrentByteOffset)
+			return ctx.Err() != nil
+		},
+	})
+	metrics.Total = time.Since(start)
+	if tree == nil {
+		metrics.Status = statusOf(ctx.Err())
+		parser.Reset()
+		return nil, metrics
+	}
+	metrics.BytesConsumed = max(metrics.BytesConsumed, uint32(tree.RootNode().EndByte()))
+	return tree, metrics
+}
+
+func statusOf(err error) Status {
+	if errors.Is(err, context.DeadlineExceeded) {
+		return TimedOut
+	}
+	return Cancelled
+}
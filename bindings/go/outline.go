@@ -0,0 +1,138 @@
+package tree_sitter_elm
+
+import tree_sitter "github.com/tree-sitter/go-tree-sitter"
+
+// OutlineKind says what an outline symbol is. Values and functions are the
+// same in Elm, OutlineFunction is any top-level value_declaration.
+type OutlineKind int
+
+const (
+	OutlineFunction OutlineKind = iota
+	OutlineType
+	OutlineVariant
+	OutlineTypeAlias
+	OutlineField
+	OutlinePort
+	OutlineLetFunction
+)
+
+// OutlineSymbol is a symbol of the outline. Parent indexes the enclosing
+// symbol, which comes before it, or is -1 at the top level. The name range
+// is empty when broken code has no name.
+type OutlineSymbol struct {
+	Kind          OutlineKind
+	Parent        int
+	StartByte     uint
+	EndByte       uint
+	NameStartByte uint
+	NameEndByte   uint
+}
+
+// Outline returns the document outline of tree in pre-order: top-level
+// values, types with their variants, type aliases with the fields of their
+// record type, ports and the functions bound in let expressions. It finds
+// the same symbols as the C helper in lib/src/outline.c, but walks the tree
+// through go-tree-sitter, which does not hand its nodes to other C code.
+func Outline(tree *tree_sitter.Tree) []OutlineSymbol {
+	var symbols []OutlineSymbol
+	cursor := tree.RootNode().Walk()
+	defer cursor.Close()
+	for more := cursor.GotoFirstChild(); more; more = cursor.GotoNextSibling() {
+		node := cursor.Node()
+		index := len(symbols)
+		switch node.Kind() {
+		case "value_declaration":
+			name := node.ChildByFieldName("pattern")
+			if left := node.ChildByFieldName("functionDeclarationLeft"); left != nil {
+				name = left.NamedChild(0)
+			}
+			symbols = addSymbol(symbols, OutlineFunction, -1, node, name)
+			symbols = addLetFunctions(symbols, node, index)
+		case "type_declaration":
+			symbols = addSymbol(symbols, OutlineType, -1, node, node.ChildByFieldName("name"))
+			symbols = addChildren(symbols, node, "union_variant", OutlineVariant, index)
+		case "type_alias_declaration":
+			symbols = addSymbol(symbols, OutlineTypeAlias, -1, node, node.ChildByFieldName("name"))
+			// The fields of a record type alias, not those of records nested
+			// in other type expressions
+			if typ := node.ChildByFieldName("typeExpression"); typ != nil && typ.NamedChildCount() == 1 {
+				if record := typ.NamedChild(0); record != nil && record.Kind() == "record_type" {
+					symbols = addChildren(symbols, record, "field_type", OutlineField, index)
+				}
+			}
+		case "port_annotation":
+			symbols = addSymbol(symbols, OutlinePort, -1, node, node.ChildByFieldName("name"))
+		}
+	}
+	return symbols
+}
+
+func addSymbol(symbols []OutlineSymbol, kind OutlineKind, parent int, node, name *tree_sitter.Node) []OutlineSymbol {
+	symbol := OutlineSymbol{
+		Kind:      kind,
+		Parent:    parent,
+		StartByte: node.StartByte(),
+		EndByte:   node.EndByte(),
+	}
+	symbol.NameStartByte, symbol.NameEndByte = symbol.StartByte, symbol.StartByte
+	if name != nil {
+		symbol.NameStartByte, symbol.NameEndByte = name.StartByte(), name.EndByte()
+	}
+	return append(symbols, symbol)
+}
+
+// addChildren adds the children of node of the given kind with their name
+// field, under parent.
+func addChildren(symbols []OutlineSymbol, node *tree_sitter.Node, childKind string, kind OutlineKind, parent int) []OutlineSymbol {
+	cursor := node.Walk()
+	defer cursor.Close()
+	for more := cursor.GotoFirstChild(); more; more = cursor.GotoNextSibling() {
+		if child := cursor.Node(); child.Kind() == childKind {
+			symbols = addSymbol(symbols, kind, parent, child, child.ChildByFieldName("name"))
+		}
+	}
+	return symbols
+}
+
+// addLetFunctions walks the whole function node for the functions its let
+// expressions bind, which nest under the closest enclosing function.
+func addLetFunctions(symbols []OutlineSymbol, node *tree_sitter.Node, parent int) []OutlineSymbol {
+	// The path from node to the current node, with the outline symbol that
+	// encloses each
+	type ancestor struct {
+		kind          string
+		outlineParent int
+	}
+	ancestors := []ancestor{{node.Kind(), parent}}
+	depth := 0
+	cursor := node.Walk()
+	defer cursor.Close()
+	for {
+		if cursor.GotoFirstChild() {
+			depth++
+		} else {
+			for !cursor.GotoNextSibling() {
+				if depth == 0 || !cursor.GotoParent() {
+					return symbols
+				}
+				depth--
+			}
+		}
+
+		current := cursor.Node()
+		kind := current.Kind()
+		outlineParent := ancestors[depth-1].outlineParent
+		// Destructuring bindings in a let are not functions
+		if kind == "value_declaration" && ancestors[depth-1].kind == "let_in_expr" {
+			if left := current.ChildByFieldName("functionDeclarationLeft"); left != nil {
+				symbols = addSymbol(symbols, OutlineLetFunction, outlineParent, current, left.NamedChild(0))
+				outlineParent = len(symbols) - 1
+			}
+		}
+		if depth < len(ancestors) {
+			ancestors[depth] = ancestor{kind, outlineParent}
+		} else {
+			ancestors = append(ancestors, ancestor{kind, outlineParent})
+		}
+	}
+}
@@ -0,0 +1,70 @@
+// Record widths of the typed arrays returned by the native `summarizeFiles`.
+const FILE_STRIDE = 6;
+const DECLARATION_STRIDE = 7;
+const IMPORT_STRIDE = 5;
+
+function concat(chunks, key) {
+  const length = chunks.reduce((sum, chunk) => sum + chunk[key].length, 0);
+  const result = new chunks[0][key].constructor(length);
+  let offset = 0;
+  for (const chunk of chunks) {
+    result.set(chunk[key], offset);
+    offset += chunk[key].length;
+  }
+  return result;
+}
+
+// Merge the results of several `summarizeFiles` calls, rebasing the record
+// indices and name offsets of every chunk after the first.
+function merge(chunks) {
+  if (chunks.length === 1) {
+    return chunks[0];
+  }
+
+  const result = {
+    files: concat(chunks, "files"),
+    declarations: concat(chunks, "declarations"),
+    imports: concat(chunks, "imports"),
+    names: concat(chunks, "names"),
+  };
+
+  let file = 0;
+  let declaration = 0;
+  let anImport = 0;
+  let name = 0;
+  for (const chunk of chunks) {
+    const fileEnd = file + chunk.files.length;
+    for (let i = file; i < fileEnd; i += FILE_STRIDE) {
+      result.files[i] += declaration / DECLARATION_STRIDE;
+      result.files[i + 2] += anImport / IMPORT_STRIDE;
+    }
+    const declarationEnd = declaration + chunk.declarations.length;
+    for (let i = declaration; i < declarationEnd; i += DECLARATION_STRIDE) {
+      result.declarations[i + 6] += name;
+    }
+    const importEnd = anImport + chunk.imports.length;
+    for (let i = anImport; i < importEnd; i += IMPORT_STRIDE) {
+      result.imports[i + 4] += name;
+    }
+    file = fileEnd;
+    declaration = declarationEnd;
+    anImport = importEnd;
+    name += chunk.names.length;
+  }
+  return result;
+}
+
+module.exports = function bindParseFilesAsync(summarizeFiles) {
+  return async function parseFilesAsync(paths, chunkSize = 16) {
+    if (paths.length === 0) {
+      return summarizeFiles([]);
+    }
+    // Each chunk is one threadpool job, so small chunks keep every pool
+    // thread busy even when file sizes vary a lot.
+    const jobs = [];
+    for (let i = 0; i < paths.length; i += chunkSize) {
+      jobs.push(summarizeFiles(paths.slice(i, i + chunkSize)));
+    }
+    return merge(await Promise.all(jobs));
+  };
+};
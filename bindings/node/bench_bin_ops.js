@@ -0,0 +1,99 @@
+// Compare re-associating every `bin_op_expr` of a module in JavaScript, by
+// walking node-tree-sitter nodes the way a type checker does today, with
+// `BinaryOperators.associate`, which parses and builds the precedence trees
+// in C.
+//
+// Usage: node bindings/node/bench_bin_ops.js [file.elm]
+// Without a file, a module with 5000 operator-heavy functions is generated.
+
+const fs = require("node:fs");
+const { performance } = require("node:perf_hooks");
+
+const Parser = require("tree-sitter");
+const Elm = require(".");
+
+const OPERATORS = {
+  "<|": ["right", 0], "|>": ["left", 0], "||": ["right", 2], "&&": ["right", 3],
+  "==": ["non", 4], "/=": ["non", 4], "<": ["non", 4], ">": ["non", 4],
+  "<=": ["non", 4], ">=": ["non", 4], "++": ["right", 5], "::": ["right", 5],
+  "+": ["left", 6], "-": ["left", 6], "*": ["left", 7], "/": ["left", 7],
+  "//": ["left", 7], "^": ["right", 8], "<<": ["left", 9], ">>": ["right", 9],
+};
+
+function generate(functions) {
+  const chunks = ["module Main exposing (..)\n"];
+  for (let i = 0; i < functions; i++) {
+    chunks.push(
+      `\nf${i} : Int -> List Int -> Int\n` +
+        `f${i} n xs =\n` +
+        `    n * ${i} + List.sum (n :: xs ++ [ n - 1 ]) // 2 - n ^ 2 ^ 3\n` +
+        `        |> max 0\n` +
+        `        |> (\\m -> if m > ${i} && n < m || n == 0 then m + n * 2 else m)\n`,
+    );
+  }
+  return chunks.join("");
+}
+
+// Shunting-yard over the named children, building nested arrays
+function associate(node) {
+  const operands = [];
+  const operators = [];
+  const reduce = () => {
+    const right = operands.pop();
+    operands.push([operands.pop(), operators.pop()[0], right]);
+  };
+  for (const child of node.namedChildren) {
+    if (child.type !== "operator") {
+      operands.push(child);
+      continue;
+    }
+    const name = child.text;
+    const [associativity, precedence] = OPERATORS[name] || ["left", 9];
+    while (operators.length > 0) {
+      const [, topAssociativity, topPrecedence] = operators[operators.length - 1];
+      if (topPrecedence < precedence) break;
+      if (topPrecedence === precedence && associativity === "right" && topAssociativity === "right") break;
+      reduce();
+    }
+    operators.push([name, associativity, precedence]);
+  }
+  while (operators.length > 0) reduce();
+  return operands[0];
+}
+
+function measure(name, runs, run) {
+  const times = [];
+  let result;
+  for (let i = 0; i < runs; i++) {
+    const start = performance.now();
+    result = run();
+    times.push(performance.now() - start);
+  }
+  times.sort((a, b) => a - b);
+  console.log(
+    `${name.padEnd(12)} ${String(result).padStart(6)} expressions` +
+      `  median ${times[runs >> 1].toFixed(2).padStart(8)} ms  min ${times[0].toFixed(2).padStart(8)} ms`,
+  );
+}
+
+function main() {
+  const file = process.argv[2];
+  const source = file ? fs.readFileSync(file, "utf8") : generate(5000);
+  console.log(`${source.split("\n").length} lines`);
+
+  const parser = new Parser();
+  parser.setLanguage(Elm);
+  measure("javascript", 10, () => {
+    const tree = parser.parse(source);
+    const expressions = tree.rootNode.descendantsOfType("bin_op_expr");
+    for (const expression of expressions) {
+      associate(expression);
+    }
+    return expressions.length;
+  });
+
+  const operators = new Elm.BinaryOperators();
+  measure("native", 10, () => operators.associate(source).expressions.length / 4);
+}
+
+main();
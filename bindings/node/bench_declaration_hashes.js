@@ -0,0 +1,68 @@
+// Replay typing into a declaration in the middle of a module, one keystroke
+// at a time, and compare hashing every declaration of the document after
+// each keystroke with `DeclarationHashes.edit`, which only hashes the
+// declarations the keystroke touched.
+//
+// Usage: node bindings/node/bench_declaration_hashes.js [file.elm]
+// Without a file, a module with 5000 functions is generated.
+
+const fs = require("node:fs");
+const { performance } = require("node:perf_hooks");
+
+const Elm = require(".");
+
+function generate(functions) {
+  const chunks = ["module Main exposing (..)\n"];
+  for (let i = 0; i < functions; i++) {
+    chunks.push(
+      `\n{-| Document the ${i}th function -}\n` +
+        `f${i} : Maybe Int -> String\n` +
+        `f${i} value =\n` +
+        `    case value of\n` +
+        `        Just n ->\n` +
+        `            String.fromInt (n + ${i})\n\n` +
+        `        Nothing ->\n` +
+        `            "none" -- nothing\n`,
+    );
+  }
+  return chunks.join("");
+}
+
+function replay(name, keystrokes, run) {
+  const times = [];
+  let changes = 0;
+  for (const [offset, text] of keystrokes) {
+    const start = performance.now();
+    changes += run(offset, text);
+    times.push(performance.now() - start);
+  }
+  times.sort((a, b) => a - b);
+  const total = times.reduce((sum, time) => sum + time, 0);
+  console.log(
+    `${name.padEnd(5)} ${String(keystrokes.length).padStart(4)} keystrokes` +
+      `  median ${times[times.length >> 1].toFixed(3).padStart(7)} ms` +
+      `  total ${total.toFixed(1).padStart(8)} ms  ${changes} changes`,
+  );
+}
+
+function main() {
+  const file = process.argv[2];
+  const source = file ? fs.readFileSync(file, "utf8") : generate(5000);
+  console.log(`${source.split("\n").length} lines`);
+
+  const text = " |> String.append (String.fromInt n)";
+  const offset = Buffer.byteLength(source.slice(0, source.indexOf("\n", source.length >> 1)));
+  const keystrokes = Array.from(text, (character, i) => [offset + i, character]);
+  console.log(`typing ${JSON.stringify(text)}`);
+
+  // Without the previous hashes, every declaration counts as changed
+  let typed = Buffer.from(source);
+  replay("full", keystrokes, (at, character) => {
+    typed = Buffer.concat([typed.subarray(0, at), Buffer.from(character), typed.subarray(at)]);
+    return new Elm.DeclarationHashes(typed.toString()).declarations().length;
+  });
+  const document = new Elm.DeclarationHashes(source);
+  replay("edit", keystrokes, (at, character) => document.edit(at, at, character).length);
+}
+
+main();
@@ -0,0 +1,95 @@
+// Compare walking every node through node-tree-sitter's object API with
+// walking the flat records returned by `parseFlat`. Both sides include a
+// full parse, `parseFlat` cannot reuse a node-tree-sitter tree.
+//
+// Usage: node --expose-gc bindings/node/bench_flat.js [directory ...]
+// Defaults to `examples`, run `script/parse-examples` first to download it.
+
+const fs = require("node:fs");
+const path = require("node:path");
+const { performance } = require("node:perf_hooks");
+
+const Parser = require("tree-sitter");
+const Elm = require(".");
+
+function collect(directory, files = []) {
+  for (const entry of fs.readdirSync(directory, { withFileTypes: true })) {
+    const file = path.join(directory, entry.name);
+    if (entry.isDirectory()) {
+      collect(file, files);
+    } else if (entry.name.endsWith(".elm")) {
+      files.push(file);
+    }
+  }
+  return files;
+}
+
+function walkObjects(node) {
+  let count = 1;
+  for (const child of node.children) {
+    count += walkObjects(child);
+  }
+  return count;
+}
+
+function walkFlat(nodes) {
+  const { size, firstChild, nextSibling, none } = Elm.flatNodeLayout;
+  let count = 0;
+  const stack = [0];
+  while (stack.length > 0) {
+    let node = stack.pop();
+    do {
+      count++;
+      const child = nodes[node * size + firstChild];
+      if (child !== none) {
+        stack.push(child);
+      }
+      node = node === 0 ? none : nodes[node * size + nextSibling];
+    } while (node !== none);
+  }
+  return count;
+}
+
+function measure(name, sources, run) {
+  global.gc?.();
+  const heapBefore = process.memoryUsage().heapUsed;
+  const start = performance.now();
+  const kept = [];
+  let nodes = 0;
+  for (const source of sources) {
+    const [count, result] = run(source);
+    nodes += count;
+    kept.push(result);
+  }
+  const elapsed = performance.now() - start;
+  const memory = process.memoryUsage();
+  console.log(
+    `${name.padEnd(7)} ${nodes} nodes ${elapsed.toFixed(1).padStart(8)} ms` +
+      `  heap +${((memory.heapUsed - heapBefore) / 1e6).toFixed(1).padStart(6)} MB` +
+      `  array buffers ${(memory.arrayBuffers / 1e6).toFixed(1).padStart(6)} MB`,
+  );
+  return kept;
+}
+
+function main() {
+  if (!global.gc) {
+    console.warn("run with --expose-gc for stable heap figures");
+  }
+  const roots = process.argv.slice(2);
+  const sources = (roots.length ? roots : [path.join(__dirname, "..", "..", "examples")])
+    .flatMap((root) => collect(root))
+    .map((file) => fs.readFileSync(file, "utf8"));
+
+  const parser = new Parser();
+  parser.setLanguage(Elm);
+  measure("objects", sources, (source) => {
+    const tree = parser.parse(source);
+    return [walkObjects(tree.rootNode), tree];
+  });
+  measure("flat", sources, (source) => {
+    const nodes = Elm.parseFlat(source);
+    return [walkFlat(nodes), nodes];
+  });
+}
+
+main();
@@ -0,0 +1,125 @@
+// Compare highlighting a whole module with node-tree-sitter query captures
+// against scrolling through it with `Highlighter`, which only queries the
+// rows on screen and caches blocks of rows until the source changes.
+//
+// The scroll goes down the file one page at a time and back up again, so the
+// way back up is served from the cache where it still holds the blocks. Then
+// an edit far from the viewport only reparses incrementally, the blocks on
+// screen stay cached.
+//
+// Usage: node bindings/node/bench_highlight_viewport.js [file.elm]
+// Without a file, a 50000 line module is generated.
+
+const fs = require("node:fs");
+const path = require("node:path");
+const { performance } = require("node:perf_hooks");
+
+const Parser = require("tree-sitter");
+const Elm = require(".");
+
+const PAGE_ROWS = 60;
+
+function generate(lines) {
+  const chunks = ["module Main exposing (..)\n\nimport Html exposing (Html)\n"];
+  for (let i = 0; chunks.length < lines / 10; i++) {
+    chunks.push(
+      `\n{-| Document the ${i}th function -}\n` +
+        `f${i} : Maybe Int -> String\n` +
+        `f${i} value =\n` +
+        `    case value of\n` +
+        `        Just n ->\n` +
+        `            "café " ++ String.fromInt (n + ${i})\n\n` +
+        `        Nothing ->\n` +
+        `            "none" -- nothing\n`,
+    );
+  }
+  return chunks.join("");
+}
+
+function measure(name, runs, run) {
+  const times = [];
+  let result;
+  for (let i = 0; i < runs; i++) {
+    const start = performance.now();
+    result = run();
+    times.push(performance.now() - start);
+  }
+  times.sort((a, b) => a - b);
+  console.log(
+    `${name.padEnd(16)} ${String(result).padStart(8)} captures` +
+      `  median ${times[runs >> 1].toFixed(3).padStart(8)} ms  min ${times[0].toFixed(3).padStart(8)} ms`,
+  );
+}
+
+function scroll(name, pages, run) {
+  const times = [];
+  let captures = 0;
+  for (const row of pages) {
+    const start = performance.now();
+    captures += run(row);
+    times.push(performance.now() - start);
+  }
+  times.sort((a, b) => a - b);
+  const total = times.reduce((sum, time) => sum + time, 0);
+  console.log(
+    `${name.padEnd(16)} ${String(pages.length).padStart(5)} pages` +
+      `  median ${times[times.length >> 1].toFixed(3).padStart(7)} ms` +
+      `  max ${times[times.length - 1].toFixed(3).padStart(7)} ms` +
+      `  total ${total.toFixed(1).padStart(8)} ms  ${captures} captures`,
+  );
+}
+
+function main() {
+  const file = process.argv[2];
+  const source = file ? fs.readFileSync(file, "utf8") : generate(50000);
+  const queries = path.join(__dirname, "..", "..", "queries");
+  const highlights = fs.readFileSync(path.join(queries, "highlights.scm"), "utf8");
+  const injections = fs.readFileSync(path.join(queries, "injections.scm"), "utf8");
+  const rows = source.split("\n").length;
+  console.log(`${rows} lines, ${PAGE_ROWS} rows per page`);
+
+  const parser = new Parser();
+  parser.setLanguage(Elm);
+  const query = new Parser.Query(Elm, highlights);
+  const tree = parser.parse(source);
+  const highlighter = new Elm.Highlighter(highlights, injections);
+  highlighter.setSource(source);
+
+  measure("js whole file", 5, () => query.captures(tree.rootNode).length);
+  measure("native first page", 5, () => {
+    highlighter.setSource(source);
+    return highlighter.highlightRows(0, PAGE_ROWS).highlights.length / 7;
+  });
+
+  const down = [];
+  for (let row = 0; row < rows; row += PAGE_ROWS) {
+    down.push(row);
+  }
+  const pages = [...down, ...[...down].reverse()];
+  scroll("js viewport", pages, (row) =>
+    query.captures(tree.rootNode, {
+      startPosition: { row, column: 0 },
+      endPosition: { row: row + PAGE_ROWS, column: 0 },
+    }).length,
+  );
+  highlighter.setSource(source);
+  scroll("native viewport", pages, (row) =>
+    highlighter.highlightRows(row, row + PAGE_ROWS).highlights.length / 7,
+  );
+  scroll("native cached", pages.slice(-16), (row) =>
+    highlighter.highlightRows(row, row + PAGE_ROWS).highlights.length / 7,
+  );
+
+  // Typing into a comment in the middle of the file keeps the blocks at its
+  // top, where the viewport is
+  const comment = source.indexOf("-- ", source.length >> 1);
+  if (comment >= 0) {
+    const at = Buffer.byteLength(source.slice(0, comment + 3));
+    measure("native edited", 20, () => {
+      highlighter.edit(at, at, "x");
+      return highlighter.highlightRows(0, PAGE_ROWS).highlights.length / 7;
+    });
+  }
+}
+
+main();
@@ -0,0 +1,184 @@
+// Compare building the document outline with a JavaScript walk over
+// node-tree-sitter's object API, as the language server's documentSymbol
+// handler does, against the native `outline`. Both include the parse, the
+// parse alone is timed too so that the cost of the walk shows.
+//
+// Usage: node bindings/node/bench_outline.js [--min-bytes N] [--runs N] [directory ...]
+// Defaults to `examples`, run `script/parse-examples` first to download it,
+// and to the modules of at least 10000 bytes, or all of them if none is.
+
+const fs = require("node:fs");
+const path = require("node:path");
+const { performance } = require("node:perf_hooks");
+
+const Parser = require("tree-sitter");
+const Elm = require(".");
+
+function collect(directory, files = []) {
+  for (const entry of fs.readdirSync(directory, { withFileTypes: true })) {
+    const file = path.join(directory, entry.name);
+    if (entry.isDirectory()) {
+      collect(file, files);
+    } else if (entry.name.endsWith(".elm")) {
+      files.push(file);
+    }
+  }
+  return files;
+}
+
+// The same symbols as lib/src/outline.c, as [kind, name, parent, start, end]
+function outlineObjects(root) {
+  const symbols = [];
+  const add = (kind, node, name, parent) => {
+    symbols.push([kind, name?.text ?? "", parent, node.startIndex, node.endIndex]);
+    return symbols.length - 1;
+  };
+  const addLets = (node, parent) => {
+    for (const child of node.namedChildren) {
+      let childParent = parent;
+      if (node.type === "let_in_expr" && child.type === "value_declaration") {
+        const left = child.childForFieldName("functionDeclarationLeft");
+        if (left) {
+          childParent = add("letFunction", child, left.namedChild(0), parent);
+        }
+      }
+      addLets(child, childParent);
+    }
+  };
+
+  for (const node of root.children) {
+    switch (node.type) {
+      case "value_declaration": {
+        const left = node.childForFieldName("functionDeclarationLeft");
+        const name = left ? left.namedChild(0) : node.childForFieldName("pattern");
+        addLets(node, add("function", node, name, null));
+        break;
+      }
+      case "type_declaration": {
+        const index = add("type", node, node.childForFieldName("name"), null);
+        for (const variant of node.namedChildren) {
+          if (variant.type === "union_variant") {
+            add("variant", variant, variant.childForFieldName("name"), index);
+          }
+        }
+        break;
+      }
+      case "type_alias_declaration": {
+        const index = add("typeAlias", node, node.childForFieldName("name"), null);
+        const type = node.childForFieldName("typeExpression");
+        const record = type?.namedChildCount === 1 ? type.namedChild(0) : null;
+        if (record?.type === "record_type") {
+          for (const field of record.namedChildren) {
+            if (field.type === "field_type") {
+              add("field", field, field.childForFieldName("name"), index);
+            }
+          }
+        }
+        break;
+      }
+      case "port_annotation":
+        add("port", node, node.childForFieldName("name"), null);
+        break;
+    }
+  }
+  return symbols;
+}
+
+function outlineNative(source) {
+  const { size, kind, parent, startByte, endByte, nameStartByte, nameEndByte, none } =
+    Elm.outlineLayout;
+  const bytes = Buffer.from(source);
+  const records = Elm.outline(bytes);
+  const symbols = [];
+  for (let i = 0; i < records.length; i += size) {
+    symbols.push([
+      Elm.outlineKinds[records[i + kind]],
+      bytes.toString("utf8", records[i + nameStartByte], records[i + nameEndByte]),
+      records[i + parent] === none ? null : records[i + parent],
+      records[i + startByte],
+      records[i + endByte],
+    ]);
+  }
+  return symbols;
+}
+
+function measure(name, sources, runs, run) {
+  let symbols = 0;
+  const start = performance.now();
+  for (let i = 0; i < runs; i++) {
+    for (const source of sources) {
+      symbols += run(source);
+    }
+  }
+  const elapsed = performance.now() - start;
+  console.log(
+    `${name.padEnd(7)} ${(symbols / runs).toFixed(0).padStart(7)} symbols` +
+      ` ${(elapsed / runs).toFixed(2).padStart(9)} ms per run`,
+  );
+  return elapsed;
+}
+
+function main() {
+  const args = process.argv.slice(2);
+  let minBytes = 10000;
+  let runs = 5;
+  while (args[0]?.startsWith("--")) {
+    const [flag, value] = args.splice(0, 2);
+    if (flag === "--min-bytes") {
+      minBytes = Number(value);
+    } else if (flag === "--runs") {
+      runs = Number(value);
+    } else {
+      console.error(`unknown option ${flag}`);
+      process.exit(1);
+    }
+  }
+  const all = (args.length ? args : [path.join(__dirname, "..", "..", "examples")])
+    .flatMap((root) => collect(root))
+    .map((file) => fs.readFileSync(file, "utf8"));
+  const large = all.filter((source) => Buffer.byteLength(source) >= minBytes);
+  const sources = large.length > 0 ? large : all;
+  const bytes = sources.reduce((sum, source) => sum + Buffer.byteLength(source), 0);
+  console.log(`${sources.length} modules, ${(bytes / 1024).toFixed(0)} KiB, ${runs} runs`);
+
+  const parser = new Parser();
+  parser.setLanguage(Elm);
+  // The two must agree before their times mean anything
+  for (const source of sources) {
+    const expected = JSON.stringify(outlineObjects(parser.parse(source).rootNode));
+    // The walk reports UTF-16 offsets, the native outline UTF-8 ones
+    const bytes = Buffer.from(source);
+    const utf16 = (offset) => bytes.toString("utf8", 0, offset).length;
+    const actual = outlineNative(source).map(([kind, name, parent, start, end]) => [
+      kind,
+      name,
+      parent,
+      utf16(start),
+      utf16(end),
+    ]);
+    if (JSON.stringify(actual) !== expected) {
+      console.error("the native outline differs from the JavaScript walk");
+      process.exit(1);
+    }
+  }
+
+  const runners = {
+    parse: (source) => (parser.parse(source), 0),
+    walk: (source) => outlineObjects(parser.parse(source).rootNode).length,
+    native: (source) => outlineNative(source).length,
+  };
+  // Warm up the JIT before timing
+  for (const run of Object.values(runners)) {
+    sources.forEach(run);
+  }
+  const times = {};
+  for (const [name, run] of Object.entries(runners)) {
+    times[name] = measure(name, sources, runs, run);
+  }
+  console.log(
+    `native/walk ${(times.native / times.walk).toFixed(2)}x,` +
+      ` walk without the parse ${((times.walk - times.parse) / runs).toFixed(2)} ms per run`,
+  );
+}
+
+main();
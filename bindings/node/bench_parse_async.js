@@ -0,0 +1,60 @@
+// Compare event loop blocking while parsing a workspace synchronously with
+// node-tree-sitter against `parseFilesAsync` on the libuv threadpool.
+//
+// Usage: node bindings/node/bench_parse_async.js [directory ...]
+// Defaults to `examples`, run `script/parse-examples` first to download it.
+
+const fs = require("node:fs");
+const path = require("node:path");
+const { monitorEventLoopDelay, performance } = require("node:perf_hooks");
+
+const Parser = require("tree-sitter");
+const Elm = require(".");
+
+function collect(directory, files = []) {
+  for (const entry of fs.readdirSync(directory, { withFileTypes: true })) {
+    const file = path.join(directory, entry.name);
+    if (entry.isDirectory()) {
+      collect(file, files);
+    } else if (entry.name.endsWith(".elm")) {
+      files.push(file);
+    }
+  }
+  return files;
+}
+
+async function measure(name, run) {
+  const histogram = monitorEventLoopDelay({ resolution: 1 });
+  // Give the loop something to do, as a language server would.
+  const ticker = setInterval(() => {}, 1);
+  histogram.enable();
+  const start = performance.now();
+  await run();
+  const elapsed = performance.now() - start;
+  histogram.disable();
+  clearInterval(ticker);
+  console.log(
+    `${name.padEnd(8)} total ${elapsed.toFixed(1).padStart(8)} ms` +
+      `  max loop delay ${(histogram.max / 1e6).toFixed(1).padStart(8)} ms` +
+      `  p99 ${(histogram.percentile(99) / 1e6).toFixed(1).padStart(6)} ms`,
+  );
+}
+
+async function main() {
+  const roots = process.argv.slice(2);
+  const files = (roots.length ? roots : [path.join(__dirname, "..", "..", "examples")])
+    .flatMap((root) => collect(root));
+  console.log(`${files.length} files`);
+
+  await measure("sync", async () => {
+    const parser = new Parser();
+    parser.setLanguage(Elm);
+    for (const file of files) {
+      parser.parse(fs.readFileSync(file, "utf8"));
+    }
+  });
+
+  await measure("async", () => Elm.parseFilesAsync(files));
+}
+
+main();
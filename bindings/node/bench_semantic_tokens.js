@@ -0,0 +1,151 @@
+// Compare encoding LSP semantic tokens in JavaScript from node-tree-sitter
+// query captures with `SemanticTokensEncoder`. Both include parsing.
+//
+// Then replay typing a line into a declaration in the middle of the module,
+// one keystroke at a time, and compare encoding the whole document after
+// each keystroke with `SemanticTokensDocument.edit`, and with encoding only
+// the 60 lines around it from the document's tree, as `semanticTokens/range`
+// does.
+//
+// Usage: node bindings/node/bench_semantic_tokens.js [file.elm]
+// Without a file, a 5000 line module is generated.
+
+const fs = require("node:fs");
+const path = require("node:path");
+const { performance } = require("node:perf_hooks");
+
+const Parser = require("tree-sitter");
+const Elm = require(".");
+
+const LEGEND = {
+  keyword: 0,
+  function: 1,
+  "local.function": 2,
+  string: 3,
+  comment: 4,
+  "constant.numeric": 5,
+  "storage.type": 6,
+  union: 7,
+};
+
+function generate(lines) {
+  const chunks = ["module Main exposing (..)\n\nimport Html exposing (Html)\n"];
+  for (let i = 0; chunks.length < lines / 10; i++) {
+    chunks.push(
+      `\n{-| Document the ${i}th function -}\n` +
+        `f${i} : Maybe Int -> String\n` +
+        `f${i} value =\n` +
+        `    case value of\n` +
+        `        Just n ->\n` +
+        `            "café " ++ String.fromInt (n + ${i})\n\n` +
+        `        Nothing ->\n` +
+        `            "none" -- nothing\n`,
+    );
+  }
+  return chunks.join("");
+}
+
+// What a language server does today: one capture at a time, mapping the
+// capture name by its longest legend prefix and delta-encoding in JS.
+function encodeInJs(parser, query, source) {
+  const tree = parser.parse(source);
+  const data = [];
+  let lastRow = 0;
+  let lastColumn = 0;
+  for (const { name, node } of query.captures(tree.rootNode)) {
+    let type;
+    for (let prefix = name; prefix; prefix = prefix.slice(0, Math.max(0, prefix.lastIndexOf(".")))) {
+      type = LEGEND[prefix];
+      if (type !== undefined) {
+        break;
+      }
+    }
+    if (type === undefined || node.startPosition.row !== node.endPosition.row) {
+      continue;
+    }
+    const { row, column } = node.startPosition;
+    data.push(row - lastRow, row === lastRow ? column - lastColumn : column, node.text.length, type, 0);
+    lastRow = row;
+    lastColumn = column;
+  }
+  return data;
+}
+
+function measure(name, runs, run) {
+  const times = [];
+  let result;
+  for (let i = 0; i < runs; i++) {
+    const start = performance.now();
+    result = run();
+    times.push(performance.now() - start);
+  }
+  times.sort((a, b) => a - b);
+  console.log(
+    `${name.padEnd(7)} ${String(result.length / 5).padStart(7)} tokens` +
+      `  median ${times[runs >> 1].toFixed(2).padStart(7)} ms  min ${times[0].toFixed(2).padStart(7)} ms`,
+  );
+}
+
+function replay(name, keystrokes, run) {
+  const times = [];
+  let integers = 0;
+  for (const [offset, text] of keystrokes) {
+    const start = performance.now();
+    integers += run(offset, text);
+    times.push(performance.now() - start);
+  }
+  times.sort((a, b) => a - b);
+  const total = times.reduce((sum, time) => sum + time, 0);
+  console.log(
+    `${name.padEnd(7)} ${String(keystrokes.length).padStart(4)} keystrokes` +
+      `  median ${times[times.length >> 1].toFixed(3).padStart(7)} ms` +
+      `  total ${total.toFixed(1).padStart(8)} ms  ${integers} integers sent`,
+  );
+}
+
+function main() {
+  const file = process.argv[2];
+  const source = file ? fs.readFileSync(file, "utf8") : generate(5000);
+  const highlights = fs.readFileSync(path.join(__dirname, "..", "..", "queries", "highlights.scm"), "utf8");
+  console.log(`${source.split("\n").length} lines`);
+
+  const parser = new Parser();
+  parser.setLanguage(Elm);
+  const query = new Parser.Query(Elm, highlights);
+  const encoder = new Elm.SemanticTokensEncoder(highlights, LEGEND);
+
+  measure("js", 20, () => encodeInJs(parser, query, source));
+  measure("native", 20, () => encoder.encode(source));
+
+  const line = '    label = "typed " ++ String.fromInt (count + 1)\n';
+  const offset = Buffer.byteLength(source.slice(0, source.indexOf("\n", source.length >> 1) + 1));
+  const keystrokes = Array.from(line, (character, i) => [offset + i, character]);
+  console.log(`typing ${JSON.stringify(line)}`);
+
+  let typed = Buffer.from(source);
+  replay("full", keystrokes, (at, text) => {
+    typed = Buffer.concat([typed.subarray(0, at), Buffer.from(text), typed.subarray(at)]);
+    return encoder.encode(typed).length;
+  });
+  const document = new Elm.SemanticTokensDocument(encoder, source);
+  replay("delta", keystrokes, (at, text) =>
+    document.edit(at, at, text).reduce((sum, edit) => sum + edit.data.length, 0),
+  );
+  const viewport = new Elm.SemanticTokensDocument(encoder, source);
+  let rangeSource = Buffer.from(source);
+  replay("range", keystrokes, (at, text) => {
+    viewport.edit(at, at, text);
+    rangeSource = Buffer.concat([rangeSource.subarray(0, at), Buffer.from(text), rangeSource.subarray(at)]);
+    let start = at;
+    for (let lines = 0; start > 0 && lines < 30; start--) {
+      lines += rangeSource[start - 1] === 0x0a;
+    }
+    let end = at;
+    for (let lines = 0; end < rangeSource.length && lines < 30; end++) {
+      lines += rangeSource[end] === 0x0a;
+    }
+    return encoder.encode(viewport, start, end).length;
+  });
+}
+
+main();
@@ -0,0 +1,122 @@
+// Compare parsing every `[glsl| ... |]` block of a shader-heavy module up
+// front, as the injections query does today, with `ShaderInjections`, which
+// parses the shaders on screen only and keeps their trees across edits, which
+// reparse the Elm source incrementally.
+//
+// Usage: node bindings/node/bench_shader_injections.js [grammar] [file.elm]
+// The grammar defaults to tree-sitter-glsl, falling back to this grammar if
+// it is not installed. Without a file, a module with 200 shaders is generated.
+
+const fs = require("node:fs");
+const path = require("node:path");
+const { performance } = require("node:perf_hooks");
+
+const Parser = require("tree-sitter");
+const Elm = require(".");
+
+const PAGE_ROWS = 60;
+
+function generate(shaders) {
+  const chunks = ["module Scene exposing (..)\n\nimport WebGL exposing (Shader)\n"];
+  for (let i = 0; i < shaders; i++) {
+    chunks.push(
+      `\nvertex${i} : Shader { position : Vec3 } { u | perspective : Mat4 } { v : Vec3 }\n` +
+        `vertex${i} =\n` +
+        `    [glsl|\n` +
+        `        attribute vec3 position;\n` +
+        `        uniform mat4 perspective;\n` +
+        `        varying vec3 v;\n` +
+        `        void main () {\n` +
+        `            gl_Position = perspective * vec4(position * ${i}.0, 1.0);\n` +
+        `            v = position;\n` +
+        `        }\n` +
+        `    |]\n\n` +
+        `scale${i} : Float -> Float\n` +
+        `scale${i} x =\n` +
+        `    x * ${i}\n`,
+    );
+  }
+  return chunks.join("");
+}
+
+function loadGrammar(name) {
+  try {
+    return require(name);
+  } catch {
+    console.log(`${name} is not installed, parsing the shaders as Elm`);
+    return Elm;
+  }
+}
+
+function measure(name, runs, run) {
+  const times = [];
+  let result;
+  for (let i = 0; i < runs; i++) {
+    const start = performance.now();
+    result = run();
+    times.push(performance.now() - start);
+  }
+  times.sort((a, b) => a - b);
+  console.log(
+    `${name.padEnd(18)} ${String(result).padStart(5)} shaders parsed` +
+      `  median ${times[runs >> 1].toFixed(2).padStart(8)} ms  min ${times[0].toFixed(2).padStart(8)} ms`,
+  );
+}
+
+function main() {
+  const grammar = loadGrammar(process.argv[2] || "tree-sitter-glsl");
+  const file = process.argv[3];
+  const source = file ? fs.readFileSync(file, "utf8") : generate(200);
+  const injections = fs.readFileSync(path.join(__dirname, "..", "..", "queries", "injections.scm"), "utf8");
+  const rows = source.split("\n").length;
+  console.log(`${rows} lines, ${source.split("[glsl|").length - 1} shaders`);
+
+  const parser = new Parser();
+  parser.setLanguage(Elm);
+  const shaderParser = new Parser();
+  shaderParser.setLanguage(grammar);
+  const query = new Parser.Query(Elm, injections);
+
+  measure("eager", 10, () => {
+    const tree = parser.parse(source);
+    let parsed = 0;
+    for (const { node } of query.captures(tree.rootNode)) {
+      shaderParser.parse(node.text);
+      parsed++;
+    }
+    return parsed;
+  });
+
+  const shaders = new Elm.ShaderInjections(grammar);
+  measure("lazy first page", 10, () => {
+    shaders.setSource("");
+    shaders.setSource(source);
+    return shaders.parseRows(0, PAGE_ROWS);
+  });
+
+  // Typing outside the shaders keeps every parsed shader
+  shaders.setSource(source);
+  shaders.parseRows(0, Infinity);
+  const edit = Buffer.byteLength(source.slice(0, source.indexOf("x * 0")));
+  let typed = "x * 0";
+  let version = 0;
+  measure("lazy after an edit", 10, () => {
+    version++;
+    const text = `x * ${version}`;
+    shaders.edit(edit, edit + typed.length, text);
+    typed = text;
+    return shaders.parseRows(rows >> 1, (rows >> 1) + PAGE_ROWS);
+  });
+
+  measure("lazy scroll", 1, () => {
+    shaders.setSource("");
+    shaders.setSource(source);
+    let parsed = 0;
+    for (let row = 0; row < rows; row += PAGE_ROWS) {
+      parsed += shaders.parseRows(row, row + PAGE_ROWS);
+    }
+    return parsed;
+  });
+}
+
+main();
@@ -0,0 +1,162 @@
+// Compare parsing with the wasm grammar in web-tree-sitter against the
+// native addon in node-tree-sitter, for full parses and for incremental
+// reparses after inserting a line in the middle of each source. Runs
+// offline and headless, so it tells whether moving parsing into browser
+// tooling is viable without opening a browser.
+//
+// Usage: node bindings/node/bench_wasm.js [--wasm file.wasm] [--runs N] [file|directory ...]
+// Defaults to the examples of test/corpus and to `examples` if it exists,
+// and to docs/js/tree-sitter-elm.wasm, script/build-wasm builds an
+// optimized one. Needs `npm install --no-save web-tree-sitter tree-sitter`,
+// with a web-tree-sitter that supports the ABI of src/parser.c.
+
+const fs = require("node:fs");
+const path = require("node:path");
+const { performance } = require("node:perf_hooks");
+
+const ROOT = path.join(__dirname, "..", "..");
+const EDIT = "-- edited\n";
+
+function collect(file, sources = []) {
+  if (fs.statSync(file).isDirectory()) {
+    for (const entry of fs.readdirSync(file)) {
+      collect(path.join(file, entry), sources);
+    }
+  } else if (file.endsWith(".txt")) {
+    sources.push(...corpusExamples(fs.readFileSync(file, "utf8")));
+  } else if (file.endsWith(".elm")) {
+    sources.push(fs.readFileSync(file, "utf8"));
+  }
+  return sources;
+}
+
+// The lines between the `===` header and the `---` line of each example
+function corpusExamples(text) {
+  const examples = [];
+  const lines = text.split("\n");
+  for (let i = 0; i < lines.length; i++) {
+    if (!/^=+$/.test(lines[i]) || !/^=+$/.test(lines[i + 2] ?? "")) {
+      continue;
+    }
+    let end = i + 3;
+    while (end < lines.length && !/^-+$/.test(lines[end])) {
+      end++;
+    }
+    examples.push(lines.slice(i + 3, end).join("\n") + "\n");
+    i = end;
+  }
+  return examples;
+}
+
+// The edited source and the edit in both APIs' terms, which are the same
+function edit(source) {
+  const middle = source.lastIndexOf("\n", source.length / 2) + 1;
+  const row = source.slice(0, middle).split("\n").length - 1;
+  return {
+    text: source.slice(0, middle) + EDIT + source.slice(middle),
+    edit: {
+      startIndex: middle,
+      oldEndIndex: middle,
+      newEndIndex: middle + EDIT.length,
+      startPosition: { row, column: 0 },
+      oldEndPosition: { row, column: 0 },
+      newEndPosition: { row: row + 1, column: 0 },
+    },
+  };
+}
+
+function measure(parser, sources, edits, runs) {
+  let full = 0;
+  let incremental = 0;
+  let errors = 0;
+  for (let run = 0; run < runs; run++) {
+    for (let i = 0; i < sources.length; i++) {
+      let start = performance.now();
+      const tree = parser.parse(sources[i]);
+      full += performance.now() - start;
+      tree.edit(edits[i].edit);
+      start = performance.now();
+      const edited = parser.parse(edits[i].text, tree);
+      incremental += performance.now() - start;
+      if (run === 0 && tree.rootNode.hasError) {
+        errors++;
+      }
+      edited.delete?.();
+      tree.delete?.();
+    }
+  }
+  return { full, incremental, errors };
+}
+
+async function wasmParser(wasm) {
+  const TreeSitter = require("web-tree-sitter");
+  // 0.25 exports the classes, earlier versions the Parser with the
+  // Language on it
+  const Parser = TreeSitter.Parser ?? TreeSitter;
+  const Language = TreeSitter.Language ?? Parser.Language;
+  await Parser.init();
+  const parser = new Parser();
+  parser.setLanguage(await Language.load(fs.readFileSync(wasm)));
+  return parser;
+}
+
+function nativeParser() {
+  const Parser = require("tree-sitter");
+  const parser = new Parser();
+  parser.setLanguage(require("."));
+  return parser;
+}
+
+async function main() {
+  const args = process.argv.slice(2);
+  let wasm = path.join(ROOT, "docs", "js", "tree-sitter-elm.wasm");
+  let runs = 5;
+  while (args[0]?.startsWith("--")) {
+    const [flag, value] = args.splice(0, 2);
+    if (flag === "--wasm") {
+      wasm = value;
+    } else if (flag === "--runs") {
+      runs = Number(value);
+    } else {
+      console.error(`unknown option ${flag}`);
+      process.exit(1);
+    }
+  }
+  const roots = args.length
+    ? args
+    : [path.join(ROOT, "test", "corpus"), path.join(ROOT, "examples")].filter(fs.existsSync);
+  const sources = roots.flatMap((root) => collect(root));
+  const edits = sources.map(edit);
+  const bytes = sources.reduce((sum, source) => sum + Buffer.byteLength(source), 0) * runs;
+  console.log(`${sources.length} sources, ${(bytes / runs / 1024).toFixed(0)} KiB, ${runs} runs`);
+  console.log(`${path.relative(process.cwd(), wasm)}: ${fs.statSync(wasm).size} bytes`);
+
+  const results = {};
+  for (const [name, create] of [["native", nativeParser], ["wasm", () => wasmParser(wasm)]]) {
+    let parser;
+    try {
+      parser = await create();
+    } catch (error) {
+      console.log(`${name.padEnd(8)} skipped: ${error.message.split("\n")[0]}`);
+      continue;
+    }
+    // Warm up the JIT and the wasm tiers before timing
+    measure(parser, sources, edits, 1);
+    const result = measure(parser, sources, edits, runs);
+    results[name] = result;
+    console.log(
+      `${name.padEnd(8)} full ${result.full.toFixed(1).padStart(9)} ms` +
+        ` ${(bytes / result.full / 1e3).toFixed(2).padStart(8)} MB/s` +
+        `  incremental ${result.incremental.toFixed(1).padStart(9)} ms` +
+        `  ${result.errors} sources with errors`,
+    );
+  }
+  if (results.native && results.wasm) {
+    console.log(
+      `wasm/native full ${(results.wasm.full / results.native.full).toFixed(2)}x` +
+        `  incremental ${(results.wasm.incremental / results.native.incremental).toFixed(2)}x`,
+    );
+  }
+}
+
+main();
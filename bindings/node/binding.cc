@@ -9,10 +9,1531 @@ const napi_type_tag LANGUAGE_TYPE_TAG = {
     0x8AF2E5212AD58ABF, 0xD5006CAD83ABBA16
 };
 
+#ifdef TREE_SITTER_ELM_LIB
+
+#include "tree_sitter/elm/batch.h"
+#include "tree_sitter/elm/bin_op.h"
+#include "tree_sitter/elm/budget.h"
+#include "tree_sitter/elm/declaration_hashes.h"
+#include "tree_sitter/elm/doc_index.h"
+#include "tree_sitter/elm/flat.h"
+#include "tree_sitter/elm/highlight.h"
+#include "tree_sitter/elm/line_index.h"
+#include "tree_sitter/elm/outline.h"
+#include "tree_sitter/elm/semantic_tokens.h"
+#include "tree_sitter/elm/shaders.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Marks the objects created by SemanticTokensEncoder
+const napi_type_tag SEMANTIC_TOKENS_ENCODER_TYPE_TAG = {
+    0x5E1A7C3D0B2F4E81, 0x93C6A2E4F7B1D058
+};
+
+// Marks the objects created by SemanticTokensDocument
+const napi_type_tag SEMANTIC_TOKENS_DOCUMENT_TYPE_TAG = {
+    0x2C8B4F71E3A6D905, 0xB7154E9A0C3F6D28
+};
+
+// `summarizeFiles` returns fixed-width uint32 records, see index.d.ts:
+//   files:        declaration index, count, import index, count, has error, errno
+//   declarations: kind, start, end, name start, name end, start row, name offset
+//   imports:      start, end, name start, name end, name offset
+// Name offsets index the UTF-8 `names` array, name lengths are end - start.
+
+// Every libuv threadpool thread keeps one parser for its whole lifetime.
+TSParser *ThreadParser() {
+    thread_local struct Holder {
+        TSParser *parser = nullptr;
+        ~Holder() {
+            if (parser != nullptr) {
+                ts_parser_delete(parser);
+            }
+        }
+    } holder;
+    if (holder.parser == nullptr) {
+        holder.parser = ts_parser_new();
+        ts_parser_set_language(holder.parser, tree_sitter_elm());
+    }
+    return holder.parser;
+}
+
+template <typename T>
+Napi::Value CopyToTypedArray(Napi::Env env, const std::vector<uint8_t> &bytes) {
+    auto buffer = Napi::ArrayBuffer::New(env, bytes.size());
+    if (!bytes.empty()) {
+        std::memcpy(buffer.Data(), bytes.data(), bytes.size());
+    }
+    return Napi::TypedArrayOf<T>::New(env, bytes.size() / sizeof(T), buffer, 0);
+}
+
+void Append(std::vector<uint8_t> &bytes, std::initializer_list<uint32_t> values) {
+    size_t offset = bytes.size();
+    bytes.resize(offset + values.size() * sizeof(uint32_t));
+    std::memcpy(bytes.data() + offset, values.begin(), values.size() * sizeof(uint32_t));
+}
+
+class SummarizeWorker : public Napi::AsyncWorker {
+  public:
+    SummarizeWorker(Napi::Env env, std::vector<std::string> paths)
+        : Napi::AsyncWorker(env), deferred_(Napi::Promise::Deferred::New(env)),
+          paths_(std::move(paths)) {}
+
+    Napi::Promise Promise() { return deferred_.Promise(); }
+
+  protected:
+    // Runs on the threadpool: parse, then flatten every summary into plain
+    // byte vectors so that OnOK only has to copy them into ArrayBuffers.
+    void Execute() override {
+        TSParser *parser = ThreadParser();
+        for (const std::string &path : paths_) {
+            TSElmFileSummary result;
+            ts_elm_summarize_file(parser, path.c_str(), &result);
+            const TSElmSummary &summary = result.summary;
+
+            Append(files_, {static_cast<uint32_t>(declaration_count_), summary.declaration_count,
+                            static_cast<uint32_t>(import_count_), summary.import_count,
+                            summary.has_error, static_cast<uint32_t>(result.error)});
+
+            for (uint32_t i = 0; i < summary.declaration_count; i++) {
+                const TSElmDeclaration &declaration = summary.declarations[i];
+                Append(declarations_,
+                       {declaration.symbol, declaration.start_byte, declaration.end_byte,
+                        declaration.name_start_byte, declaration.name_end_byte,
+                        declaration.start_point.row, AppendName(result, declaration.name_start_byte,
+                                                                declaration.name_end_byte)});
+            }
+            for (uint32_t i = 0; i < summary.import_count; i++) {
+                const TSElmImport &import = summary.imports[i];
+                Append(imports_, {import.start_byte, import.end_byte, import.name_start_byte,
+                                  import.name_end_byte,
+                                  AppendName(result, import.name_start_byte, import.name_end_byte)});
+            }
+            declaration_count_ += summary.declaration_count;
+            import_count_ += summary.import_count;
+
+            ts_elm_file_summary_delete(&result);
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        auto result = Napi::Object::New(env);
+        result["files"] = CopyToTypedArray<uint32_t>(env, files_);
+        result["declarations"] = CopyToTypedArray<uint32_t>(env, declarations_);
+        result["imports"] = CopyToTypedArray<uint32_t>(env, imports_);
+        result["names"] = CopyToTypedArray<uint8_t>(env, names_);
+        deferred_.Resolve(result);
+    }
+
+    void OnError(const Napi::Error &error) override { deferred_.Reject(error.Value()); }
+
+  private:
+    uint32_t AppendName(const TSElmFileSummary &result, uint32_t start, uint32_t end) {
+        uint32_t offset = static_cast<uint32_t>(names_.size());
+        names_.insert(names_.end(), result.source + start, result.source + end);
+        return offset;
+    }
+
+    Napi::Promise::Deferred deferred_;
+    std::vector<std::string> paths_;
+    std::vector<uint8_t> files_;
+    std::vector<uint8_t> declarations_;
+    std::vector<uint8_t> imports_;
+    std::vector<uint8_t> names_;
+    size_t declaration_count_ = 0;
+    size_t import_count_ = 0;
+};
+
+Napi::Value SummarizeFiles(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsArray()) {
+        throw Napi::TypeError::New(env, "Expected an array of paths");
+    }
+
+    auto array = info[0].As<Napi::Array>();
+    std::vector<std::string> paths;
+    paths.reserve(array.Length());
+    for (uint32_t i = 0; i < array.Length(); i++) {
+        Napi::Value path = array[i];
+        if (!path.IsString()) {
+            throw Napi::TypeError::New(env, "Expected an array of paths");
+        }
+        paths.push_back(path.As<Napi::String>().Utf8Value());
+    }
+
+    auto *worker = new SummarizeWorker(env, std::move(paths));
+    Napi::Promise promise = worker->Promise();
+    worker->Queue();
+    return promise;
+}
+
+// Reads `source` as a string or a Uint8Array of UTF-8. `string` owns the
+// bytes in the first case and must outlive `source`.
+void SourceArgument(const Napi::Value &value, std::string &string, const char *&source,
+                    uint32_t &length) {
+    size_t size;
+    if (value.IsString()) {
+        string = value.As<Napi::String>().Utf8Value();
+        source = string.data();
+        size = string.size();
+    } else if (value.IsTypedArray()) {
+        auto bytes = value.As<Napi::TypedArray>();
+        source = static_cast<const char *>(bytes.ArrayBuffer().Data()) + bytes.ByteOffset();
+        size = bytes.ByteLength();
+    } else {
+        throw Napi::TypeError::New(value.Env(), "Expected a string or a Uint8Array");
+    }
+    if (size > UINT32_MAX) {
+        throw Napi::RangeError::New(value.Env(), "Source is too large");
+    }
+    length = static_cast<uint32_t>(size);
+}
+
+// parseFlat(source, namedOnly) parses `source` again on the calling thread,
+// from scratch, and flattens that tree straight into the returned
+// ArrayBuffer, see flat.h for the layout. No caller tree is reused.
+Napi::Value ParseFlat(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1) {
+        throw Napi::TypeError::New(env, "Expected a string or a Uint8Array");
+    }
+    std::string string;
+    const char *source;
+    uint32_t length;
+    SourceArgument(info[0], string, source, length);
+    bool named_only = info.Length() > 1 && info[1].ToBoolean();
+
+    TSTree *tree = ts_parser_parse_string(ThreadParser(), nullptr, source, length);
+    TSNode root = ts_tree_root_node(tree);
+    uint32_t capacity = ts_node_descendant_count(root);
+    auto buffer = Napi::ArrayBuffer::New(env, capacity * sizeof(TSElmFlatNode));
+    uint32_t count = ts_elm_flatten(root, named_only, static_cast<TSElmFlatNode *>(buffer.Data()),
+                                    capacity);
+    ts_tree_delete(tree);
+    if (count == 0) {
+        throw Napi::Error::New(env, "Out of memory");
+    }
+    return Napi::Uint32Array::New(env, count * (sizeof(TSElmFlatNode) / sizeof(uint32_t)), buffer,
+                                  0);
+}
+
+// outline(source) parses on the calling thread and returns the document
+// outline as six uint32 values per symbol, see outlineLayout in index.js.
+Napi::Value Outline(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1) {
+        throw Napi::TypeError::New(env, "Expected a string or a Uint8Array");
+    }
+    std::string string;
+    const char *source;
+    uint32_t length;
+    SourceArgument(info[0], string, source, length);
+
+    TSTree *tree = ts_parser_parse_string(ThreadParser(), nullptr, source, length);
+    TSElmOutline outline = {};
+    bool ok = ts_elm_outline_build(&outline, ts_tree_root_node(tree));
+    ts_tree_delete(tree);
+    if (!ok) {
+        throw Napi::Error::New(env, "Out of memory");
+    }
+    auto result = Napi::Uint32Array::New(
+        env, outline.count * (sizeof(TSElmOutlineSymbol) / sizeof(uint32_t)));
+    if (outline.count > 0) {
+        std::memcpy(result.Data(), outline.symbols, outline.count * sizeof(TSElmOutlineSymbol));
+    }
+    ts_elm_outline_delete(&outline);
+    return result;
+}
+
+Napi::Uint32Array CopyToUint32Array(Napi::Env env, const uint32_t *data, uint32_t length) {
+    auto result = Napi::Uint32Array::New(env, length);
+    if (length > 0) {
+        std::memcpy(result.Data(), data, length * sizeof(uint32_t));
+    }
+    return result;
+}
+
+// The C helpers read the flag as a plain size_t
+static_assert(sizeof(std::atomic<size_t>) == sizeof(size_t), "atomic size_t has padding");
+
+// parseWithBudget(source, options) parses on the threadpool until
+// `options.timeoutMs` runs out or `options.signal` aborts, and resolves to
+// the parse metrics plus, when the parse completed, the tree in the layout
+// of parseFlat.
+class BudgetWorker : public Napi::AsyncWorker {
+  public:
+    BudgetWorker(Napi::Env env, std::string source, bool named_only, TSElmParseBudget budget)
+        : Napi::AsyncWorker(env), deferred_(Napi::Promise::Deferred::New(env)),
+          source_(std::move(source)), named_only_(named_only), budget_(budget),
+          cancelled_(std::make_shared<std::atomic<size_t>>(0)) {
+        budget_.cancellation_flag = reinterpret_cast<const size_t *>(cancelled_.get());
+    }
+
+    Napi::Promise Promise() { return deferred_.Promise(); }
+
+    // Cancel the parse when `signal` aborts, or right away if it already has.
+    void Listen(Napi::Object signal) {
+        if (signal.Get("aborted").ToBoolean()) {
+            cancelled_->store(1);
+            return;
+        }
+        std::shared_ptr<std::atomic<size_t>> cancelled = cancelled_;
+        auto listener = Napi::Function::New(
+            Env(), [cancelled](const Napi::CallbackInfo &) { cancelled->store(1); });
+        signal.Get("addEventListener").As<Napi::Function>().Call(
+            signal, {Napi::String::New(Env(), "abort"), listener});
+        signal_ = Napi::Persistent(signal);
+        listener_ = Napi::Persistent(listener);
+    }
+
+  protected:
+    void Execute() override {
+        TSTree *tree = ts_elm_parse_string_with_budget(ThreadParser(), nullptr, source_.data(),
+                                                       static_cast<uint32_t>(source_.size()),
+                                                       &budget_, &metrics_);
+        if (tree == nullptr) {
+            return;
+        }
+        TSNode root = ts_tree_root_node(tree);
+        nodes_.resize(ts_node_descendant_count(root));
+        nodes_.resize(ts_elm_flatten(root, named_only_, nodes_.data(),
+                                     static_cast<uint32_t>(nodes_.size())));
+        ts_tree_delete(tree);
+        if (nodes_.empty()) {
+            SetError("Out of memory");
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        StopListening();
+        static const char *const STATUSES[] = {"completed", "timedOut", "cancelled"};
+        auto result = Napi::Object::New(env);
+        result["status"] = STATUSES[metrics_.status];
+        result["bytesConsumed"] = metrics_.bytes_consumed;
+        result["totalMs"] = static_cast<double>(metrics_.total_nanos) / 1e6;
+        result["scannerMs"] = static_cast<double>(metrics_.scanner_nanos) / 1e6;
+        result["scannerCalls"] = static_cast<double>(metrics_.scanner_calls);
+        if (metrics_.status == TSElmParseCompleted) {
+            uint32_t length = static_cast<uint32_t>(nodes_.size() * sizeof(TSElmFlatNode) /
+                                                    sizeof(uint32_t));
+            result["nodes"] = CopyToUint32Array(
+                env, reinterpret_cast<const uint32_t *>(nodes_.data()), length);
+        }
+        deferred_.Resolve(result);
+    }
+
+    void OnError(const Napi::Error &error) override {
+        StopListening();
+        deferred_.Reject(error.Value());
+    }
+
+  private:
+    void StopListening() {
+        if (signal_.IsEmpty()) {
+            return;
+        }
+        Napi::Object signal = signal_.Value();
+        signal.Get("removeEventListener").As<Napi::Function>().Call(
+            signal, {Napi::String::New(Env(), "abort"), listener_.Value()});
+        signal_.Reset();
+        listener_.Reset();
+    }
+
+    Napi::Promise::Deferred deferred_;
+    std::string source_;
+    bool named_only_;
+    TSElmParseBudget budget_;
+    TSElmParseMetrics metrics_ = {};
+    std::shared_ptr<std::atomic<size_t>> cancelled_;
+    std::vector<TSElmFlatNode> nodes_;
+    Napi::ObjectReference signal_;
+    Napi::FunctionReference listener_;
+};
+
+Napi::Value ParseWithBudget(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1) {
+        throw Napi::TypeError::New(env, "Expected a string or a Uint8Array");
+    }
+    std::string string;
+    const char *source;
+    uint32_t length;
+    SourceArgument(info[0], string, source, length);
+    if (string.empty()) {
+        string.assign(source, length);
+    }
+
+    TSElmParseBudget budget = {0, nullptr, false};
+    bool named_only = false;
+    Napi::Object signal;
+    if (info.Length() > 1 && info[1].IsObject()) {
+        auto options = info[1].As<Napi::Object>();
+        Napi::Value timeout = options.Get("timeoutMs");
+        if (timeout.IsNumber()) {
+            double micros = timeout.As<Napi::Number>().DoubleValue() * 1000;
+            budget.timeout_micros = micros < 1 ? 1 : static_cast<uint64_t>(micros);
+        }
+        budget.time_scanner = options.Get("timeScanner").ToBoolean();
+        named_only = options.Get("namedOnly").ToBoolean();
+        Napi::Value value = options.Get("signal");
+        if (value.IsObject()) {
+            signal = value.As<Napi::Object>();
+        }
+    }
+
+    auto *worker = new BudgetWorker(env, std::move(string), named_only, budget);
+    if (!signal.IsEmpty()) {
+        worker->Listen(signal);
+    }
+    Napi::Promise promise = worker->Promise();
+    worker->Queue();
+    return promise;
+}
+
+// new SemanticTokensEncoder(highlightsQuery, legend), where `legend` maps
+// capture prefixes to a token type or a [type, modifiers] pair.
+class SemanticTokensEncoder : public Napi::ObjectWrap<SemanticTokensEncoder> {
+  public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "SemanticTokensEncoder",
+                           {InstanceMethod("encode", &SemanticTokensEncoder::Encode)});
+    }
+
+    SemanticTokensEncoder(const Napi::CallbackInfo &info)
+        : Napi::ObjectWrap<SemanticTokensEncoder>(info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 2 || !info[0].IsString() || !info[1].IsObject()) {
+            throw Napi::TypeError::New(env, "Expected a query string and a legend object");
+        }
+        std::string query = info[0].As<Napi::String>().Utf8Value();
+
+        auto legend = info[1].As<Napi::Object>();
+        Napi::Array keys = legend.GetPropertyNames();
+        std::vector<std::string> captures;
+        std::vector<TSElmTokenMapping> mappings;
+        for (uint32_t i = 0; i < keys.Length(); i++) {
+            Napi::Value key = keys[i];
+            Napi::Value value = legend.Get(key);
+            TSElmTokenMapping mapping = {nullptr, 0, 0};
+            if (value.IsNumber()) {
+                mapping.token_type = value.As<Napi::Number>().Uint32Value();
+            } else if (value.IsArray() && value.As<Napi::Array>().Length() == 2) {
+                auto pair = value.As<Napi::Array>();
+                mapping.token_type = pair.Get(0u).ToNumber().Uint32Value();
+                mapping.token_modifiers = pair.Get(1u).ToNumber().Uint32Value();
+            } else {
+                throw Napi::TypeError::New(env, "Expected a token type or a [type, modifiers] pair");
+            }
+            captures.push_back(key.ToString().Utf8Value());
+            mappings.push_back(mapping);
+        }
+        for (size_t i = 0; i < mappings.size(); i++) {
+            mappings[i].capture = captures[i].c_str();
+        }
+
+        uint32_t error_offset;
+        TSQueryError error_type;
+        tokens_ = ts_elm_semantic_tokens_new(query.data(), static_cast<uint32_t>(query.size()),
+                                             mappings.data(),
+                                             static_cast<uint32_t>(mappings.size()),
+                                             &error_offset, &error_type);
+        if (tokens_ == nullptr) {
+            throw Napi::Error::New(env, "Invalid query at offset " + std::to_string(error_offset));
+        }
+        info.This().As<Napi::Object>().TypeTag(&SEMANTIC_TOKENS_ENCODER_TYPE_TAG);
+    }
+
+    TSElmSemanticTokens *Tokens() const { return tokens_; }
+
+    ~SemanticTokensEncoder() { ts_elm_semantic_tokens_delete(tokens_); }
+
+  private:
+    // encode(document, startByte = 0, endByte = source length) returns the
+    // LSP `data` array for the tokens in the byte range. `document` is a
+    // SemanticTokensDocument, whose tree is used as is, or a source, which
+    // is parsed for this call only. Defined after SemanticTokensDocument.
+    Napi::Value Encode(const Napi::CallbackInfo &info);
+
+    // Encodes into `data_` and returns the number of integers written
+    uint32_t EncodeTree(TSNode root, const char *source, uint32_t start_byte, uint32_t end_byte) {
+        uint32_t count = ts_elm_semantic_tokens_encode(tokens_, root, source, start_byte, end_byte,
+                                                       data_.data(),
+                                                       static_cast<uint32_t>(data_.size()));
+        if (count > data_.size()) {
+            data_.resize(count);
+            ts_elm_semantic_tokens_encode(tokens_, root, source, start_byte, end_byte,
+                                          data_.data(), count);
+        }
+        return count;
+    }
+
+    TSElmSemanticTokens *tokens_ = nullptr;
+    // Reused between calls, grown to the largest encoding seen so far
+    std::vector<uint32_t> data_;
+};
+
+TSPoint Advance(TSPoint point, const char *text, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (text[i] == '\n') {
+            point.row++;
+            point.column = 0;
+        } else {
+            point.column++;
+        }
+    }
+    return point;
+}
+
+// Start from the smallest node around `byte` rather than the top of the
+// source, so that long documents are not scanned on every keystroke.
+TSPoint PointAt(TSNode root, const std::string &source, uint32_t byte) {
+    TSNode node = ts_node_descendant_for_byte_range(root, byte, byte);
+    if (ts_node_start_byte(node) > byte) {
+        return Advance(TSPoint{0, 0}, source.data(), byte);
+    }
+    uint32_t start = ts_node_start_byte(node);
+    return Advance(ts_node_start_point(node), source.data() + start, byte - start);
+}
+
+// Apply the (startByte, oldEndByte, text) arguments of a document's `edit`
+// to its UTF-8 source and its tree, which is then ready to be reparsed.
+TSInputEdit EditSource(const Napi::CallbackInfo &info, std::string &source, TSTree *tree) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 3 || !info[0].IsNumber() || !info[1].IsNumber() ||
+        !info[2].IsString()) {
+        throw Napi::TypeError::New(env, "Expected a start byte, an old end byte and a string");
+    }
+    uint32_t start = info[0].As<Napi::Number>().Uint32Value();
+    uint32_t old_end = info[1].As<Napi::Number>().Uint32Value();
+    std::string text = info[2].As<Napi::String>().Utf8Value();
+    if (start > old_end || old_end > source.size() ||
+        source.size() - (old_end - start) + text.size() > UINT32_MAX) {
+        throw Napi::RangeError::New(env, "Invalid edit range");
+    }
+
+    TSNode root = ts_tree_root_node(tree);
+    TSInputEdit edit;
+    edit.start_byte = start;
+    edit.old_end_byte = old_end;
+    edit.new_end_byte = start + static_cast<uint32_t>(text.size());
+    edit.start_point = PointAt(root, source, start);
+    edit.old_end_point = PointAt(root, source, old_end);
+    edit.new_end_point = Advance(edit.start_point, text.data(), text.size());
+
+    source.replace(start, old_end - start, text);
+    ts_tree_edit(tree, &edit);
+    return edit;
+}
+
+// new SemanticTokensDocument(encoder, source) keeps the source, its tree and
+// its tokens, so that `edit` only highlights the declarations it touches.
+class SemanticTokensDocument : public Napi::ObjectWrap<SemanticTokensDocument> {
+  public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "SemanticTokensDocument",
+                           {InstanceMethod("data", &SemanticTokensDocument::Data),
+                            InstanceMethod("edit", &SemanticTokensDocument::Edit)});
+    }
+
+    SemanticTokensDocument(const Napi::CallbackInfo &info)
+        : Napi::ObjectWrap<SemanticTokensDocument>(info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 2 || !info[0].IsObject() ||
+            !info[0].As<Napi::Object>().CheckTypeTag(&SEMANTIC_TOKENS_ENCODER_TYPE_TAG) ||
+            !info[1].IsString()) {
+            throw Napi::TypeError::New(env, "Expected a SemanticTokensEncoder and a string");
+        }
+        encoder_ = Napi::Persistent(info[0].As<Napi::Object>());
+        tokens_ = SemanticTokensEncoder::Unwrap(encoder_.Value())->Tokens();
+        source_ = info[1].As<Napi::String>().Utf8Value();
+        if (source_.size() > UINT32_MAX) {
+            throw Napi::RangeError::New(env, "Source is too large");
+        }
+
+        cache_ = ts_elm_semantic_tokens_cache_new();
+        tree_ = ts_parser_parse_string(ThreadParser(), nullptr, source_.data(),
+                                       static_cast<uint32_t>(source_.size()));
+        if (cache_ == nullptr ||
+            !ts_elm_semantic_tokens_cache_reset(tokens_, cache_, ts_tree_root_node(tree_),
+                                                source_.data(),
+                                                static_cast<uint32_t>(source_.size()))) {
+            throw Napi::Error::New(env, "Out of memory");
+        }
+        info.This().As<Napi::Object>().TypeTag(&SEMANTIC_TOKENS_DOCUMENT_TYPE_TAG);
+    }
+
+    const TSTree *Tree() const { return tree_; }
+    const std::string &Source() const { return source_; }
+
+    ~SemanticTokensDocument() {
+        ts_elm_semantic_tokens_cache_delete(cache_);
+        if (tree_ != nullptr) {
+            ts_tree_delete(tree_);
+        }
+    }
+
+  private:
+    // data() returns the `data` of a full LSP `SemanticTokens` result.
+    Napi::Value Data(const Napi::CallbackInfo &info) {
+        uint32_t length;
+        const uint32_t *data = ts_elm_semantic_tokens_cache_data(cache_, &length);
+        return CopyToUint32Array(info.Env(), data, length);
+    }
+
+    // edit(startByte, oldEndByte, text) replaces a byte range of the UTF-8
+    // source and returns the `edits` of an LSP `SemanticTokensDelta`.
+    Napi::Value Edit(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        TSInputEdit edit = EditSource(info, source_, tree_);
+        TSTree *tree = ts_parser_parse_string(ThreadParser(), tree_, source_.data(),
+                                              static_cast<uint32_t>(source_.size()));
+        bool ok = ts_elm_semantic_tokens_cache_update(tokens_, cache_, tree_, tree, source_.data(),
+                                                      static_cast<uint32_t>(source_.size()),
+                                                      &edit, 1);
+        ts_tree_delete(tree_);
+        tree_ = tree;
+        if (!ok) {
+            throw Napi::Error::New(env, "Out of memory");
+        }
+
+        uint32_t length, count;
+        const uint32_t *data = ts_elm_semantic_tokens_cache_data(cache_, &length);
+        const TSElmSemanticTokensEdit *edits = ts_elm_semantic_tokens_cache_edits(cache_, &count);
+        auto result = Napi::Array::New(env, count);
+        for (uint32_t i = 0; i < count; i++) {
+            auto object = Napi::Object::New(env);
+            object["start"] = Napi::Number::New(env, edits[i].start);
+            object["deleteCount"] = Napi::Number::New(env, edits[i].delete_count);
+            object["data"] = CopyToUint32Array(env, data + edits[i].data_start, edits[i].data_count);
+            result[i] = object;
+        }
+        return result;
+    }
+
+    Napi::ObjectReference encoder_;
+    TSElmSemanticTokens *tokens_ = nullptr;
+    TSElmSemanticTokensCache *cache_ = nullptr;
+    TSTree *tree_ = nullptr;
+    std::string source_;
+};
+
+Napi::Value SemanticTokensEncoder::Encode(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1) {
+        throw Napi::TypeError::New(env, "Expected a SemanticTokensDocument, a string or a Uint8Array");
+    }
+    uint32_t start_byte = info.Length() > 1 ? info[1].ToNumber().Uint32Value() : 0;
+    uint32_t end_byte = info.Length() > 2 ? info[2].ToNumber().Uint32Value() : UINT32_MAX;
+
+    if (info[0].IsObject() &&
+        info[0].As<Napi::Object>().CheckTypeTag(&SEMANTIC_TOKENS_DOCUMENT_TYPE_TAG)) {
+        auto document = SemanticTokensDocument::Unwrap(info[0].As<Napi::Object>());
+        const std::string &source = document->Source();
+        uint32_t length = static_cast<uint32_t>(source.size());
+        uint32_t count = EncodeTree(ts_tree_root_node(document->Tree()), source.data(), start_byte,
+                                    std::min(end_byte, length));
+        return CopyToUint32Array(env, data_.data(), count);
+    }
+
+    std::string string;
+    const char *source;
+    uint32_t length;
+    SourceArgument(info[0], string, source, length);
+    TSTree *tree = ts_parser_parse_string(ThreadParser(), nullptr, source, length);
+    uint32_t count = EncodeTree(ts_tree_root_node(tree), source, start_byte,
+                                std::min(end_byte, length));
+    ts_tree_delete(tree);
+    return CopyToUint32Array(env, data_.data(), count);
+}
+
+TSQuery *NewQuery(Napi::Env env, const std::string &source) {
+    uint32_t error_offset;
+    TSQueryError error_type;
+    TSQuery *query = ts_query_new(tree_sitter_elm(), source.data(),
+                                  static_cast<uint32_t>(source.size()), &error_offset, &error_type);
+    if (query == nullptr) {
+        throw Napi::Error::New(env, "Invalid query at offset " + std::to_string(error_offset));
+    }
+    return query;
+}
+
+// new Highlighter(highlightsQuery, injectionsQuery) highlights the rows an
+// editor shows. Results are cached per block of rows until `setSource`, an
+// `edit` only drops the blocks around it.
+class Highlighter : public Napi::ObjectWrap<Highlighter> {
+  public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "Highlighter",
+                           {InstanceMethod("setSource", &Highlighter::SetSource),
+                            InstanceMethod("edit", &Highlighter::Edit),
+                            InstanceMethod("highlightRows", &Highlighter::HighlightRows),
+                            InstanceMethod("highlightBytes", &Highlighter::HighlightBytes)});
+    }
+
+    Highlighter(const Napi::CallbackInfo &info) : Napi::ObjectWrap<Highlighter>(info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 1 || !info[0].IsString() ||
+            (info.Length() > 1 && !info[1].IsString() && !info[1].IsUndefined())) {
+            throw Napi::TypeError::New(env, "Expected a highlights query and an injections query");
+        }
+        // The destructor does not run when the constructor throws
+        highlights_ = NewQuery(env, info[0].As<Napi::String>().Utf8Value());
+        try {
+            if (info.Length() > 1 && info[1].IsString()) {
+                injections_ = NewQuery(env, info[1].As<Napi::String>().Utf8Value());
+            }
+            highlighter_ = ts_elm_highlighter_new(highlights_, injections_);
+            if (highlighter_ == nullptr) {
+                throw Napi::Error::New(env, "Out of memory");
+            }
+        } catch (...) {
+            ts_query_delete(highlights_);
+            if (injections_ != nullptr) {
+                ts_query_delete(injections_);
+            }
+            throw;
+        }
+
+        uint32_t capture_count = ts_query_capture_count(highlights_);
+        auto captures = Napi::Array::New(env, capture_count);
+        for (uint32_t i = 0; i < capture_count; i++) {
+            uint32_t length;
+            const char *name = ts_query_capture_name_for_id(highlights_, i, &length);
+            captures[i] = Napi::String::New(env, name, length);
+        }
+        uint32_t language_count = ts_elm_highlighter_injection_language_count(highlighter_);
+        auto languages = Napi::Array::New(env, language_count);
+        for (uint32_t i = 0; i < language_count; i++) {
+            uint32_t length;
+            const char *name = ts_elm_highlighter_injection_language(highlighter_, i, &length);
+            languages[i] = Napi::String::New(env, name, length);
+        }
+        Napi::Object self = info.This().As<Napi::Object>();
+        self["captureNames"] = captures;
+        self["injectionLanguages"] = languages;
+    }
+
+    ~Highlighter() {
+        ts_elm_highlighter_delete(highlighter_);
+        if (tree_ != nullptr) {
+            ts_tree_delete(tree_);
+        }
+        ts_query_delete(highlights_);
+        if (injections_ != nullptr) {
+            ts_query_delete(injections_);
+        }
+    }
+
+  private:
+    Napi::Value SetSource(const Napi::CallbackInfo &info) {
+        if (info.Length() < 1) {
+            throw Napi::TypeError::New(info.Env(), "Expected a string or a Uint8Array");
+        }
+        std::string string;
+        const char *source;
+        uint32_t length;
+        SourceArgument(info[0], string, source, length);
+        // Kept for `edit`
+        source_.assign(source, length);
+        TSTree *tree = ts_parser_parse_string(ThreadParser(), nullptr, source, length);
+        ts_elm_highlighter_set_tree(highlighter_, tree);
+        if (tree_ != nullptr) {
+            ts_tree_delete(tree_);
+        }
+        tree_ = tree;
+        return info.Env().Undefined();
+    }
+
+    // edit(startByte, oldEndByte, text) replaces a byte range of the UTF-8
+    // source and reparses it incrementally. Cached blocks away from the edit
+    // are kept.
+    Napi::Value Edit(const Napi::CallbackInfo &info) {
+        if (tree_ == nullptr) {
+            throw Napi::Error::New(info.Env(), "No source to edit, call setSource first");
+        }
+        TSInputEdit edit = EditSource(info, source_, tree_);
+        TSTree *tree = ts_parser_parse_string(ThreadParser(), tree_, source_.data(),
+                                              static_cast<uint32_t>(source_.size()));
+        ts_elm_highlighter_edit_tree(highlighter_, tree_, tree, &edit, 1);
+        ts_tree_delete(tree_);
+        tree_ = tree;
+        return info.Env().Undefined();
+    }
+
+    // highlightRows(startRow, endRow) and highlightBytes(startByte, endByte)
+    // return `highlights` and `injections` as records of seven integers:
+    // start byte, end byte, start row, start column, end row, end column and
+    // the index into `captureNames` or `injectionLanguages`. Columns count
+    // bytes, like tree-sitter points.
+    Napi::Value HighlightRows(const Napi::CallbackInfo &info) {
+        auto [start, end] = Range(info);
+        if (!ts_elm_highlighter_highlight_rows(highlighter_, start, end)) {
+            throw Napi::Error::New(info.Env(), "Out of memory");
+        }
+        return Result(info.Env());
+    }
+
+    Napi::Value HighlightBytes(const Napi::CallbackInfo &info) {
+        auto [start, end] = Range(info);
+        if (!ts_elm_highlighter_highlight_bytes(highlighter_, start, end)) {
+            throw Napi::Error::New(info.Env(), "Out of memory");
+        }
+        return Result(info.Env());
+    }
+
+    static std::pair<uint32_t, uint32_t> Range(const Napi::CallbackInfo &info) {
+        if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+            throw Napi::TypeError::New(info.Env(), "Expected a start and an end");
+        }
+        double end = info[1].As<Napi::Number>().DoubleValue();
+        return {info[0].As<Napi::Number>().Uint32Value(),
+                end >= UINT32_MAX ? UINT32_MAX : info[1].As<Napi::Number>().Uint32Value()};
+    }
+
+    template <typename T>
+    static Napi::Uint32Array Records(Napi::Env env, const T *items, uint32_t count,
+                                     uint32_t T::*index) {
+        auto result = Napi::Uint32Array::New(env, static_cast<size_t>(count) * 7);
+        uint32_t *data = result.Data();
+        for (uint32_t i = 0; i < count; i++, data += 7) {
+            const T &item = items[i];
+            data[0] = item.start_byte;
+            data[1] = item.end_byte;
+            data[2] = item.start_point.row;
+            data[3] = item.start_point.column;
+            data[4] = item.end_point.row;
+            data[5] = item.end_point.column;
+            data[6] = item.*index;
+        }
+        return result;
+    }
+
+    Napi::Object Result(Napi::Env env) {
+        uint32_t highlight_count, injection_count;
+        const TSElmHighlight *highlights = ts_elm_highlighter_highlights(highlighter_, &highlight_count);
+        const TSElmInjection *injections = ts_elm_highlighter_injections(highlighter_, &injection_count);
+        auto result = Napi::Object::New(env);
+        result["highlights"] = Records(env, highlights, highlight_count, &TSElmHighlight::capture);
+        result["injections"] = Records(env, injections, injection_count, &TSElmInjection::language);
+        return result;
+    }
+
+    TSQuery *highlights_ = nullptr;
+    TSQuery *injections_ = nullptr;
+    TSElmHighlighter *highlighter_ = nullptr;
+    TSTree *tree_ = nullptr;
+    std::string source_;
+};
+
+// new ShaderInjections(grammar) parses the `[glsl| ... |]` blocks of a file
+// with another grammar's `language`, only the ones asked for.
+class ShaderInjections : public Napi::ObjectWrap<ShaderInjections> {
+  public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "ShaderInjections",
+                           {InstanceMethod("setSource", &ShaderInjections::SetSource),
+                            InstanceMethod("edit", &ShaderInjections::Edit),
+                            InstanceMethod("ranges", &ShaderInjections::Ranges),
+                            InstanceMethod("parseRows", &ShaderInjections::ParseRows),
+                            InstanceMethod("flatTree", &ShaderInjections::FlatTree)});
+    }
+
+    ShaderInjections(const Napi::CallbackInfo &info) : Napi::ObjectWrap<ShaderInjections>(info) {
+        Napi::Env env = info.Env();
+        Napi::Value language;
+        if (info.Length() > 0 && info[0].IsObject()) {
+            language = info[0].As<Napi::Object>().Get("language");
+        }
+        if (language.IsEmpty() || !language.IsExternal() ||
+            !language.As<Napi::External<TSLanguage>>().CheckTypeTag(&LANGUAGE_TYPE_TAG)) {
+            throw Napi::TypeError::New(env, "Expected a tree-sitter grammar");
+        }
+        const TSLanguage *glsl = language.As<Napi::External<TSLanguage>>().Data();
+        shaders_ = ts_elm_shaders_new(glsl);
+        if (shaders_ == nullptr) {
+            throw Napi::Error::New(env, "Incompatible grammar");
+        }
+
+        uint32_t count = ts_language_symbol_count(glsl);
+        auto names = Napi::Array::New(env, count);
+        for (uint32_t i = 0; i < count; i++) {
+            names[i] = Napi::String::New(env, ts_language_symbol_name(glsl, static_cast<TSSymbol>(i)));
+        }
+        info.This().As<Napi::Object>()["symbolNames"] = names;
+    }
+
+    ~ShaderInjections() {
+        ts_elm_shaders_delete(shaders_);
+        if (tree_ != nullptr) {
+            ts_tree_delete(tree_);
+        }
+    }
+
+  private:
+    // setSource(source) parses the Elm source and returns the number of
+    // shader blocks. Shaders whose content did not change stay parsed.
+    Napi::Value SetSource(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 1) {
+            throw Napi::TypeError::New(env, "Expected a string or a Uint8Array");
+        }
+        std::string string;
+        const char *source;
+        uint32_t length;
+        SourceArgument(info[0], string, source, length);
+        // The driver borrows the source until the next call
+        source_.assign(source, length);
+        if (tree_ != nullptr) {
+            ts_tree_delete(tree_);
+        }
+        tree_ = ts_parser_parse_string(ThreadParser(), nullptr, source_.data(), length);
+        return SetTree(env);
+    }
+
+    // edit(startByte, oldEndByte, text) replaces a byte range of the UTF-8
+    // source, reparses it incrementally and returns the number of shader
+    // blocks, like setSource.
+    Napi::Value Edit(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        if (tree_ == nullptr) {
+            throw Napi::Error::New(env, "No source to edit, call setSource first");
+        }
+        EditSource(info, source_, tree_);
+        TSTree *tree = ts_parser_parse_string(ThreadParser(), tree_, source_.data(),
+                                              static_cast<uint32_t>(source_.size()));
+        ts_tree_delete(tree_);
+        tree_ = tree;
+        return SetTree(env);
+    }
+
+    Napi::Value SetTree(Napi::Env env) {
+        if (!ts_elm_shaders_set_tree(shaders_, tree_, source_.data(),
+                                     static_cast<uint32_t>(source_.size()))) {
+            throw Napi::Error::New(env, "Out of memory");
+        }
+        uint32_t count;
+        ts_elm_shaders_ranges(shaders_, &count);
+        return Napi::Number::New(env, count);
+    }
+
+    // ranges() returns six integers per shader: start byte, end byte, start
+    // row, start column, end row and end column of its content.
+    Napi::Value Ranges(const Napi::CallbackInfo &info) {
+        uint32_t count;
+        const TSElmShader *shaders = ts_elm_shaders_ranges(shaders_, &count);
+        auto result = Napi::Uint32Array::New(info.Env(), static_cast<size_t>(count) * 6);
+        uint32_t *data = result.Data();
+        for (uint32_t i = 0; i < count; i++, data += 6) {
+            data[0] = shaders[i].start_byte;
+            data[1] = shaders[i].end_byte;
+            data[2] = shaders[i].start_point.row;
+            data[3] = shaders[i].start_point.column;
+            data[4] = shaders[i].end_point.row;
+            data[5] = shaders[i].end_point.column;
+        }
+        return result;
+    }
+
+    // parseRows(startRow, endRow) parses the shaders in view that are not
+    // cached yet and returns how many it parsed.
+    Napi::Value ParseRows(const Napi::CallbackInfo &info) {
+        if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+            throw Napi::TypeError::New(info.Env(), "Expected a start and an end row");
+        }
+        double end = info[1].As<Napi::Number>().DoubleValue();
+        uint32_t parsed = ts_elm_shaders_parse_rows(
+            shaders_, info[0].As<Napi::Number>().Uint32Value(),
+            end >= UINT32_MAX ? UINT32_MAX : info[1].As<Napi::Number>().Uint32Value());
+        return Napi::Number::New(info.Env(), parsed);
+    }
+
+    // flatTree(index, namedOnly) parses a shader unless it is cached and
+    // flattens its tree like parseFlat, with bytes relative to the shader.
+    Napi::Value FlatTree(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 1 || !info[0].IsNumber()) {
+            throw Napi::TypeError::New(env, "Expected a shader index");
+        }
+        const TSTree *tree = ts_elm_shaders_tree(shaders_, info[0].As<Napi::Number>().Uint32Value());
+        if (tree == nullptr) {
+            return env.Null();
+        }
+        bool named_only = info.Length() > 1 && info[1].ToBoolean();
+        TSNode root = ts_tree_root_node(tree);
+        uint32_t capacity = ts_node_descendant_count(root);
+        auto buffer = Napi::ArrayBuffer::New(env, capacity * sizeof(TSElmFlatNode));
+        uint32_t count = ts_elm_flatten(root, named_only, static_cast<TSElmFlatNode *>(buffer.Data()),
+                                        capacity);
+        if (count == 0) {
+            throw Napi::Error::New(env, "Out of memory");
+        }
+        return Napi::Uint32Array::New(env, count * (sizeof(TSElmFlatNode) / sizeof(uint32_t)),
+                                      buffer, 0);
+    }
+
+    TSElmShaders *shaders_ = nullptr;
+    TSTree *tree_ = nullptr;
+    std::string source_;
+};
+
+// new BinaryOperators() holds an operator table seeded with the elm/core
+// operators and gives the flat `bin_op_expr`s of a file their structure.
+class BinaryOperators : public Napi::ObjectWrap<BinaryOperators> {
+  public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "BinaryOperators",
+                           {InstanceMethod("set", &BinaryOperators::Set),
+                            InstanceMethod("readDeclarations", &BinaryOperators::ReadDeclarations),
+                            InstanceMethod("associate", &BinaryOperators::Associate)});
+    }
+
+    BinaryOperators(const Napi::CallbackInfo &info) : Napi::ObjectWrap<BinaryOperators>(info) {
+        operators_ = ts_elm_operators_new();
+        if (operators_ == nullptr) {
+            throw Napi::Error::New(info.Env(), "Out of memory");
+        }
+    }
+
+    ~BinaryOperators() { ts_elm_operators_delete(operators_); }
+
+  private:
+    // set(name, associativity, precedence) with "left", "right" or "non".
+    Napi::Value Set(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 3 || !info[0].IsString() || !info[1].IsString() || !info[2].IsNumber()) {
+            throw Napi::TypeError::New(env, "Expected an operator, an associativity and a precedence");
+        }
+        std::string name = info[0].As<Napi::String>().Utf8Value();
+        std::string associativity = info[1].As<Napi::String>().Utf8Value();
+        TSElmAssociativity value;
+        if (associativity == "left") {
+            value = TSElmAssociativityLeft;
+        } else if (associativity == "right") {
+            value = TSElmAssociativityRight;
+        } else if (associativity == "non") {
+            value = TSElmAssociativityNone;
+        } else {
+            throw Napi::TypeError::New(env, "Expected \"left\", \"right\" or \"non\"");
+        }
+        if (!ts_elm_operators_set(operators_, name.data(), static_cast<uint32_t>(name.size()), value,
+                                  info[2].As<Napi::Number>().Uint32Value())) {
+            throw Napi::RangeError::New(env, "Not an Elm operator");
+        }
+        return env.Undefined();
+    }
+
+    // readDeclarations(source) adds the operators of the file's
+    // `infix_declaration`s and returns how many it read.
+    Napi::Value ReadDeclarations(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 1) {
+            throw Napi::TypeError::New(env, "Expected a string or a Uint8Array");
+        }
+        std::string string;
+        const char *source;
+        uint32_t length;
+        SourceArgument(info[0], string, source, length);
+        TSTree *tree = ts_parser_parse_string(ThreadParser(), nullptr, source, length);
+        uint32_t count = ts_elm_operators_read_declarations(operators_, ts_tree_root_node(tree), source);
+        ts_tree_delete(tree);
+        return Napi::Number::New(env, count);
+    }
+
+    // associate(source) parses the source and builds the tree of every
+    // `bin_op_expr` in it, nested ones included. `expressions` has four
+    // integers per expression: start byte, end byte, index of its first node
+    // and node count, 0 if Elm rejects the operator mix. `nodes` has the
+    // five integers of each node, see bin_op.h, with left and right
+    // relative to the expression's first node.
+    Napi::Value Associate(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 1) {
+            throw Napi::TypeError::New(env, "Expected a string or a Uint8Array");
+        }
+        std::string string;
+        const char *source;
+        uint32_t length;
+        SourceArgument(info[0], string, source, length);
+
+        static const TSSymbol bin_op_expr =
+            ts_language_symbol_for_name(tree_sitter_elm(), "bin_op_expr", 11, true);
+        std::vector<uint32_t> expressions;
+        std::vector<TSElmBinOpNode> nodes;
+        TSTree *tree = ts_parser_parse_string(ThreadParser(), nullptr, source, length);
+        TSTreeCursor cursor = ts_tree_cursor_new(ts_tree_root_node(tree));
+        for (bool done = false; !done;) {
+            TSNode node = ts_tree_cursor_current_node(&cursor);
+            if (ts_node_symbol(node) == bin_op_expr) {
+                size_t first = nodes.size();
+                nodes.resize(first + ts_node_named_child_count(node));
+                uint32_t count = ts_elm_bin_op_tree(operators_, node, source, nodes.data() + first,
+                                                    static_cast<uint32_t>(nodes.size() - first));
+                nodes.resize(first + count);
+                expressions.insert(expressions.end(), {ts_node_start_byte(node), ts_node_end_byte(node),
+                                                       static_cast<uint32_t>(first), count});
+            }
+            if (ts_tree_cursor_goto_first_child(&cursor)) {
+                continue;
+            }
+            while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+                if (!ts_tree_cursor_goto_parent(&cursor)) {
+                    done = true;
+                    break;
+                }
+            }
+        }
+        ts_tree_cursor_delete(&cursor);
+        ts_tree_delete(tree);
+
+        auto result = Napi::Object::New(env);
+        result["expressions"] = CopyToUint32Array(env, expressions.data(),
+                                                  static_cast<uint32_t>(expressions.size()));
+        result["nodes"] = CopyToUint32Array(env, reinterpret_cast<const uint32_t *>(nodes.data()),
+                                            static_cast<uint32_t>(nodes.size() * 5));
+        return result;
+    }
+
+    TSElmOperators *operators_ = nullptr;
+};
+
+// new DeclarationHashes(source) keeps the source, its tree and the hash of
+// each top-level declaration, so that `edit` reports the declarations it
+// added, removed or changed.
+class DeclarationHashes : public Napi::ObjectWrap<DeclarationHashes> {
+  public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "DeclarationHashes",
+                           {InstanceMethod("declarations", &DeclarationHashes::Declarations),
+                            InstanceMethod("edit", &DeclarationHashes::Edit)});
+    }
+
+    DeclarationHashes(const Napi::CallbackInfo &info) : Napi::ObjectWrap<DeclarationHashes>(info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 1 || !info[0].IsString()) {
+            throw Napi::TypeError::New(env, "Expected a string");
+        }
+        source_ = info[0].As<Napi::String>().Utf8Value();
+        if (source_.size() > UINT32_MAX) {
+            throw Napi::RangeError::New(env, "Source is too large");
+        }
+
+        hashes_ = ts_elm_declaration_hashes_new();
+        tree_ = ts_parser_parse_string(ThreadParser(), nullptr, source_.data(),
+                                       static_cast<uint32_t>(source_.size()));
+        if (hashes_ == nullptr ||
+            !ts_elm_declaration_hashes_reset(hashes_, ts_tree_root_node(tree_), source_.data())) {
+            throw Napi::Error::New(env, "Out of memory");
+        }
+        ReadNames();
+    }
+
+    ~DeclarationHashes() {
+        ts_elm_declaration_hashes_delete(hashes_);
+        if (tree_ != nullptr) {
+            ts_tree_delete(tree_);
+        }
+    }
+
+  private:
+    // declarations() returns every top-level declaration in source order.
+    Napi::Value Declarations(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        uint32_t count;
+        const TSElmDeclarationHash *items = ts_elm_declaration_hashes_items(hashes_, &count);
+        auto result = Napi::Array::New(env, count);
+        for (uint32_t i = 0; i < count; i++) {
+            result[i] = Declaration(env, items[i], names_[i]);
+        }
+        return result;
+    }
+
+    // edit(startByte, oldEndByte, text) replaces a byte range of the UTF-8
+    // source and returns the declarations it added, removed or changed.
+    // Removed declarations keep their positions from before the edit.
+    Napi::Value Edit(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        TSInputEdit edit = EditSource(info, source_, tree_);
+        TSTree *tree = ts_parser_parse_string(ThreadParser(), tree_, source_.data(),
+                                              static_cast<uint32_t>(source_.size()));
+        bool ok = ts_elm_declaration_hashes_update(hashes_, tree_, tree, source_.data(), &edit, 1);
+        ts_tree_delete(tree_);
+        tree_ = tree;
+        std::vector<std::string> previous_names = std::move(names_);
+        ReadNames();
+        if (!ok) {
+            throw Napi::Error::New(env, "Out of memory");
+        }
+
+        uint32_t count, item_count, previous_count;
+        const TSElmDeclarationChange *changes = ts_elm_declaration_hashes_changes(hashes_, &count);
+        const TSElmDeclarationHash *items = ts_elm_declaration_hashes_items(hashes_, &item_count);
+        const TSElmDeclarationHash *previous =
+            ts_elm_declaration_hashes_previous(hashes_, &previous_count);
+        auto result = Napi::Array::New(env, count);
+        for (uint32_t i = 0; i < count; i++) {
+            const TSElmDeclarationChange &change = changes[i];
+            Napi::Object object;
+            if (change.kind == TSElmDeclarationRemoved) {
+                object = Declaration(env, previous[change.previous], previous_names[change.previous]);
+                object["change"] = "removed";
+            } else {
+                object = Declaration(env, items[change.current], names_[change.current]);
+                object["change"] = change.kind == TSElmDeclarationAdded ? "added" : "changed";
+            }
+            result[i] = object;
+        }
+        return result;
+    }
+
+    void ReadNames() {
+        uint32_t count;
+        const TSElmDeclarationHash *items = ts_elm_declaration_hashes_items(hashes_, &count);
+        names_.clear();
+        for (uint32_t i = 0; i < count; i++) {
+            names_.emplace_back(source_, items[i].name_start_byte,
+                                items[i].name_end_byte - items[i].name_start_byte);
+        }
+    }
+
+    // The hash is a hexadecimal string, JavaScript numbers cannot hold it.
+    static Napi::Object Declaration(Napi::Env env, const TSElmDeclarationHash &item,
+                                    const std::string &name) {
+        char hash[17];
+        std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(item.hash));
+        auto object = Napi::Object::New(env);
+        object["symbol"] = Napi::Number::New(env, item.symbol);
+        object["name"] = Napi::String::New(env, name);
+        object["startByte"] = Napi::Number::New(env, item.start_byte);
+        object["endByte"] = Napi::Number::New(env, item.end_byte);
+        object["hash"] = Napi::String::New(env, hash);
+        return object;
+    }
+
+    TSElmDeclarationHashes *hashes_ = nullptr;
+    TSTree *tree_ = nullptr;
+    std::string source_;
+    // The names of the current declarations, copied out of the source so
+    // that removed ones can still be reported after an edit.
+    std::vector<std::string> names_;
+};
+
+// new DocIndex(source) indexes the doc comments of a source by declaration
+// name, so that hover looks a name up instead of searching the tree.
+class DocIndex : public Napi::ObjectWrap<DocIndex> {
+  public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "DocIndex",
+                           {InstanceMethod("find", &DocIndex::Find),
+                            InstanceMethod("moduleDoc", &DocIndex::ModuleDoc),
+                            InstanceMethod("groups", &DocIndex::Groups)});
+    }
+
+    DocIndex(const Napi::CallbackInfo &info) : Napi::ObjectWrap<DocIndex>(info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 1 || !info[0].IsString()) {
+            throw Napi::TypeError::New(env, "Expected a string");
+        }
+        source_ = info[0].As<Napi::String>().Utf8Value();
+        if (source_.size() > UINT32_MAX) {
+            throw Napi::RangeError::New(env, "Source is too large");
+        }
+
+        // The index copies the names, so the tree is not kept
+        index_ = ts_elm_doc_index_new();
+        TSTree *tree = ts_parser_parse_string(ThreadParser(), nullptr, source_.data(),
+                                              static_cast<uint32_t>(source_.size()));
+        bool ok = index_ != nullptr &&
+                  ts_elm_doc_index_build(index_, ts_tree_root_node(tree), source_.data());
+        ts_tree_delete(tree);
+        if (!ok) {
+            throw Napi::Error::New(env, "Out of memory");
+        }
+    }
+
+    ~DocIndex() { ts_elm_doc_index_delete(index_); }
+
+  private:
+    // find(name) returns the declaration named `name` with its doc comment,
+    // or null. `doc` is empty for an undocumented declaration.
+    Napi::Value Find(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 1 || !info[0].IsString()) {
+            throw Napi::TypeError::New(env, "Expected a string");
+        }
+        std::string name = info[0].As<Napi::String>().Utf8Value();
+        const TSElmDocEntry *entry =
+            ts_elm_doc_index_find(index_, name.data(), static_cast<uint32_t>(name.size()));
+        if (entry == nullptr) {
+            return env.Null();
+        }
+        auto object = Napi::Object::New(env);
+        object["symbol"] = Napi::Number::New(env, entry->symbol);
+        object["name"] = Napi::String::New(env, name);
+        object["startByte"] = Napi::Number::New(env, entry->start_byte);
+        object["endByte"] = Napi::Number::New(env, entry->end_byte);
+        object["docStartByte"] = Napi::Number::New(env, entry->doc_start_byte);
+        object["docEndByte"] = Napi::Number::New(env, entry->doc_end_byte);
+        object["doc"] = Slice(env, entry->doc_start_byte, entry->doc_end_byte);
+        return object;
+    }
+
+    // moduleDoc() returns the module doc comment, or null.
+    Napi::Value ModuleDoc(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        uint32_t start, end;
+        if (!ts_elm_doc_index_module_doc(index_, &start, &end)) {
+            return env.Null();
+        }
+        auto object = Napi::Object::New(env);
+        object["startByte"] = Napi::Number::New(env, start);
+        object["endByte"] = Napi::Number::New(env, end);
+        object["doc"] = Slice(env, start, end);
+        return object;
+    }
+
+    // groups() returns the `@docs` lines of the module doc comment with
+    // the heading above each and the names it lists.
+    Napi::Value Groups(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        uint32_t count, name_count;
+        const TSElmDocGroup *groups = ts_elm_doc_index_groups(index_, &count);
+        const TSElmDocName *names = ts_elm_doc_index_names(index_, &name_count);
+        auto result = Napi::Array::New(env, count);
+        for (uint32_t i = 0; i < count; i++) {
+            const TSElmDocGroup &group = groups[i];
+            auto object = Napi::Object::New(env);
+            object["startByte"] = Napi::Number::New(env, group.start_byte);
+            object["endByte"] = Napi::Number::New(env, group.end_byte);
+            object["heading"] = Slice(env, group.heading_start_byte, group.heading_end_byte);
+            auto list = Napi::Array::New(env, group.name_count);
+            for (uint32_t j = 0; j < group.name_count; j++) {
+                const TSElmDocName &name = names[group.first_name + j];
+                list[j] = Slice(env, name.start_byte, name.end_byte);
+            }
+            object["names"] = list;
+            result[i] = object;
+        }
+        return result;
+    }
+
+    Napi::String Slice(Napi::Env env, uint32_t start, uint32_t end) const {
+        return Napi::String::New(env, source_.data() + start, end - start);
+    }
+
+    TSElmDocIndex *index_ = nullptr;
+    std::string source_;
+};
+
+// new LineIndex(source) keeps a copy of the UTF-8 source and the start of
+// each line, to convert between LSP positions and the byte offsets the
+// native classes use, and to turn LSP content changes into tree edits.
+class LineIndex : public Napi::ObjectWrap<LineIndex> {
+  public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "LineIndex",
+                           {InstanceMethod("lineCount", &LineIndex::LineCount),
+                            InstanceMethod("position", &LineIndex::Position),
+                            InstanceMethod("byteOffset", &LineIndex::ByteOffset),
+                            InstanceMethod("applyChange", &LineIndex::ApplyChange)});
+    }
+
+    LineIndex(const Napi::CallbackInfo &info) : Napi::ObjectWrap<LineIndex>(info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 1 || !info[0].IsString()) {
+            throw Napi::TypeError::New(env, "Expected a string");
+        }
+        source_ = info[0].As<Napi::String>().Utf8Value();
+        if (source_.size() > UINT32_MAX) {
+            throw Napi::RangeError::New(env, "Source is too large");
+        }
+        index_ = ts_elm_line_index_new();
+        if (index_ == nullptr ||
+            !ts_elm_line_index_reset(index_, source_.data(), static_cast<uint32_t>(source_.size()))) {
+            throw Napi::Error::New(env, "Out of memory");
+        }
+    }
+
+    ~LineIndex() { ts_elm_line_index_delete(index_); }
+
+  private:
+    Napi::Value LineCount(const Napi::CallbackInfo &info) {
+        return Napi::Number::New(info.Env(), ts_elm_line_index_line_count(index_));
+    }
+
+    // position(byte) returns the LSP position of a UTF-8 byte offset.
+    Napi::Value Position(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 1 || !info[0].IsNumber()) {
+            throw Napi::TypeError::New(env, "Expected a byte offset");
+        }
+        TSElmPosition position = ts_elm_line_index_position(
+            index_, source_.data(), info[0].As<Napi::Number>().Uint32Value());
+        return NewPosition(env, position);
+    }
+
+    // byteOffset({ line, character }) returns the UTF-8 byte offset of an
+    // LSP position, clamped to its line.
+    Napi::Value ByteOffset(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 1) {
+            throw Napi::TypeError::New(env, "Expected a position");
+        }
+        return Napi::Number::New(env, ts_elm_line_index_byte(index_, source_.data(),
+                                                             ReadPosition(env, info[0])));
+    }
+
+    // applyChange({ range?, text }) applies an LSP
+    // TextDocumentContentChangeEvent, a change without a range replacing the
+    // whole text, and returns the edit in bytes and tree-sitter points.
+    Napi::Value ApplyChange(const Napi::CallbackInfo &info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 1 || !info[0].IsObject() ||
+            !info[0].As<Napi::Object>().Get("text").IsString()) {
+            throw Napi::TypeError::New(env, "Expected a content change");
+        }
+        Napi::Object change = info[0].As<Napi::Object>();
+        std::string text = change.Get("text").As<Napi::String>().Utf8Value();
+        TSElmPosition start = {0, 0};
+        TSElmPosition end = {UINT32_MAX, 0};
+        Napi::Value range = change.Get("range");
+        if (range.IsObject()) {
+            start = ReadPosition(env, range.As<Napi::Object>().Get("start"));
+            end = ReadPosition(env, range.As<Napi::Object>().Get("end"));
+        }
+        TSInputEdit edit = ts_elm_line_index_change(index_, source_.data(), start, end, text.data(),
+                                                    static_cast<uint32_t>(text.size()));
+        if (source_.size() - (edit.old_end_byte - edit.start_byte) + text.size() > UINT32_MAX) {
+            throw Napi::RangeError::New(env, "Source is too large");
+        }
+
+        source_.replace(edit.start_byte, edit.old_end_byte - edit.start_byte, text);
+        if (!ts_elm_line_index_edit(index_, source_.data(), static_cast<uint32_t>(source_.size()),
+                                    &edit)) {
+            throw Napi::Error::New(env, "Out of memory");
+        }
+
+        auto result = Napi::Object::New(env);
+        result["startByte"] = Napi::Number::New(env, edit.start_byte);
+        result["oldEndByte"] = Napi::Number::New(env, edit.old_end_byte);
+        result["newEndByte"] = Napi::Number::New(env, edit.new_end_byte);
+        result["startPoint"] = NewPoint(env, edit.start_point);
+        result["oldEndPoint"] = NewPoint(env, edit.old_end_point);
+        result["newEndPoint"] = NewPoint(env, edit.new_end_point);
+        return result;
+    }
+
+    static TSElmPosition ReadPosition(Napi::Env env, const Napi::Value &value) {
+        if (!value.IsObject()) {
+            throw Napi::TypeError::New(env, "Expected a position");
+        }
+        Napi::Object object = value.As<Napi::Object>();
+        Napi::Value line = object.Get("line");
+        Napi::Value character = object.Get("character");
+        if (!line.IsNumber() || !character.IsNumber()) {
+            throw Napi::TypeError::New(env, "Expected a position");
+        }
+        return TSElmPosition{line.As<Napi::Number>().Uint32Value(),
+                             character.As<Napi::Number>().Uint32Value()};
+    }
+
+    static Napi::Object NewPosition(Napi::Env env, TSElmPosition position) {
+        auto object = Napi::Object::New(env);
+        object["line"] = Napi::Number::New(env, position.line);
+        object["character"] = Napi::Number::New(env, position.character);
+        return object;
+    }
+
+    static Napi::Object NewPoint(Napi::Env env, TSPoint point) {
+        auto object = Napi::Object::New(env);
+        object["row"] = Napi::Number::New(env, point.row);
+        object["column"] = Napi::Number::New(env, point.column);
+        return object;
+    }
+
+    TSElmLineIndex *index_ = nullptr;
+    std::string source_;
+};
+
+Napi::Array SymbolNames(Napi::Env env) {
+    const TSLanguage *language = tree_sitter_elm();
+    uint32_t count = ts_language_symbol_count(language);
+    auto names = Napi::Array::New(env, count);
+    for (uint32_t i = 0; i < count; i++) {
+        names[i] = Napi::String::New(env, ts_language_symbol_name(language, static_cast<TSSymbol>(i)));
+    }
+    return names;
+}
+
+Napi::Array FieldNames(Napi::Env env) {
+    const TSLanguage *language = tree_sitter_elm();
+    uint32_t count = ts_language_field_count(language);
+    auto names = Napi::Array::New(env, count + 1);
+    names[0u] = env.Null();
+    for (uint32_t i = 1; i <= count; i++) {
+        names[i] = Napi::String::New(env, ts_language_field_name_for_id(language, static_cast<TSFieldId>(i)));
+    }
+    return names;
+}
+
+Napi::Object DeclarationKinds(Napi::Env env) {
+    auto kinds = Napi::Object::New(env);
+    for (const char *name : {"value_declaration", "type_declaration", "type_alias_declaration",
+                             "port_annotation", "infix_declaration"}) {
+        TSSymbol symbol = ts_language_symbol_for_name(
+            tree_sitter_elm(), name, static_cast<uint32_t>(std::strlen(name)), true);
+        kinds[name] = Napi::Number::New(env, symbol);
+    }
+    return kinds;
+}
+
+// The names of TSElmOutlineKind, indexed by the kind of an outline symbol.
+Napi::Array OutlineKinds(Napi::Env env) {
+    auto kinds = Napi::Array::New(env);
+    uint32_t i = 0;
+    for (const char *name :
+         {"function", "type", "variant", "typeAlias", "field", "port", "letFunction"}) {
+        kinds[i++] = Napi::String::New(env, name);
+    }
+    return kinds;
+}
+
+} // namespace
+
+#endif
+
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
     auto language = Napi::External<TSLanguage>::New(env, tree_sitter_elm());
     language.TypeTag(&LANGUAGE_TYPE_TAG);
     exports["language"] = language;
+#ifdef TREE_SITTER_ELM_LIB
+    exports["summarizeFiles"] = Napi::Function::New(env, SummarizeFiles, "summarizeFiles");
+    exports["declarationKinds"] = DeclarationKinds(env);
+    exports["parseFlat"] = Napi::Function::New(env, ParseFlat, "parseFlat");
+    exports["outline"] = Napi::Function::New(env, Outline, "outline");
+    exports["outlineKinds"] = OutlineKinds(env);
+    exports["parseWithBudget"] = Napi::Function::New(env, ParseWithBudget, "parseWithBudget");
+    exports["symbolNames"] = SymbolNames(env);
+    exports["fieldNames"] = FieldNames(env);
+    exports["SemanticTokensEncoder"] = SemanticTokensEncoder::Define(env);
+    exports["SemanticTokensDocument"] = SemanticTokensDocument::Define(env);
+    exports["Highlighter"] = Highlighter::Define(env);
+    exports["ShaderInjections"] = ShaderInjections::Define(env);
+    exports["BinaryOperators"] = BinaryOperators::Define(env);
+    exports["DeclarationHashes"] = DeclarationHashes::Define(env);
+    exports["DocIndex"] = DocIndex::Define(env);
+    exports["LineIndex"] = LineIndex::Define(env);
+#endif
     return exports;
 }
 
@@ -1,9 +1,367 @@
 const assert = require("node:assert");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
 const { test } = require("node:test");
 
 const Parser = require("tree-sitter");
 
+const language = require(".");
+
 test("can load grammar", () => {
   const parser = new Parser();
   assert.doesNotThrow(() => parser.setLanguage(require(".")));
 });
+
+test("parseFilesAsync", async () => {
+  const directory = fs.mkdtempSync(path.join(os.tmpdir(), "tree-sitter-elm-"));
+  const good = path.join(directory, "Main.elm");
+  const broken = path.join(directory, "Broken.elm");
+  fs.writeFileSync(good, 'module Main exposing (main)\n\nimport Html\n\nmain =\n    Html.text "hi"\n');
+  fs.writeFileSync(broken, "main = (\n");
+
+  const paths = [good, broken, good, path.join(directory, "Missing.elm")];
+  const { files, declarations, imports, names } = await language.parseFilesAsync(paths, 1);
+  fs.rmSync(directory, { recursive: true });
+
+  const name = (offset, start, end) =>
+    Buffer.from(names.buffer, names.byteOffset + offset, end - start).toString();
+
+  assert.strictEqual(files.length, paths.length * 6);
+  for (const i of [0, 2]) {
+    const [declaration, declarationCount, anImport, importCount, hasError, error] =
+      files.subarray(i * 6, i * 6 + 6);
+    assert.deepStrictEqual([declarationCount, importCount, hasError, error], [1, 1, 0, 0]);
+    const record = declarations.subarray(declaration * 7, declaration * 7 + 7);
+    assert.strictEqual(record[0], language.declarationKinds.value_declaration);
+    assert.strictEqual(name(record[6], record[3], record[4]), "main");
+    assert.strictEqual(record[5], 4);
+    const importRecord = imports.subarray(anImport * 5, anImport * 5 + 5);
+    assert.strictEqual(name(importRecord[4], importRecord[2], importRecord[3]), "Html");
+  }
+  assert.strictEqual(files[1 * 6 + 4], 1);
+  assert.notStrictEqual(files[3 * 6 + 5], 0);
+});
+
+test("parseFlat", () => {
+  const { size, symbol, fieldId, endByte, parent, firstChild, nextSibling, none } =
+    language.flatNodeLayout;
+  const source = 'main =\n    f 1 "a"\n';
+  const nodes = language.parseFlat(source);
+  const names = language.symbolNames;
+
+  assert.strictEqual(names[nodes[symbol]], "file");
+  assert.strictEqual(nodes[parent], none);
+  assert.strictEqual(nodes[endByte], source.length);
+  assert.strictEqual(nodes[firstChild], 1);
+  assert.strictEqual(names[nodes[size + symbol]], "value_declaration");
+  assert.strictEqual(language.fieldNames[nodes[2 * size + fieldId]], "functionDeclarationLeft");
+
+  let count = 0;
+  const stack = [0];
+  while (stack.length > 0) {
+    for (let node = stack.pop(); node !== none; node = nodes[node * size + nextSibling]) {
+      count++;
+      if (nodes[node * size + firstChild] !== none) {
+        stack.push(nodes[node * size + firstChild]);
+      }
+      if (node === 0) {
+        break;
+      }
+    }
+  }
+  assert.strictEqual(count, nodes.length / size);
+  assert.ok(language.parseFlat(Buffer.from(source), true).length < nodes.length);
+});
+
+test("outline", () => {
+  const { size, kind, parent, nameStartByte, nameEndByte, none } = language.outlineLayout;
+  const source =
+    "type Msg\n    = Increment\n    | Set Int\n\n\ntype alias Model =\n    { count : Int }\n\n\n" +
+    "update msg model =\n    let\n        step n =\n            n + 1\n    in\n    step model\n";
+  const symbols = language.outline(source);
+  const outline = [];
+  for (let i = 0; i < symbols.length; i += size) {
+    outline.push([
+      language.outlineKinds[symbols[i + kind]],
+      source.slice(symbols[i + nameStartByte], symbols[i + nameEndByte]),
+      symbols[i + parent] === none ? null : symbols[i + parent],
+    ]);
+  }
+  assert.deepStrictEqual(outline, [
+    ["type", "Msg", null],
+    ["variant", "Increment", 0],
+    ["variant", "Set", 0],
+    ["typeAlias", "Model", null],
+    ["field", "count", 3],
+    ["function", "update", null],
+    ["letFunction", "step", 5],
+  ]);
+});
+
+test("parseWithBudget", async () => {
+  const source = 'main =\n    f 1 "a"\n';
+  const completed = await language.parseWithBudget(source, { timeoutMs: 10000, timeScanner: true });
+  assert.strictEqual(completed.status, "completed");
+  assert.strictEqual(completed.bytesConsumed, source.length);
+  assert.ok(completed.scannerCalls > 0 && completed.scannerMs <= completed.totalMs);
+  assert.deepStrictEqual(completed.nodes, language.parseFlat(source));
+
+  // Unclosed brackets keep error recovery busy for far longer than the budget
+  const stress = "main =\n" + '    ( [ { x | y = f (g [ 1, "a", \'b\' ] \n'.repeat(40000);
+  const timedOut = await language.parseWithBudget(stress, { timeoutMs: 2 });
+  assert.strictEqual(timedOut.status, "timedOut");
+  assert.strictEqual(timedOut.nodes, undefined);
+  assert.ok(timedOut.bytesConsumed < stress.length);
+  assert.ok(timedOut.totalMs < 200);
+
+  const controller = new AbortController();
+  const cancelled = language.parseWithBudget(stress, { signal: controller.signal });
+  controller.abort();
+  assert.strictEqual((await cancelled).status, "cancelled");
+  const aborted = await language.parseWithBudget(source, { signal: AbortSignal.abort() });
+  assert.strictEqual(aborted.status, "cancelled");
+});
+
+test("SemanticTokensEncoder", () => {
+  const query = fs.readFileSync(path.join(__dirname, "..", "..", "queries", "highlights.scm"), "utf8");
+  const encoder = new language.SemanticTokensEncoder(query, {
+    keyword: 0,
+    function: 1,
+    "local.function": [2, 1],
+    string: 3,
+  });
+  const source = 'main =\n    f "\u{1F600}"\n';
+  assert.deepStrictEqual(
+    Array.from(encoder.encode(source)),
+    [0, 0, 4, 1, 0, 0, 5, 1, 0, 0, 1, 4, 1, 1, 0, 0, 2, 1, 3, 0, 0, 1, 2, 3, 0, 0, 2, 1, 3, 0],
+  );
+  const start = Buffer.byteLength('main =\n    f "');
+  assert.deepStrictEqual(Array.from(encoder.encode(Buffer.from(source), start)), [
+    1, 7, 2, 3, 0, 0, 2, 1, 3, 0,
+  ]);
+  assert.throws(() => new language.SemanticTokensEncoder("(nope) @x", {}));
+});
+
+test("SemanticTokensDocument", () => {
+  const query = fs.readFileSync(path.join(__dirname, "..", "..", "queries", "highlights.scm"), "utf8");
+  const encoder = new language.SemanticTokensEncoder(query, { keyword: 0, function: 1, string: 2 });
+  let source = 'a =\n    "a"\n\nb =\n    "b"\n\nc =\n    "c"\n';
+  const document = new language.SemanticTokensDocument(encoder, source);
+  assert.deepStrictEqual(document.data(), encoder.encode(source));
+
+  for (const [pattern, text] of [
+    ['"b"', 'f "\u{e9}"'],
+    ["b =", "bb x ="],
+    ['    "c"\n', ""],
+  ]) {
+    const previous = Array.from(document.data());
+    const start = Buffer.byteLength(source.slice(0, source.indexOf(pattern)));
+    const edits = document.edit(start, start + Buffer.byteLength(pattern), text);
+    source = source.replace(pattern, text);
+
+    const applied = previous.slice();
+    for (const { start, deleteCount, data } of [...edits].reverse()) {
+      applied.splice(start, deleteCount, ...data);
+    }
+    assert.deepStrictEqual(applied, Array.from(encoder.encode(source)));
+    assert.deepStrictEqual(document.data(), encoder.encode(source));
+    assert.deepStrictEqual(encoder.encode(document), encoder.encode(source));
+  }
+  const start = Buffer.byteLength(source.slice(0, source.indexOf("c =")));
+  assert.deepStrictEqual(encoder.encode(document, start), encoder.encode(source, start));
+});
+
+test("Highlighter", () => {
+  const queries = path.join(__dirname, "..", "..", "queries");
+  const highlighter = new language.Highlighter(
+    fs.readFileSync(path.join(queries, "highlights.scm"), "utf8"),
+    fs.readFileSync(path.join(queries, "injections.scm"), "utf8"),
+  );
+  assert.deepStrictEqual(highlighter.injectionLanguages, ["glsl"]);
+
+  const lines = ["module Main exposing (..)", ""];
+  for (let i = 0; i < 400; i++) {
+    lines.push(`f${i} =`, `    "${i}"`, "");
+  }
+  lines.push("shader =", "    [glsl|", "void main () {}", "|]", "");
+  const source = lines.join("\n");
+  highlighter.setSource(source);
+
+  // Scrolling returns the same captures as highlighting everything at once
+  const all = highlighter.highlightRows(0, Infinity).highlights;
+  const rows = (result) => {
+    const records = [];
+    for (let i = 0; i < result.length; i += 7) {
+      records.push(Array.from(result.subarray(i, i + 7)));
+    }
+    return records;
+  };
+  for (const [start, end] of [[0, 60], [250, 310], [1000, 1060], [250, 310]]) {
+    const expected = rows(all).filter(
+      ([, , startRow, , endRow, endColumn]) =>
+        startRow < end && (endRow > start || (endRow === start && endColumn > 0)),
+    );
+    assert.deepStrictEqual(rows(highlighter.highlightRows(start, end).highlights), expected);
+  }
+
+  const string = Buffer.byteLength(source.slice(0, source.indexOf('"7"'))) + 1;
+  const highlights = rows(highlighter.highlightBytes(string, string + 1).highlights);
+  assert.strictEqual(highlights.length, 1);
+  assert.deepStrictEqual(highlights[0].slice(0, 2), [string, string + 1]);
+  assert.strictEqual(highlighter.captureNames[highlights[0][6]], "string.elm");
+
+  const injections = highlighter.highlightRows(lines.length - 6, lines.length).injections;
+  assert.strictEqual(injections.length, 7);
+  assert.strictEqual(source.slice(injections[0], injections[1]), "\nvoid main () {}\n");
+
+  // Edits keep the blocks away from them, which still match a fresh parse
+  const fresh = new language.Highlighter(
+    fs.readFileSync(path.join(queries, "highlights.scm"), "utf8"),
+  );
+  let edited = source;
+  for (const [pattern, text] of [['"7"', '"seven"'], ["f300 =", "f300 x =\n    x\n\nf300b ="]]) {
+    highlighter.highlightRows(0, Infinity);
+    const start = Buffer.byteLength(edited.slice(0, edited.indexOf(pattern)));
+    highlighter.edit(start, start + Buffer.byteLength(pattern), text);
+    edited = edited.replace(pattern, text);
+    fresh.setSource(edited);
+    assert.deepStrictEqual(
+      highlighter.highlightRows(0, Infinity).highlights,
+      fresh.highlightRows(0, Infinity).highlights,
+    );
+  }
+  assert.throws(() => new language.Highlighter("(nope) @x"));
+});
+
+test("ShaderInjections", () => {
+  // Any grammar will do, this one parses the shaders as Elm
+  const shaders = new language.ShaderInjections(language);
+  const shader = (name, body) => `${name} =\n    [glsl|\n${body}\n|]\n\n`;
+  let source = "module Main exposing (..)\n\n" + shader("a", "void main () {}") + shader("b", "float x;");
+  assert.strictEqual(shaders.setSource(source), 2);
+  const ranges = shaders.ranges();
+  assert.strictEqual(source.slice(ranges[0], ranges[1]), "\nvoid main () {}\n");
+  assert.strictEqual(ranges[2], 3);
+
+  assert.strictEqual(shaders.parseRows(0, 5), 1);
+  assert.strictEqual(shaders.parseRows(0, Infinity), 1);
+  assert.strictEqual(shaders.parseRows(0, Infinity), 0);
+  const tree = shaders.flatTree(0);
+  assert.strictEqual(shaders.symbolNames[tree[language.flatNodeLayout.symbol]], "file");
+  assert.strictEqual(shaders.flatTree(2), null);
+
+  source = source.replace("float x;", "float y;");
+  assert.strictEqual(shaders.setSource(source), 2);
+  assert.strictEqual(shaders.parseRows(0, Infinity), 1);
+
+  const start = Buffer.byteLength(source.slice(0, source.indexOf("b =")));
+  assert.strictEqual(shaders.edit(start, start + 1, "c"), 2);
+  assert.strictEqual(shaders.parseRows(0, Infinity), 0);
+  assert.strictEqual(shaders.edit(start, start + 1, "c =\n    [glsl|\nint z;\n|]\n\nb"), 3);
+  assert.strictEqual(shaders.parseRows(0, Infinity), 1);
+  assert.throws(() => new language.ShaderInjections({}));
+});
+
+test("BinaryOperators", () => {
+  const operators = new language.BinaryOperators();
+  // Print each expression's tree with every operator application in parentheses
+  const render = (source, { expressions, nodes }) => {
+    const trees = [];
+    for (let i = 0; i < expressions.length; i += 4) {
+      const [, , first, count] = expressions.subarray(i, i + 4);
+      const print = (index) => {
+        const [start, end, , left, right] = nodes.subarray((first + index) * 5, (first + index + 1) * 5);
+        if (left === 0xffffffff) return source.slice(start, end);
+        const [leftEnd] = nodes.subarray((first + left) * 5 + 1);
+        const [rightStart] = nodes.subarray((first + right) * 5);
+        return `(${print(left)} ${source.slice(leftEnd, rightStart).trim()} ${print(right)})`;
+      };
+      trees.push(count === 0 ? null : print(count - 1));
+    }
+    return trees;
+  };
+
+  const source = "module Main exposing (..)\n\nx = a + b * c - d\n\ny = f <| (p == q |> g)\n\nz = a == b == c\n";
+  assert.deepStrictEqual(render(source, operators.associate(source)), [
+    "((a + (b * c)) - d)",
+    "(f <| (p == q |> g))",
+    "((p == q) |> g)",
+    null,
+  ]);
+
+  operators.set("-", "right", 6);
+  operators.set("+", "right", 6);
+  assert.deepStrictEqual(render(source, operators.associate(source))[0], "(a + ((b * c) - d))");
+  const basics = "module Basics exposing (..)\n\ninfix left 6 (+) = add\ninfix left 6 (-) = sub\n";
+  assert.strictEqual(operators.readDeclarations(basics), 2);
+  assert.deepStrictEqual(render(source, operators.associate(source))[0], "((a + (b * c)) - d)");
+  assert.throws(() => operators.set("<==>", "left", 1));
+  assert.throws(() => operators.set("+", "up", 1));
+});
+
+test("DeclarationHashes", () => {
+  let source = "module Main exposing (..)\n\ninit : Int\ninit =\n    0\n\nupdate n =\n    n + 1\n\nview n =\n    n\n";
+  const document = new language.DeclarationHashes(source);
+  const declarations = document.declarations();
+  assert.deepStrictEqual(declarations.map(({ name }) => name), ["init", "update", "view"]);
+  assert.strictEqual(source.slice(declarations[0].startByte, declarations[0].endByte), "init : Int\ninit =\n    0");
+
+  const edit = (pattern, text) => {
+    const start = Buffer.byteLength(source.slice(0, source.indexOf(pattern)));
+    const changes = document.edit(start, start + Buffer.byteLength(pattern), text);
+    source = source.replace(pattern, text);
+    return changes.map(({ change, name }) => `${change} ${name}`);
+  };
+  assert.deepStrictEqual(edit("n + 1", "n  +  1 -- next"), []);
+  assert.deepStrictEqual(edit("n  +  1", "n - 1"), ["changed update"]);
+  assert.deepStrictEqual(edit("view n", "main =\n    0\n\nshow n"), ["removed view", "added main", "added show"]);
+  assert.strictEqual(document.declarations()[0].hash, declarations[0].hash);
+  assert.notStrictEqual(document.declarations()[1].hash, declarations[1].hash);
+});
+
+test("DocIndex", () => {
+  const source =
+    "module Main exposing (init, view)\n\n{-| Main.\n\n# Program\n@docs init, view\n-}\n\n\n" +
+    "{-| Starts at zero. -}\ninit : Int\ninit =\n    0\n\n\nview n =\n    n\n";
+  const index = new language.DocIndex(source);
+  const init = index.find("init");
+  assert.strictEqual(init.doc, "{-| Starts at zero. -}");
+  assert.strictEqual(source.slice(init.startByte, init.endByte), "init : Int\ninit =\n    0");
+  assert.strictEqual(index.find("view").doc, "");
+  assert.strictEqual(index.find("main"), null);
+  assert.ok(index.moduleDoc().doc.startsWith("{-| Main."));
+  assert.deepStrictEqual(
+    index.groups().map(({ heading, names }) => ({ heading, names })),
+    [{ heading: "Program", names: ["init", "view"] }],
+  );
+});
+
+test("LineIndex", () => {
+  let source = "module Main exposing (..)\r\n\nname =\n    \"Élm 𝔼\"\n";
+  const index = new language.LineIndex(source);
+  assert.strictEqual(index.lineCount(), 5);
+  const byte = Buffer.byteLength(source.slice(0, source.indexOf("𝔼")));
+  assert.deepStrictEqual(index.position(byte), { line: 3, character: 9 });
+  assert.strictEqual(index.byteOffset({ line: 3, character: 9 }), byte);
+  assert.strictEqual(index.byteOffset({ line: 0, character: 100 }), 25);
+
+  const edit = index.applyChange({
+    range: { start: { line: 3, character: 5 }, end: { line: 3, character: 6 } },
+    text: "E\nl",
+  });
+  assert.deepStrictEqual(edit, {
+    startByte: byte - 5,
+    oldEndByte: byte - 3,
+    newEndByte: byte - 2,
+    startPoint: { row: 3, column: 5 },
+    oldEndPoint: { row: 3, column: 7 },
+    newEndPoint: { row: 4, column: 1 },
+  });
+  source = source.replace("É", "E\nl");
+  assert.strictEqual(index.lineCount(), 6);
+  assert.deepStrictEqual(index.position(Buffer.byteLength(source)), { line: 5, character: 0 });
+
+  index.applyChange({ text: "x = 1\n" });
+  assert.strictEqual(index.lineCount(), 2);
+});
@@ -18,9 +18,354 @@ type NodeInfo =
       children: ChildNode[];
     });
 
+/**
+ * Fixed-width records describing a batch of parsed files. Byte offsets are
+ * into the UTF-8 contents of each file.
+ */
+type FileSummaries = {
+  /** Per file: declaration index, declaration count, import index, import count, has error, errno. */
+  files: Uint32Array;
+  /** Per declaration: kind, start byte, end byte, name start byte, name end byte, start row, name offset. */
+  declarations: Uint32Array;
+  /** Per import: start byte, end byte, name start byte, name end byte, name offset. */
+  imports: Uint32Array;
+  /** UTF-8 names referenced by the name offsets, each `name end - name start` bytes long. */
+  names: Uint8Array;
+};
+
+type ParseBudget = {
+  /** Stop parsing after this many milliseconds. */
+  timeoutMs?: number;
+  /** Stop parsing when the signal aborts. */
+  signal?: AbortSignal;
+  /** Measure the time spent in the external scanner. */
+  timeScanner?: boolean;
+  /** Leave anonymous nodes out of `nodes`, as `parseFlat` does. */
+  namedOnly?: boolean;
+};
+
+type BudgetedParse = {
+  status: "completed" | "timedOut" | "cancelled";
+  /** How far into the UTF-8 source the parser got. */
+  bytesConsumed: number;
+  totalMs: number;
+  /** Time in the external scanner when `timeScanner` was set, the rest of `totalMs` went to the lexer and the parse table. */
+  scannerMs: number;
+  scannerCalls: number;
+  /** The tree in the layout of `parseFlat`, when the parse completed. */
+  nodes?: Uint32Array;
+};
+
+/** Offsets into the six uint32 values of each symbol returned by `outline`. */
+type OutlineLayout = {
+  readonly size: 6;
+  /** Index into `outlineKinds`. */
+  readonly kind: 0;
+  /** Index of the enclosing symbol. */
+  readonly parent: 1;
+  readonly startByte: 2;
+  readonly endByte: 3;
+  readonly nameStartByte: 4;
+  readonly nameEndByte: 5;
+  /** Value of the parent of a top-level symbol. */
+  readonly none: 0xffffffff;
+};
+
+type OutlineKind = "function" | "type" | "variant" | "typeAlias" | "field" | "port" | "letFunction";
+
+type DeclarationKinds = {
+  value_declaration: number;
+  type_declaration: number;
+  type_alias_declaration: number;
+  port_annotation: number;
+  infix_declaration: number;
+};
+
+/** Offsets into the seven uint32 values of each node returned by `parseFlat`. */
+type FlatNodeLayout = {
+  readonly size: 7;
+  readonly symbol: 0;
+  readonly fieldId: 1;
+  readonly startByte: 2;
+  readonly endByte: 3;
+  readonly parent: 4;
+  readonly firstChild: 5;
+  readonly nextSibling: 6;
+  /** Value of a missing parent, first child or next sibling. */
+  readonly none: 0xffffffff;
+};
+
+/**
+ * Encodes highlight captures as LSP semantic tokens. Legend keys are capture
+ * prefixes, `keyword` matches `@keyword.control.elm` and the longest prefix
+ * wins. Values are a token type index or a `[type, modifiers]` pair.
+ */
+declare class SemanticTokensEncoder {
+  constructor(highlightsQuery: string, legend: { [capture: string]: number | [number, number] });
+  /**
+   * Return the `data` array of an LSP `SemanticTokens` result for the tokens
+   * in `[startByte, endByte)` of the UTF-8 source, as `semanticTokens/range`
+   * asks for. A `SemanticTokensDocument` is encoded from the tree it keeps
+   * up to date, a source is parsed from scratch for this call only.
+   */
+  encode(
+    document: SemanticTokensDocument | string | Uint8Array,
+    startByte?: number,
+    endByte?: number,
+  ): Uint32Array;
+}
+
+/** One LSP `SemanticTokensEdit`, relative to the previous `data`. */
+type SemanticTokensEdit = {
+  start: number;
+  deleteCount: number;
+  data: Uint32Array;
+};
+
+/**
+ * A document whose tokens are kept between edits, so that an edit only
+ * highlights the top-level declarations it touches again.
+ */
+declare class SemanticTokensDocument {
+  constructor(encoder: SemanticTokensEncoder, source: string);
+  /** The `data` of a full LSP `SemanticTokens` result. */
+  data(): Uint32Array;
+  /**
+   * Replace `[startByte, oldEndByte)` of the UTF-8 source with `text` and
+   * return the `edits` of an LSP `SemanticTokensDelta`.
+   */
+  edit(startByte: number, oldEndByte: number, text: string): SemanticTokensEdit[];
+}
+
+/**
+ * Records of seven integers: start byte, end byte, start row, start column,
+ * end row, end column and an index into `captureNames` for highlights or
+ * `injectionLanguages` for injections. Columns count bytes.
+ */
+type ViewportHighlights = {
+  highlights: Uint32Array;
+  injections: Uint32Array;
+};
+
+/**
+ * Runs the highlights and injections queries over the rows an editor shows.
+ * Results are cached per block of rows until the next `setSource`, an `edit`
+ * only drops the blocks around it.
+ */
+declare class Highlighter {
+  constructor(highlightsQuery: string, injectionsQuery?: string);
+  readonly captureNames: string[];
+  readonly injectionLanguages: string[];
+  /** Parse `source` from scratch and drop the cached blocks. */
+  setSource(source: string | Uint8Array): void;
+  /**
+   * Replace `[startByte, oldEndByte)` of the UTF-8 source with `text` and
+   * reparse it incrementally. Blocks away from the edit stay cached, except
+   * the ones after an edit that adds or removes lines.
+   */
+  edit(startByte: number, oldEndByte: number, text: string): void;
+  /** Captures that overlap `[startRow, endRow)`, in document order. */
+  highlightRows(startRow: number, endRow: number): ViewportHighlights;
+  /** Captures that overlap `[startByte, endByte)` of the UTF-8 source. */
+  highlightBytes(startByte: number, endByte: number): ViewportHighlights;
+}
+
+/**
+ * Parses the `[glsl| ... |]` blocks of a file with another grammar, only
+ * when asked to. Trees are cached by shader content across `setSource`.
+ */
+declare class ShaderInjections {
+  /** `grammar` is a node tree-sitter grammar module, such as GLSL. */
+  constructor(grammar: { language: unknown });
+  /** Node type names of the shader grammar, indexed by flat node `symbol`. */
+  readonly symbolNames: string[];
+  /** Parse `source` from scratch, find its shader blocks and return their number. */
+  setSource(source: string | Uint8Array): number;
+  /**
+   * Replace `[startByte, oldEndByte)` of the UTF-8 source with `text`,
+   * reparse it incrementally and return the number of shader blocks.
+   */
+  edit(startByte: number, oldEndByte: number, text: string): number;
+  /**
+   * Six integers per shader: start byte, end byte, start row, start column,
+   * end row and end column of its content.
+   */
+  ranges(): Uint32Array;
+  /** Parse the uncached shaders in `[startRow, endRow)`, return how many. */
+  parseRows(startRow: number, endRow: number): number;
+  /**
+   * The tree of a shader in the layout of `parseFlat`, with bytes relative
+   * to the start of the shader, or null if it could not be parsed.
+   */
+  flatTree(index: number, namedOnly?: boolean): Uint32Array | null;
+}
+
+declare class BinaryOperators {
+  /** A table with the operators of elm/core, elm/parser and elm/url. */
+  constructor();
+  /** Add an operator or change an existing one. */
+  set(name: string, associativity: "left" | "right" | "non", precedence: number): void;
+  /** Add the operators of the file's `infix_declaration`s, return how many. */
+  readDeclarations(source: string | Uint8Array): number;
+  /**
+   * Structure every `bin_op_expr` of `source` by operator precedence.
+   * `expressions` has four integers per expression: start byte, end byte,
+   * index of its first node and node count, 0 if Elm rejects the operator
+   * mix. `nodes` has five integers per node: start byte, end byte, child
+   * index of the operand or operator in the `bin_op_expr`, and the left and
+   * right nodes relative to the expression's first node, 0xffffffff for
+   * operands. The expression's root is its last node.
+   */
+  associate(source: string | Uint8Array): { expressions: Uint32Array; nodes: Uint32Array };
+}
+
+/**
+ * A top-level declaration. `symbol` is one of `declarationKinds`, `hash` is
+ * a hexadecimal hash of its structure without comments and whitespace, and
+ * a value declaration includes its type annotation.
+ */
+type DeclarationHash = {
+  symbol: number;
+  name: string;
+  startByte: number;
+  endByte: number;
+  hash: string;
+};
+
+/**
+ * A document whose declaration hashes are kept between edits, so that an
+ * edit only hashes the declarations it touches again.
+ */
+declare class DeclarationHashes {
+  constructor(source: string);
+  /** The top-level declarations in source order. */
+  declarations(): DeclarationHash[];
+  /**
+   * Replace `[startByte, oldEndByte)` of the UTF-8 source with `text` and
+   * return the declarations it removed, then those it added or changed in
+   * source order. Removed declarations have their positions before the edit.
+   */
+  edit(
+    startByte: number,
+    oldEndByte: number,
+    text: string,
+  ): (DeclarationHash & { change: "added" | "removed" | "changed" })[];
+}
+
+/** A top-level declaration and its `{-| -}` doc comment. */
+type DocEntry = {
+  symbol: number;
+  name: string;
+  startByte: number;
+  endByte: number;
+  docStartByte: number;
+  docEndByte: number;
+  /** Empty when the declaration has no doc comment. */
+  doc: string;
+};
+
+/** One `@docs` line of the module doc comment and the heading above it. */
+type DocGroup = {
+  startByte: number;
+  endByte: number;
+  heading: string;
+  names: string[];
+};
+
+/**
+ * The doc comments of a document indexed by declaration name, built in one
+ * pass so that hover is a lookup instead of a tree search.
+ */
+declare class DocIndex {
+  constructor(source: string);
+  /** The declaration named `name`, or null. */
+  find(name: string): DocEntry | null;
+  /** The module doc comment, the first doc comment after `module`. */
+  moduleDoc(): { startByte: number; endByte: number; doc: string } | null;
+  /** The `@docs` lines of the module doc comment, in order. */
+  groups(): DocGroup[];
+}
+
+/** An LSP `Position`: zero-based line and UTF-16 character offset. */
+type LinePosition = { line: number; character: number };
+
+/** A tree-sitter point: zero-based row and byte column. */
+type LinePoint = { row: number; column: number };
+
+/**
+ * The lines of a UTF-8 document, to convert between LSP positions and the
+ * byte offsets of the native classes. Lines are found with SIMD and only
+ * the changed ones are scanned again after `applyChange`.
+ */
+declare class LineIndex {
+  constructor(source: string);
+  lineCount(): number;
+  /** The LSP position of a byte offset. */
+  position(byte: number): LinePosition;
+  /** The byte offset of an LSP position, clamped to its line. */
+  byteOffset(position: LinePosition): number;
+  /**
+   * Apply an LSP `TextDocumentContentChangeEvent`, replacing the whole text
+   * if it has no range, and return the edit for `ts_tree_edit`.
+   */
+  applyChange(change: { range?: { start: LinePosition; end: LinePosition }; text: string }): {
+    startByte: number;
+    oldEndByte: number;
+    newEndByte: number;
+    startPoint: LinePoint;
+    oldEndPoint: LinePoint;
+    newEndPoint: LinePoint;
+  };
+}
+
+/**
+ * Everything but `language` and `nodeTypeInfo` comes from the native helpers,
+ * which link the shared libtree-sitter. An addon built with
+ * `TREE_SITTER_ELM_NO_LIB` set has the grammar alone.
+ */
 type Language = {
   language: unknown;
   nodeTypeInfo: NodeInfo[];
+  /** Parse files on the libuv threadpool, `chunkSize` files per job. */
+  parseFilesAsync: (paths: string[], chunkSize?: number) => Promise<FileSummaries>;
+  /** Symbol ids of the declaration kinds used in `FileSummaries`. */
+  declarationKinds: DeclarationKinds;
+  /**
+   * Parse `source` a second time and return the new tree as pre-order node
+   * records, see `flatNodeLayout`. This is not an export of an existing
+   * tree: a `Tree` from node-tree-sitter cannot be passed in, since that
+   * package keeps its `TSTree` private to its own addon, so every call pays
+   * for a full parse of its own, even when the caller has just reparsed the
+   * same source incrementally.
+   */
+  parseFlat: (source: string | Uint8Array, namedOnly?: boolean) => Uint32Array;
+  /**
+   * Parse `source` and return its document outline in pre-order, see
+   * `outlineLayout`: top-level values, types and their variants, type
+   * aliases and their record fields, ports and `let` functions.
+   */
+  outline: (source: string | Uint8Array) => Uint32Array;
+  /** Kind names indexed by the `kind` of an outline symbol. */
+  outlineKinds: OutlineKind[];
+  /**
+   * Parse `source` on the libuv threadpool within `budget`, so that one
+   * pathological file cannot hold up the others.
+   */
+  parseWithBudget: (source: string | Uint8Array, budget?: ParseBudget) => Promise<BudgetedParse>;
+  /** Node type names indexed by the `symbol` of a flat node. */
+  symbolNames: string[];
+  /** Field names indexed by the `fieldId` of a flat node, 0 means no field. */
+  fieldNames: (string | null)[];
+  flatNodeLayout: FlatNodeLayout;
+  outlineLayout: OutlineLayout;
+  SemanticTokensEncoder: typeof SemanticTokensEncoder;
+  SemanticTokensDocument: typeof SemanticTokensDocument;
+  Highlighter: typeof Highlighter;
+  ShaderInjections: typeof ShaderInjections;
+  BinaryOperators: typeof BinaryOperators;
+  DeclarationHashes: typeof DeclarationHashes;
+  DocIndex: typeof DocIndex;
+  LineIndex: typeof LineIndex;
 };
 
 declare const language: Language;
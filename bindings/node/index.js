@@ -9,3 +9,34 @@ module.exports =
 try {
   module.exports.nodeTypeInfo = require("../../src/node-types.json");
 } catch (_) {}
+
+if (typeof module.exports.summarizeFiles === "function") {
+  module.exports.parseFilesAsync = require("./batch")(module.exports.summarizeFiles);
+}
+
+// Offsets into the seven uint32 values of each `parseFlat` node, matching
+// `TSElmFlatNode` in lib/include/tree_sitter/elm/flat.h.
+module.exports.flatNodeLayout = Object.freeze({
+  size: 7,
+  symbol: 0,
+  fieldId: 1,
+  startByte: 2,
+  endByte: 3,
+  parent: 4,
+  firstChild: 5,
+  nextSibling: 6,
+  none: 0xffffffff,
+});
+
+// Offsets into the six uint32 values of each `outline` symbol, matching
+// `TSElmOutlineSymbol` in lib/include/tree_sitter/elm/outline.h.
+module.exports.outlineLayout = Object.freeze({
+  size: 6,
+  kind: 0,
+  parent: 1,
+  startByte: 2,
+  endByte: 3,
+  nameStartByte: 4,
+  nameEndByte: 5,
+  none: 0xffffffff,
+});
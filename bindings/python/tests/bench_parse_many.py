@@ -0,0 +1,57 @@
+"""Measure how `parse_many` scales with the number of threads.
+
+Usage: python bindings/python/tests/bench_parse_many.py [directory ...]
+
+Defaults to the `examples` directory; run `script/parse-examples` first to
+download the example packages.
+"""
+
+import sys
+from glob import glob
+from os import cpu_count, path
+from time import perf_counter
+
+import tree_sitter_elm
+
+
+def collect(directories):
+    files = []
+    for directory in directories:
+        files += glob(path.join(directory, "**", "*.elm"), recursive=True)
+    return sorted(files)
+
+
+def best_of(runs, files, threads):
+    best = float("inf")
+    for _ in range(runs):
+        start = perf_counter()
+        tree_sitter_elm.parse_many(files, threads=threads)
+        best = min(best, perf_counter() - start)
+    return best
+
+
+def main():
+
+    root = path.join(path.dirname(__file__), "..", "..", "..")
+    files = collect(sys.argv[1:] or [path.join(root, "examples")])
+    if not files:
+        sys.exit("no .elm files found")
+    size = sum(path.getsize(file) for file in files)
+    print(f"{len(files)} files, {size / 1e6:.1f} MB")
+
+    threads = 1
+    baseline = None
+    while True:
+        elapsed = best_of(3, files, threads)
+        baseline = baseline or elapsed
+        print(
+            f"threads={threads:<3} {elapsed * 1e3:8.1f} ms"
+            f" {size / elapsed / 1e6:8.1f} MB/s  speedup {baseline / elapsed:4.2f}x"
+        )
+        if threads >= (cpu_count() or 1):
+            break
+        threads = min(threads * 2, cpu_count() or 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,3 +1,6 @@
+from os import path
+from tempfile import TemporaryDirectory
+from threading import Timer
 from unittest import TestCase
 
 import tree_sitter
@@ -10,3 +13,128 @@ class TestLanguage(TestCase):
             tree_sitter.Language(tree_sitter_elm.language())
         except Exception:
             self.fail("Error loading Elm grammar")
+
+
+class TestParseMany(TestCase):
+    SOURCE = (
+        "module Main exposing (main)\n"
+        "\n"
+        "import Html\n"
+        "\n"
+        "type alias Model =\n"
+        "    { count : Int }\n"
+        "\n"
+        "main =\n"
+        '    Html.text "hello"\n'
+    )
+
+    def test_parse_many(self):
+        with TemporaryDirectory() as directory:
+            good = path.join(directory, "Main.elm")
+            broken = path.join(directory, "Broken.elm")
+            with open(good, "w") as file:
+                file.write(self.SOURCE)
+            with open(broken, "w") as file:
+                file.write("main = (\n")
+
+            results = tree_sitter_elm.parse_many([good, broken] * 4, threads=3)
+
+        self.assertEqual(len(results), 8)
+        file, has_error, declarations, imports = results[0]
+        self.assertEqual(file, good)
+        self.assertFalse(has_error)
+        self.assertEqual(imports, ["Html"])
+        self.assertEqual(
+            [(kind, name, row) for kind, name, _, _, row in declarations],
+            [("type_alias_declaration", "Model", 4), ("value_declaration", "main", 7)],
+        )
+        self.assertTrue(results[1][1])
+        self.assertEqual(results[6], results[0])
+
+    def test_parse_many_missing_file(self):
+        with TemporaryDirectory() as directory:
+            good = path.join(directory, "Main.elm")
+            missing = path.join(directory, "Missing.elm")
+            with open(good, "w") as file:
+                file.write(self.SOURCE)
+
+            results = tree_sitter_elm.parse_many([missing, good])
+
+        self.assertIsInstance(results[0], FileNotFoundError)
+        self.assertEqual(results[0].filename, missing)
+        self.assertEqual(results[1][0], good)
+        self.assertEqual(results[1][3], ["Html"])
+
+
+class TestParseWithBudget(TestCase):
+    # Unclosed brackets keep error recovery busy for far longer than the budgets
+    STRESS = "main =\n" + "    ( [ { x | y = f (g [ 1, \"a\", 'b' ] \n" * 40000
+
+    def test_completed(self):
+        source = 'import Html\n\nmain =\n    Html.text """é"""\n'
+        summary, metrics = tree_sitter_elm.parse_with_budget(source, timeout=10, time_scanner=True)
+        self.assertEqual(summary[0], False)
+        self.assertEqual(summary[2], ["Html"])
+        status, consumed, seconds, scanner_seconds, scanner_calls = metrics
+        self.assertEqual(status, "completed")
+        self.assertEqual(consumed, len(source.encode()))
+        self.assertGreater(scanner_calls, 0)
+        self.assertLessEqual(scanner_seconds, seconds)
+
+    def test_timeout(self):
+        summary, (status, consumed, seconds, _, _) = tree_sitter_elm.parse_with_budget(
+            self.STRESS, timeout=0.002
+        )
+        self.assertIsNone(summary)
+        self.assertEqual(status, "timed_out")
+        self.assertLess(consumed, len(self.STRESS))
+        self.assertLess(seconds, 0.2)
+
+    def test_cancelled(self):
+        flag = tree_sitter_elm.CancellationFlag()
+        timer = Timer(0.01, flag.cancel)
+        timer.start()
+        summary, (status, _, seconds, _, _) = tree_sitter_elm.parse_with_budget(
+            self.STRESS, cancellation_flag=flag
+        )
+        timer.join()
+        self.assertIsNone(summary)
+        self.assertEqual(status, "cancelled")
+        self.assertTrue(flag.is_cancelled())
+        flag.reset()
+        self.assertEqual(
+            tree_sitter_elm.parse_with_budget("main = 1\n", cancellation_flag=flag)[1][0],
+            "completed",
+        )
+
+
+class TestOutline(TestCase):
+    def test_outline(self):
+        source = (
+            "port send : String -> Cmd msg\n"
+            "\n"
+            "type Msg\n"
+            "    = Increment\n"
+            "\n"
+            "update msg model =\n"
+            "    let\n"
+            "        step n =\n"
+            "            n + 1\n"
+            "    in\n"
+            "    step model\n"
+        )
+        symbols = tree_sitter_elm.outline(source)
+        self.assertEqual(
+            [(kind, name, parent) for kind, name, parent, _, _, _, _ in symbols],
+            [
+                ("port", "send", None),
+                ("type", "Msg", None),
+                ("variant", "Increment", 1),
+                ("function", "update", None),
+                ("let_function", "step", 3),
+            ],
+        )
+        _, _, _, start, end, name_start, name_end = symbols[4]
+        self.assertEqual(source[start:end], "step n =\n            n + 1")
+        self.assertEqual(source[name_start:name_end], "step")
+        self.assertEqual(tree_sitter_elm.outline(source.encode()), symbols)
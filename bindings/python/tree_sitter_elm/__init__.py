@@ -4,6 +4,12 @@ from importlib.resources import files as _files
 
 from ._binding import language
 
+try:
+    from ._binding import CancellationFlag, outline, parse_many, parse_with_budget
+except ImportError:
+    # Built with TREE_SITTER_ELM_NO_LIB, the grammar alone
+    pass
+
 
 def _get_query(name, file):
     query = _files(f"{__package__}.queries") / file
@@ -34,6 +40,9 @@ __all__ = [
     "TAGS_QUERY",
 ]
 
+if "parse_many" in globals():
+    __all__ += ["CancellationFlag", "outline", "parse_many", "parse_with_budget"]
+
 
 def __dir__():
     return sorted(
@@ -1,4 +1,5 @@
-from typing import Final
+from os import PathLike
+from typing import Final, Literal, Sequence
 
 # NOTE: uncomment these to include any queries that this grammar contains:
 
@@ -8,3 +9,56 @@ LOCALS_QUERY: Final[str]
 TAGS_QUERY: Final[str]
 
 def language() -> object: ...
+
+Declaration = tuple[str, str, int, int, int]
+"""Node type, name, start byte, end byte and start row of a top-level declaration."""
+
+FileSummary = tuple[str | PathLike[str], bool, list[Declaration], list[str]]
+"""Path, whether the tree has errors, declarations and imported module names."""
+
+def parse_many(
+    paths: Sequence[str | PathLike[str]], threads: int = 0
+) -> list[FileSummary | OSError]:
+    """Parse and summarize `paths` on `threads` threads with the GIL
+    released, 0 for one per CPU. The result for a file that cannot be read is
+    its `OSError`, such as `FileNotFoundError`, the other files still get
+    their summary."""
+
+class CancellationFlag:
+    """A cancellation token for `parse_with_budget`, safe to set from any thread."""
+
+    def cancel(self) -> None: ...
+    def reset(self) -> None: ...
+    def is_cancelled(self) -> bool: ...
+
+SourceSummary = tuple[bool, list[Declaration], list[str]]
+"""Whether the tree has errors, declarations and imported module names."""
+
+ParseMetrics = tuple[Literal["completed", "timed_out", "cancelled"], int, float, float, int]
+"""Status, bytes consumed, seconds, seconds in the external scanner and scanner calls."""
+
+def parse_with_budget(
+    source: str | bytes,
+    timeout: float | None = None,
+    cancellation_flag: CancellationFlag | None = None,
+    time_scanner: bool = False,
+) -> tuple[SourceSummary | None, ParseMetrics]:
+    """Parse `source` with the GIL released, stopping after `timeout` seconds
+    or once `cancellation_flag` is set. The summary is None unless the parse
+    completed. Scanner time is only measured with `time_scanner`."""
+
+OutlineSymbol = tuple[
+    Literal["function", "type", "variant", "type_alias", "field", "port", "let_function"],
+    str,
+    int | None,
+    int,
+    int,
+    int,
+    int,
+]
+"""Kind, name, index of the enclosing symbol, start and end byte, and name start and end byte."""
+
+def outline(source: str | bytes) -> list[OutlineSymbol]:
+    """The document outline of `source` in one pass: top-level values, types
+    and their variants, type aliases and their record fields, ports and the
+    functions bound in `let` expressions. Parsed with the GIL released."""
@@ -8,7 +8,386 @@ static PyObject* _binding_language(PyObject *Py_UNUSED(self), PyObject *Py_UNUSE
     return PyCapsule_New(tree_sitter_elm(), "tree_sitter.Language", NULL);
 }
 
+#ifdef TREE_SITTER_ELM_LIB
+
+#include "tree_sitter/elm/batch.h"
+#include "tree_sitter/elm/budget.h"
+#include "tree_sitter/elm/outline.h"
+
+static PyObject *_slice(const TSElmFileSummary *file, uint32_t start, uint32_t end) {
+    return PyUnicode_DecodeUTF8(file->source + start, end - start, "replace");
+}
+
+// The declaration and import lists of a summary, as returned by parse_many.
+static int _summary_lists(const TSElmFileSummary *file, PyObject **declarations_result,
+                          PyObject **imports_result) {
+    const TSElmSummary *summary = &file->summary;
+    const TSLanguage *language = tree_sitter_elm();
+
+    PyObject *declarations = PyList_New(summary->declaration_count);
+    if (declarations == NULL) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < summary->declaration_count; i++) {
+        const TSElmDeclaration *declaration = &summary->declarations[i];
+        PyObject *item = Py_BuildValue(
+            "(sNIII)", ts_language_symbol_name(language, declaration->symbol),
+            _slice(file, declaration->name_start_byte, declaration->name_end_byte),
+            declaration->start_byte, declaration->end_byte,
+            declaration->start_point.row);
+        if (item == NULL) {
+            Py_DECREF(declarations);
+            return -1;
+        }
+        PyList_SetItem(declarations, i, item);
+    }
+
+    PyObject *imports = PyList_New(summary->import_count);
+    if (imports == NULL) {
+        Py_DECREF(declarations);
+        return -1;
+    }
+    for (uint32_t i = 0; i < summary->import_count; i++) {
+        const TSElmImport *import = &summary->imports[i];
+        PyObject *item = _slice(file, import->name_start_byte, import->name_end_byte);
+        if (item == NULL) {
+            Py_DECREF(declarations);
+            Py_DECREF(imports);
+            return -1;
+        }
+        PyList_SetItem(imports, i, item);
+    }
+
+    *declarations_result = declarations;
+    *imports_result = imports;
+    return 0;
+}
+
+static PyObject *_file_result(PyObject *path, const TSElmFileSummary *file) {
+    PyObject *declarations, *imports;
+    if (_summary_lists(file, &declarations, &imports) < 0) {
+        return NULL;
+    }
+    return Py_BuildValue("(OONN)", path, file->summary.has_error ? Py_True : Py_False,
+                         declarations, imports);
+}
+
+static PyObject *_binding_parse_many(PyObject *Py_UNUSED(self), PyObject *args, PyObject *kwargs) {
+    static char *keywords[] = {"paths", "threads", NULL};
+    PyObject *paths_arg;
+    unsigned int threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|I:parse_many", keywords, &paths_arg,
+                                     &threads)) {
+        return NULL;
+    }
+
+    PyObject *paths = PySequence_List(paths_arg);
+    if (paths == NULL) {
+        return NULL;
+    }
+    Py_ssize_t count = PyList_Size(paths);
+    if ((size_t)count > UINT32_MAX) {
+        Py_DECREF(paths);
+        return PyErr_Format(PyExc_ValueError, "too many paths");
+    }
+
+    PyObject *encoded = PyList_New(count);
+    const char **raw = PyMem_Calloc(count > 0 ? count : 1, sizeof(char *));
+    TSElmFileSummary *results = PyMem_Calloc(count > 0 ? count : 1, sizeof(TSElmFileSummary));
+    PyObject *list = NULL;
+    if (encoded == NULL || raw == NULL || results == NULL) {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    for (Py_ssize_t i = 0; i < count; i++) {
+        PyObject *bytes;
+        if (!PyUnicode_FSConverter(PyList_GetItem(paths, i), &bytes)) {
+            goto done;
+        }
+        PyList_SetItem(encoded, i, bytes);
+        raw[i] = PyBytes_AsString(bytes);
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    ts_elm_summarize_files(raw, (uint32_t)count, threads, results);
+    Py_END_ALLOW_THREADS
+
+    list = PyList_New(count);
+    if (list == NULL) {
+        goto done;
+    }
+    for (Py_ssize_t i = 0; i < count; i++) {
+        PyObject *path = PyList_GetItem(paths, i);
+        // A file that cannot be read gets its error, the OSError subclass
+        // for its errno, instead of failing the whole batch
+        PyObject *item = results[i].error != 0
+                             ? PyObject_CallFunction(PyExc_OSError, "isO", results[i].error,
+                                                     strerror(results[i].error), path)
+                             : _file_result(path, &results[i]);
+        if (item == NULL) {
+            Py_CLEAR(list);
+            goto done;
+        }
+        PyList_SetItem(list, i, item);
+    }
+
+done:
+    if (results != NULL) {
+        for (Py_ssize_t i = 0; i < count; i++) {
+            ts_elm_file_summary_delete(&results[i]);
+        }
+    }
+    PyMem_Free(results);
+    PyMem_Free(raw);
+    Py_XDECREF(encoded);
+    Py_DECREF(paths);
+    return list;
+}
+
+// A flag another thread sets to stop parse_with_budget, which reads it
+// atomically while the GIL is released.
+typedef struct {
+    PyObject_HEAD
+    size_t cancelled;
+} CancellationFlag;
+
+static PyObject *cancellation_flag_type;
+
+// The runtime reads the flag the same way, with plain volatile accesses on
+// MSVC, where aligned word accesses are atomic
+static void _store_flag(size_t *flag, size_t value) {
+#ifdef _MSC_VER
+    *(volatile size_t *)flag = value;
+#else
+    __atomic_store_n(flag, value, __ATOMIC_RELAXED);
+#endif
+}
+
+static size_t _load_flag(const size_t *flag) {
+#ifdef _MSC_VER
+    return *(const volatile size_t *)flag;
+#else
+    return __atomic_load_n(flag, __ATOMIC_RELAXED);
+#endif
+}
+
+static PyObject *_cancellation_flag_cancel(PyObject *self, PyObject *Py_UNUSED(args)) {
+    _store_flag(&((CancellationFlag *)self)->cancelled, 1);
+    Py_RETURN_NONE;
+}
+
+static PyObject *_cancellation_flag_reset(PyObject *self, PyObject *Py_UNUSED(args)) {
+    _store_flag(&((CancellationFlag *)self)->cancelled, 0);
+    Py_RETURN_NONE;
+}
+
+static PyObject *_cancellation_flag_is_cancelled(PyObject *self, PyObject *Py_UNUSED(args)) {
+    return PyBool_FromLong(_load_flag(&((CancellationFlag *)self)->cancelled) != 0);
+}
+
+static PyMethodDef cancellation_flag_methods[] = {
+    {"cancel", _cancellation_flag_cancel, METH_NOARGS, "Stop the parses that use this flag."},
+    {"reset", _cancellation_flag_reset, METH_NOARGS, "Clear the flag to use it again."},
+    {"is_cancelled", _cancellation_flag_is_cancelled, METH_NOARGS,
+     "Whether cancel was called since the last reset."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyType_Slot cancellation_flag_slots[] = {
+    {Py_tp_doc, "A cancellation token for parse_with_budget, safe to set from any thread."},
+    {Py_tp_new, PyType_GenericNew},
+    {Py_tp_methods, cancellation_flag_methods},
+    {0, NULL}
+};
+
+static PyType_Spec cancellation_flag_spec = {
+    .name = "tree_sitter_elm._binding.CancellationFlag",
+    .basicsize = sizeof(CancellationFlag),
+    .flags = Py_TPFLAGS_DEFAULT,
+    .slots = cancellation_flag_slots,
+};
+
+static const char *const PARSE_STATUSES[] = {"completed", "timed_out", "cancelled"};
+
+static PyObject *_binding_parse_with_budget(PyObject *Py_UNUSED(self), PyObject *args,
+                                            PyObject *kwargs) {
+    static char *keywords[] = {"source", "timeout", "cancellation_flag", "time_scanner", NULL};
+    PyObject *source_arg;
+    PyObject *timeout = Py_None;
+    PyObject *flag = Py_None;
+    int time_scanner = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|OOp:parse_with_budget", keywords, &source_arg,
+                                     &timeout, &flag, &time_scanner)) {
+        return NULL;
+    }
+
+    PyObject *source;
+    if (PyUnicode_Check(source_arg)) {
+        source = PyUnicode_AsUTF8String(source_arg);
+    } else if (PyBytes_Check(source_arg)) {
+        source = Py_NewRef(source_arg);
+    } else {
+        return PyErr_Format(PyExc_TypeError, "source must be str or bytes");
+    }
+    if (source == NULL) {
+        return NULL;
+    }
+
+    TSElmParseBudget budget = {0, NULL, time_scanner != 0};
+    PyObject *result = NULL;
+    char *data;
+    Py_ssize_t length;
+    if (PyBytes_AsStringAndSize(source, &data, &length) < 0) {
+        goto done;
+    }
+    if ((size_t)length > UINT32_MAX) {
+        PyErr_Format(PyExc_ValueError, "source is too large");
+        goto done;
+    }
+    if (timeout != Py_None) {
+        double seconds = PyFloat_AsDouble(timeout);
+        if (seconds == -1.0 && PyErr_Occurred()) {
+            goto done;
+        }
+        budget.timeout_micros = seconds * 1e6 < 1 ? 1 : (uint64_t)(seconds * 1e6);
+    }
+    if (flag != Py_None) {
+        if (!PyObject_TypeCheck(flag, (PyTypeObject *)cancellation_flag_type)) {
+            PyErr_Format(PyExc_TypeError, "cancellation_flag must be a CancellationFlag");
+            goto done;
+        }
+        budget.cancellation_flag = &((CancellationFlag *)flag)->cancelled;
+    }
+
+    TSElmFileSummary file = {data, (uint32_t)length, {0}, 0};
+    TSElmParseMetrics metrics;
+    bool built = true;
+    Py_BEGIN_ALLOW_THREADS
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_elm());
+    TSTree *tree = ts_elm_parse_string_with_budget(parser, NULL, file.source, file.length,
+                                                   &budget, &metrics);
+    if (tree != NULL) {
+        built = ts_elm_summary_build(&file.summary, ts_tree_root_node(tree));
+        ts_tree_delete(tree);
+    }
+    ts_parser_delete(parser);
+    Py_END_ALLOW_THREADS
+
+    if (!built) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    PyObject *summary = NULL;
+    PyObject *declarations, *imports;
+    if (metrics.status != TSElmParseCompleted) {
+        summary = Py_NewRef(Py_None);
+    } else if (_summary_lists(&file, &declarations, &imports) == 0) {
+        summary = Py_BuildValue("(ONN)", file.summary.has_error ? Py_True : Py_False,
+                                declarations, imports);
+    }
+    ts_elm_summary_delete(&file.summary);
+    if (summary == NULL) {
+        goto done;
+    }
+    result = Py_BuildValue("(N(sIddK))", summary, PARSE_STATUSES[metrics.status],
+                           metrics.bytes_consumed, (double)metrics.total_nanos / 1e9,
+                           (double)metrics.scanner_nanos / 1e9,
+                           (unsigned long long)metrics.scanner_calls);
+
+done:
+    Py_DECREF(source);
+    return result;
+}
+
+static const char *const OUTLINE_KINDS[] = {
+    "function", "type", "variant", "type_alias", "field", "port", "let_function",
+};
+
+static PyObject *_binding_outline(PyObject *Py_UNUSED(self), PyObject *source_arg) {
+    PyObject *source;
+    if (PyUnicode_Check(source_arg)) {
+        source = PyUnicode_AsUTF8String(source_arg);
+    } else if (PyBytes_Check(source_arg)) {
+        source = Py_NewRef(source_arg);
+    } else {
+        return PyErr_Format(PyExc_TypeError, "source must be str or bytes");
+    }
+    if (source == NULL) {
+        return NULL;
+    }
+
+    PyObject *list = NULL;
+    char *data;
+    Py_ssize_t length;
+    if (PyBytes_AsStringAndSize(source, &data, &length) < 0) {
+        goto done;
+    }
+    if ((size_t)length > UINT32_MAX) {
+        PyErr_Format(PyExc_ValueError, "source is too large");
+        goto done;
+    }
+
+    TSElmOutline outline = {0};
+    bool built;
+    Py_BEGIN_ALLOW_THREADS
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_elm());
+    TSTree *tree = ts_parser_parse_string(parser, NULL, data, (uint32_t)length);
+    built = ts_elm_outline_build(&outline, ts_tree_root_node(tree));
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+    Py_END_ALLOW_THREADS
+
+    if (!built) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    list = PyList_New(outline.count);
+    for (uint32_t i = 0; list != NULL && i < outline.count; i++) {
+        const TSElmOutlineSymbol *symbol = &outline.symbols[i];
+        PyObject *parent = symbol->parent == TS_ELM_OUTLINE_NONE
+                               ? Py_NewRef(Py_None)
+                               : PyLong_FromUnsignedLong(symbol->parent);
+        PyObject *item = parent == NULL ? NULL : Py_BuildValue(
+            "(sNNIIII)", OUTLINE_KINDS[symbol->kind],
+            PyUnicode_DecodeUTF8(data + symbol->name_start_byte,
+                                 symbol->name_end_byte - symbol->name_start_byte, "replace"),
+            parent, symbol->start_byte, symbol->end_byte, symbol->name_start_byte,
+            symbol->name_end_byte);
+        if (item == NULL) {
+            Py_CLEAR(list);
+            break;
+        }
+        PyList_SetItem(list, i, item);
+    }
+    ts_elm_outline_delete(&outline);
+
+done:
+    Py_DECREF(source);
+    return list;
+}
+
+static int _binding_exec(PyObject *module) {
+    cancellation_flag_type = PyType_FromSpec(&cancellation_flag_spec);
+    if (cancellation_flag_type == NULL) {
+        return -1;
+    }
+    Py_INCREF(cancellation_flag_type);
+    if (PyModule_AddObject(module, "CancellationFlag", cancellation_flag_type) < 0) {
+        Py_DECREF(cancellation_flag_type);
+        return -1;
+    }
+    return 0;
+}
+
+#endif
+
 static struct PyModuleDef_Slot slots[] = {
+#ifdef TREE_SITTER_ELM_LIB
+    {Py_mod_exec, _binding_exec},
+#endif
 #ifdef Py_GIL_DISABLED
     {Py_mod_gil, Py_MOD_GIL_NOT_USED},
 #endif
@@ -18,6 +397,16 @@ static struct PyModuleDef_Slot slots[] = {
 static PyMethodDef methods[] = {
     {"language", _binding_language, METH_NOARGS,
      "Get the tree-sitter language for this grammar."},
+#ifdef TREE_SITTER_ELM_LIB
+    {"parse_many", (PyCFunction)(void (*)(void))_binding_parse_many, METH_VARARGS | METH_KEYWORDS,
+     "Parse Elm files in parallel and return their declarations, imports and error flags, "
+     "or the OSError of a file that cannot be read."},
+    {"parse_with_budget", (PyCFunction)(void (*)(void))_binding_parse_with_budget,
+     METH_VARARGS | METH_KEYWORDS,
+     "Parse Elm source within a timeout or until cancelled, and return its summary and metrics."},
+    {"outline", _binding_outline, METH_O,
+     "Parse Elm source and return its document outline, parents before children."},
+#endif
     {NULL, NULL, 0, NULL}
 };
 
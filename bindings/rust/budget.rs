@@ -0,0 +1,194 @@
+//! Parsing within a time budget or until cancelled, so that one
+//! pathological file cannot stall a batch.
+//!
+//! ```
+//! use std::time::Duration;
+//! use tree_sitter_elm::budget::{parse_with_budget, Budget, Status};
+//!
+//! let mut parser = tree_sitter::Parser::new();
+//! parser.set_language(&tree_sitter_elm::LANGUAGE.into()).unwrap();
+//! let budget = Budget { timeout: Some(Duration::from_secs(1)), ..Budget::default() };
+//! let (tree, metrics) = parse_with_budget(&mut parser, b"main = 1\n", None, &budget);
+//! assert_eq!(metrics.status, Status::Completed);
+//! assert!(!tree.unwrap().root_node().has_error());
+//! ```
+
+use std::ops::ControlFlow;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::OnceLock;
+use std::time::{Duration, Instant};
+
+use tree_sitter::{ParseOptions, ParseState, Parser, Tree};
+
+/// `ElmScannerTiming` in src/scanner_timing.h.
+#[repr(C)]
+struct ScannerTiming {
+    clock: extern "C" fn() -> u64,
+    nanos: u64,
+    calls: u64,
+}
+
+/// The clock of the scanner's timing hook, in nanoseconds since its first
+/// call.
+extern "C" fn nanos() -> u64 {
+    static START: OnceLock<Instant> = OnceLock::new();
+    START.get_or_init(Instant::now).elapsed().as_nanos() as u64
+}
+
+// Defined by src/scanner.c
+extern "C" {
+    fn tree_sitter_elm_scanner_timing_begin(timing: *mut ScannerTiming);
+    fn tree_sitter_elm_scanner_timing_end();
+}
+
+/// Limits on one parse.
+#[derive(Clone, Copy, Debug, Default)]
+pub struct Budget<'a> {
+    /// Stop after this long.
+    pub timeout: Option<Duration>,
+    /// Stop once this is set, from any thread.
+    pub cancellation_flag: Option<&'a AtomicBool>,
+    /// Measure the time spent in the external scanner of
+    /// [`LANGUAGE`](crate::LANGUAGE). Parsers with another language report
+    /// no scanner time.
+    pub time_scanner: bool,
+}
+
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub enum Status {
+    #[default]
+    Completed,
+    TimedOut,
+    Cancelled,
+}
+
+#[derive(Clone, Copy, Debug, Default)]
+pub struct Metrics {
+    pub status: Status,
+    /// How far into the source the parser got, all of it when completed.
+    pub bytes_consumed: usize,
+    pub total: Duration,
+    /// Time in the external scanner when it was measured, the rest of
+    /// `total` went to the lexer and the parse table.
+    pub scanner: Duration,
+    pub scanner_calls: u64,
+}
+
+/// Parse `source` within `budget`, checked from the runtime's progress
+/// callback. Returns no tree when the parse ran out of time or was
+/// cancelled, in which case the parser is reset and the metrics say how far
+/// it got.
+pub fn parse_with_budget(
+    parser: &mut Parser,
+    source: &[u8],
+    old_tree: Option<&Tree>,
+    budget: &Budget,
+) -> (Option<Tree>, Metrics) {
+    let start = Instant::now();
+    let mut metrics = Metrics::default();
+    let cancelled = || budget.cancellation_flag.is_some_and(|flag| flag.load(Ordering::Relaxed));
+    if cancelled() {
+        metrics.status = Status::Cancelled;
+        return (None, metrics);
+    }
+
+    let mut timing = ScannerTiming { clock: nanos, nanos: 0, calls: 0 };
+    if budget.time_scanner {
+        // SAFETY: the parse runs on this thread and ends before `timing`.
+        unsafe { tree_sitter_elm_scanner_timing_begin(&mut timing) };
+    }
+    let deadline = budget.timeout.map(|timeout| start + timeout);
+    let mut status = Status::Completed;
+    let mut consumed = 0;
+    let mut progress = |state: &ParseState| {
+        consumed = consumed.max(state.current_byte_offset());
+        if cancelled() {
+            status = Status::Cancelled;
+        } else if deadline.is_some_and(|deadline| Instant::now() >= deadline) {
+            status = Status::TimedOut;
+        } else {
+            return ControlFlow::Continue(());
+        }
+        ControlFlow::Break(())
+    };
+    let tree = parser.parse_with_options(
+        &mut |byte, _| source.get(byte..).unwrap_or_default(),
+        old_tree,
+        Some(ParseOptions::new().progress_callback(&mut progress)),
+    );
+    if budget.time_scanner {
+        unsafe { tree_sitter_elm_scanner_timing_end() };
+    }
+
+    metrics.total = start.elapsed();
+    metrics.scanner = Duration::from_nanos(timing.nanos);
+    metrics.scanner_calls = timing.calls;
+    metrics.bytes_consumed = consumed;
+    match tree {
+        Some(tree) => {
+            metrics.bytes_consumed = consumed.max(tree.root_node().end_byte());
+            (Some(tree), metrics)
+        }
+        None => {
+            metrics.status = status;
+            parser.reset();
+            (None, metrics)
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn parser() -> Parser {
+        let mut parser = Parser::new();
+        parser.set_language(&crate::LANGUAGE.into()).unwrap();
+        parser
+    }
+
+    /// Unclosed brackets that keep error recovery busy for far longer than
+    /// the budgets below.
+    fn stress_source() -> String {
+        "main =\n".to_string() + &"    ( [ { x | y = f (g [ 1, \"a\", 'b' ] \n".repeat(40000)
+    }
+
+    #[test]
+    fn test_completed() {
+        let source = b"main =\n    \"\"\"multi\n    line\"\"\"\n";
+        let budget = Budget { time_scanner: true, ..Budget::default() };
+        let (tree, metrics) = parse_with_budget(&mut parser(), source, None, &budget);
+        assert_eq!(metrics.status, Status::Completed);
+        assert_eq!(metrics.bytes_consumed, source.len());
+        assert!(metrics.scanner_calls > 0 && metrics.scanner <= metrics.total);
+        assert!(!tree.unwrap().root_node().has_error());
+    }
+
+    #[test]
+    fn test_timeout() {
+        let source = stress_source();
+        let budget = Budget { timeout: Some(Duration::from_millis(2)), ..Budget::default() };
+        let mut parser = parser();
+        let (tree, metrics) = parse_with_budget(&mut parser, source.as_bytes(), None, &budget);
+        assert!(tree.is_none());
+        assert_eq!(metrics.status, Status::TimedOut);
+        assert!(metrics.bytes_consumed < source.len());
+        assert!(metrics.total < Duration::from_millis(200));
+        assert!(parser.parse("main = 1\n", None).is_some());
+    }
+
+    #[test]
+    fn test_cancelled() {
+        let source = stress_source();
+        let flag = AtomicBool::new(false);
+        let budget = Budget { cancellation_flag: Some(&flag), ..Budget::default() };
+        let metrics = std::thread::scope(|scope| {
+            scope.spawn(|| {
+                std::thread::sleep(Duration::from_millis(10));
+                flag.store(true, Ordering::Relaxed);
+            });
+            parse_with_budget(&mut parser(), source.as_bytes(), None, &budget).1
+        });
+        assert_eq!(metrics.status, Status::Cancelled);
+    }
+}
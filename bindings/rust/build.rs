@@ -15,6 +15,23 @@ fn main() {
     if scanner_path.exists() {
         c_config.file(&scanner_path);
         println!("cargo:rerun-if-changed={}", scanner_path.to_str().unwrap());
+        println!("cargo:rerun-if-changed=src/scanner_timing.h");
+    }
+
+    if std::env::var_os("CARGO_FEATURE_TREE_SITTER").is_some() {
+        // The line_index and outline modules wrap C helpers that use the
+        // runtime's headers, which the tree-sitter crate exports as
+        // DEP_TREE_SITTER_INCLUDE
+        let runtime_include = std::env::var_os("DEP_TREE_SITTER_INCLUDE")
+            .expect("the tree-sitter crate did not export its include directory");
+        c_config
+            .include(runtime_include)
+            .include("lib/include")
+            .include("bindings/c");
+        for path in ["lib/src/line_index.c", "lib/src/outline.c", "lib/src/symbols.c"] {
+            c_config.file(path);
+            println!("cargo:rerun-if-changed={path}");
+        }
     }
 
     c_config.compile("tree-sitter-elm");
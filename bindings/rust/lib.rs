@@ -20,6 +20,13 @@
 
 use tree_sitter_language::LanguageFn;
 
+#[cfg(feature = "tree-sitter")]
+pub mod budget;
+#[cfg(feature = "tree-sitter")]
+pub mod line_index;
+#[cfg(feature = "tree-sitter")]
+pub mod outline;
+
 extern "C" {
     fn tree_sitter_elm() -> *const ();
 }
@@ -0,0 +1,280 @@
+//! Conversion between byte offsets, tree-sitter points and LSP positions,
+//! through the line index of `lib/src/line_index.c`.
+//!
+//! A [`LineIndex`] keeps the start of each line of a UTF-8 document and
+//! whether the line is ASCII only. Lines end at `\n`, as tree-sitter rows do,
+//! and a `\r` before it is not part of the line for LSP positions. Newlines
+//! and non-ASCII bytes are found 16 bytes at a time with SSE2 or NEON.
+//!
+//! ```
+//! use tree_sitter_elm::line_index::{LineIndex, Position};
+//!
+//! let mut source = String::from("a =\n    \"é\"\n");
+//! let mut index = LineIndex::new(&source);
+//! let edit = index.apply_change(
+//!     &mut source,
+//!     Some((Position { line: 1, character: 5 }, Position { line: 1, character: 6 })),
+//!     "e",
+//! );
+//! assert_eq!(source, "a =\n    \"e\"\n");
+//! assert_eq!((edit.start_byte, edit.old_end_byte, edit.new_end_byte), (9, 11, 10));
+//! ```
+
+use std::os::raw::c_char;
+use std::ptr::NonNull;
+
+use tree_sitter::{ffi, InputEdit, Point};
+
+/// An LSP `Position`: a zero-based line and a character offset in UTF-16
+/// code units. `TSElmPosition` in lib/include/tree_sitter/elm/line_index.h.
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct Position {
+    pub line: u32,
+    pub character: u32,
+}
+
+/// `TSElmLineIndex`.
+#[repr(C)]
+struct RawLineIndex {
+    _private: [u8; 0],
+}
+
+extern "C" {
+    fn ts_elm_line_index_new() -> *mut RawLineIndex;
+    fn ts_elm_line_index_delete(index: *mut RawLineIndex);
+    fn ts_elm_line_index_reset(
+        index: *mut RawLineIndex,
+        source: *const c_char,
+        length: u32,
+    ) -> bool;
+    fn ts_elm_line_index_edit(
+        index: *mut RawLineIndex,
+        source: *const c_char,
+        length: u32,
+        edit: *const ffi::TSInputEdit,
+    ) -> bool;
+    fn ts_elm_line_index_line_count(index: *const RawLineIndex) -> u32;
+    fn ts_elm_line_index_point(index: *const RawLineIndex, byte: u32) -> ffi::TSPoint;
+    fn ts_elm_line_index_position(
+        index: *const RawLineIndex,
+        source: *const c_char,
+        byte: u32,
+    ) -> Position;
+    fn ts_elm_line_index_byte(
+        index: *const RawLineIndex,
+        source: *const c_char,
+        position: Position,
+    ) -> u32;
+    fn ts_elm_line_index_change(
+        index: *const RawLineIndex,
+        source: *const c_char,
+        start: Position,
+        end: Position,
+        text: *const c_char,
+        text_length: u32,
+    ) -> ffi::TSInputEdit;
+}
+
+/// The offsets of the C helper are 32 bits, like the runtime's.
+fn length(text: &str) -> u32 {
+    u32::try_from(text.len()).expect("text longer than 4 GiB")
+}
+
+fn offset(byte: usize) -> u32 {
+    u32::try_from(byte).unwrap_or(u32::MAX)
+}
+
+fn point(point: ffi::TSPoint) -> Point {
+    Point::new(point.row as usize, point.column as usize)
+}
+
+fn raw_point(point: Point) -> ffi::TSPoint {
+    ffi::TSPoint { row: offset(point.row), column: offset(point.column) }
+}
+
+/// The line starts of a document. The index does not keep the source,
+/// methods that need the text of a line take the current source.
+///
+/// # Panics
+///
+/// The methods that index text panic if the C helper runs out of memory or
+/// the text is longer than 4 GiB.
+#[derive(Debug)]
+pub struct LineIndex {
+    raw: NonNull<RawLineIndex>,
+}
+
+// SAFETY: the C index has no thread affinity, and the methods taking `&self`
+// only read it.
+unsafe impl Send for LineIndex {}
+unsafe impl Sync for LineIndex {}
+
+impl LineIndex {
+    /// Index `source`.
+    pub fn new(source: &str) -> Self {
+        // SAFETY: the helper returns an owned index or null.
+        let raw = NonNull::new(unsafe { ts_elm_line_index_new() }).expect("out of memory");
+        let index = Self { raw };
+        // SAFETY: the source outlives the call, which only reads it.
+        let indexed = unsafe {
+            ts_elm_line_index_reset(raw.as_ptr(), source.as_ptr().cast(), length(source))
+        };
+        assert!(indexed, "out of memory");
+        index
+    }
+
+    /// The number of lines, one more than the number of newlines.
+    pub fn line_count(&self) -> usize {
+        unsafe { ts_elm_line_index_line_count(self.raw.as_ptr()) as usize }
+    }
+
+    /// The tree-sitter point of a byte offset.
+    pub fn point(&self, byte: usize) -> Point {
+        point(unsafe { ts_elm_line_index_point(self.raw.as_ptr(), offset(byte)) })
+    }
+
+    /// The LSP position of a byte offset. Finding the line takes O(log n),
+    /// the character needs no scan on ASCII lines and a scan of the line up
+    /// to `byte` otherwise.
+    pub fn position(&self, source: &str, byte: usize) -> Position {
+        // SAFETY: the helper reads the source up to `byte`, clamped to the
+        // indexed length, which is the length of `source`.
+        unsafe {
+            ts_elm_line_index_position(self.raw.as_ptr(), source.as_ptr().cast(), offset(byte))
+        }
+    }
+
+    /// The byte offset of an LSP position. Positions past the end of a line
+    /// are clamped to it, and lines past the end of the document to its
+    /// length.
+    pub fn byte(&self, source: &str, position: Position) -> usize {
+        unsafe {
+            ts_elm_line_index_byte(self.raw.as_ptr(), source.as_ptr().cast(), position) as usize
+        }
+    }
+
+    /// Turn an LSP `TextDocumentContentChangeEvent` replacing `range`, or the
+    /// whole text without one, with `text` into the edit for the tree,
+    /// computed on the source before the change.
+    pub fn change(
+        &self,
+        source: &str,
+        range: Option<(Position, Position)>,
+        text: &str,
+    ) -> InputEdit {
+        // Positions past the end clamp to it, so the whole text is the range
+        // from the start to the largest position
+        let (start, end) = range
+            .unwrap_or((Position::default(), Position { line: u32::MAX, character: u32::MAX }));
+        let edit = unsafe {
+            ts_elm_line_index_change(
+                self.raw.as_ptr(),
+                source.as_ptr().cast(),
+                start,
+                end,
+                text.as_ptr().cast(),
+                length(text),
+            )
+        };
+        InputEdit {
+            start_byte: edit.start_byte as usize,
+            old_end_byte: edit.old_end_byte as usize,
+            new_end_byte: edit.new_end_byte as usize,
+            start_position: point(edit.start_point),
+            old_end_position: point(edit.old_end_point),
+            new_end_position: point(edit.new_end_point),
+        }
+    }
+
+    /// Bring the index up to date after `edit`, where `source` is the text
+    /// after the edit. Only the lines from the edit's start to the end of the
+    /// line holding its new end are scanned, the later ones are moved.
+    pub fn edit(&mut self, source: &str, edit: &InputEdit) {
+        let edit = ffi::TSInputEdit {
+            start_byte: offset(edit.start_byte),
+            old_end_byte: offset(edit.old_end_byte),
+            new_end_byte: offset(edit.new_end_byte),
+            start_point: raw_point(edit.start_position),
+            old_end_point: raw_point(edit.old_end_position),
+            new_end_point: raw_point(edit.new_end_position),
+        };
+        // SAFETY: the source and the edit outlive the call, which only reads
+        // them.
+        let edited = unsafe {
+            ts_elm_line_index_edit(self.raw.as_ptr(), source.as_ptr().cast(), length(source), &edit)
+        };
+        assert!(edited, "out of memory");
+    }
+
+    /// Apply an LSP content change to `source` and the index, and return the
+    /// edit to apply to the tree.
+    pub fn apply_change(
+        &mut self,
+        source: &mut String,
+        range: Option<(Position, Position)>,
+        text: &str,
+    ) -> InputEdit {
+        let edit = self.change(source, range, text);
+        source.replace_range(edit.start_byte..edit.old_end_byte, text);
+        self.edit(source, &edit);
+        edit
+    }
+}
+
+impl Drop for LineIndex {
+    fn drop(&mut self) {
+        unsafe { ts_elm_line_index_delete(self.raw.as_ptr()) };
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const SOURCE: &str = "module Main exposing (..)\r\n\nname =\n    \"Élm 𝔼 and a line long enough to fill a few blocks\" -- é\n";
+
+    #[test]
+    fn test_positions() {
+        let index = LineIndex::new(SOURCE);
+        assert_eq!(index.line_count(), 5);
+        let byte = SOURCE.find('𝔼').unwrap();
+        assert_eq!(index.position(SOURCE, byte), Position { line: 3, character: 9 });
+        assert_eq!(index.byte(SOURCE, Position { line: 3, character: 9 }), byte);
+        assert_eq!(index.position(SOURCE, byte + 4), Position { line: 3, character: 11 });
+        assert_eq!(index.byte(SOURCE, Position { line: 0, character: 100 }), 25);
+        assert_eq!(index.byte(SOURCE, Position { line: 9, character: 0 }), SOURCE.len());
+        assert_eq!(index.point(byte), Point::new(3, 10));
+    }
+
+    #[test]
+    fn test_changes() {
+        let mut source = SOURCE.to_string();
+        let mut index = LineIndex::new(&source);
+        let changes = [
+            (Some((3, 6, 3, 6)), "ü"),
+            (Some((2, 0, 4, 0)), ""),
+            (Some((0, 7, 0, 11)), "Main\n\nimport Html\n\nx =\n    \"𝔼\"\n"),
+            (Some((5, 0, 9, 2)), "é"),
+            (None, "only\nthis\n"),
+        ];
+        for (range, text) in changes {
+            let range = range.map(|(line, character, end_line, end_character)| {
+                (
+                    Position { line, character },
+                    Position { line: end_line, character: end_character },
+                )
+            });
+            let edit = index.apply_change(&mut source, range, text);
+            let expected = LineIndex::new(&source);
+            assert_eq!(index.line_count(), expected.line_count());
+            for byte in 0..=source.len() {
+                assert_eq!(index.point(byte), expected.point(byte));
+                if source.is_char_boundary(byte) {
+                    assert_eq!(index.position(&source, byte), expected.position(&source, byte));
+                }
+            }
+            assert_eq!(expected.point(edit.new_end_byte), edit.new_end_position);
+        }
+    }
+}
@@ -0,0 +1,134 @@
+//! The document outline of an Elm tree, built in one walk by the C helper
+//! in `lib/src/outline.c`: top-level values, types with their variants,
+//! type aliases with the fields of their record type, ports and the
+//! functions bound in `let` expressions.
+//!
+//! ```
+//! use tree_sitter_elm::outline::{outline, SymbolKind};
+//!
+//! let source = "type Msg\n    = Increment\n";
+//! let mut parser = tree_sitter::Parser::new();
+//! parser.set_language(&tree_sitter_elm::LANGUAGE.into()).unwrap();
+//! let tree = parser.parse(source, None).unwrap();
+//! let symbols = outline(&tree);
+//! assert_eq!(symbols[1].kind, SymbolKind::Variant);
+//! assert_eq!(symbols[1].parent, Some(0));
+//! assert_eq!(&source[symbols[1].name_range.clone()], "Increment");
+//! ```
+
+use std::ops::Range;
+
+use tree_sitter::{ffi, Tree};
+
+/// What an outline symbol is. Values and functions are the same in Elm,
+/// [`SymbolKind::Function`] is any top-level `value_declaration`.
+#[derive(Clone, Copy, Debug, PartialEq, Eq, Hash)]
+pub enum SymbolKind {
+    Function,
+    Type,
+    Variant,
+    TypeAlias,
+    Field,
+    Port,
+    LetFunction,
+}
+
+const KINDS: [SymbolKind; 7] = [
+    SymbolKind::Function,
+    SymbolKind::Type,
+    SymbolKind::Variant,
+    SymbolKind::TypeAlias,
+    SymbolKind::Field,
+    SymbolKind::Port,
+    SymbolKind::LetFunction,
+];
+
+/// A symbol of the outline. `parent` indexes the enclosing symbol, which
+/// comes before it. The name range is empty when broken code has no name.
+#[derive(Clone, Debug, PartialEq, Eq)]
+pub struct OutlineSymbol {
+    pub kind: SymbolKind,
+    pub parent: Option<usize>,
+    pub byte_range: Range<usize>,
+    pub name_range: Range<usize>,
+}
+
+/// `TSElmOutlineSymbol` in lib/include/tree_sitter/elm/outline.h.
+#[repr(C)]
+struct RawSymbol {
+    kind: u32,
+    parent: u32,
+    start_byte: u32,
+    end_byte: u32,
+    name_start_byte: u32,
+    name_end_byte: u32,
+}
+
+/// `TSElmOutline`.
+#[repr(C)]
+struct RawOutline {
+    symbols: *mut RawSymbol,
+    count: u32,
+    capacity: u32,
+}
+
+extern "C" {
+    fn ts_elm_outline_build(outline: *mut RawOutline, root: ffi::TSNode) -> bool;
+    fn ts_elm_outline_delete(outline: *mut RawOutline);
+}
+
+/// The outline of `tree` in pre-order.
+///
+/// # Panics
+///
+/// If the C helper runs out of memory.
+pub fn outline(tree: &Tree) -> Vec<OutlineSymbol> {
+    let mut raw = RawOutline { symbols: std::ptr::null_mut(), count: 0, capacity: 0 };
+    // SAFETY: the tree outlives the call, which only reads it.
+    let built = unsafe { ts_elm_outline_build(&mut raw, tree.root_node().into_raw()) };
+    assert!(built, "out of memory");
+    let symbols = if raw.count == 0 {
+        &[][..]
+    } else {
+        // SAFETY: the helper filled `count` symbols.
+        unsafe { std::slice::from_raw_parts(raw.symbols, raw.count as usize) }
+    };
+    let result = symbols
+        .iter()
+        .map(|symbol| OutlineSymbol {
+            kind: KINDS[symbol.kind as usize],
+            parent: (symbol.parent != u32::MAX).then_some(symbol.parent as usize),
+            byte_range: symbol.start_byte as usize..symbol.end_byte as usize,
+            name_range: symbol.name_start_byte as usize..symbol.name_end_byte as usize,
+        })
+        .collect();
+    unsafe { ts_elm_outline_delete(&mut raw) };
+    result
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_outline() {
+        let source = "type alias Model =\n    { count : Int }\n\n\n\
+                      update model =\n    let\n        step n =\n            n + 1\n    in\n    step model\n";
+        let mut parser = tree_sitter::Parser::new();
+        parser.set_language(&crate::LANGUAGE.into()).unwrap();
+        let tree = parser.parse(source, None).unwrap();
+        let symbols: Vec<_> = outline(&tree)
+            .into_iter()
+            .map(|symbol| (symbol.kind, &source[symbol.name_range], symbol.parent))
+            .collect();
+        assert_eq!(
+            symbols,
+            [
+                (SymbolKind::TypeAlias, "Model", None),
+                (SymbolKind::Field, "count", Some(0)),
+                (SymbolKind::Function, "update", None),
+                (SymbolKind::LetFunction, "step", Some(2)),
+            ]
+        );
+    }
+}
@@ -0,0 +1,10 @@
+/// <reference types="tree-sitter-cli/dsl" />
+// @ts-check
+
+// The Elm grammar with anonymous keyword and punctuation nodes, see
+// transform.js. The committed parser is derived from the full one rather
+// than generated from this file, see README.md.
+
+const { lean } = require("./transform");
+
+module.exports = { grammar: lean(require("../grammar").grammar) };
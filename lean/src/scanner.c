@@ -0,0 +1,14 @@
+// The lean grammar has the same external tokens as the Elm grammar, so it
+// reuses its scanner under the names the lean parser looks up.
+#define tree_sitter_elm_external_scanner_create tree_sitter_elm_lean_external_scanner_create
+#define tree_sitter_elm_external_scanner_destroy tree_sitter_elm_lean_external_scanner_destroy
+#define tree_sitter_elm_external_scanner_scan tree_sitter_elm_lean_external_scanner_scan
+#define tree_sitter_elm_external_scanner_serialize tree_sitter_elm_lean_external_scanner_serialize
+#define tree_sitter_elm_external_scanner_deserialize tree_sitter_elm_lean_external_scanner_deserialize
+#define tree_sitter_elm_trace_read tree_sitter_elm_lean_trace_read
+#define tree_sitter_elm_trace_dump tree_sitter_elm_lean_trace_dump
+#define tree_sitter_elm_trace_clear tree_sitter_elm_lean_trace_clear
+#define tree_sitter_elm_scanner_timing_begin tree_sitter_elm_lean_scanner_timing_begin
+#define tree_sitter_elm_scanner_timing_end tree_sitter_elm_lean_scanner_timing_end
+
+#include "../../src/scanner.c"
@@ -0,0 +1,157 @@
+// Turns the Elm grammar into the lean variant, where the keywords and
+// punctuation in `TOKENS` are anonymous nodes instead of named ones.
+//
+// Usage: node lean/transform.js
+// Writes lean/src/grammar.json, parser.c and node-types.json from the full
+// grammar's generated files in src/. The lean parser is the full one with
+// the symbol names and metadata of `TOKENS` rewritten, so the two share
+// their parse and lex tables and need no tree-sitter CLI to stay in sync.
+
+const TOKENS = {
+  colon: ":",
+  eq: "=",
+  arrow: "->",
+  case: "case",
+  of: "of",
+  as: "as",
+  port: "port",
+  alias: "alias",
+  exposing: "exposing",
+  double_dot: "..",
+  backslash: "\\",
+  dot: ".",
+  underscore: "_",
+};
+
+function strip(rule) {
+  if (rule.type === "SYMBOL" && rule.name in TOKENS) {
+    return { type: "STRING", value: TOKENS[rule.name] };
+  }
+  if (rule.type === "ALIAS" && rule.named && rule.value in TOKENS) {
+    return { ...rule, content: strip(rule.content), named: false, value: TOKENS[rule.value] };
+  }
+  const result = { ...rule };
+  if (rule.content) {
+    result.content = strip(rule.content);
+  }
+  if (rule.members) {
+    result.members = rule.members.map(strip);
+  }
+  return result;
+}
+
+function lean(grammar) {
+  const rules = {};
+  for (const [name, rule] of Object.entries(grammar.rules)) {
+    if (!(name in TOKENS)) {
+      rules[name] = strip(rule);
+    }
+  }
+  return { ...grammar, name: `${grammar.name}_lean`, rules, extras: grammar.extras.map(strip) };
+}
+
+// The C string literal of a token's text
+function cString(text) {
+  return JSON.stringify(text);
+}
+
+// Rewrites the entries of `sym_<name>` in the generated array `array`
+function rewriteArray(source, array, rewrite) {
+  const start = source.indexOf(`${array}[] = {`);
+  const end = source.indexOf("\n};\n", start);
+  if (start < 0 || end < 0) {
+    throw new Error(`no ${array} in the generated parser`);
+  }
+  return source.slice(0, start) + rewrite(source.slice(start, end)) + source.slice(end);
+}
+
+function leanParser(source) {
+  const names = source.slice(source.indexOf("ts_symbol_names[] = {"));
+  // An anonymous token with the same text is the public symbol of the
+  // rewritten one, as the CLI would have made them a single symbol
+  const publicSymbol = (text) =>
+    names.match(new RegExp(`\\[(anon_sym_\\w+)\\] = ${cString(text).replace(/[\\.]/g, "\\$&")},`))?.[1];
+
+  for (const [name, text] of Object.entries(TOKENS)) {
+    const symbol = `sym_${name}`;
+    let found = false;
+    source = rewriteArray(source, "ts_symbol_names", (block) =>
+      block.replace(`[${symbol}] = "${name}",`, () => {
+        found = true;
+        return `[${symbol}] = ${cString(text)},`;
+      }),
+    );
+    if (!found) {
+      throw new Error(`no ${symbol} in the generated parser`);
+    }
+    const anonymous = publicSymbol(text);
+    if (anonymous) {
+      source = rewriteArray(source, "ts_symbol_map", (block) =>
+        block.replace(`[${symbol}] = ${symbol},`, `[${symbol}] = ${anonymous},`),
+      );
+    }
+    source = rewriteArray(source, "ts_symbol_metadata", (block) =>
+      block.replace(
+        `[${symbol}] = {\n    .visible = true,\n    .named = true,\n  },`,
+        `[${symbol}] = {\n    .visible = true,\n    .named = false,\n  },`,
+      ),
+    );
+  }
+  return source
+    .replace(/\btree_sitter_elm\b/g, "tree_sitter_elm_lean")
+    .replace(/\btree_sitter_elm_external_scanner_/g, "tree_sitter_elm_lean_external_scanner_")
+    .replace('.name = "elm",', '.name = "elm_lean",');
+}
+
+function leanNodeTypes(types) {
+  const rename = (type) =>
+    type.named && type.type in TOKENS ? { type: TOKENS[type.type], named: false } : type;
+  const unique = (list) => {
+    const seen = new Set();
+    return list.filter(({ type, named }) => {
+      const key = `${named} ${type}`;
+      return seen.has(key) ? false : seen.add(key);
+    });
+  };
+  const renameTypes = (info) => info && { ...info, types: unique(info.types.map(rename)) };
+
+  const result = types.map((entry) => {
+    if (entry.named && entry.type in TOKENS) {
+      return rename(entry);
+    }
+    const lean = { ...entry };
+    if (entry.fields) {
+      lean.fields = Object.fromEntries(
+        Object.entries(entry.fields).map(([field, info]) => [field, renameTypes(info)]),
+      );
+    }
+    if (entry.children) {
+      lean.children = renameTypes(entry.children);
+    }
+    if (entry.subtypes) {
+      lean.subtypes = unique(entry.subtypes.map(rename));
+    }
+    return lean;
+  });
+  // Tokens come after the rules, in the order of their text
+  const rules = result.filter((entry) => entry.fields || entry.children || entry.subtypes);
+  const tokens = result.filter((entry) => !rules.includes(entry));
+  tokens.sort((a, b) => (a.type < b.type ? -1 : a.type > b.type ? 1 : 0));
+  return unique([...rules, ...tokens]);
+}
+
+module.exports = { TOKENS, lean, leanParser, leanNodeTypes };
+
+if (require.main === module) {
+  const fs = require("node:fs");
+  const path = require("node:path");
+  const source = (file) => fs.readFileSync(path.join(__dirname, "..", "src", file), "utf8");
+  const write = (file, contents) => fs.writeFileSync(path.join(__dirname, "src", file), contents);
+
+  write("grammar.json", `${JSON.stringify(lean(JSON.parse(source("grammar.json"))), null, 2)}\n`);
+  write("parser.c", leanParser(source("parser.c")));
+  write(
+    "node-types.json",
+    `${JSON.stringify(leanNodeTypes(JSON.parse(source("node-types.json"))), null, 2)}\n`,
+  );
+}
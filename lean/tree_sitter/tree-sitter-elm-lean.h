@@ -0,0 +1,16 @@
+#ifndef TREE_SITTER_ELM_LEAN_H_
+#define TREE_SITTER_ELM_LEAN_H_
+
+typedef struct TSLanguage TSLanguage;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+const TSLanguage *tree_sitter_elm_lean(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_LEAN_H_
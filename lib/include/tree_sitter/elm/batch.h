@@ -0,0 +1,77 @@
+#ifndef TREE_SITTER_ELM_BATCH_H_
+#define TREE_SITTER_ELM_BATCH_H_
+
+#include "tree_sitter/elm/summary.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The result of summarizing one file. `source` holds the file contents so
+ * that names can be sliced out of it using the summary's byte ranges.
+ * `error` is an errno value if the file could not be read, and 0 otherwise.
+ */
+typedef struct {
+    char *source;
+    uint32_t length;
+    TSElmSummary summary;
+    int error;
+} TSElmFileSummary;
+
+/**
+ * Read, parse and summarize a single file with the given parser, which must
+ * have the Elm language set. Hosts with their own thread pools can keep one
+ * parser per thread and call this directly.
+ */
+void ts_elm_summarize_file(TSParser *parser, const char *path,
+                           TSElmFileSummary *result);
+
+/**
+ * Read, parse and summarize `count` files on up to `thread_count` threads,
+ * or one thread per online CPU if `thread_count` is 0. Every thread owns its
+ * own parser, and no locks are taken while parsing, so the call can run with
+ * a language runtime's global lock released. `results` must have room for
+ * `count` entries.
+ */
+void ts_elm_summarize_files(const char *const *paths, uint32_t count,
+                            uint32_t thread_count, TSElmFileSummary *results);
+
+/**
+ * Pick up to `chunk_count` chunks of about equal size for parsing `source`
+ * in parts. Each chunk after the first starts at a line that starts a
+ * top-level declaration or annotation in column 0, outside comments,
+ * strings and GLSL blocks. There the layout scanner is in its initial
+ * state, so a chunk parses like a file of its own. Writes the start bytes
+ * to `starts`, the first one is 0, and returns how many it found, which is
+ * fewer than `chunk_count` if the source has fewer such lines.
+ */
+uint32_t ts_elm_chunk_source(const char *source, uint32_t length,
+                             uint32_t chunk_count, uint32_t *starts);
+
+/**
+ * Summarize one large source by parsing chunks of at least
+ * `min_chunk_size` bytes, or 64 KiB if it is 0, on up to `thread_count`
+ * threads, or one per online CPU if it is 0. Positions in the result are
+ * relative to the whole source.
+ *
+ * A syntax error can make a chunk boundary fall where a whole-file parse
+ * would not put one, so if any chunk has an error the source is parsed
+ * again as a whole on the calling thread. The result always matches
+ * `ts_elm_summary_build` on a sequential parse. Returns false if memory
+ * could not be allocated, in which case `result` is left empty.
+ */
+bool ts_elm_summarize_source(const char *source, uint32_t length,
+                             uint32_t thread_count, uint32_t min_chunk_size,
+                             TSElmSummary *result);
+
+/**
+ * Free the source and summary owned by a result.
+ */
+void ts_elm_file_summary_delete(TSElmFileSummary *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_BATCH_H_
@@ -0,0 +1,94 @@
+#ifndef TREE_SITTER_ELM_BIN_OP_H_
+#define TREE_SITTER_ELM_BIN_OP_H_
+
+#include "tree_sitter/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Marks a missing operand in a binary operator node.
+ */
+#define TS_ELM_BIN_OP_NONE UINT32_MAX
+
+typedef enum {
+    TSElmAssociativityLeft,
+    TSElmAssociativityRight,
+    TSElmAssociativityNone,
+} TSElmAssociativity;
+
+/**
+ * The associativity and precedence of the operators in scope, used to give
+ * the flat operand and operator list of a `bin_op_expr` its structure.
+ */
+typedef struct TSElmOperators TSElmOperators;
+
+/**
+ * A node of the tree built from a `bin_op_expr`, as five uint32 values like
+ * `TSElmFlatNode`. A leaf is an operand and has no `left` or `right`, any
+ * other node applies an operator to its `left` and `right` nodes. `child` is
+ * the index of the operand or the `operator` among the children of the
+ * `bin_op_expr`, the byte range spans the whole subexpression.
+ */
+typedef struct {
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t child;
+    uint32_t left;
+    uint32_t right;
+} TSElmBinOpNode;
+
+/**
+ * Create a table with the operators of elm/core, and those of elm/parser
+ * and elm/url, which the grammar also knows.
+ */
+TSElmOperators *ts_elm_operators_new(void);
+
+void ts_elm_operators_delete(TSElmOperators *self);
+
+/**
+ * Add an operator or change an existing one. Returns false if `name` is
+ * longer than any Elm operator or the table is full, it holds twice as many
+ * operators as the grammar knows.
+ */
+bool ts_elm_operators_set(TSElmOperators *self, const char *name,
+                          uint32_t length, TSElmAssociativity associativity,
+                          uint32_t precedence);
+
+/**
+ * Look up an operator. Returns false if it is not in the table, the
+ * associativity and precedence are then those used for unknown operators,
+ * left and 9.
+ */
+bool ts_elm_operators_get(const TSElmOperators *self, const char *name,
+                          uint32_t length, TSElmAssociativity *associativity,
+                          uint32_t *precedence);
+
+/**
+ * Add the operators declared by the `infix_declaration`s among the
+ * children of `root`, the root node of a tree parsed from `source`.
+ * Returns the number of declarations read.
+ */
+uint32_t ts_elm_operators_read_declarations(TSElmOperators *self, TSNode root,
+                                            const char *source);
+
+/**
+ * Write the tree of the `bin_op_expr` node `expr`, parsed from `source`,
+ * into `nodes`. Children come before their parents, so the root is the
+ * last node. `capacity` is the length of `nodes`,
+ * `ts_node_named_child_count(expr)` is always enough. Returns the number of
+ * nodes written, or 0 if `expr` does not alternate operands and operators,
+ * if it chains non-associative operators or operators of the same
+ * precedence but different associativity, which Elm rejects, or if memory
+ * runs out.
+ */
+uint32_t ts_elm_bin_op_tree(const TSElmOperators *self, TSNode expr,
+                            const char *source, TSElmBinOpNode *nodes,
+                            uint32_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_BIN_OP_H_
@@ -0,0 +1,68 @@
+#ifndef TREE_SITTER_ELM_BUDGET_H_
+#define TREE_SITTER_ELM_BUDGET_H_
+
+#include "tree_sitter/api.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Limits on one parse. */
+typedef struct {
+    /** Stop after this many microseconds, or never if 0. */
+    uint64_t timeout_micros;
+    /**
+     * Stop once the value this points to is nonzero, if not NULL. It is read
+     * atomically, so another thread may set it during the parse.
+     */
+    const size_t *cancellation_flag;
+    /**
+     * Measure the time spent in the external scanner of `tree_sitter_elm()`.
+     * Parsers with another language report no scanner time.
+     */
+    bool time_scanner;
+} TSElmParseBudget;
+
+typedef enum {
+    TSElmParseCompleted,
+    TSElmParseTimedOut,
+    TSElmParseCancelled,
+} TSElmParseStatus;
+
+typedef struct {
+    TSElmParseStatus status;
+    /** How far into the input the parser got, all of it when completed. */
+    uint32_t bytes_consumed;
+    uint64_t total_nanos;
+    /**
+     * Time spent in the external scanner, when it was measured. The rest of
+     * `total_nanos` went to the lexer and the parse table.
+     */
+    uint64_t scanner_nanos;
+    uint64_t scanner_calls;
+} TSElmParseMetrics;
+
+/**
+ * Parse `input` within `budget` through the runtime's progress callback,
+ * which it calls every few operations. Returns the tree when the parse
+ * completes, or NULL when it runs out of time or is cancelled, in which
+ * case `parser` is reset and `metrics` says how far it got.
+ */
+TSTree *ts_elm_parse_with_budget(TSParser *parser, const TSTree *old_tree,
+                                 TSInput input, const TSElmParseBudget *budget,
+                                 TSElmParseMetrics *metrics);
+
+/** `ts_elm_parse_with_budget` on a UTF-8 string. */
+TSTree *ts_elm_parse_string_with_budget(TSParser *parser,
+                                        const TSTree *old_tree,
+                                        const char *source, uint32_t length,
+                                        const TSElmParseBudget *budget,
+                                        TSElmParseMetrics *metrics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_BUDGET_H_
@@ -0,0 +1,109 @@
+#ifndef TREE_SITTER_ELM_DECLARATION_HASHES_H_
+#define TREE_SITTER_ELM_DECLARATION_HASHES_H_
+
+#include "tree_sitter/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Marks a missing declaration index in a change.
+ */
+#define TS_ELM_DECLARATION_NONE UINT32_MAX
+
+/**
+ * A top-level declaration and a hash of its structure: the node types and
+ * the text of the tokens, without comments and whitespace. A value
+ * declaration includes the type annotation right before it. Declarations
+ * are identified across versions by `symbol` and `name_hash`.
+ */
+typedef struct {
+    TSSymbol symbol;
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t name_start_byte;
+    uint32_t name_end_byte;
+    /** 64-bit FNV-1a hash of the name. */
+    uint64_t name_hash;
+    /** 64-bit FNV-1a hash of the structure. */
+    uint64_t hash;
+} TSElmDeclarationHash;
+
+typedef enum {
+    TSElmDeclarationAdded,
+    TSElmDeclarationRemoved,
+    TSElmDeclarationChanged,
+} TSElmDeclarationChangeKind;
+
+/**
+ * A declaration that was added, removed or changed by an update. `current`
+ * indexes the declarations after the update, `previous` those before it,
+ * either is `TS_ELM_DECLARATION_NONE` when the declaration is missing there.
+ */
+typedef struct {
+    TSElmDeclarationChangeKind kind;
+    uint32_t current;
+    uint32_t previous;
+} TSElmDeclarationChange;
+
+/**
+ * The declaration hashes of one document, kept between versions so that an
+ * edit only rehashes the declarations it touched.
+ */
+typedef struct TSElmDeclarationHashes TSElmDeclarationHashes;
+
+TSElmDeclarationHashes *ts_elm_declaration_hashes_new(void);
+
+void ts_elm_declaration_hashes_delete(TSElmDeclarationHashes *self);
+
+/**
+ * Hash every declaration of the tree rooted at `root`, dropping what
+ * `self` held before. Returns false if memory runs out.
+ */
+bool ts_elm_declaration_hashes_reset(TSElmDeclarationHashes *self, TSNode root,
+                                     const char *source);
+
+/**
+ * Bring `self` from `old_tree` to `new_tree`, where `old_tree` is the tree
+ * it was last reset or updated with, after `ts_tree_edit` was applied to it
+ * with `edits`, and `new_tree` was parsed from it.
+ *
+ * Declarations outside the edits and `ts_tree_get_changed_ranges` keep
+ * their hashes, only the others are hashed again. The differences are
+ * available from `ts_elm_declaration_hashes_changes`. Returns false if
+ * memory runs out, which leaves `self` empty.
+ */
+bool ts_elm_declaration_hashes_update(TSElmDeclarationHashes *self,
+                                      const TSTree *old_tree,
+                                      const TSTree *new_tree,
+                                      const char *source,
+                                      const TSInputEdit *edits,
+                                      uint32_t edit_count);
+
+/** The declarations of the current version, in source order. */
+const TSElmDeclarationHash *ts_elm_declaration_hashes_items(
+    const TSElmDeclarationHashes *self, uint32_t *count);
+
+/**
+ * The declarations of the version before the last update, with positions
+ * in that version. Empty after a reset.
+ */
+const TSElmDeclarationHash *ts_elm_declaration_hashes_previous(
+    const TSElmDeclarationHashes *self, uint32_t *count);
+
+/**
+ * The changes made by the last update, removed declarations first, then
+ * added and changed ones in source order. Empty after a reset.
+ */
+const TSElmDeclarationChange *ts_elm_declaration_hashes_changes(
+    const TSElmDeclarationHashes *self, uint32_t *count);
+
+/** The number of declarations the last reset or update hashed. */
+uint32_t ts_elm_declaration_hashes_rehashed(const TSElmDeclarationHashes *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_DECLARATION_HASHES_H_
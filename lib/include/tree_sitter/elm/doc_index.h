@@ -0,0 +1,93 @@
+#ifndef TREE_SITTER_ELM_DOC_INDEX_H_
+#define TREE_SITTER_ELM_DOC_INDEX_H_
+
+#include "tree_sitter/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A top-level declaration and its doc comment, the `{-| -}` block comment
+ * right before it, or before its type annotation. The declaration range
+ * includes the annotation. Without a doc comment, the doc range is empty
+ * at the start of the declaration.
+ */
+typedef struct {
+    TSSymbol symbol;
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t name_start_byte;
+    uint32_t name_end_byte;
+    uint32_t doc_start_byte;
+    uint32_t doc_end_byte;
+} TSElmDocEntry;
+
+/** A name listed by `@docs`. */
+typedef struct {
+    uint32_t start_byte;
+    uint32_t end_byte;
+} TSElmDocName;
+
+/**
+ * One `@docs` line of the module comment. Its names are
+ * `names[first_name]` to `names[first_name + name_count - 1]` of
+ * `ts_elm_doc_index_names`. The heading is the text of the last markdown
+ * heading above the line, or empty at the start of the line.
+ */
+typedef struct {
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t heading_start_byte;
+    uint32_t heading_end_byte;
+    uint32_t first_name;
+    uint32_t name_count;
+} TSElmDocGroup;
+
+/**
+ * The doc comments of one file, found in one pass over the top-level nodes,
+ * with a hash table from declaration names to declarations so that hover
+ * does not search the tree.
+ */
+typedef struct TSElmDocIndex TSElmDocIndex;
+
+TSElmDocIndex *ts_elm_doc_index_new(void);
+
+void ts_elm_doc_index_delete(TSElmDocIndex *self);
+
+/**
+ * Index the tree rooted at `root`, parsed from `source`, dropping what
+ * `self` held before. The names are copied, so `source` is only read
+ * during the call. Returns false if memory runs out, which leaves `self`
+ * empty.
+ */
+bool ts_elm_doc_index_build(TSElmDocIndex *self, TSNode root, const char *source);
+
+/**
+ * The declaration named `name`, or NULL. The first one wins when broken
+ * code declares a name twice.
+ */
+const TSElmDocEntry *ts_elm_doc_index_find(const TSElmDocIndex *self, const char *name,
+                                           uint32_t length);
+
+/** Every top-level declaration, in source order. */
+const TSElmDocEntry *ts_elm_doc_index_entries(const TSElmDocIndex *self, uint32_t *count);
+
+/**
+ * The range of the module doc comment, the first doc comment after the
+ * module declaration. Returns false if there is none.
+ */
+bool ts_elm_doc_index_module_doc(const TSElmDocIndex *self, uint32_t *start_byte,
+                                 uint32_t *end_byte);
+
+/** The `@docs` lines of the module doc comment, in order. */
+const TSElmDocGroup *ts_elm_doc_index_groups(const TSElmDocIndex *self, uint32_t *count);
+
+/** The names of all `@docs` lines, in order. */
+const TSElmDocName *ts_elm_doc_index_names(const TSElmDocIndex *self, uint32_t *count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_DOC_INDEX_H_
@@ -0,0 +1,43 @@
+#ifndef TREE_SITTER_ELM_FLAT_H_
+#define TREE_SITTER_ELM_FLAT_H_
+
+#include "tree_sitter/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Marks a missing parent, child or sibling in a flat node.
+ */
+#define TS_ELM_FLAT_NONE UINT32_MAX
+
+/**
+ * A node of a flattened tree, as seven uint32 values so that the array can
+ * be read through a `Uint32Array` or any other plain integer view. Nodes are
+ * stored in pre-order, parent, child and sibling links are node indices.
+ */
+typedef struct {
+    uint32_t symbol;
+    uint32_t field_id;
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t parent;
+    uint32_t first_child;
+    uint32_t next_sibling;
+} TSElmFlatNode;
+
+/**
+ * Write the subtree of `root` into `nodes` in pre-order, skipping anonymous
+ * nodes if `named_only` is set. `capacity` is the length of `nodes`,
+ * `ts_node_descendant_count(root)` is always enough. Returns the number of
+ * nodes written, or 0 if memory for the walk could not be allocated.
+ */
+uint32_t ts_elm_flatten(TSNode root, bool named_only, TSElmFlatNode *nodes,
+                        uint32_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_FLAT_H_
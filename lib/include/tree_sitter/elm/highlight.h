@@ -0,0 +1,101 @@
+#ifndef TREE_SITTER_ELM_HIGHLIGHT_H_
+#define TREE_SITTER_ELM_HIGHLIGHT_H_
+
+#include "tree_sitter/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** A node captured by the highlights query. */
+typedef struct {
+    uint32_t start_byte;
+    uint32_t end_byte;
+    TSPoint start_point;
+    TSPoint end_point;
+    /** Capture id in the highlights query. */
+    uint32_t capture;
+} TSElmHighlight;
+
+/** A node to parse with another language, from the injections query. */
+typedef struct {
+    uint32_t start_byte;
+    uint32_t end_byte;
+    TSPoint start_point;
+    TSPoint end_point;
+    /** See `ts_elm_highlighter_injection_language`. */
+    uint32_t language;
+} TSElmInjection;
+
+/**
+ * Runs `queries/highlights.scm` and `queries/injections.scm` over the rows an
+ * editor shows. Results are computed per block of rows and the most
+ * recently used blocks are kept until the tree changes, so scrolling back
+ * and forth does not query the same rows again. After an edit only the
+ * blocks around it are queried again.
+ */
+typedef struct TSElmHighlighter TSElmHighlighter;
+
+/**
+ * Create a highlighter. The queries are borrowed and must outlive it, and
+ * `injections` may be NULL. Injection languages come from `#set!
+ * injection.language` properties and content from `@injection.content`.
+ */
+TSElmHighlighter *ts_elm_highlighter_new(const TSQuery *highlights,
+                                         const TSQuery *injections);
+
+void ts_elm_highlighter_delete(TSElmHighlighter *self);
+
+/**
+ * Highlight `tree` from now on and drop the cached blocks. The tree is
+ * borrowed and must stay alive while the highlighter uses it.
+ */
+void ts_elm_highlighter_set_tree(TSElmHighlighter *self, const TSTree *tree);
+
+/**
+ * Highlight `new_tree` from now on, where `old_tree` is the tree set before,
+ * after `ts_tree_edit` was applied to it with `edits`, and `new_tree` was
+ * parsed from it. Cached blocks away from the edits, from
+ * `ts_tree_get_changed_ranges` and from the top-level nodes around them are
+ * kept and moved to their new bytes. Blocks after an edit that adds or
+ * removes lines are dropped, their rows no longer line up.
+ */
+void ts_elm_highlighter_edit_tree(TSElmHighlighter *self,
+                                  const TSTree *old_tree,
+                                  const TSTree *new_tree,
+                                  const TSInputEdit *edits,
+                                  uint32_t edit_count);
+
+/**
+ * Collect the highlights and injections that overlap `[start_row, end_row)`,
+ * in document order. Returns false if memory runs out.
+ */
+bool ts_elm_highlighter_highlight_rows(TSElmHighlighter *self,
+                                       uint32_t start_row, uint32_t end_row);
+
+/** Like `ts_elm_highlighter_highlight_rows`, for `[start_byte, end_byte)`. */
+bool ts_elm_highlighter_highlight_bytes(TSElmHighlighter *self,
+                                        uint32_t start_byte,
+                                        uint32_t end_byte);
+
+/** The highlights found by the last call, valid until the next one. */
+const TSElmHighlight *ts_elm_highlighter_highlights(
+    const TSElmHighlighter *self, uint32_t *count);
+
+/** The injections found by the last call, valid until the next one. */
+const TSElmInjection *ts_elm_highlighter_injections(
+    const TSElmHighlighter *self, uint32_t *count);
+
+/** The number of distinct injection languages in the injections query. */
+uint32_t ts_elm_highlighter_injection_language_count(
+    const TSElmHighlighter *self);
+
+/** The name of an injection language, such as `glsl`. */
+const char *ts_elm_highlighter_injection_language(
+    const TSElmHighlighter *self, uint32_t language, uint32_t *length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_HIGHLIGHT_H_
@@ -0,0 +1,59 @@
+#ifndef TREE_SITTER_ELM_INPUT_H_
+#define TREE_SITTER_ELM_INPUT_H_
+
+#include "tree_sitter/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A file to parse with `ts_parser_parse` without first reading it into a
+ * string: either mapped into memory, or read in chunks into one buffer
+ * that is reused for the whole file.
+ */
+typedef struct TSElmFileInput TSElmFileInput;
+
+/**
+ * Map the file at `path` read-only. Returns NULL and stores an errno value
+ * in `error` if the file cannot be opened or mapped, or is larger than 4
+ * GiB.
+ */
+TSElmFileInput *ts_elm_file_input_map(const char *path, int *error);
+
+/**
+ * Read the file open as `fd` in chunks of `buffer_size` bytes, or 64 KiB if
+ * it is 0, through a single buffer. The parser rereads earlier bytes when
+ * it backtracks, so `fd` must be seekable, and it is read at offsets
+ * without moving its file position. The caller keeps ownership of `fd`,
+ * which must stay open while the input is used. Returns NULL and stores an
+ * errno value in `error` on failure, ESPIPE for pipes and sockets.
+ */
+TSElmFileInput *ts_elm_file_input_stream(int fd, uint32_t buffer_size,
+                                         int *error);
+
+/** The UTF-8 `TSInput` of the file, valid until the input is deleted. */
+TSInput ts_elm_file_input(TSElmFileInput *self);
+
+/** The length of the file in bytes. */
+uint32_t ts_elm_file_input_length(const TSElmFileInput *self);
+
+/**
+ * The contents of a mapped file, to slice node text out of with byte
+ * offsets, or NULL for a stream.
+ */
+const char *ts_elm_file_input_data(const TSElmFileInput *self);
+
+/**
+ * The errno value of a read that failed while parsing from a stream, which
+ * ends the input early, or 0.
+ */
+int ts_elm_file_input_error(const TSElmFileInput *self);
+
+void ts_elm_file_input_delete(TSElmFileInput *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_INPUT_H_
@@ -0,0 +1,85 @@
+#ifndef TREE_SITTER_ELM_LINE_INDEX_H_
+#define TREE_SITTER_ELM_LINE_INDEX_H_
+
+#include "tree_sitter/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * An LSP `Position`: a zero-based line and a character offset in UTF-16
+ * code units.
+ */
+typedef struct {
+    uint32_t line;
+    uint32_t character;
+} TSElmPosition;
+
+/**
+ * The line starts of a UTF-8 document and whether each line is ASCII only,
+ * for converting between byte offsets, tree-sitter points and LSP
+ * positions. Lines end at `\n`, as tree-sitter rows do, and a `\r` before
+ * it is not part of the line for LSP positions.
+ *
+ * The index does not keep the source, functions that need the text of a
+ * line take the current source as an argument.
+ */
+typedef struct TSElmLineIndex TSElmLineIndex;
+
+TSElmLineIndex *ts_elm_line_index_new(void);
+
+void ts_elm_line_index_delete(TSElmLineIndex *self);
+
+/**
+ * Index `source`, dropping what `self` held before. Returns false if memory
+ * runs out, which leaves `self` empty.
+ */
+bool ts_elm_line_index_reset(TSElmLineIndex *self, const char *source,
+                             uint32_t length);
+
+/**
+ * Bring `self` up to date after `edit`, where `source` is the text after
+ * the edit. Only the lines from the edit's start to the end of the line
+ * holding its new end are scanned, the later ones are moved. Returns false
+ * if memory runs out, which leaves `self` empty.
+ */
+bool ts_elm_line_index_edit(TSElmLineIndex *self, const char *source,
+                            uint32_t length, const TSInputEdit *edit);
+
+uint32_t ts_elm_line_index_line_count(const TSElmLineIndex *self);
+
+/** The tree-sitter point of a byte offset, the column in bytes. */
+TSPoint ts_elm_line_index_point(const TSElmLineIndex *self, uint32_t byte);
+
+/**
+ * The LSP position of a byte offset. Finding the line takes O(log n), the
+ * character needs no scan on ASCII lines and a scan of the line up to
+ * `byte` otherwise.
+ */
+TSElmPosition ts_elm_line_index_position(const TSElmLineIndex *self,
+                                         const char *source, uint32_t byte);
+
+/**
+ * The byte offset of an LSP position. Positions past the end of a line are
+ * clamped to it, and lines past the end of the document to its length.
+ */
+uint32_t ts_elm_line_index_byte(const TSElmLineIndex *self, const char *source,
+                                TSElmPosition position);
+
+/**
+ * Turn an LSP `TextDocumentContentChangeEvent` replacing `[start, end)` with
+ * `text` into the edit to pass to `ts_tree_edit`, computed on the source
+ * before the change. Once the text is replaced, pass the same edit and the
+ * new source to `ts_elm_line_index_edit`.
+ */
+TSInputEdit ts_elm_line_index_change(const TSElmLineIndex *self,
+                                     const char *source, TSElmPosition start,
+                                     TSElmPosition end, const char *text,
+                                     uint32_t text_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_LINE_INDEX_H_
@@ -0,0 +1,72 @@
+#ifndef TREE_SITTER_ELM_OUTLINE_H_
+#define TREE_SITTER_ELM_OUTLINE_H_
+
+#include "tree_sitter/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Marks a top-level symbol, which has no parent.
+ */
+#define TS_ELM_OUTLINE_NONE UINT32_MAX
+
+/**
+ * What an outline symbol is. Values and functions are the same in Elm,
+ * `TSElmOutlineFunction` is any top-level `value_declaration`.
+ */
+typedef enum {
+    TSElmOutlineFunction,
+    TSElmOutlineType,
+    TSElmOutlineVariant,
+    TSElmOutlineTypeAlias,
+    TSElmOutlineField,
+    TSElmOutlinePort,
+    TSElmOutlineLetFunction,
+} TSElmOutlineKind;
+
+/**
+ * A symbol of the document outline, as six uint32 values like
+ * `TSElmFlatNode`. Symbols are in pre-order and `parent` is the index of
+ * the enclosing symbol: the type of a `union_variant`, the type alias of a
+ * record field, the function a `let_in_expr` binding is declared in. The
+ * name range is empty when broken code has no name.
+ */
+typedef struct {
+    uint32_t kind;
+    uint32_t parent;
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t name_start_byte;
+    uint32_t name_end_byte;
+} TSElmOutlineSymbol;
+
+/**
+ * The outline of a document: top-level values, types with their variants,
+ * type aliases with the fields of their record type, ports and the
+ * functions bound in `let` expressions, at any depth.
+ */
+typedef struct {
+    TSElmOutlineSymbol *symbols;
+    uint32_t count;
+    uint32_t capacity;
+} TSElmOutline;
+
+/**
+ * Fill `self` from the root node of an Elm tree in one walk, reusing the
+ * array it already holds. Start from a zeroed outline. Returns false if
+ * memory runs out, in which case `self` is left empty.
+ */
+bool ts_elm_outline_build(TSElmOutline *self, TSNode root);
+
+/**
+ * Free the array owned by an outline.
+ */
+void ts_elm_outline_delete(TSElmOutline *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_OUTLINE_H_
@@ -0,0 +1,120 @@
+#ifndef TREE_SITTER_ELM_SEMANTIC_TOKENS_H_
+#define TREE_SITTER_ELM_SEMANTIC_TOKENS_H_
+
+#include "tree_sitter/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maps highlight captures to an LSP token type and modifier set. `capture`
+ * is a dotted prefix: `keyword` matches `@keyword.control.elm`, and the
+ * longest matching prefix wins, so `keyword.operator` can refine it.
+ */
+typedef struct {
+    const char *capture;
+    uint32_t token_type;
+    uint32_t token_modifiers;
+} TSElmTokenMapping;
+
+typedef struct TSElmSemanticTokens TSElmSemanticTokens;
+
+/**
+ * Compile a highlights query (normally `queries/highlights.scm`) and resolve
+ * its captures against `mappings`. Captures without a mapping are ignored, and
+ * so are text predicates such as `#eq?`.
+ * Returns NULL if the query does not compile, with the error details stored
+ * in `error_offset` and `error_type`.
+ */
+TSElmSemanticTokens *ts_elm_semantic_tokens_new(
+    const char *query_source, uint32_t query_length,
+    const TSElmTokenMapping *mappings, uint32_t mapping_count,
+    uint32_t *error_offset, TSQueryError *error_type);
+
+void ts_elm_semantic_tokens_delete(TSElmSemanticTokens *self);
+
+/**
+ * Run the query over `[start_byte, end_byte)` of a tree parsed from `source`
+ * and write the LSP delta encoding (line, start character, length, type,
+ * modifiers) into `data`. Columns and lengths are in UTF-16 code units,
+ * tokens spanning several lines are split per line, and nested captures are
+ * split so that the innermost one wins. Positions are relative to the start
+ * of the document, as `textDocument/semanticTokens/range` expects.
+ *
+ * Returns the number of integers the full encoding needs. Only the first
+ * `capacity` of them are written, so a result above `capacity` means the
+ * call should be repeated with a larger buffer.
+ *
+ * An encoder keeps scratch state and must not be shared between threads.
+ */
+uint32_t ts_elm_semantic_tokens_encode(TSElmSemanticTokens *self, TSNode root,
+                                       const char *source, uint32_t start_byte,
+                                       uint32_t end_byte, uint32_t *data,
+                                       uint32_t capacity);
+
+/**
+ * The tokens of one document, kept between versions so that an edit only
+ * re-runs the query around the text it touched.
+ */
+typedef struct TSElmSemanticTokensCache TSElmSemanticTokensCache;
+
+/**
+ * One LSP `SemanticTokensEdit`: replace `delete_count` integers at `start` of
+ * the previous data with `data_count` integers at `data_start` of the current
+ * data, see `ts_elm_semantic_tokens_cache_data`.
+ */
+typedef struct {
+    uint32_t start;
+    uint32_t delete_count;
+    uint32_t data_start;
+    uint32_t data_count;
+} TSElmSemanticTokensEdit;
+
+TSElmSemanticTokensCache *ts_elm_semantic_tokens_cache_new(void);
+
+void ts_elm_semantic_tokens_cache_delete(TSElmSemanticTokensCache *self);
+
+/**
+ * Encode the whole document into `cache`, dropping what it held before.
+ * Returns false if memory runs out.
+ */
+bool ts_elm_semantic_tokens_cache_reset(TSElmSemanticTokens *self,
+                                        TSElmSemanticTokensCache *cache,
+                                        TSNode root, const char *source,
+                                        uint32_t length);
+
+/**
+ * Bring `cache` from `old_tree` to `new_tree`, where `old_tree` is the tree
+ * the cache was last reset or updated with, after `ts_tree_edit` was applied
+ * to it with `edits`, and `new_tree` was parsed from it.
+ *
+ * Only the lines touched by the edits or by `ts_tree_get_changed_ranges`
+ * are highlighted again, widened to the top-level declarations around them.
+ * The resulting edits are available from `ts_elm_semantic_tokens_cache_edits`.
+ * Returns false if memory runs out, which leaves the cache empty.
+ */
+bool ts_elm_semantic_tokens_cache_update(TSElmSemanticTokens *self,
+                                         TSElmSemanticTokensCache *cache,
+                                         const TSTree *old_tree,
+                                         const TSTree *new_tree,
+                                         const char *source, uint32_t length,
+                                         const TSInputEdit *edits,
+                                         uint32_t edit_count);
+
+/** The LSP `data` of the current version, `*length` integers long. */
+const uint32_t *ts_elm_semantic_tokens_cache_data(
+    const TSElmSemanticTokensCache *self, uint32_t *length);
+
+/**
+ * The edits from the previous version to the current one, sorted and not
+ * overlapping. Empty after a reset.
+ */
+const TSElmSemanticTokensEdit *ts_elm_semantic_tokens_cache_edits(
+    const TSElmSemanticTokensCache *self, uint32_t *count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_SEMANTIC_TOKENS_H_
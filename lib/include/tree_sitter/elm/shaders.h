@@ -0,0 +1,66 @@
+#ifndef TREE_SITTER_ELM_SHADERS_H_
+#define TREE_SITTER_ELM_SHADERS_H_
+
+#include "tree_sitter/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The `glsl_content` of a `[glsl| ... |]` block. */
+typedef struct {
+    uint32_t start_byte;
+    uint32_t end_byte;
+    TSPoint start_point;
+    TSPoint end_point;
+    /** 64-bit FNV-1a hash of the content. */
+    uint64_t hash;
+} TSElmShader;
+
+/**
+ * Finds the shader blocks of an Elm tree and parses them with another
+ * language only when asked to, typically when they scroll into view.
+ * Shader trees are cached by content, so a shader that did not change
+ * between two versions of a file is not parsed again, and identical shaders
+ * share a tree.
+ */
+typedef struct TSElmShaders TSElmShaders;
+
+/** Create a driver that parses shaders with `language`, such as GLSL. */
+TSElmShaders *ts_elm_shaders_new(const TSLanguage *language);
+
+void ts_elm_shaders_delete(TSElmShaders *self);
+
+/**
+ * Record the shader blocks of `tree`, parsed from `source`. This looks for
+ * `[glsl|` in the source instead of walking the tree. `source` is borrowed
+ * until the next call. Cached trees whose content is no longer in the file
+ * are freed. Returns false if memory runs out.
+ */
+bool ts_elm_shaders_set_tree(TSElmShaders *self, const TSTree *tree,
+                             const char *source, uint32_t length);
+
+/** The shader blocks found by the last `ts_elm_shaders_set_tree`. */
+const TSElmShader *ts_elm_shaders_ranges(const TSElmShaders *self,
+                                         uint32_t *count);
+
+/**
+ * The tree of a shader, parsed now unless its content is cached. Positions
+ * are relative to the start of the shader. The tree is owned by the driver
+ * and lives until the shader's content leaves the file. Returns NULL if the
+ * shader could not be parsed.
+ */
+const TSTree *ts_elm_shaders_tree(TSElmShaders *self, uint32_t index);
+
+/**
+ * Parse the shaders that overlap `[start_row, end_row)` and are not cached
+ * yet. Returns the number of shaders parsed by this call.
+ */
+uint32_t ts_elm_shaders_parse_rows(TSElmShaders *self, uint32_t start_row,
+                                   uint32_t end_row);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_SHADERS_H_
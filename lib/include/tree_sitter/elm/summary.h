@@ -0,0 +1,62 @@
+#ifndef TREE_SITTER_ELM_SUMMARY_H_
+#define TREE_SITTER_ELM_SUMMARY_H_
+
+#include "tree_sitter/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A top-level declaration: `value_declaration`, `type_declaration`,
+ * `type_alias_declaration`, `port_annotation` or `infix_declaration`.
+ * `symbol` is the node's symbol id, the name range covers the declared
+ * identifier (or the whole pattern of a destructuring declaration).
+ */
+typedef struct {
+    TSSymbol symbol;
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t name_start_byte;
+    uint32_t name_end_byte;
+    TSPoint start_point;
+} TSElmDeclaration;
+
+/**
+ * An `import_clause`, with the byte range of its `moduleName`.
+ */
+typedef struct {
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t name_start_byte;
+    uint32_t name_end_byte;
+} TSElmImport;
+
+/**
+ * The compact per-file result of the batch helpers: top-level declarations,
+ * imports and whether the tree contains errors.
+ */
+typedef struct {
+    TSElmDeclaration *declarations;
+    uint32_t declaration_count;
+    TSElmImport *imports;
+    uint32_t import_count;
+    bool has_error;
+} TSElmSummary;
+
+/**
+ * Fill `self` from the root node of an Elm tree. Returns false if memory
+ * could not be allocated, in which case `self` is left empty.
+ */
+bool ts_elm_summary_build(TSElmSummary *self, TSNode root);
+
+/**
+ * Free the arrays owned by a summary.
+ */
+void ts_elm_summary_delete(TSElmSummary *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_ELM_SUMMARY_H_
@@ -0,0 +1,398 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "tree_sitter/elm/batch.h"
+#include "symbols.h"
+#include "thread.h"
+
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_THREADS 256
+#define DEFAULT_MIN_CHUNK_SIZE (64 * 1024)
+#define CHUNKS_PER_THREAD 4
+
+typedef struct {
+    const char *const *paths;
+    TSElmFileSummary *results;
+    uint32_t count;
+    atomic_uint next;
+} Batch;
+
+static int read_file(const char *path, char **source, uint32_t *length) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return errno;
+    }
+
+    int error = 0;
+    char *data = NULL;
+    size_t size = 0;
+    size_t capacity = 0;
+    while (true) {
+        if (size == capacity) {
+            capacity = capacity == 0 ? 16384 : capacity * 2;
+            char *grown = realloc(data, capacity);
+            if (grown == NULL) {
+                error = ENOMEM;
+                break;
+            }
+            data = grown;
+        }
+        size += fread(data + size, 1, capacity - size, file);
+        if (ferror(file)) {
+            error = EIO;
+            break;
+        }
+        if (feof(file)) {
+            break;
+        }
+    }
+    fclose(file);
+
+    if (error == 0 && size > UINT32_MAX) {
+        error = EFBIG;
+    }
+    if (error != 0) {
+        free(data);
+        return error;
+    }
+
+    *source = data;
+    *length = (uint32_t)size;
+    return 0;
+}
+
+void ts_elm_summarize_file(TSParser *parser, const char *path,
+                           TSElmFileSummary *result) {
+    memset(result, 0, sizeof(*result));
+    result->error = read_file(path, &result->source, &result->length);
+    if (result->error != 0) {
+        return;
+    }
+
+    TSTree *tree =
+        ts_parser_parse_string(parser, NULL, result->source, result->length);
+    if (!ts_elm_summary_build(&result->summary, ts_tree_root_node(tree))) {
+        result->error = ENOMEM;
+    }
+    ts_tree_delete(tree);
+}
+
+static ELM_THREAD_FN(batch_worker, arg) {
+    Batch *batch = arg;
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, elm_language());
+
+    while (true) {
+        uint32_t index = atomic_fetch_add(&batch->next, 1);
+        if (index >= batch->count) {
+            break;
+        }
+        ts_elm_summarize_file(parser, batch->paths[index],
+                              &batch->results[index]);
+    }
+
+    ts_parser_delete(parser);
+    ELM_THREAD_RETURN;
+}
+
+// Run `worker` on up to `thread_count` threads, or one per online CPU if it
+// is 0, and at most `job_count` of them. The calling thread is one of the
+// workers, so a single-threaded run never spawns, and a failed spawn only
+// costs parallelism.
+static void run_workers(elm_thread_fn worker, void *arg, uint32_t thread_count,
+                        uint32_t job_count) {
+    if (thread_count == 0) {
+        thread_count = elm_cpu_count();
+    }
+    if (thread_count > job_count) {
+        thread_count = job_count;
+    }
+    if (thread_count > MAX_THREADS) {
+        thread_count = MAX_THREADS;
+    }
+
+    elm_thread_t threads[MAX_THREADS];
+    uint32_t started = 0;
+    while (started + 1 < thread_count &&
+           elm_thread_start(&threads[started], worker, arg)) {
+        started++;
+    }
+    worker(arg);
+    for (uint32_t i = 0; i < started; i++) {
+        elm_thread_join(threads[i]);
+    }
+}
+
+void ts_elm_summarize_files(const char *const *paths, uint32_t count,
+                            uint32_t thread_count, TSElmFileSummary *results) {
+    Batch batch = {.paths = paths, .results = results, .count = count};
+    atomic_init(&batch.next, 0);
+    run_workers(batch_worker, &batch, thread_count, count);
+}
+
+// Skip a string, character literal or comment starting at `i`, returning the
+// index after it. Single-line strings and literals also end at a newline, so
+// that an unterminated one does not hide the rest of the file.
+static uint32_t skip_string(const char *source, uint32_t length, uint32_t i,
+                            char quote, bool multiline) {
+    while (i < length) {
+        char c = source[i];
+        if (c == '\\') {
+            i += 2;
+        } else if (c == quote && (!multiline || (i + 2 < length &&
+                                                 source[i + 1] == quote &&
+                                                 source[i + 2] == quote))) {
+            return i + (multiline ? 3 : 1);
+        } else if (c == '\n' && !multiline) {
+            return i;
+        } else {
+            i++;
+        }
+    }
+    return length;
+}
+
+static uint32_t skip_block_comment(const char *source, uint32_t length,
+                                   uint32_t i) {
+    uint32_t depth = 1;
+    while (i + 1 < length) {
+        if (source[i] == '{' && source[i + 1] == '-') {
+            depth++;
+            i += 2;
+        } else if (source[i] == '-' && source[i + 1] == '}') {
+            i += 2;
+            if (--depth == 0) {
+                return i;
+            }
+        } else {
+            i++;
+        }
+    }
+    return length;
+}
+
+static bool has_prefix(const char *source, uint32_t length, uint32_t i,
+                       const char *prefix) {
+    size_t size = strlen(prefix);
+    return length - i >= size && memcmp(source + i, prefix, size) == 0;
+}
+
+// A top-level declaration or annotation starts with a lowercase name or
+// keyword. The module header and imports are left in the first chunk.
+static bool starts_declaration(const char *source, uint32_t length,
+                               uint32_t i) {
+    if (i == length || source[i] < 'a' || source[i] > 'z') {
+        return false;
+    }
+    static const char *const HEADER[] = {"import", "module", "port module",
+                                         "effect", "exposing"};
+    for (size_t k = 0; k < sizeof(HEADER) / sizeof(HEADER[0]); k++) {
+        if (has_prefix(source, length, i, HEADER[k])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t ts_elm_chunk_source(const char *source, uint32_t length,
+                             uint32_t chunk_count, uint32_t *starts) {
+    if (chunk_count == 0) {
+        return 0;
+    }
+    starts[0] = 0;
+    uint32_t count = 1;
+    uint32_t i = 0;
+    while (i < length && count < chunk_count) {
+        char c = source[i];
+        if (c == '\n') {
+            i++;
+            if (i >= (uint64_t)length * count / chunk_count &&
+                starts_declaration(source, length, i)) {
+                starts[count++] = i;
+            }
+        } else if (has_prefix(source, length, i, "{-")) {
+            i = skip_block_comment(source, length, i + 2);
+        } else if (has_prefix(source, length, i, "--")) {
+            const char *end = memchr(source + i, '\n', length - i);
+            i = end ? (uint32_t)(end - source) : length;
+        } else if (has_prefix(source, length, i, "\"\"\"")) {
+            i = skip_string(source, length, i + 3, '"', true);
+        } else if (c == '"' || c == '\'') {
+            i = skip_string(source, length, i + 1, c, false);
+        } else if (has_prefix(source, length, i, "[glsl|")) {
+            i += 6;
+            while (i < length && !has_prefix(source, length, i, "|]")) {
+                i++;
+            }
+        } else {
+            i++;
+        }
+    }
+    return count;
+}
+
+typedef struct {
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t rows;
+    bool ok;
+    TSElmSummary summary;
+} Chunk;
+
+typedef struct {
+    const char *source;
+    Chunk *chunks;
+    uint32_t count;
+    atomic_uint next;
+} ChunkedSource;
+
+static ELM_THREAD_FN(chunk_worker, arg) {
+    ChunkedSource *chunked = arg;
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, elm_language());
+
+    while (true) {
+        uint32_t index = atomic_fetch_add(&chunked->next, 1);
+        if (index >= chunked->count) {
+            break;
+        }
+        Chunk *chunk = &chunked->chunks[index];
+        const char *text = chunked->source + chunk->start_byte;
+        uint32_t length = chunk->end_byte - chunk->start_byte;
+        TSTree *tree = ts_parser_parse_string(parser, NULL, text, length);
+        chunk->ok = ts_elm_summary_build(&chunk->summary, ts_tree_root_node(tree));
+        ts_tree_delete(tree);
+        const char *line = memchr(text, '\n', length);
+        while (line != NULL) {
+            chunk->rows++;
+            line++;
+            line = memchr(line, '\n', length - (uint32_t)(line - text));
+        }
+    }
+
+    ts_parser_delete(parser);
+    ELM_THREAD_RETURN;
+}
+
+// Concatenate the chunks' summaries, moving them to their place in the
+// source. Chunks start in column 0, so only the rows of points move.
+static bool merge_chunks(const Chunk *chunks, uint32_t count,
+                         TSElmSummary *result) {
+    uint32_t declaration_count = 0, import_count = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        declaration_count += chunks[i].summary.declaration_count;
+        import_count += chunks[i].summary.import_count;
+    }
+    memset(result, 0, sizeof(*result));
+    result->declarations = malloc((declaration_count ? declaration_count : 1) *
+                                  sizeof(TSElmDeclaration));
+    result->imports = malloc((import_count ? import_count : 1) * sizeof(TSElmImport));
+    if (result->declarations == NULL || result->imports == NULL) {
+        ts_elm_summary_delete(result);
+        return false;
+    }
+
+    uint32_t row = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const TSElmSummary *summary = &chunks[i].summary;
+        uint32_t offset = chunks[i].start_byte;
+        for (uint32_t j = 0; j < summary->declaration_count; j++) {
+            TSElmDeclaration declaration = summary->declarations[j];
+            declaration.start_byte += offset;
+            declaration.end_byte += offset;
+            declaration.name_start_byte += offset;
+            declaration.name_end_byte += offset;
+            declaration.start_point.row += row;
+            result->declarations[result->declaration_count++] = declaration;
+        }
+        for (uint32_t j = 0; j < summary->import_count; j++) {
+            TSElmImport import = summary->imports[j];
+            import.start_byte += offset;
+            import.end_byte += offset;
+            import.name_start_byte += offset;
+            import.name_end_byte += offset;
+            result->imports[result->import_count++] = import;
+        }
+        row += chunks[i].rows;
+    }
+    return true;
+}
+
+bool ts_elm_summarize_source(const char *source, uint32_t length,
+                             uint32_t thread_count, uint32_t min_chunk_size,
+                             TSElmSummary *result) {
+    if (thread_count == 0) {
+        thread_count = elm_cpu_count();
+    }
+    if (min_chunk_size == 0) {
+        min_chunk_size = DEFAULT_MIN_CHUNK_SIZE;
+    }
+    // A few chunks per thread even out declarations that parse slowly
+    uint32_t chunk_count = length / min_chunk_size;
+    if (chunk_count > thread_count * CHUNKS_PER_THREAD) {
+        chunk_count = thread_count * CHUNKS_PER_THREAD;
+    }
+
+    uint32_t *starts = NULL;
+    Chunk *chunks = NULL;
+    uint32_t count = 0;
+    bool ok = true;
+    if (chunk_count > 1) {
+        starts = malloc(chunk_count * sizeof(uint32_t));
+        ok = starts != NULL;
+        count = ok ? ts_elm_chunk_source(source, length, chunk_count, starts) : 0;
+    }
+
+    bool parsed = false;
+    if (count > 1) {
+        chunks = calloc(count, sizeof(Chunk));
+        ok = chunks != NULL;
+    }
+    if (ok && chunks != NULL) {
+        for (uint32_t i = 0; i < count; i++) {
+            chunks[i].start_byte = starts[i];
+            chunks[i].end_byte = i + 1 < count ? starts[i + 1] : length;
+        }
+        ChunkedSource chunked = {.source = source, .chunks = chunks, .count = count};
+        atomic_init(&chunked.next, 0);
+        run_workers(chunk_worker, &chunked, thread_count, count);
+
+        bool has_error = false;
+        for (uint32_t i = 0; i < count; i++) {
+            ok = ok && chunks[i].ok;
+            has_error = has_error || chunks[i].summary.has_error;
+        }
+        if (ok && !has_error) {
+            ok = merge_chunks(chunks, count, result);
+            parsed = true;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            ts_elm_summary_delete(&chunks[i].summary);
+        }
+    }
+    free(chunks);
+    free(starts);
+
+    if (ok && !parsed) {
+        TSParser *parser = ts_parser_new();
+        ts_parser_set_language(parser, elm_language());
+        TSTree *tree = ts_parser_parse_string(parser, NULL, source, length);
+        ok = ts_elm_summary_build(result, ts_tree_root_node(tree));
+        ts_tree_delete(tree);
+        ts_parser_delete(parser);
+    }
+    if (!ok) {
+        memset(result, 0, sizeof(*result));
+    }
+    return ok;
+}
+
+void ts_elm_file_summary_delete(TSElmFileSummary *self) {
+    free(self->source);
+    ts_elm_summary_delete(&self->summary);
+    memset(self, 0, sizeof(*self));
+}
@@ -0,0 +1,295 @@
+#include "tree_sitter/elm/bin_op.h"
+#include "symbols.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_OPERATOR_LENGTH 3
+#define MAX_OPERATORS 48
+#define UNKNOWN_PRECEDENCE 9
+
+// Operand and operator stacks up to this size live on the C stack.
+#define STACK_SIZE 32
+
+typedef struct {
+    char name[MAX_OPERATOR_LENGTH];
+    uint8_t length;
+    TSElmAssociativity associativity;
+    uint32_t precedence;
+} Operator;
+
+struct TSElmOperators {
+    Operator items[MAX_OPERATORS];
+    uint32_t count;
+};
+
+// The infix declarations of elm/core's Basics and List, elm/parser's Parser
+// and elm/url's Url.Parser.
+static const struct {
+    const char *name;
+    TSElmAssociativity associativity;
+    uint32_t precedence;
+} DEFAULT_OPERATORS[] = {
+    {"<|", TSElmAssociativityRight, 0}, {"|>", TSElmAssociativityLeft, 0},
+    {"||", TSElmAssociativityRight, 2}, {"&&", TSElmAssociativityRight, 3},
+    {"==", TSElmAssociativityNone, 4},  {"/=", TSElmAssociativityNone, 4},
+    {"<", TSElmAssociativityNone, 4},   {">", TSElmAssociativityNone, 4},
+    {"<=", TSElmAssociativityNone, 4},  {">=", TSElmAssociativityNone, 4},
+    {"++", TSElmAssociativityRight, 5}, {"::", TSElmAssociativityRight, 5},
+    {"+", TSElmAssociativityLeft, 6},   {"-", TSElmAssociativityLeft, 6},
+    {"*", TSElmAssociativityLeft, 7},   {"/", TSElmAssociativityLeft, 7},
+    {"//", TSElmAssociativityLeft, 7},  {"^", TSElmAssociativityRight, 8},
+    {"<<", TSElmAssociativityLeft, 9},  {">>", TSElmAssociativityRight, 9},
+    {"|=", TSElmAssociativityLeft, 5},  {"|.", TSElmAssociativityLeft, 6},
+    {"</>", TSElmAssociativityRight, 7}, {"<?>", TSElmAssociativityLeft, 8},
+};
+
+static Operator *find(const TSElmOperators *self, const char *name,
+                      uint32_t length) {
+    for (uint32_t i = 0; i < self->count; i++) {
+        const Operator *entry = &self->items[i];
+        if (entry->length == length && memcmp(entry->name, name, length) == 0) {
+            return (Operator *)entry;
+        }
+    }
+    return NULL;
+}
+
+TSElmOperators *ts_elm_operators_new(void) {
+    TSElmOperators *self = calloc(1, sizeof(TSElmOperators));
+    if (self == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < sizeof(DEFAULT_OPERATORS) / sizeof(DEFAULT_OPERATORS[0]); i++) {
+        ts_elm_operators_set(self, DEFAULT_OPERATORS[i].name,
+                             (uint32_t)strlen(DEFAULT_OPERATORS[i].name),
+                             DEFAULT_OPERATORS[i].associativity,
+                             DEFAULT_OPERATORS[i].precedence);
+    }
+    return self;
+}
+
+void ts_elm_operators_delete(TSElmOperators *self) { free(self); }
+
+bool ts_elm_operators_set(TSElmOperators *self, const char *name,
+                          uint32_t length, TSElmAssociativity associativity,
+                          uint32_t precedence) {
+    if (length > MAX_OPERATOR_LENGTH) {
+        return false;
+    }
+    Operator *entry = find(self, name, length);
+    if (entry == NULL) {
+        if (self->count == MAX_OPERATORS) {
+            return false;
+        }
+        entry = &self->items[self->count++];
+        memcpy(entry->name, name, length);
+        entry->length = (uint8_t)length;
+    }
+    entry->associativity = associativity;
+    entry->precedence = precedence;
+    return true;
+}
+
+bool ts_elm_operators_get(const TSElmOperators *self, const char *name,
+                          uint32_t length, TSElmAssociativity *associativity,
+                          uint32_t *precedence) {
+    const Operator *entry = find(self, name, length);
+    *associativity = entry ? entry->associativity : TSElmAssociativityLeft;
+    *precedence = entry ? entry->precedence : UNKNOWN_PRECEDENCE;
+    return entry != NULL;
+}
+
+static bool has_text(TSNode node, const char *source, const char *text) {
+    uint32_t start = ts_node_start_byte(node);
+    uint32_t length = ts_node_end_byte(node) - start;
+    return length == strlen(text) && memcmp(source + start, text, length) == 0;
+}
+
+uint32_t ts_elm_operators_read_declarations(TSElmOperators *self, TSNode root,
+                                            const char *source) {
+    const ElmSymbols *s = elm_symbols();
+    uint32_t count = 0;
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    bool more = ts_tree_cursor_goto_first_child(&cursor);
+    for (; more; more = ts_tree_cursor_goto_next_sibling(&cursor)) {
+        TSNode child = ts_tree_cursor_current_node(&cursor);
+        if (ts_node_symbol(child) != s->infix_declaration) {
+            continue;
+        }
+        TSNode associativity_node =
+            ts_node_child_by_field_id(child, s->field_associativity);
+        TSNode precedence_node =
+            ts_node_child_by_field_id(child, s->field_precedence);
+        TSNode operator_node = ts_node_child_by_field_id(child, s->field_operator);
+        if (ts_node_is_null(associativity_node) ||
+            ts_node_is_null(precedence_node) || ts_node_is_null(operator_node)) {
+            continue;
+        }
+
+        TSElmAssociativity associativity;
+        if (has_text(associativity_node, source, "left")) {
+            associativity = TSElmAssociativityLeft;
+        } else if (has_text(associativity_node, source, "right")) {
+            associativity = TSElmAssociativityRight;
+        } else if (has_text(associativity_node, source, "non")) {
+            associativity = TSElmAssociativityNone;
+        } else {
+            continue;
+        }
+        uint32_t precedence = 0;
+        for (uint32_t i = ts_node_start_byte(precedence_node);
+             i < ts_node_end_byte(precedence_node); i++) {
+            if (source[i] < '0' || source[i] > '9') {
+                break;
+            }
+            precedence = precedence * 10 + (uint32_t)(source[i] - '0');
+        }
+
+        uint32_t start = ts_node_start_byte(operator_node);
+        if (ts_elm_operators_set(self, source + start,
+                                 ts_node_end_byte(operator_node) - start,
+                                 associativity, precedence)) {
+            count++;
+        }
+    }
+    ts_tree_cursor_delete(&cursor);
+    return count;
+}
+
+typedef struct {
+    uint32_t child;
+    TSElmAssociativity associativity;
+    uint32_t precedence;
+} PendingOperator;
+
+typedef struct {
+    TSElmBinOpNode *nodes;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t *operands;
+    uint32_t operand_count;
+    PendingOperator *operators;
+    uint32_t operator_count;
+} Builder;
+
+// Apply the topmost operator to the two topmost operands.
+static bool reduce(Builder *builder) {
+    if (builder->count == builder->capacity || builder->operand_count < 2) {
+        return false;
+    }
+    PendingOperator pending = builder->operators[--builder->operator_count];
+    uint32_t right = builder->operands[--builder->operand_count];
+    uint32_t left = builder->operands[builder->operand_count - 1];
+    uint32_t index = builder->count++;
+    builder->nodes[index] = (TSElmBinOpNode){
+        .start_byte = builder->nodes[left].start_byte,
+        .end_byte = builder->nodes[right].end_byte,
+        .child = pending.child,
+        .left = left,
+        .right = right,
+    };
+    builder->operands[builder->operand_count - 1] = index;
+    return true;
+}
+
+// Reduce the operators that bind tighter than `pending`, then push it.
+static bool push_operator(Builder *builder, PendingOperator pending) {
+    while (builder->operator_count > 0) {
+        const PendingOperator *top = &builder->operators[builder->operator_count - 1];
+        if (top->precedence < pending.precedence) {
+            break;
+        }
+        if (top->precedence == pending.precedence) {
+            if (top->associativity != pending.associativity ||
+                pending.associativity == TSElmAssociativityNone) {
+                return false;
+            }
+            if (pending.associativity == TSElmAssociativityRight) {
+                break;
+            }
+        }
+        if (!reduce(builder)) {
+            return false;
+        }
+    }
+    builder->operators[builder->operator_count++] = pending;
+    return true;
+}
+
+static bool push_operand(Builder *builder, TSNode node, uint32_t child) {
+    if (builder->count == builder->capacity) {
+        return false;
+    }
+    uint32_t index = builder->count++;
+    builder->nodes[index] = (TSElmBinOpNode){
+        .start_byte = ts_node_start_byte(node),
+        .end_byte = ts_node_end_byte(node),
+        .child = child,
+        .left = TS_ELM_BIN_OP_NONE,
+        .right = TS_ELM_BIN_OP_NONE,
+    };
+    builder->operands[builder->operand_count++] = index;
+    return true;
+}
+
+uint32_t ts_elm_bin_op_tree(const TSElmOperators *self, TSNode expr,
+                            const char *source, TSElmBinOpNode *nodes,
+                            uint32_t capacity) {
+    const ElmSymbols *s = elm_symbols();
+    if (ts_node_symbol(expr) != s->bin_op_expr) {
+        return 0;
+    }
+
+    // Operands and operators alternate, so neither stack outgrows the
+    // named children.
+    uint32_t bound = ts_node_named_child_count(expr);
+    uint32_t operand_buffer[STACK_SIZE];
+    PendingOperator operator_buffer[STACK_SIZE];
+    Builder builder = {
+        .nodes = nodes,
+        .capacity = capacity,
+        .operands = operand_buffer,
+        .operators = operator_buffer,
+    };
+    if (bound > STACK_SIZE) {
+        builder.operands = malloc(bound * sizeof(uint32_t));
+        builder.operators = malloc(bound * sizeof(PendingOperator));
+    }
+
+    bool ok = builder.operands != NULL && builder.operators != NULL;
+    bool expect_operand = true;
+    uint32_t child = 0;
+    TSTreeCursor cursor = ts_tree_cursor_new(expr);
+    bool more = ok && ts_tree_cursor_goto_first_child(&cursor);
+    for (; more && ok; more = ts_tree_cursor_goto_next_sibling(&cursor), child++) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        if (!ts_node_is_named(node) || ts_node_is_extra(node)) {
+            continue;
+        }
+        bool is_operator = ts_node_symbol(node) == s->operator_node;
+        if (is_operator == expect_operand) {
+            ok = false;
+        } else if (is_operator) {
+            uint32_t start = ts_node_start_byte(node);
+            PendingOperator pending = {.child = child};
+            ts_elm_operators_get(self, source + start, ts_node_end_byte(node) - start,
+                                 &pending.associativity, &pending.precedence);
+            ok = push_operator(&builder, pending);
+        } else {
+            ok = push_operand(&builder, node, child);
+        }
+        expect_operand = !expect_operand;
+    }
+    ts_tree_cursor_delete(&cursor);
+
+    ok = ok && !expect_operand;
+    while (ok && builder.operator_count > 0) {
+        ok = reduce(&builder);
+    }
+    if (bound > STACK_SIZE) {
+        free(builder.operands);
+        free(builder.operators);
+    }
+    return ok ? builder.count : 0;
+}
@@ -0,0 +1,108 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "tree_sitter/elm/budget.h"
+#include "timing.h"
+
+typedef struct {
+    const TSElmParseBudget *budget;
+    TSElmParseMetrics *metrics;
+    uint64_t deadline;
+} Progress;
+
+typedef struct {
+    const char *source;
+    uint32_t length;
+} StringInput;
+
+static size_t load_flag(const size_t *flag) {
+#ifdef _MSC_VER
+    return *(const volatile size_t *)flag;
+#else
+    return __atomic_load_n(flag, __ATOMIC_RELAXED);
+#endif
+}
+
+// Returns true to stop the parse.
+static bool check_progress(TSParseState *state) {
+    Progress *progress = state->payload;
+    TSElmParseMetrics *metrics = progress->metrics;
+    if (state->current_byte_offset > metrics->bytes_consumed) {
+        metrics->bytes_consumed = state->current_byte_offset;
+    }
+    const size_t *flag = progress->budget->cancellation_flag;
+    if (flag != NULL && load_flag(flag) != 0) {
+        metrics->status = TSElmParseCancelled;
+        return true;
+    }
+    if (progress->deadline != 0 && elm_nanos() >= progress->deadline) {
+        metrics->status = TSElmParseTimedOut;
+        return true;
+    }
+    return false;
+}
+
+TSTree *ts_elm_parse_with_budget(TSParser *parser, const TSTree *old_tree,
+                                 TSInput input, const TSElmParseBudget *budget,
+                                 TSElmParseMetrics *metrics) {
+    *metrics = (TSElmParseMetrics){.status = TSElmParseCompleted};
+    uint64_t start = elm_nanos();
+    if (budget->cancellation_flag != NULL && load_flag(budget->cancellation_flag) != 0) {
+        metrics->status = TSElmParseCancelled;
+        return NULL;
+    }
+
+    Progress progress = {budget, metrics, 0};
+    if (budget->timeout_micros != 0) {
+        progress.deadline = start + budget->timeout_micros * 1000;
+    }
+    TSParseOptions options = {.payload = &progress, .progress_callback = check_progress};
+
+    ElmScannerTiming timing = {elm_nanos, 0, 0};
+    if (budget->time_scanner) {
+        tree_sitter_elm_scanner_timing_begin(&timing);
+    }
+    TSTree *tree = ts_parser_parse_with_options(parser, old_tree, input, options);
+    if (budget->time_scanner) {
+        tree_sitter_elm_scanner_timing_end();
+    }
+
+    metrics->total_nanos = elm_nanos() - start;
+    metrics->scanner_nanos = timing.nanos;
+    metrics->scanner_calls = timing.calls;
+    if (tree == NULL) {
+        // Parsing from scratch next time instead of resuming this parse
+        ts_parser_reset(parser);
+        return NULL;
+    }
+    uint32_t end = ts_node_end_byte(ts_tree_root_node(tree));
+    if (end > metrics->bytes_consumed) {
+        metrics->bytes_consumed = end;
+    }
+    metrics->status = TSElmParseCompleted;
+    return tree;
+}
+
+static const char *read_string(void *payload, uint32_t byte, TSPoint position,
+                               uint32_t *bytes_read) {
+    StringInput *input = payload;
+    (void)position;
+    if (byte >= input->length) {
+        *bytes_read = 0;
+        return "";
+    }
+    *bytes_read = input->length - byte;
+    return input->source + byte;
+}
+
+TSTree *ts_elm_parse_string_with_budget(TSParser *parser,
+                                        const TSTree *old_tree,
+                                        const char *source, uint32_t length,
+                                        const TSElmParseBudget *budget,
+                                        TSElmParseMetrics *metrics) {
+    StringInput string = {source, length};
+    TSInput input = {0};
+    input.payload = &string;
+    input.read = read_string;
+    input.encoding = TSInputEncodingUTF8;
+    return ts_elm_parse_with_budget(parser, old_tree, input, budget, metrics);
+}
@@ -0,0 +1,409 @@
+#include "tree_sitter/elm/declaration_hashes.h"
+#include "symbols.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define FNV_OFFSET 0xcbf29ce484222325u
+#define FNV_PRIME 0x100000001b3u
+
+// Mixed in after the last child of a node, so that the hash follows the
+// shape of the tree and not only the order of its nodes.
+#define END_OF_CHILDREN UINT32_MAX
+
+typedef struct {
+    uint32_t start_byte;
+    uint32_t end_byte;
+} Range;
+
+// A previous declaration moved to the new source, `touched` if an edit
+// overlapped it.
+typedef struct {
+    uint32_t start_byte;
+    uint32_t end_byte;
+    bool touched;
+} Shifted;
+
+// A declaration's identity, sorted to pair up the two versions.
+typedef struct {
+    uint64_t name_hash;
+    TSSymbol symbol;
+    uint32_t index;
+} Key;
+
+typedef struct {
+    TSElmDeclarationHash *items;
+    uint32_t count;
+    uint32_t capacity;
+} List;
+
+struct TSElmDeclarationHashes {
+    List current;
+    List previous;
+    TSElmDeclarationChange *changes;
+    uint32_t change_count;
+    uint32_t change_capacity;
+    Shifted *shifted;
+    uint32_t shifted_capacity;
+    Range *ranges;
+    uint32_t range_capacity;
+    uint32_t rehashed;
+};
+
+static bool reserve(void **items, uint32_t *capacity, uint32_t count,
+                    size_t size) {
+    if (count <= *capacity) {
+        return true;
+    }
+    uint32_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < count) {
+        new_capacity *= 2;
+    }
+    void *new_items = realloc(*items, new_capacity * size);
+    if (new_items == NULL) {
+        return false;
+    }
+    *items = new_items;
+    *capacity = new_capacity;
+    return true;
+}
+
+static uint64_t mix_bytes(uint64_t hash, const char *bytes, uint32_t length) {
+    for (uint32_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static uint64_t mix_value(uint64_t hash, uint32_t value) {
+    for (int i = 0; i < 4; i++, value >>= 8) {
+        hash ^= value & 0xff;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Mix in the symbols of the subtree in pre-order and the text of its
+// leaves. Comments are extras and skipped with everything below them,
+// whitespace is between tokens and never read.
+static uint64_t hash_subtree(uint64_t hash, TSNode node, const char *source) {
+    TSTreeCursor cursor = ts_tree_cursor_new(node);
+    for (;;) {
+        TSNode current = ts_tree_cursor_current_node(&cursor);
+        if (!ts_node_is_extra(current)) {
+            hash = mix_value(hash, ts_node_symbol(current));
+            if (ts_node_child_count(current) == 0) {
+                uint32_t start = ts_node_start_byte(current);
+                uint32_t length = ts_node_end_byte(current) - start;
+                hash = mix_bytes(mix_value(hash, length), source + start, length);
+            } else if (ts_tree_cursor_goto_first_child(&cursor)) {
+                continue;
+            }
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                ts_tree_cursor_delete(&cursor);
+                return hash;
+            }
+            hash = mix_value(hash, END_OF_CHILDREN);
+        }
+    }
+}
+
+static bool overlaps(const Range *ranges, uint32_t count, uint32_t start_byte,
+                     uint32_t end_byte) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (ranges[i].start_byte <= end_byte && ranges[i].end_byte >= start_byte) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Fill the current list from the top-level children of `root`. With
+// `shifted`, a declaration that is outside `ranges` and sits exactly where
+// an untouched previous one moved to keeps that one's hash.
+static bool collect(TSElmDeclarationHashes *self, TSNode root,
+                    const char *source, const Shifted *shifted,
+                    const Range *ranges, uint32_t range_count) {
+    const ElmSymbols *s = elm_symbols();
+    List *list = &self->current;
+    list->count = 0;
+    self->rehashed = 0;
+    uint32_t previous = 0;
+    TSNode annotation = {0};
+    bool ok = true;
+
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    bool more = ts_tree_cursor_goto_first_child(&cursor);
+    for (; more && ok; more = ts_tree_cursor_goto_next_sibling(&cursor)) {
+        TSNode child = ts_tree_cursor_current_node(&cursor);
+        if (ts_node_is_extra(child)) {
+            continue;
+        }
+        TSSymbol symbol = ts_node_symbol(child);
+        if (symbol == s->type_annotation) {
+            annotation = child;
+            continue;
+        }
+        bool annotated = symbol == s->value_declaration && !ts_node_is_null(annotation);
+        annotation = (TSNode){0};
+        if (!elm_is_declaration(s, symbol)) {
+            continue;
+        }
+        if (!reserve((void **)&list->items, &list->capacity, list->count + 1,
+                     sizeof(TSElmDeclarationHash))) {
+            ok = false;
+            break;
+        }
+
+        TSNode name = elm_declaration_name(s, child);
+        TSElmDeclarationHash *item = &list->items[list->count++];
+        item->symbol = symbol;
+        item->start_byte = ts_node_start_byte(annotated ? annotation : child);
+        item->end_byte = ts_node_end_byte(child);
+        item->name_start_byte = ts_node_is_null(name) ? item->start_byte : ts_node_start_byte(name);
+        item->name_end_byte = ts_node_is_null(name) ? item->start_byte : ts_node_end_byte(name);
+        item->name_hash = mix_bytes(FNV_OFFSET, source + item->name_start_byte,
+                                    item->name_end_byte - item->name_start_byte);
+
+        if (shifted != NULL) {
+            while (previous < self->previous.count &&
+                   shifted[previous].start_byte < item->start_byte) {
+                previous++;
+            }
+            if (previous < self->previous.count && !shifted[previous].touched &&
+                shifted[previous].start_byte == item->start_byte &&
+                shifted[previous].end_byte == item->end_byte &&
+                !overlaps(ranges, range_count, item->start_byte, item->end_byte)) {
+                item->hash = self->previous.items[previous].hash;
+                continue;
+            }
+        }
+        item->hash = FNV_OFFSET;
+        if (annotated) {
+            item->hash = hash_subtree(item->hash, annotation, source);
+        }
+        item->hash = hash_subtree(item->hash, child, source);
+        self->rehashed++;
+    }
+    ts_tree_cursor_delete(&cursor);
+    return ok;
+}
+
+static int compare_names(const Key *left, const Key *right) {
+    if (left->symbol != right->symbol) {
+        return left->symbol < right->symbol ? -1 : 1;
+    }
+    if (left->name_hash != right->name_hash) {
+        return left->name_hash < right->name_hash ? -1 : 1;
+    }
+    return 0;
+}
+
+static int compare_keys(const void *a, const void *b) {
+    const Key *left = a;
+    const Key *right = b;
+    int order = compare_names(left, right);
+    if (order != 0) {
+        return order;
+    }
+    return left->index < right->index ? -1 : left->index > right->index;
+}
+
+static int compare_changes(const void *a, const void *b) {
+    const TSElmDeclarationChange *left = a;
+    const TSElmDeclarationChange *right = b;
+    bool left_removed = left->kind == TSElmDeclarationRemoved;
+    bool right_removed = right->kind == TSElmDeclarationRemoved;
+    if (left_removed != right_removed) {
+        return left_removed ? -1 : 1;
+    }
+    uint32_t left_index = left_removed ? left->previous : left->current;
+    uint32_t right_index = right_removed ? right->previous : right->current;
+    return left_index < right_index ? -1 : left_index > right_index;
+}
+
+static Key *sorted_keys(const List *list) {
+    Key *keys = malloc((list->count ? list->count : 1) * sizeof(Key));
+    if (keys == NULL) {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < list->count; i++) {
+        keys[i] = (Key){list->items[i].name_hash, list->items[i].symbol, i};
+    }
+    qsort(keys, list->count, sizeof(Key), compare_keys);
+    return keys;
+}
+
+static bool add_change(TSElmDeclarationHashes *self,
+                       TSElmDeclarationChangeKind kind, uint32_t current,
+                       uint32_t previous) {
+    if (!reserve((void **)&self->changes, &self->change_capacity,
+                 self->change_count + 1, sizeof(TSElmDeclarationChange))) {
+        return false;
+    }
+    self->changes[self->change_count++] =
+        (TSElmDeclarationChange){kind, current, previous};
+    return true;
+}
+
+// Pair the declarations of both versions by symbol and name, in order for
+// duplicates, and record the unpaired ones and the pairs whose hash differs.
+static bool diff(TSElmDeclarationHashes *self) {
+    Key *previous = sorted_keys(&self->previous);
+    Key *current = sorted_keys(&self->current);
+    bool ok = previous != NULL && current != NULL;
+    uint32_t i = 0, j = 0;
+    while (ok && (i < self->previous.count || j < self->current.count)) {
+        int order = i == self->previous.count  ? 1
+                    : j == self->current.count ? -1
+                                               : compare_names(&previous[i], &current[j]);
+        if (order < 0) {
+            ok = add_change(self, TSElmDeclarationRemoved, TS_ELM_DECLARATION_NONE,
+                            previous[i++].index);
+        } else if (order > 0) {
+            ok = add_change(self, TSElmDeclarationAdded, current[j++].index,
+                            TS_ELM_DECLARATION_NONE);
+        } else {
+            uint32_t old_index = previous[i++].index;
+            uint32_t new_index = current[j++].index;
+            if (self->previous.items[old_index].hash != self->current.items[new_index].hash) {
+                ok = add_change(self, TSElmDeclarationChanged, new_index, old_index);
+            }
+        }
+    }
+    free(previous);
+    free(current);
+    qsort(self->changes, self->change_count, sizeof(TSElmDeclarationChange),
+          compare_changes);
+    return ok;
+}
+
+static inline uint32_t shift_start(uint32_t byte, const TSInputEdit *edit) {
+    if (byte < edit->start_byte) {
+        return byte;
+    }
+    if (byte >= edit->old_end_byte) {
+        return byte - edit->old_end_byte + edit->new_end_byte;
+    }
+    return edit->start_byte;
+}
+
+static inline uint32_t shift_end(uint32_t byte, const TSInputEdit *edit) {
+    if (byte <= edit->start_byte) {
+        return byte;
+    }
+    if (byte >= edit->old_end_byte) {
+        return byte - edit->old_end_byte + edit->new_end_byte;
+    }
+    return edit->new_end_byte;
+}
+
+TSElmDeclarationHashes *ts_elm_declaration_hashes_new(void) {
+    return calloc(1, sizeof(TSElmDeclarationHashes));
+}
+
+void ts_elm_declaration_hashes_delete(TSElmDeclarationHashes *self) {
+    if (self == NULL) {
+        return;
+    }
+    free(self->current.items);
+    free(self->previous.items);
+    free(self->changes);
+    free(self->shifted);
+    free(self->ranges);
+    free(self);
+}
+
+bool ts_elm_declaration_hashes_reset(TSElmDeclarationHashes *self, TSNode root,
+                                     const char *source) {
+    self->previous.count = 0;
+    self->change_count = 0;
+    if (!collect(self, root, source, NULL, NULL, 0)) {
+        self->current.count = 0;
+        return false;
+    }
+    return true;
+}
+
+bool ts_elm_declaration_hashes_update(TSElmDeclarationHashes *self,
+                                      const TSTree *old_tree,
+                                      const TSTree *new_tree,
+                                      const char *source,
+                                      const TSInputEdit *edits,
+                                      uint32_t edit_count) {
+    List old = self->current;
+    self->current = self->previous;
+    self->previous = old;
+    self->change_count = 0;
+
+    uint32_t changed_count;
+    TSRange *changed = ts_tree_get_changed_ranges(old_tree, new_tree, &changed_count);
+    bool ok = reserve((void **)&self->ranges, &self->range_capacity,
+                      edit_count + changed_count + 1, sizeof(Range)) &&
+              reserve((void **)&self->shifted, &self->shifted_capacity,
+                      self->previous.count + 1, sizeof(Shifted));
+
+    // Move the previous declarations and the earlier edits through each edit
+    uint32_t range_count = 0;
+    for (uint32_t i = 0; ok && i < self->previous.count; i++) {
+        self->shifted[i] = (Shifted){self->previous.items[i].start_byte,
+                                     self->previous.items[i].end_byte, false};
+    }
+    for (uint32_t i = 0; ok && i < edit_count; i++) {
+        const TSInputEdit *edit = &edits[i];
+        for (uint32_t j = 0; j < self->previous.count; j++) {
+            Shifted *declaration = &self->shifted[j];
+            if (declaration->start_byte <= edit->old_end_byte &&
+                declaration->end_byte >= edit->start_byte) {
+                declaration->touched = true;
+            }
+            declaration->start_byte = shift_start(declaration->start_byte, edit);
+            declaration->end_byte = shift_end(declaration->end_byte, edit);
+        }
+        for (uint32_t j = 0; j < range_count; j++) {
+            self->ranges[j].start_byte = shift_start(self->ranges[j].start_byte, edit);
+            self->ranges[j].end_byte = shift_end(self->ranges[j].end_byte, edit);
+        }
+        self->ranges[range_count++] = (Range){edit->start_byte, edit->new_end_byte};
+    }
+    for (uint32_t i = 0; ok && i < changed_count; i++) {
+        self->ranges[range_count++] = (Range){changed[i].start_byte, changed[i].end_byte};
+    }
+    free(changed);
+
+    ok = ok &&
+         collect(self, ts_tree_root_node(new_tree), source, self->shifted,
+                 self->ranges, range_count) &&
+         diff(self);
+    if (!ok) {
+        self->current.count = 0;
+        self->previous.count = 0;
+        self->change_count = 0;
+    }
+    return ok;
+}
+
+const TSElmDeclarationHash *ts_elm_declaration_hashes_items(
+    const TSElmDeclarationHashes *self, uint32_t *count) {
+    *count = self->current.count;
+    return self->current.items;
+}
+
+const TSElmDeclarationHash *ts_elm_declaration_hashes_previous(
+    const TSElmDeclarationHashes *self, uint32_t *count) {
+    *count = self->previous.count;
+    return self->previous.items;
+}
+
+const TSElmDeclarationChange *ts_elm_declaration_hashes_changes(
+    const TSElmDeclarationHashes *self, uint32_t *count) {
+    *count = self->change_count;
+    return self->changes;
+}
+
+uint32_t ts_elm_declaration_hashes_rehashed(const TSElmDeclarationHashes *self) {
+    return self->rehashed;
+}
@@ -0,0 +1,352 @@
+#include "tree_sitter/elm/doc_index.h"
+#include "symbols.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define FNV_OFFSET 0xcbf29ce484222325u
+#define FNV_PRIME 0x100000001b3u
+
+struct TSElmDocIndex {
+    TSElmDocEntry *entries;
+    uint32_t entry_count;
+    uint32_t entry_capacity;
+    // The names of the entries back to back, entry i's at name_offsets[i]
+    char *names;
+    uint32_t names_length;
+    uint32_t names_capacity;
+    uint32_t *name_offsets;
+    uint32_t name_offset_capacity;
+    // Open addressing over the entries, a slot holds an entry index plus
+    // one and 0 when it is empty
+    uint32_t *slots;
+    uint32_t slot_capacity;
+    bool has_module_doc;
+    uint32_t module_doc_start_byte;
+    uint32_t module_doc_end_byte;
+    TSElmDocGroup *groups;
+    uint32_t group_count;
+    uint32_t group_capacity;
+    TSElmDocName *doc_names;
+    uint32_t doc_name_count;
+    uint32_t doc_name_capacity;
+};
+
+static bool reserve(void **items, uint32_t *capacity, uint32_t count,
+                    size_t size) {
+    if (count <= *capacity) {
+        return true;
+    }
+    uint32_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < count) {
+        new_capacity *= 2;
+    }
+    void *new_items = realloc(*items, new_capacity * size);
+    if (new_items == NULL) {
+        return false;
+    }
+    *items = new_items;
+    *capacity = new_capacity;
+    return true;
+}
+
+static uint64_t hash_name(const char *name, uint32_t length) {
+    uint64_t hash = FNV_OFFSET;
+    for (uint32_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)name[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static inline uint32_t name_length(const TSElmDocEntry *entry) {
+    return entry->name_end_byte - entry->name_start_byte;
+}
+
+static bool is_doc(const ElmSymbols *s, TSNode node, const char *source) {
+    return ts_node_symbol(node) == s->block_comment &&
+           ts_node_end_byte(node) - ts_node_start_byte(node) >= 3 &&
+           memcmp(source + ts_node_start_byte(node), "{-|", 3) == 0;
+}
+
+// A doc comment at the very end of `node`. The comment after a declaration
+// can end up inside it, depending on where the layout scanner ends it.
+static TSNode trailing_doc(const ElmSymbols *s, TSNode node, const char *source) {
+    uint32_t count;
+    while ((count = ts_node_child_count(node)) > 0) {
+        node = ts_node_child(node, count - 1);
+        if (is_doc(s, node, source)) {
+            return node;
+        }
+    }
+    return (TSNode){0};
+}
+
+static bool add_entry(TSElmDocIndex *self, TSSymbol symbol, TSNode start, TSNode node,
+                      TSNode name, TSNode doc, const char *source) {
+    if (!reserve((void **)&self->entries, &self->entry_capacity, self->entry_count + 1,
+                 sizeof(TSElmDocEntry)) ||
+        !reserve((void **)&self->name_offsets, &self->name_offset_capacity,
+                 self->entry_count + 1, sizeof(uint32_t))) {
+        return false;
+    }
+    TSElmDocEntry *entry = &self->entries[self->entry_count];
+    entry->symbol = symbol;
+    entry->start_byte = ts_node_start_byte(start);
+    entry->end_byte = ts_node_end_byte(node);
+    entry->name_start_byte = ts_node_is_null(name) ? entry->start_byte : ts_node_start_byte(name);
+    entry->name_end_byte = ts_node_is_null(name) ? entry->start_byte : ts_node_end_byte(name);
+    entry->doc_start_byte = ts_node_is_null(doc) ? entry->start_byte : ts_node_start_byte(doc);
+    entry->doc_end_byte = ts_node_is_null(doc) ? entry->start_byte : ts_node_end_byte(doc);
+
+    uint32_t length = name_length(entry);
+    // One more byte keeps `names` allocated for empty names
+    if (!reserve((void **)&self->names, &self->names_capacity,
+                 self->names_length + length + 1, 1)) {
+        return false;
+    }
+    memcpy(self->names + self->names_length, source + entry->name_start_byte, length);
+    self->name_offsets[self->entry_count++] = self->names_length;
+    self->names_length += length;
+    return true;
+}
+
+static bool build_table(TSElmDocIndex *self) {
+    uint32_t capacity = 16;
+    while (capacity < self->entry_count * 2) {
+        capacity *= 2;
+    }
+    if (capacity > self->slot_capacity) {
+        uint32_t *slots = realloc(self->slots, capacity * sizeof(uint32_t));
+        if (slots == NULL) {
+            return false;
+        }
+        self->slots = slots;
+        self->slot_capacity = capacity;
+    }
+    memset(self->slots, 0, self->slot_capacity * sizeof(uint32_t));
+
+    uint32_t mask = self->slot_capacity - 1;
+    for (uint32_t i = 0; i < self->entry_count; i++) {
+        const char *name = self->names + self->name_offsets[i];
+        uint32_t length = name_length(&self->entries[i]);
+        uint32_t slot = (uint32_t)hash_name(name, length) & mask;
+        for (;; slot = (slot + 1) & mask) {
+            uint32_t other = self->slots[slot];
+            if (other == 0) {
+                self->slots[slot] = i + 1;
+                break;
+            }
+            // Keep the first of duplicate names
+            if (name_length(&self->entries[other - 1]) == length &&
+                memcmp(self->names + self->name_offsets[other - 1], name, length) == 0) {
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+static inline bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+// Collect the `@docs` lines of the module comment between `start` and
+// `end`, the text between `{-|` and `-}`, with the markdown heading above
+// each.
+static bool parse_groups(TSElmDocIndex *self, const char *source, uint32_t start,
+                         uint32_t end) {
+    bool has_heading = false;
+    uint32_t heading_start = 0, heading_end = 0;
+    uint32_t line = start;
+    while (line < end) {
+        uint32_t line_end = line;
+        while (line_end < end && source[line_end] != '\n') {
+            line_end++;
+        }
+        uint32_t i = line;
+        while (i < line_end && is_blank(source[i])) {
+            i++;
+        }
+
+        if (i < line_end && source[i] == '#') {
+            while (i < line_end && (source[i] == '#' || is_blank(source[i]))) {
+                i++;
+            }
+            uint32_t text_end = line_end;
+            while (text_end > i && is_blank(source[text_end - 1])) {
+                text_end--;
+            }
+            has_heading = true;
+            heading_start = i;
+            heading_end = text_end;
+        } else if (line_end - i >= 5 && memcmp(source + i, "@docs", 5) == 0) {
+            if (!reserve((void **)&self->groups, &self->group_capacity, self->group_count + 1,
+                         sizeof(TSElmDocGroup))) {
+                return false;
+            }
+            TSElmDocGroup *group = &self->groups[self->group_count++];
+            group->start_byte = line;
+            group->end_byte = line_end;
+            group->heading_start_byte = has_heading ? heading_start : line;
+            group->heading_end_byte = has_heading ? heading_end : line;
+            group->first_name = self->doc_name_count;
+            group->name_count = 0;
+            // The names are separated by commas and blanks
+            for (i += 5; i < line_end;) {
+                if (source[i] == ',' || is_blank(source[i])) {
+                    i++;
+                    continue;
+                }
+                uint32_t name_start = i;
+                while (i < line_end && source[i] != ',' && !is_blank(source[i])) {
+                    i++;
+                }
+                if (!reserve((void **)&self->doc_names, &self->doc_name_capacity,
+                             self->doc_name_count + 1, sizeof(TSElmDocName))) {
+                    return false;
+                }
+                self->doc_names[self->doc_name_count++] = (TSElmDocName){name_start, i};
+                group->name_count++;
+            }
+        }
+        line = line_end + 1;
+    }
+    return true;
+}
+
+static void clear(TSElmDocIndex *self) {
+    self->entry_count = 0;
+    self->names_length = 0;
+    self->has_module_doc = false;
+    self->module_doc_start_byte = 0;
+    self->module_doc_end_byte = 0;
+    self->group_count = 0;
+    self->doc_name_count = 0;
+    if (self->slots != NULL) {
+        memset(self->slots, 0, self->slot_capacity * sizeof(uint32_t));
+    }
+}
+
+TSElmDocIndex *ts_elm_doc_index_new(void) {
+    return calloc(1, sizeof(TSElmDocIndex));
+}
+
+void ts_elm_doc_index_delete(TSElmDocIndex *self) {
+    if (self == NULL) {
+        return;
+    }
+    free(self->entries);
+    free(self->names);
+    free(self->name_offsets);
+    free(self->slots);
+    free(self->groups);
+    free(self->doc_names);
+    free(self);
+}
+
+bool ts_elm_doc_index_build(TSElmDocIndex *self, TSNode root, const char *source) {
+    const ElmSymbols *s = elm_symbols();
+    clear(self);
+    TSNode doc = {0};
+    TSNode annotation = {0};
+    // Set right after the module declaration, until anything but a doc
+    // comment follows it
+    bool module_doc_next = false;
+    bool ok = true;
+
+    // Walk with a cursor, `ts_node_child` rescans the siblings on every call.
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    bool more = ts_tree_cursor_goto_first_child(&cursor);
+    for (; more && ok; more = ts_tree_cursor_goto_next_sibling(&cursor)) {
+        TSNode child = ts_tree_cursor_current_node(&cursor);
+        TSSymbol symbol = ts_node_symbol(child);
+        if (is_doc(s, child, source)) {
+            if (module_doc_next) {
+                self->has_module_doc = true;
+                self->module_doc_start_byte = ts_node_start_byte(child);
+                self->module_doc_end_byte = ts_node_end_byte(child);
+                module_doc_next = false;
+            } else {
+                doc = child;
+            }
+            continue;
+        }
+        if (ts_node_is_extra(child)) {
+            continue;
+        }
+        if (symbol == s->module_declaration) {
+            TSNode module_doc = trailing_doc(s, child, source);
+            module_doc_next = ts_node_is_null(module_doc);
+            if (!module_doc_next) {
+                self->has_module_doc = true;
+                self->module_doc_start_byte = ts_node_start_byte(module_doc);
+                self->module_doc_end_byte = ts_node_end_byte(module_doc);
+            }
+            continue;
+        }
+        module_doc_next = false;
+        if (symbol == s->type_annotation) {
+            annotation = child;
+            continue;
+        }
+
+        if (elm_is_declaration(s, symbol)) {
+            bool annotated = symbol == s->value_declaration && !ts_node_is_null(annotation);
+            ok = add_entry(self, symbol, annotated ? annotation : child, child,
+                           elm_declaration_name(s, child), doc, source);
+        }
+        annotation = (TSNode){0};
+        doc = trailing_doc(s, child, source);
+    }
+    ts_tree_cursor_delete(&cursor);
+
+    ok = ok && build_table(self) &&
+         (!self->has_module_doc ||
+          self->module_doc_end_byte - self->module_doc_start_byte < 5 ||
+          parse_groups(self, source, self->module_doc_start_byte + 3,
+                       self->module_doc_end_byte - 2));
+    if (!ok) {
+        clear(self);
+    }
+    return ok;
+}
+
+const TSElmDocEntry *ts_elm_doc_index_find(const TSElmDocIndex *self, const char *name,
+                                           uint32_t length) {
+    if (self->entry_count == 0) {
+        return NULL;
+    }
+    uint32_t mask = self->slot_capacity - 1;
+    for (uint32_t slot = (uint32_t)hash_name(name, length) & mask;; slot = (slot + 1) & mask) {
+        uint32_t index = self->slots[slot];
+        if (index == 0) {
+            return NULL;
+        }
+        const TSElmDocEntry *entry = &self->entries[index - 1];
+        if (name_length(entry) == length &&
+            memcmp(self->names + self->name_offsets[index - 1], name, length) == 0) {
+            return entry;
+        }
+    }
+}
+
+const TSElmDocEntry *ts_elm_doc_index_entries(const TSElmDocIndex *self, uint32_t *count) {
+    *count = self->entry_count;
+    return self->entries;
+}
+
+bool ts_elm_doc_index_module_doc(const TSElmDocIndex *self, uint32_t *start_byte,
+                                 uint32_t *end_byte) {
+    *start_byte = self->module_doc_start_byte;
+    *end_byte = self->module_doc_end_byte;
+    return self->has_module_doc;
+}
+
+const TSElmDocGroup *ts_elm_doc_index_groups(const TSElmDocIndex *self, uint32_t *count) {
+    *count = self->group_count;
+    return self->groups;
+}
+
+const TSElmDocName *ts_elm_doc_index_names(const TSElmDocIndex *self, uint32_t *count) {
+    *count = self->doc_name_count;
+    return self->doc_names;
+}
@@ -0,0 +1,90 @@
+#include "tree_sitter/elm/flat.h"
+
+#include <stdlib.h>
+
+typedef struct {
+    uint32_t node;
+    uint32_t last_child;
+} Ancestor;
+
+static uint32_t append(TSElmFlatNode *nodes, uint32_t *count,
+                       const TSTreeCursor *cursor, Ancestor *parent) {
+    TSNode node = ts_tree_cursor_current_node(cursor);
+    uint32_t index = (*count)++;
+    nodes[index] = (TSElmFlatNode){
+        .symbol = ts_node_symbol(node),
+        .field_id = ts_tree_cursor_current_field_id(cursor),
+        .start_byte = ts_node_start_byte(node),
+        .end_byte = ts_node_end_byte(node),
+        .parent = parent == NULL ? TS_ELM_FLAT_NONE : parent->node,
+        .first_child = TS_ELM_FLAT_NONE,
+        .next_sibling = TS_ELM_FLAT_NONE,
+    };
+    if (parent != NULL) {
+        if (parent->last_child == TS_ELM_FLAT_NONE) {
+            nodes[parent->node].first_child = index;
+        } else {
+            nodes[parent->last_child].next_sibling = index;
+        }
+        parent->last_child = index;
+    }
+    return index;
+}
+
+uint32_t ts_elm_flatten(TSNode root, bool named_only, TSElmFlatNode *nodes,
+                        uint32_t capacity) {
+    if (capacity == 0) {
+        return 0;
+    }
+
+    // `ancestors[depth]` is the node the cursor descended from at each level
+    // of the current path, along with its most recently written child.
+    uint32_t ancestor_capacity = 64;
+    Ancestor *ancestors = malloc(ancestor_capacity * sizeof(Ancestor));
+    if (ancestors == NULL) {
+        return 0;
+    }
+
+    uint32_t count = 0;
+    uint32_t depth = 0;
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    ancestors[0] = (Ancestor){append(nodes, &count, &cursor, NULL),
+                              TS_ELM_FLAT_NONE};
+
+    while (count < capacity) {
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            depth++;
+        } else {
+            while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+                if (depth == 0 || !ts_tree_cursor_goto_parent(&cursor)) {
+                    goto done;
+                }
+                depth--;
+            }
+        }
+
+        if (depth >= ancestor_capacity) {
+            ancestor_capacity *= 2;
+            Ancestor *grown =
+                realloc(ancestors, ancestor_capacity * sizeof(Ancestor));
+            if (grown == NULL) {
+                count = 0;
+                goto done;
+            }
+            ancestors = grown;
+        }
+
+        // Anonymous nodes are leaves, so skipping one never orphans a child.
+        if (named_only &&
+            !ts_node_is_named(ts_tree_cursor_current_node(&cursor))) {
+            continue;
+        }
+        uint32_t index = append(nodes, &count, &cursor, &ancestors[depth - 1]);
+        ancestors[depth] = (Ancestor){index, TS_ELM_FLAT_NONE};
+    }
+
+done:
+    ts_tree_cursor_delete(&cursor);
+    free(ancestors);
+    return count;
+}
@@ -0,0 +1,499 @@
+#include "tree_sitter/elm/highlight.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Rows per cached block and the number of blocks kept, enough for a few
+// screens above and below the viewport.
+#define BLOCK_ROWS 256
+#define CACHED_BLOCKS 16
+
+#define NONE UINT32_MAX
+
+typedef struct {
+    uint32_t index;
+    uint64_t last_used;
+    TSElmHighlight *highlights;
+    uint32_t highlight_count;
+    uint32_t highlight_capacity;
+    TSElmInjection *injections;
+    uint32_t injection_count;
+    uint32_t injection_capacity;
+} Block;
+
+struct TSElmHighlighter {
+    const TSQuery *highlights;
+    const TSQuery *injections;
+    TSQueryCursor *cursor;
+    const TSTree *tree;
+    // Indexed by injections pattern, NONE for patterns without a language
+    uint32_t *pattern_languages;
+    // String ids of the language names in the injections query
+    uint32_t *languages;
+    uint32_t language_count;
+    uint32_t content_capture;
+    Block blocks[CACHED_BLOCKS];
+    uint64_t clock;
+    TSElmHighlight *highlights_out;
+    uint32_t highlight_count;
+    uint32_t highlight_capacity;
+    TSElmInjection *injections_out;
+    uint32_t injection_count;
+    uint32_t injection_capacity;
+};
+
+static bool reserve(void **items, uint32_t *capacity, uint32_t count,
+                    size_t size) {
+    if (count <= *capacity) {
+        return true;
+    }
+    uint32_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < count) {
+        new_capacity *= 2;
+    }
+    void *new_items = realloc(*items, new_capacity * size);
+    if (new_items == NULL) {
+        return false;
+    }
+    *items = new_items;
+    *capacity = new_capacity;
+    return true;
+}
+
+static bool equals(const char *string, uint32_t length, const char *expected) {
+    return length == strlen(expected) && memcmp(string, expected, length) == 0;
+}
+
+// Find `(#set! injection.language "name")` in every injections pattern.
+static bool resolve_languages(TSElmHighlighter *self) {
+    const TSQuery *query = self->injections;
+    uint32_t pattern_count = ts_query_pattern_count(query);
+    self->pattern_languages = malloc((pattern_count + 1) * sizeof(uint32_t));
+    self->languages = malloc((pattern_count + 1) * sizeof(uint32_t));
+    if (self->pattern_languages == NULL || self->languages == NULL) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < pattern_count; i++) {
+        self->pattern_languages[i] = NONE;
+        uint32_t step_count, length;
+        const TSQueryPredicateStep *steps =
+            ts_query_predicates_for_pattern(query, i, &step_count);
+        for (uint32_t j = 0; j + 2 < step_count; j++) {
+            if (steps[j].type != TSQueryPredicateStepTypeString ||
+                steps[j + 1].type != TSQueryPredicateStepTypeString ||
+                steps[j + 2].type != TSQueryPredicateStepTypeString) {
+                continue;
+            }
+            const char *name =
+                ts_query_string_value_for_id(query, steps[j].value_id, &length);
+            if (!equals(name, length, "set!")) {
+                continue;
+            }
+            const char *key = ts_query_string_value_for_id(
+                query, steps[j + 1].value_id, &length);
+            if (!equals(key, length, "injection.language")) {
+                continue;
+            }
+            uint32_t value = steps[j + 2].value_id, language = 0;
+            while (language < self->language_count &&
+                   self->languages[language] != value) {
+                language++;
+            }
+            if (language == self->language_count) {
+                self->languages[self->language_count++] = value;
+            }
+            self->pattern_languages[i] = language;
+        }
+    }
+
+    self->content_capture = NONE;
+    uint32_t capture_count = ts_query_capture_count(query);
+    for (uint32_t i = 0; i < capture_count; i++) {
+        uint32_t length;
+        const char *name = ts_query_capture_name_for_id(query, i, &length);
+        if (equals(name, length, "injection.content")) {
+            self->content_capture = i;
+        }
+    }
+    return true;
+}
+
+TSElmHighlighter *ts_elm_highlighter_new(const TSQuery *highlights,
+                                         const TSQuery *injections) {
+    TSElmHighlighter *self = calloc(1, sizeof(TSElmHighlighter));
+    if (self == NULL) {
+        return NULL;
+    }
+    self->highlights = highlights;
+    self->injections = injections;
+    self->cursor = ts_query_cursor_new();
+    for (uint32_t i = 0; i < CACHED_BLOCKS; i++) {
+        self->blocks[i].index = NONE;
+    }
+    if (self->cursor == NULL ||
+        (injections != NULL && !resolve_languages(self))) {
+        ts_elm_highlighter_delete(self);
+        return NULL;
+    }
+    return self;
+}
+
+void ts_elm_highlighter_delete(TSElmHighlighter *self) {
+    if (self == NULL) {
+        return;
+    }
+    if (self->cursor != NULL) {
+        ts_query_cursor_delete(self->cursor);
+    }
+    for (uint32_t i = 0; i < CACHED_BLOCKS; i++) {
+        free(self->blocks[i].highlights);
+        free(self->blocks[i].injections);
+    }
+    free(self->pattern_languages);
+    free(self->languages);
+    free(self->highlights_out);
+    free(self->injections_out);
+    free(self);
+}
+
+void ts_elm_highlighter_set_tree(TSElmHighlighter *self, const TSTree *tree) {
+    self->tree = tree;
+    for (uint32_t i = 0; i < CACHED_BLOCKS; i++) {
+        self->blocks[i].index = NONE;
+    }
+}
+
+// Where a capture bound ends up after an edit, see `shift_start` and
+// `shift_end` in semantic_tokens.c. Bounds in the replaced text move to its
+// start or new end, their block is dropped anyway.
+static inline uint32_t shift(uint32_t byte, const TSInputEdit *edit, bool end) {
+    if (byte < edit->start_byte || (end && byte == edit->start_byte)) {
+        return byte;
+    }
+    if (byte < edit->old_end_byte) {
+        return end ? edit->new_end_byte : edit->start_byte;
+    }
+    return byte - edit->old_end_byte + edit->new_end_byte;
+}
+
+static void move(uint32_t *byte, TSPoint *point, const TSInputEdit *edit,
+                 bool end) {
+    if (*byte < edit->start_byte || (end && *byte == edit->start_byte)) {
+        return;
+    }
+    if (*byte < edit->old_end_byte) {
+        *point = end ? edit->new_end_point : edit->start_point;
+    } else {
+        if (point->row == edit->old_end_point.row) {
+            point->column = point->column - edit->old_end_point.column +
+                            edit->new_end_point.column;
+        }
+        point->row =
+            point->row - edit->old_end_point.row + edit->new_end_point.row;
+    }
+    *byte = shift(*byte, edit, end);
+}
+
+// Keep a block that ends before the edited rows, or starts after them when
+// the edit does not change the line count, and move its captures.
+static bool move_block(Block *block, const TSInputEdit *edit) {
+    uint32_t start_row = block->index * BLOCK_ROWS;
+    if (start_row + BLOCK_ROWS > edit->start_point.row &&
+        (start_row <= edit->old_end_point.row ||
+         edit->new_end_point.row != edit->old_end_point.row)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < block->highlight_count; i++) {
+        TSElmHighlight *highlight = &block->highlights[i];
+        move(&highlight->start_byte, &highlight->start_point, edit, false);
+        move(&highlight->end_byte, &highlight->end_point, edit, true);
+    }
+    for (uint32_t i = 0; i < block->injection_count; i++) {
+        TSElmInjection *injection = &block->injections[i];
+        move(&injection->start_byte, &injection->start_point, edit, false);
+        move(&injection->end_byte, &injection->end_point, edit, true);
+    }
+    return true;
+}
+
+// Drop the blocks overlapping `[start_byte, end_byte)` of the new tree,
+// widened to the top-level nodes around it: a capture can depend on its
+// ancestors, such as a function name on its declaration.
+static void drop_bytes(TSElmHighlighter *self, TSNode root, uint32_t start_byte,
+                       uint32_t end_byte) {
+    TSNode first = ts_node_descendant_for_byte_range(root, start_byte, start_byte);
+    TSNode last = ts_node_descendant_for_byte_range(root, end_byte, end_byte);
+    uint32_t start_row = ts_node_start_point(first).row;
+    uint32_t end_row = ts_node_end_point(last).row;
+    TSNode top = ts_node_first_child_for_byte(root, start_byte);
+    if (!ts_node_is_null(top) && ts_node_start_byte(top) <= start_byte &&
+        ts_node_start_point(top).row < start_row) {
+        start_row = ts_node_start_point(top).row;
+    }
+    top = ts_node_first_child_for_byte(root, end_byte > 0 ? end_byte - 1 : 0);
+    if (!ts_node_is_null(top) && ts_node_start_byte(top) <= end_byte &&
+        ts_node_end_point(top).row > end_row) {
+        end_row = ts_node_end_point(top).row;
+    }
+    for (uint32_t i = 0; i < CACHED_BLOCKS; i++) {
+        Block *block = &self->blocks[i];
+        if (block->index != NONE && block->index * BLOCK_ROWS <= end_row &&
+            (block->index + 1) * BLOCK_ROWS > start_row) {
+            block->index = NONE;
+        }
+    }
+}
+
+void ts_elm_highlighter_edit_tree(TSElmHighlighter *self,
+                                  const TSTree *old_tree,
+                                  const TSTree *new_tree,
+                                  const TSInputEdit *edits,
+                                  uint32_t edit_count) {
+    self->tree = new_tree;
+    for (uint32_t i = 0; i < CACHED_BLOCKS; i++) {
+        Block *block = &self->blocks[i];
+        for (uint32_t j = 0; block->index != NONE && j < edit_count; j++) {
+            if (!move_block(block, &edits[j])) {
+                block->index = NONE;
+            }
+        }
+    }
+    if (new_tree == NULL) {
+        return;
+    }
+
+    TSNode root = ts_tree_root_node(new_tree);
+    for (uint32_t i = 0; i < edit_count; i++) {
+        // Move the edited text through the edits after it
+        uint32_t start_byte = edits[i].start_byte, end_byte = edits[i].new_end_byte;
+        for (uint32_t j = i + 1; j < edit_count; j++) {
+            start_byte = shift(start_byte, &edits[j], false);
+            end_byte = shift(end_byte, &edits[j], true);
+        }
+        drop_bytes(self, root, start_byte, end_byte);
+    }
+    if (old_tree != NULL) {
+        uint32_t changed_count;
+        TSRange *changed =
+            ts_tree_get_changed_ranges(old_tree, new_tree, &changed_count);
+        for (uint32_t i = 0; i < changed_count; i++) {
+            drop_bytes(self, root, changed[i].start_byte, changed[i].end_byte);
+        }
+        free(changed);
+    }
+}
+
+static bool query_block(TSElmHighlighter *self, Block *block, uint32_t index) {
+    TSNode root = ts_tree_root_node(self->tree);
+    TSPoint start = {index * BLOCK_ROWS, 0};
+    TSPoint end = {(index + 1) * BLOCK_ROWS, 0};
+    block->index = NONE;
+    block->highlight_count = 0;
+    block->injection_count = 0;
+
+    TSQueryMatch match;
+    uint32_t capture_index;
+    ts_query_cursor_set_point_range(self->cursor, start, end);
+    ts_query_cursor_exec(self->cursor, self->highlights, root);
+    while (ts_query_cursor_next_capture(self->cursor, &match, &capture_index)) {
+        const TSQueryCapture *capture = &match.captures[capture_index];
+        if (!reserve((void **)&block->highlights, &block->highlight_capacity,
+                     block->highlight_count + 1, sizeof(TSElmHighlight))) {
+            return false;
+        }
+        block->highlights[block->highlight_count++] = (TSElmHighlight){
+            .start_byte = ts_node_start_byte(capture->node),
+            .end_byte = ts_node_end_byte(capture->node),
+            .start_point = ts_node_start_point(capture->node),
+            .end_point = ts_node_end_point(capture->node),
+            .capture = capture->index,
+        };
+    }
+
+    if (self->injections != NULL && self->content_capture != NONE) {
+        ts_query_cursor_exec(self->cursor, self->injections, root);
+        while (ts_query_cursor_next_match(self->cursor, &match)) {
+            uint32_t language = self->pattern_languages[match.pattern_index];
+            if (language == NONE) {
+                continue;
+            }
+            for (uint16_t i = 0; i < match.capture_count; i++) {
+                const TSQueryCapture *capture = &match.captures[i];
+                if (capture->index != self->content_capture) {
+                    continue;
+                }
+                if (!reserve((void **)&block->injections,
+                             &block->injection_capacity,
+                             block->injection_count + 1,
+                             sizeof(TSElmInjection))) {
+                    return false;
+                }
+                block->injections[block->injection_count++] = (TSElmInjection){
+                    .start_byte = ts_node_start_byte(capture->node),
+                    .end_byte = ts_node_end_byte(capture->node),
+                    .start_point = ts_node_start_point(capture->node),
+                    .end_point = ts_node_end_point(capture->node),
+                    .language = language,
+                };
+            }
+        }
+    }
+    block->index = index;
+    return true;
+}
+
+static Block *get_block(TSElmHighlighter *self, uint32_t index) {
+    Block *victim = &self->blocks[0];
+    for (uint32_t i = 0; i < CACHED_BLOCKS; i++) {
+        Block *block = &self->blocks[i];
+        if (block->index == index) {
+            block->last_used = ++self->clock;
+            return block;
+        }
+        if (block->index == NONE ||
+            (victim->index != NONE && block->last_used < victim->last_used)) {
+            victim = block;
+        }
+    }
+    if (!query_block(self, victim, index)) {
+        return NULL;
+    }
+    victim->last_used = ++self->clock;
+    return victim;
+}
+
+static inline bool point_lt(TSPoint a, TSPoint b) {
+    return a.row < b.row || (a.row == b.row && a.column < b.column);
+}
+
+// A node that overlaps several blocks is reported by each of them, keep it
+// only in the first block it is seen in.
+static inline bool keep(TSPoint start, TSPoint end, uint32_t block_start_row,
+                        bool first_block, TSPoint range_start,
+                        TSPoint range_end) {
+    return (first_block || start.row >= block_start_row) &&
+           point_lt(start, range_end) &&
+           (point_lt(range_start, end) ||
+            (start.row == end.row && start.column == end.column &&
+             !point_lt(start, range_start)));
+}
+
+bool ts_elm_highlighter_highlight_rows(TSElmHighlighter *self,
+                                       uint32_t start_row, uint32_t end_row) {
+    self->highlight_count = 0;
+    self->injection_count = 0;
+    if (self->tree == NULL) {
+        return true;
+    }
+    uint32_t last_row = ts_node_end_point(ts_tree_root_node(self->tree)).row;
+    if (end_row > last_row + 1) {
+        end_row = last_row + 1;
+    }
+    if (start_row >= end_row) {
+        return true;
+    }
+
+    TSPoint range_start = {start_row, 0}, range_end = {end_row, 0};
+    uint32_t first = start_row / BLOCK_ROWS, last = (end_row - 1) / BLOCK_ROWS;
+    for (uint32_t index = first; index <= last; index++) {
+        const Block *block = get_block(self, index);
+        if (block == NULL) {
+            return false;
+        }
+        uint32_t block_start_row = index * BLOCK_ROWS;
+        for (uint32_t i = 0; i < block->highlight_count; i++) {
+            const TSElmHighlight *highlight = &block->highlights[i];
+            if (!keep(highlight->start_point, highlight->end_point,
+                      block_start_row, index == first, range_start,
+                      range_end)) {
+                continue;
+            }
+            if (!reserve((void **)&self->highlights_out,
+                         &self->highlight_capacity, self->highlight_count + 1,
+                         sizeof(TSElmHighlight))) {
+                return false;
+            }
+            self->highlights_out[self->highlight_count++] = *highlight;
+        }
+        for (uint32_t i = 0; i < block->injection_count; i++) {
+            const TSElmInjection *injection = &block->injections[i];
+            if (!keep(injection->start_point, injection->end_point,
+                      block_start_row, index == first, range_start,
+                      range_end)) {
+                continue;
+            }
+            if (!reserve((void **)&self->injections_out,
+                         &self->injection_capacity, self->injection_count + 1,
+                         sizeof(TSElmInjection))) {
+                return false;
+            }
+            self->injections_out[self->injection_count++] = *injection;
+        }
+    }
+    return true;
+}
+
+bool ts_elm_highlighter_highlight_bytes(TSElmHighlighter *self,
+                                        uint32_t start_byte,
+                                        uint32_t end_byte) {
+    if (self->tree == NULL || start_byte >= end_byte) {
+        self->highlight_count = 0;
+        self->injection_count = 0;
+        return true;
+    }
+
+    // Highlight the rows around the range, then keep what overlaps it
+    TSNode root = ts_tree_root_node(self->tree);
+    TSNode first = ts_node_descendant_for_byte_range(root, start_byte, start_byte);
+    TSNode last = ts_node_descendant_for_byte_range(root, end_byte - 1, end_byte - 1);
+    if (!ts_elm_highlighter_highlight_rows(self, ts_node_start_point(first).row,
+                                           ts_node_end_point(last).row + 1)) {
+        return false;
+    }
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < self->highlight_count; i++) {
+        const TSElmHighlight *highlight = &self->highlights_out[i];
+        if (highlight->start_byte < end_byte && highlight->end_byte > start_byte) {
+            self->highlights_out[count++] = *highlight;
+        }
+    }
+    self->highlight_count = count;
+    count = 0;
+    for (uint32_t i = 0; i < self->injection_count; i++) {
+        const TSElmInjection *injection = &self->injections_out[i];
+        if (injection->start_byte < end_byte && injection->end_byte > start_byte) {
+            self->injections_out[count++] = *injection;
+        }
+    }
+    self->injection_count = count;
+    return true;
+}
+
+const TSElmHighlight *ts_elm_highlighter_highlights(
+    const TSElmHighlighter *self, uint32_t *count) {
+    *count = self->highlight_count;
+    return self->highlights_out;
+}
+
+const TSElmInjection *ts_elm_highlighter_injections(
+    const TSElmHighlighter *self, uint32_t *count) {
+    *count = self->injection_count;
+    return self->injections_out;
+}
+
+uint32_t ts_elm_highlighter_injection_language_count(
+    const TSElmHighlighter *self) {
+    return self->language_count;
+}
+
+const char *ts_elm_highlighter_injection_language(
+    const TSElmHighlighter *self, uint32_t language, uint32_t *length) {
+    if (language >= self->language_count) {
+        *length = 0;
+        return NULL;
+    }
+    return ts_query_string_value_for_id(self->injections,
+                                        self->languages[language], length);
+}
@@ -0,0 +1,312 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "tree_sitter/elm/input.h"
+
+#include <errno.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define DEFAULT_BUFFER_SIZE (64 * 1024)
+
+// The longest UTF-8 sequence. A chunk the lexer asks for again because it
+// ends within a character must hold at least this much.
+#define MAX_CHARACTER_SIZE 4
+
+struct TSElmFileInput {
+    uint32_t length;
+    int error;
+    // A mapped file
+    const char *data;
+#ifdef _WIN32
+    HANDLE mapping;
+#endif
+    // A stream, with the part of the file the buffer holds
+    int fd;
+    char *buffer;
+    uint32_t buffer_size;
+    uint32_t buffer_start;
+    uint32_t buffer_length;
+};
+
+#ifdef _WIN32
+
+static int windows_error(void) {
+    switch (GetLastError()) {
+    case ERROR_FILE_NOT_FOUND:
+    case ERROR_PATH_NOT_FOUND:
+        return ENOENT;
+    case ERROR_ACCESS_DENIED:
+        return EACCES;
+    case ERROR_NOT_ENOUGH_MEMORY:
+        return ENOMEM;
+    default:
+        return EIO;
+    }
+}
+
+static int map_file(TSElmFileInput *self, const char *path) {
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return windows_error();
+    }
+    LARGE_INTEGER size;
+    int error = 0;
+    if (!GetFileSizeEx(file, &size)) {
+        error = windows_error();
+    } else if (size.QuadPart > UINT32_MAX) {
+        error = EFBIG;
+    } else if (size.QuadPart > 0) {
+        self->mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        self->data = self->mapping
+                         ? MapViewOfFile(self->mapping, FILE_MAP_READ, 0, 0, 0)
+                         : NULL;
+        if (self->data == NULL) {
+            error = windows_error();
+        }
+        self->length = (uint32_t)size.QuadPart;
+    }
+    CloseHandle(file);
+    return error;
+}
+
+static void unmap_file(TSElmFileInput *self) {
+    if (self->data != NULL && self->length > 0) {
+        UnmapViewOfFile(self->data);
+    }
+    if (self->mapping != NULL) {
+        CloseHandle(self->mapping);
+    }
+}
+
+static int stream_length(int fd, uint32_t *length) {
+    HANDLE file = (HANDLE)_get_osfhandle(fd);
+    LARGE_INTEGER size;
+    if (file == INVALID_HANDLE_VALUE) {
+        return EBADF;
+    }
+    if (GetFileType(file) != FILE_TYPE_DISK) {
+        return ESPIPE;
+    }
+    if (!GetFileSizeEx(file, &size)) {
+        return windows_error();
+    }
+    if (size.QuadPart > UINT32_MAX) {
+        return EFBIG;
+    }
+    *length = (uint32_t)size.QuadPart;
+    return 0;
+}
+
+// Read up to `size` bytes at `offset`, returning -1 and setting errno on
+// failure.
+static long read_at(int fd, char *buffer, uint32_t size, uint32_t offset) {
+    OVERLAPPED overlapped = {0};
+    overlapped.Offset = offset;
+    DWORD count;
+    if (!ReadFile((HANDLE)_get_osfhandle(fd), buffer, size, &count, &overlapped)) {
+        if (GetLastError() == ERROR_HANDLE_EOF) {
+            return 0;
+        }
+        errno = windows_error();
+        return -1;
+    }
+    return (long)count;
+}
+
+#else
+
+static int map_file(TSElmFileInput *self, const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return errno;
+    }
+    struct stat status;
+    int error = 0;
+    if (fstat(fd, &status) != 0) {
+        error = errno;
+    } else if (!S_ISREG(status.st_mode)) {
+        error = ENODEV;
+    } else if ((uint64_t)status.st_size > UINT32_MAX) {
+        error = EFBIG;
+    } else if (status.st_size > 0) {
+        void *data = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            error = errno;
+        } else {
+            // The parser reads the file front to back
+            posix_madvise(data, (size_t)status.st_size, POSIX_MADV_SEQUENTIAL);
+            self->data = data;
+            self->length = (uint32_t)status.st_size;
+        }
+    }
+    close(fd);
+    return error;
+}
+
+static void unmap_file(TSElmFileInput *self) {
+    if (self->data != NULL && self->length > 0) {
+        munmap((void *)self->data, self->length);
+    }
+}
+
+static int stream_length(int fd, uint32_t *length) {
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        return errno;
+    }
+    if (!S_ISREG(status.st_mode) && !S_ISBLK(status.st_mode)) {
+        return ESPIPE;
+    }
+    if ((uint64_t)status.st_size > UINT32_MAX) {
+        return EFBIG;
+    }
+    *length = (uint32_t)status.st_size;
+    return 0;
+}
+
+static long read_at(int fd, char *buffer, uint32_t size, uint32_t offset) {
+    ssize_t count;
+    do {
+        count = pread(fd, buffer, size, (off_t)offset);
+    } while (count < 0 && errno == EINTR);
+    return (long)count;
+}
+
+#endif
+
+static const char *read_mapped(void *payload, uint32_t byte, TSPoint position,
+                               uint32_t *bytes_read) {
+    TSElmFileInput *self = payload;
+    (void)position;
+    if (byte >= self->length) {
+        *bytes_read = 0;
+        return "";
+    }
+    *bytes_read = self->length - byte;
+    return self->data + byte;
+}
+
+// Fill the buffer from `byte` on, short only at the end of the file.
+static bool fill(TSElmFileInput *self, uint32_t byte) {
+    uint32_t size = self->buffer_size;
+    if (size > self->length - byte) {
+        size = self->length - byte;
+    }
+    uint32_t filled = 0;
+    while (filled < size) {
+        long count = read_at(self->fd, self->buffer + filled, size - filled, byte + filled);
+        if (count < 0) {
+            self->error = errno;
+            return false;
+        }
+        if (count == 0) {
+            break;
+        }
+        filled += (uint32_t)count;
+    }
+    self->buffer_start = byte;
+    self->buffer_length = filled;
+    return true;
+}
+
+static const char *read_stream(void *payload, uint32_t byte, TSPoint position,
+                               uint32_t *bytes_read) {
+    TSElmFileInput *self = payload;
+    (void)position;
+    uint32_t end = self->buffer_start + self->buffer_length;
+    // Refill when the lexer moves outside the buffer, or asks again for the
+    // end of it because a character continues in the next chunk
+    bool outside = byte < self->buffer_start || byte >= end;
+    bool partial = end - byte < MAX_CHARACTER_SIZE && byte > self->buffer_start;
+    if (byte >= self->length || ((outside || partial) && !fill(self, byte))) {
+        *bytes_read = 0;
+        return "";
+    }
+    *bytes_read = self->buffer_start + self->buffer_length - byte;
+    return self->buffer + (byte - self->buffer_start);
+}
+
+TSElmFileInput *ts_elm_file_input_map(const char *path, int *error) {
+    TSElmFileInput *self = calloc(1, sizeof(TSElmFileInput));
+    if (self == NULL) {
+        *error = ENOMEM;
+        return NULL;
+    }
+    self->fd = -1;
+    *error = map_file(self, path);
+    if (*error != 0) {
+        ts_elm_file_input_delete(self);
+        return NULL;
+    }
+    if (self->data == NULL) {
+        self->data = "";
+    }
+    return self;
+}
+
+TSElmFileInput *ts_elm_file_input_stream(int fd, uint32_t buffer_size,
+                                         int *error) {
+    if (buffer_size == 0) {
+        buffer_size = DEFAULT_BUFFER_SIZE;
+    }
+    if (buffer_size < MAX_CHARACTER_SIZE) {
+        buffer_size = MAX_CHARACTER_SIZE;
+    }
+    TSElmFileInput *self = calloc(1, sizeof(TSElmFileInput));
+    if (self == NULL) {
+        *error = ENOMEM;
+        return NULL;
+    }
+    self->fd = fd;
+    *error = stream_length(fd, &self->length);
+    if (*error == 0) {
+        self->buffer_size = buffer_size;
+        self->buffer = malloc(buffer_size);
+        *error = self->buffer ? 0 : ENOMEM;
+    }
+    if (*error != 0) {
+        ts_elm_file_input_delete(self);
+        return NULL;
+    }
+    return self;
+}
+
+TSInput ts_elm_file_input(TSElmFileInput *self) {
+    TSInput input = {0};
+    input.payload = self;
+    input.read = self->buffer != NULL ? read_stream : read_mapped;
+    input.encoding = TSInputEncodingUTF8;
+    return input;
+}
+
+uint32_t ts_elm_file_input_length(const TSElmFileInput *self) {
+    return self->length;
+}
+
+const char *ts_elm_file_input_data(const TSElmFileInput *self) {
+    return self->buffer != NULL ? NULL : self->data;
+}
+
+int ts_elm_file_input_error(const TSElmFileInput *self) { return self->error; }
+
+void ts_elm_file_input_delete(TSElmFileInput *self) {
+    if (self == NULL) {
+        return;
+    }
+    if (self->buffer == NULL) {
+        unmap_file(self);
+    }
+    free(self->buffer);
+    free(self);
+}
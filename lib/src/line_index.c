@@ -0,0 +1,346 @@
+#include "tree_sitter/elm/line_index.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Newlines and non-ASCII bytes are found 16 bytes at a time with SSE2 or
+// NEON. Build with TREE_SITTER_ELM_NO_SIMD to compare with the plain loop.
+#if !defined(TREE_SITTER_ELM_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define LINE_INDEX_SSE2
+#elif !defined(TREE_SITTER_ELM_NO_SIMD) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#include <arm_neon.h>
+#define LINE_INDEX_NEON
+#endif
+
+#define BLOCK_SIZE 16
+
+typedef struct {
+    uint32_t *starts;
+    uint8_t *ascii;
+    uint32_t count;
+    uint32_t starts_capacity;
+    uint32_t ascii_capacity;
+} Lines;
+
+struct TSElmLineIndex {
+    Lines lines;
+    // The lines of the edited region while an edit is applied
+    Lines scratch;
+    uint32_t length;
+};
+
+// Bit masks of the newline and the non-ASCII bytes of a block, with
+// BITS_PER_BYTE bits per byte, lowest byte first.
+typedef struct {
+    uint64_t newlines;
+    uint64_t non_ascii;
+} Masks;
+
+#if defined(LINE_INDEX_SSE2)
+
+#define BITS_PER_BYTE 1
+
+static inline Masks block_masks(const char *bytes) {
+    __m128i block = _mm_loadu_si128((const __m128i *)bytes);
+    Masks masks;
+    masks.newlines = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')));
+    masks.non_ascii = (uint32_t)_mm_movemask_epi8(block);
+    return masks;
+}
+
+#elif defined(LINE_INDEX_NEON)
+
+#define BITS_PER_BYTE 4
+
+// NEON has no movemask. Narrowing each 16-bit lane by 4 bits leaves a
+// nibble per byte, of which only the lowest bit is kept.
+static inline uint64_t nibble_mask(uint8x16_t matches) {
+    uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x1111111111111111u;
+}
+
+static inline Masks block_masks(const char *bytes) {
+    uint8x16_t block = vld1q_u8((const uint8_t *)bytes);
+    Masks masks;
+    masks.newlines = nibble_mask(vceqq_u8(block, vdupq_n_u8('\n')));
+    masks.non_ascii = nibble_mask(vcgeq_u8(block, vdupq_n_u8(0x80)));
+    return masks;
+}
+
+#else
+
+#define BITS_PER_BYTE 1
+
+static inline Masks block_masks(const char *bytes) {
+    Masks masks = {0, 0};
+    for (uint32_t i = 0; i < BLOCK_SIZE; i++) {
+        masks.newlines |= (uint64_t)(bytes[i] == '\n') << i;
+        masks.non_ascii |= (uint64_t)((uint8_t)bytes[i] >= 0x80) << i;
+    }
+    return masks;
+}
+
+#endif
+
+static inline uint32_t lowest_bit(uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return (uint32_t)index;
+#else
+    return (uint32_t)__builtin_ctzll(mask);
+#endif
+}
+
+static bool reserve(void **items, uint32_t *capacity, uint32_t count,
+                    size_t size) {
+    if (count <= *capacity) {
+        return true;
+    }
+    uint32_t new_capacity = *capacity ? *capacity : 64;
+    while (new_capacity < count) {
+        new_capacity *= 2;
+    }
+    void *new_items = realloc(*items, new_capacity * size);
+    if (new_items == NULL) {
+        return false;
+    }
+    *items = new_items;
+    *capacity = new_capacity;
+    return true;
+}
+
+static bool reserve_lines(Lines *lines, uint32_t count) {
+    return reserve((void **)&lines->starts, &lines->starts_capacity, count,
+                   sizeof(uint32_t)) &&
+           reserve((void **)&lines->ascii, &lines->ascii_capacity, count,
+                   sizeof(uint8_t));
+}
+
+static bool push_line(Lines *lines, uint32_t start) {
+    if (!reserve_lines(lines, lines->count + 1)) {
+        return false;
+    }
+    lines->starts[lines->count] = start;
+    lines->ascii[lines->count] = true;
+    lines->count++;
+    return true;
+}
+
+// Add a line after each newline in `[start, end)` and mark the lines with
+// non-ASCII bytes, the last line being the one `start` is on.
+static bool scan(Lines *lines, const char *source, uint32_t start,
+                 uint32_t end) {
+    uint32_t i = start;
+    for (; i + BLOCK_SIZE <= end; i += BLOCK_SIZE) {
+        Masks masks = block_masks(source + i);
+        if (masks.newlines == 0) {
+            if (masks.non_ascii != 0) {
+                lines->ascii[lines->count - 1] = false;
+            }
+            continue;
+        }
+        for (uint64_t both = masks.newlines | masks.non_ascii; both != 0;
+             both &= both - 1) {
+            uint32_t bit = lowest_bit(both);
+            if (masks.newlines & ((uint64_t)1 << bit)) {
+                if (!push_line(lines, i + bit / BITS_PER_BYTE + 1)) {
+                    return false;
+                }
+            } else {
+                lines->ascii[lines->count - 1] = false;
+            }
+        }
+    }
+    for (; i < end; i++) {
+        if (source[i] == '\n') {
+            if (!push_line(lines, i + 1)) {
+                return false;
+            }
+        } else if ((uint8_t)source[i] >= 0x80) {
+            lines->ascii[lines->count - 1] = false;
+        }
+    }
+    return true;
+}
+
+// The last line starting at or before `byte`.
+static uint32_t find_line(const Lines *lines, uint32_t byte) {
+    uint32_t low = 0, high = lines->count;
+    while (high - low > 1) {
+        uint32_t middle = low + (high - low) / 2;
+        if (lines->starts[middle] <= byte) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// Leave a single empty line, which the allocation in `new` has room for.
+static void clear(TSElmLineIndex *self) {
+    self->lines.count = 1;
+    self->lines.starts[0] = 0;
+    self->lines.ascii[0] = true;
+    self->length = 0;
+}
+
+TSElmLineIndex *ts_elm_line_index_new(void) {
+    TSElmLineIndex *self = calloc(1, sizeof(TSElmLineIndex));
+    if (self == NULL) {
+        return NULL;
+    }
+    if (!push_line(&self->lines, 0)) {
+        ts_elm_line_index_delete(self);
+        return NULL;
+    }
+    return self;
+}
+
+void ts_elm_line_index_delete(TSElmLineIndex *self) {
+    if (self == NULL) {
+        return;
+    }
+    free(self->lines.starts);
+    free(self->lines.ascii);
+    free(self->scratch.starts);
+    free(self->scratch.ascii);
+    free(self);
+}
+
+bool ts_elm_line_index_reset(TSElmLineIndex *self, const char *source,
+                             uint32_t length) {
+    clear(self);
+    if (!scan(&self->lines, source, 0, length)) {
+        clear(self);
+        return false;
+    }
+    self->length = length;
+    return true;
+}
+
+bool ts_elm_line_index_edit(TSElmLineIndex *self, const char *source,
+                            uint32_t length, const TSInputEdit *edit) {
+    // Rescan from the start of the edit's first line to the end of the line
+    // holding its new end, and keep the lines after that in the old text.
+    Lines *lines = &self->lines;
+    uint32_t first = find_line(lines, edit->start_byte);
+    const char *newline = memchr(source + edit->new_end_byte, '\n',
+                                 length - edit->new_end_byte);
+    uint32_t end = newline ? (uint32_t)(newline - source) : length;
+    uint32_t old_end = end - edit->new_end_byte + edit->old_end_byte;
+    uint32_t tail = find_line(lines, old_end) + 1;
+    uint32_t tail_count = lines->count - tail;
+
+    Lines *scratch = &self->scratch;
+    scratch->count = 0;
+    bool ok = push_line(scratch, lines->starts[first]) &&
+              scan(scratch, source, lines->starts[first], end) &&
+              reserve_lines(lines, first + scratch->count + tail_count);
+    if (!ok) {
+        clear(self);
+        return false;
+    }
+
+    uint32_t moved = first + scratch->count;
+    memmove(lines->starts + moved, lines->starts + tail, tail_count * sizeof(uint32_t));
+    memmove(lines->ascii + moved, lines->ascii + tail, tail_count);
+    for (uint32_t i = moved; i < moved + tail_count; i++) {
+        lines->starts[i] = lines->starts[i] - edit->old_end_byte + edit->new_end_byte;
+    }
+    memcpy(lines->starts + first, scratch->starts, scratch->count * sizeof(uint32_t));
+    memcpy(lines->ascii + first, scratch->ascii, scratch->count);
+    lines->count = moved + tail_count;
+    self->length = length;
+    return true;
+}
+
+uint32_t ts_elm_line_index_line_count(const TSElmLineIndex *self) {
+    return self->lines.count;
+}
+
+TSPoint ts_elm_line_index_point(const TSElmLineIndex *self, uint32_t byte) {
+    if (byte > self->length) {
+        byte = self->length;
+    }
+    uint32_t line = find_line(&self->lines, byte);
+    return (TSPoint){line, byte - self->lines.starts[line]};
+}
+
+TSElmPosition ts_elm_line_index_position(const TSElmLineIndex *self,
+                                         const char *source, uint32_t byte) {
+    TSPoint point = ts_elm_line_index_point(self, byte);
+    TSElmPosition position = {point.row, point.column};
+    if (self->lines.ascii[point.row]) {
+        return position;
+    }
+    // Every byte but a continuation byte starts a character, and those of
+    // four bytes take a surrogate pair
+    position.character = 0;
+    for (uint32_t i = self->lines.starts[point.row]; i < byte && i < self->length; i++) {
+        uint8_t c = (uint8_t)source[i];
+        if ((c & 0xC0) != 0x80) {
+            position.character += c >= 0xF0 ? 2 : 1;
+        }
+    }
+    return position;
+}
+
+uint32_t ts_elm_line_index_byte(const TSElmLineIndex *self, const char *source,
+                                TSElmPosition position) {
+    const Lines *lines = &self->lines;
+    if (position.line >= lines->count) {
+        return self->length;
+    }
+    uint32_t start = lines->starts[position.line];
+    uint32_t end = position.line + 1 < lines->count
+                       ? lines->starts[position.line + 1] - 1
+                       : self->length;
+    if (end > start && source[end - 1] == '\r') {
+        end--;
+    }
+    if (lines->ascii[position.line]) {
+        return position.character < end - start ? start + position.character : end;
+    }
+
+    uint32_t i = start;
+    for (uint32_t character = 0; i < end && character < position.character;) {
+        uint8_t c = (uint8_t)source[i];
+        uint32_t size = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+        character += size == 4 ? 2 : 1;
+        i += size;
+    }
+    return i < end ? i : end;
+}
+
+TSInputEdit ts_elm_line_index_change(const TSElmLineIndex *self,
+                                     const char *source, TSElmPosition start,
+                                     TSElmPosition end, const char *text,
+                                     uint32_t text_length) {
+    TSInputEdit edit;
+    edit.start_byte = ts_elm_line_index_byte(self, source, start);
+    edit.old_end_byte = ts_elm_line_index_byte(self, source, end);
+    if (edit.old_end_byte < edit.start_byte) {
+        edit.old_end_byte = edit.start_byte;
+    }
+    edit.new_end_byte = edit.start_byte + text_length;
+    edit.start_point = ts_elm_line_index_point(self, edit.start_byte);
+    edit.old_end_point = ts_elm_line_index_point(self, edit.old_end_byte);
+
+    edit.new_end_point = edit.start_point;
+    edit.new_end_point.column += text_length;
+    const char *newline = memchr(text, '\n', text_length);
+    while (newline != NULL) {
+        uint32_t after = (uint32_t)(newline - text) + 1;
+        edit.new_end_point.row++;
+        edit.new_end_point.column = text_length - after;
+        newline = memchr(text + after, '\n', text_length - after);
+    }
+    return edit;
+}
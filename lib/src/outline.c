@@ -0,0 +1,189 @@
+#include "tree_sitter/elm/outline.h"
+#include "symbols.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// A node on the path of the walk through a function body, with the
+// outline symbol that encloses it.
+typedef struct {
+    TSSymbol symbol;
+    uint32_t outline_parent;
+} Ancestor;
+
+static bool reserve(void **items, uint32_t *capacity, uint32_t count,
+                    size_t size) {
+    if (count <= *capacity) {
+        return true;
+    }
+    uint32_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < count) {
+        new_capacity *= 2;
+    }
+    void *new_items = realloc(*items, new_capacity * size);
+    if (new_items == NULL) {
+        return false;
+    }
+    *items = new_items;
+    *capacity = new_capacity;
+    return true;
+}
+
+static bool add(TSElmOutline *self, TSElmOutlineKind kind, uint32_t parent,
+                TSNode node, TSNode name) {
+    if (!reserve((void **)&self->symbols, &self->capacity, self->count + 1,
+                 sizeof(TSElmOutlineSymbol))) {
+        return false;
+    }
+    TSElmOutlineSymbol *symbol = &self->symbols[self->count++];
+    symbol->kind = kind;
+    symbol->parent = parent;
+    symbol->start_byte = ts_node_start_byte(node);
+    symbol->end_byte = ts_node_end_byte(node);
+    if (ts_node_is_null(name)) {
+        symbol->name_start_byte = symbol->start_byte;
+        symbol->name_end_byte = symbol->start_byte;
+    } else {
+        symbol->name_start_byte = ts_node_start_byte(name);
+        symbol->name_end_byte = ts_node_end_byte(name);
+    }
+    return true;
+}
+
+// Add the children of `node` that are `child_symbol` with their `name`
+// field, under `parent`.
+static bool add_children(TSElmOutline *self, TSTreeCursor *cursor, TSNode node,
+                         TSSymbol child_symbol, TSElmOutlineKind kind,
+                         uint32_t parent) {
+    const ElmSymbols *s = elm_symbols();
+    ts_tree_cursor_reset(cursor, node);
+    bool more = ts_tree_cursor_goto_first_child(cursor);
+    for (; more; more = ts_tree_cursor_goto_next_sibling(cursor)) {
+        TSNode child = ts_tree_cursor_current_node(cursor);
+        if (ts_node_symbol(child) == child_symbol &&
+            !add(self, kind, parent,
+                 child, ts_node_child_by_field_id(child, s->field_name))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The fields of a type alias of a record type, not those of records nested
+// in other type expressions.
+static bool add_fields(TSElmOutline *self, TSTreeCursor *cursor, TSNode alias,
+                       uint32_t parent) {
+    const ElmSymbols *s = elm_symbols();
+    TSNode type = ts_node_child_by_field_id(alias, s->field_type_expression);
+    if (ts_node_is_null(type) || ts_node_named_child_count(type) != 1) {
+        return true;
+    }
+    TSNode record = ts_node_named_child(type, 0);
+    if (ts_node_symbol(record) != s->record_type) {
+        return true;
+    }
+    return add_children(self, cursor, record, s->field_type, TSElmOutlineField,
+                        parent);
+}
+
+// Walk the whole function `node` for the functions its `let` expressions
+// bind, which nest under the closest enclosing function. `ancestors` is
+// the path from `node` to the current node.
+static bool add_let_functions(TSElmOutline *self, TSTreeCursor *cursor,
+                              TSNode node, uint32_t parent,
+                              Ancestor **ancestors,
+                              uint32_t *ancestor_capacity) {
+    const ElmSymbols *s = elm_symbols();
+    if (!reserve((void **)ancestors, ancestor_capacity, 1, sizeof(Ancestor))) {
+        return false;
+    }
+    (*ancestors)[0] = (Ancestor){ts_node_symbol(node), parent};
+    uint32_t depth = 0;
+    ts_tree_cursor_reset(cursor, node);
+
+    for (;;) {
+        if (ts_tree_cursor_goto_first_child(cursor)) {
+            depth++;
+        } else {
+            while (!ts_tree_cursor_goto_next_sibling(cursor)) {
+                if (depth == 0 || !ts_tree_cursor_goto_parent(cursor)) {
+                    return true;
+                }
+                depth--;
+            }
+        }
+        if (!reserve((void **)ancestors, ancestor_capacity, depth + 1,
+                     sizeof(Ancestor))) {
+            return false;
+        }
+
+        TSNode current = ts_tree_cursor_current_node(cursor);
+        TSSymbol symbol = ts_node_symbol(current);
+        uint32_t outline_parent = (*ancestors)[depth - 1].outline_parent;
+        // Destructuring bindings in a `let` are not functions
+        if (symbol == s->value_declaration &&
+            (*ancestors)[depth - 1].symbol == s->let_in_expr) {
+            TSNode left = ts_node_child_by_field_id(
+                current, s->field_function_declaration_left);
+            if (!ts_node_is_null(left)) {
+                if (!add(self, TSElmOutlineLetFunction, outline_parent, current,
+                         ts_node_named_child(left, 0))) {
+                    return false;
+                }
+                outline_parent = self->count - 1;
+            }
+        }
+        (*ancestors)[depth] = (Ancestor){symbol, outline_parent};
+    }
+}
+
+bool ts_elm_outline_build(TSElmOutline *self, TSNode root) {
+    const ElmSymbols *s = elm_symbols();
+    self->count = 0;
+    bool ok = true;
+    Ancestor *ancestors = NULL;
+    uint32_t ancestor_capacity = 0;
+    // Walks the children of one declaration at a time
+    TSTreeCursor inner = ts_tree_cursor_new(root);
+
+    // Walk with a cursor, `ts_node_child` rescans the siblings on every call.
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    bool more = ts_tree_cursor_goto_first_child(&cursor);
+    for (; more && ok; more = ts_tree_cursor_goto_next_sibling(&cursor)) {
+        TSNode child = ts_tree_cursor_current_node(&cursor);
+        TSSymbol symbol = ts_node_symbol(child);
+        uint32_t index = self->count;
+
+        if (symbol == s->value_declaration) {
+            ok = add(self, TSElmOutlineFunction, TS_ELM_OUTLINE_NONE, child,
+                     elm_declaration_name(s, child)) &&
+                 add_let_functions(self, &inner, child, index, &ancestors,
+                                   &ancestor_capacity);
+        } else if (symbol == s->type_declaration) {
+            ok = add(self, TSElmOutlineType, TS_ELM_OUTLINE_NONE, child,
+                     ts_node_child_by_field_id(child, s->field_name)) &&
+                 add_children(self, &inner, child, s->union_variant,
+                              TSElmOutlineVariant, index);
+        } else if (symbol == s->type_alias_declaration) {
+            ok = add(self, TSElmOutlineTypeAlias, TS_ELM_OUTLINE_NONE, child,
+                     ts_node_child_by_field_id(child, s->field_name)) &&
+                 add_fields(self, &inner, child, index);
+        } else if (symbol == s->port_annotation) {
+            ok = add(self, TSElmOutlinePort, TS_ELM_OUTLINE_NONE, child,
+                     ts_node_child_by_field_id(child, s->field_name));
+        }
+    }
+    ts_tree_cursor_delete(&cursor);
+    ts_tree_cursor_delete(&inner);
+    free(ancestors);
+
+    if (!ok) {
+        ts_elm_outline_delete(self);
+    }
+    return ok;
+}
+
+void ts_elm_outline_delete(TSElmOutline *self) {
+    free(self->symbols);
+    memset(self, 0, sizeof(*self));
+}
@@ -0,0 +1,730 @@
+#include "tree_sitter/elm/semantic_tokens.h"
+#include "symbols.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_TOKEN UINT32_MAX
+
+// Integers per token in the LSP encoding
+#define TOKEN_SIZE 5
+
+typedef struct {
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t row;
+    uint32_t line_start_byte;
+    uint32_t pattern_index;
+    uint32_t mapping;
+} Capture;
+
+typedef struct {
+    uint32_t end_byte;
+    uint32_t mapping;
+} Open;
+
+// A token at its absolute position, before delta encoding
+typedef struct {
+    uint32_t start_byte;
+    uint32_t row;
+    uint32_t column;
+    uint32_t length;
+    uint32_t type;
+    uint32_t modifiers;
+} Token;
+
+typedef struct {
+    uint32_t start_byte;
+    uint32_t end_byte;
+} Range;
+
+struct TSElmSemanticTokens {
+    TSQuery *query;
+    TSQueryCursor *cursor;
+    // Indexed by capture id, NO_TOKEN for captures without a mapping
+    uint32_t *capture_mappings;
+    uint32_t *token_types;
+    uint32_t *token_modifiers;
+    Capture *captures;
+    uint32_t capture_capacity;
+    Open *stack;
+    uint32_t stack_capacity;
+    Token *tokens;
+    uint32_t token_count;
+    uint32_t token_capacity;
+};
+
+// Token start bytes next to their LSP encoding, TOKEN_SIZE integers each
+typedef struct {
+    uint32_t *starts;
+    uint32_t *data;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t last_row;
+    uint32_t last_column;
+} Output;
+
+struct TSElmSemanticTokensCache {
+    Output tokens;
+    TSElmSemanticTokensEdit *edits;
+    uint32_t edit_count;
+    uint32_t edit_capacity;
+    Range *ranges;
+    uint32_t range_capacity;
+};
+
+// Walks the source forward, tracking the line and UTF-16 column, and
+// collects tokens at their absolute positions.
+typedef struct {
+    TSElmSemanticTokens *owner;
+    const char *source;
+    uint32_t byte;
+    uint32_t row;
+    uint32_t column;
+    bool failed;
+} Encoder;
+
+static bool reserve(void **items, uint32_t *capacity, uint32_t count,
+                    size_t size) {
+    if (count <= *capacity) {
+        return true;
+    }
+    uint32_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < count) {
+        new_capacity *= 2;
+    }
+    void *new_items = realloc(*items, new_capacity * size);
+    if (new_items == NULL) {
+        return false;
+    }
+    *items = new_items;
+    *capacity = new_capacity;
+    return true;
+}
+
+static inline uint32_t utf16_width(unsigned char byte) {
+    if ((byte & 0xC0) == 0x80) {
+        return 0;
+    }
+    return byte >= 0xF0 ? 2 : 1;
+}
+
+static void advance(Encoder *self, uint32_t byte) {
+    for (; self->byte < byte; self->byte++) {
+        unsigned char c = (unsigned char)self->source[self->byte];
+        if (c == '\n') {
+            self->row++;
+            self->column = 0;
+        } else {
+            self->column += utf16_width(c);
+        }
+    }
+}
+
+static void push(Encoder *self, uint32_t length, uint32_t mapping) {
+    TSElmSemanticTokens *owner = self->owner;
+    if (!reserve((void **)&owner->tokens, &owner->token_capacity,
+                 owner->token_count + 1, sizeof(Token))) {
+        self->failed = true;
+        return;
+    }
+    owner->tokens[owner->token_count++] = (Token){
+        .start_byte = self->byte,
+        .row = self->row,
+        .column = self->column,
+        .length = length,
+        .type = owner->token_types[mapping],
+        .modifiers = owner->token_modifiers[mapping],
+    };
+}
+
+// Emit `[start, end)` as one token per line, leaving out line breaks.
+static void emit(Encoder *self, uint32_t mapping, uint32_t start,
+                 uint32_t end) {
+    advance(self, start);
+    while (self->byte < end) {
+        uint32_t line_end = self->byte, width = 0;
+        while (line_end < end && self->source[line_end] != '\n') {
+            width += utf16_width((unsigned char)self->source[line_end]);
+            line_end++;
+        }
+        uint32_t length = width;
+        if (line_end > self->byte && self->source[line_end - 1] == '\r') {
+            length--;
+        }
+        if (length > 0) {
+            push(self, length, mapping);
+        }
+        self->byte = line_end;
+        self->column += width;
+        if (line_end < end) {
+            self->byte++;
+            self->row++;
+            self->column = 0;
+        }
+    }
+}
+
+static uint32_t longest_mapping(const char *name, uint32_t length,
+                                const TSElmTokenMapping *mappings,
+                                uint32_t mapping_count) {
+    uint32_t best = NO_TOKEN;
+    size_t best_length = 0;
+    for (uint32_t i = 0; i < mapping_count; i++) {
+        size_t prefix = strlen(mappings[i].capture);
+        if (prefix > length || (prefix < length && name[prefix] != '.') ||
+            memcmp(name, mappings[i].capture, prefix) != 0) {
+            continue;
+        }
+        if (best == NO_TOKEN || prefix > best_length) {
+            best = i;
+            best_length = prefix;
+        }
+    }
+    return best;
+}
+
+TSElmSemanticTokens *ts_elm_semantic_tokens_new(
+    const char *query_source, uint32_t query_length,
+    const TSElmTokenMapping *mappings, uint32_t mapping_count,
+    uint32_t *error_offset, TSQueryError *error_type) {
+    TSQuery *query = ts_query_new(elm_language(), query_source, query_length,
+                                  error_offset, error_type);
+    if (query == NULL) {
+        return NULL;
+    }
+
+    TSElmSemanticTokens *self = calloc(1, sizeof(TSElmSemanticTokens));
+    uint32_t capture_count = ts_query_capture_count(query);
+    if (self == NULL) {
+        ts_query_delete(query);
+        return NULL;
+    }
+    self->query = query;
+    self->cursor = ts_query_cursor_new();
+    self->capture_mappings = calloc(capture_count + 1, sizeof(uint32_t));
+    self->token_types = calloc(mapping_count + 1, sizeof(uint32_t));
+    self->token_modifiers = calloc(mapping_count + 1, sizeof(uint32_t));
+    if (self->cursor == NULL || self->capture_mappings == NULL ||
+        self->token_types == NULL || self->token_modifiers == NULL) {
+        ts_elm_semantic_tokens_delete(self);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < mapping_count; i++) {
+        self->token_types[i] = mappings[i].token_type;
+        self->token_modifiers[i] = mappings[i].token_modifiers;
+    }
+    for (uint32_t i = 0; i < capture_count; i++) {
+        uint32_t length;
+        const char *name = ts_query_capture_name_for_id(query, i, &length);
+        self->capture_mappings[i] =
+            longest_mapping(name, length, mappings, mapping_count);
+    }
+    return self;
+}
+
+void ts_elm_semantic_tokens_delete(TSElmSemanticTokens *self) {
+    if (self == NULL) {
+        return;
+    }
+    if (self->cursor != NULL) {
+        ts_query_cursor_delete(self->cursor);
+    }
+    ts_query_delete(self->query);
+    free(self->capture_mappings);
+    free(self->token_types);
+    free(self->token_modifiers);
+    free(self->captures);
+    free(self->stack);
+    free(self->tokens);
+    free(self);
+}
+
+// Outer captures before the ones nested in them, and the first pattern first
+// when several capture the same node.
+static int compare_captures(const void *a, const void *b) {
+    const Capture *left = a, *right = b;
+    if (left->start_byte != right->start_byte) {
+        return left->start_byte < right->start_byte ? -1 : 1;
+    }
+    if (left->end_byte != right->end_byte) {
+        return left->end_byte > right->end_byte ? -1 : 1;
+    }
+    if (left->pattern_index != right->pattern_index) {
+        return left->pattern_index < right->pattern_index ? -1 : 1;
+    }
+    return 0;
+}
+
+static bool collect(TSElmSemanticTokens *self, TSNode root, uint32_t start_byte,
+                    uint32_t end_byte, uint32_t *count) {
+    ts_query_cursor_set_byte_range(self->cursor, start_byte, end_byte);
+    ts_query_cursor_exec(self->cursor, self->query, root);
+
+    TSQueryMatch match;
+    uint32_t capture_index;
+    *count = 0;
+    while (ts_query_cursor_next_capture(self->cursor, &match, &capture_index)) {
+        const TSQueryCapture *capture = &match.captures[capture_index];
+        uint32_t mapping = self->capture_mappings[capture->index];
+        if (mapping == NO_TOKEN) {
+            continue;
+        }
+        uint32_t start = ts_node_start_byte(capture->node);
+        uint32_t end = ts_node_end_byte(capture->node);
+        if (start < start_byte) {
+            start = start_byte;
+        }
+        if (end > end_byte) {
+            end = end_byte;
+        }
+        if (start >= end) {
+            continue;
+        }
+        if (!reserve((void **)&self->captures, &self->capture_capacity,
+                     *count + 1, sizeof(Capture))) {
+            return false;
+        }
+        TSPoint point = ts_node_start_point(capture->node);
+        self->captures[(*count)++] = (Capture){
+            .start_byte = start,
+            .end_byte = end,
+            .row = point.row,
+            .line_start_byte = ts_node_start_byte(capture->node) - point.column,
+            .pattern_index = match.pattern_index,
+            .mapping = mapping,
+        };
+    }
+    qsort(self->captures, *count, sizeof(Capture), compare_captures);
+    return true;
+}
+
+// Fill `self->tokens` with the tokens in `[start_byte, end_byte)`.
+static bool tokenize(TSElmSemanticTokens *self, TSNode root,
+                     const char *source, uint32_t start_byte,
+                     uint32_t end_byte) {
+    self->token_count = 0;
+    if (start_byte >= end_byte) {
+        return true;
+    }
+    uint32_t count;
+    if (!collect(self, root, start_byte, end_byte, &count)) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    // Start counting UTF-16 columns from the line of the first capture
+    const Capture *first = &self->captures[0];
+    Encoder encoder = {
+        .owner = self,
+        .source = source,
+        .byte = first->line_start_byte,
+        .row = first->row,
+    };
+
+    // Captures are nodes, so they either nest or are disjoint. Keep the open
+    // ones on a stack and give every byte to the innermost.
+    uint32_t depth = 0, position = first->start_byte;
+    for (uint32_t i = 0; i <= count; i++) {
+        const Capture *capture = i < count ? &self->captures[i] : NULL;
+        uint32_t next = capture != NULL ? capture->start_byte : end_byte;
+
+        while (depth > 0 && self->stack[depth - 1].end_byte <= next) {
+            const Open *top = &self->stack[--depth];
+            if (position < top->end_byte) {
+                emit(&encoder, top->mapping, position, top->end_byte);
+                position = top->end_byte;
+            }
+        }
+        if (capture == NULL) {
+            break;
+        }
+        if (depth > 0 && position < next) {
+            emit(&encoder, self->stack[depth - 1].mapping, position, next);
+        }
+        if (position < next) {
+            position = next;
+        }
+        if (capture->end_byte <= position ||
+            (i > 0 && capture->start_byte == self->captures[i - 1].start_byte &&
+             capture->end_byte == self->captures[i - 1].end_byte)) {
+            continue;
+        }
+
+        if (!reserve((void **)&self->stack, &self->stack_capacity, depth + 1,
+                     sizeof(Open))) {
+            return false;
+        }
+        self->stack[depth++] = (Open){capture->end_byte, capture->mapping};
+    }
+    return !encoder.failed;
+}
+
+static inline void encode_token(const Token *token, uint32_t *last_row,
+                                uint32_t *last_column, uint32_t *values) {
+    values[0] = token->row - *last_row;
+    values[1] = token->row == *last_row ? token->column - *last_column
+                                        : token->column;
+    values[2] = token->length;
+    values[3] = token->type;
+    values[4] = token->modifiers;
+    *last_row = token->row;
+    *last_column = token->column;
+}
+
+uint32_t ts_elm_semantic_tokens_encode(TSElmSemanticTokens *self, TSNode root,
+                                       const char *source, uint32_t start_byte,
+                                       uint32_t end_byte, uint32_t *data,
+                                       uint32_t capacity) {
+    if (!tokenize(self, root, source, start_byte, end_byte)) {
+        return 0;
+    }
+    uint32_t last_row = 0, last_column = 0, count = 0;
+    for (uint32_t i = 0; i < self->token_count; i++) {
+        uint32_t values[TOKEN_SIZE];
+        encode_token(&self->tokens[i], &last_row, &last_column, values);
+        for (uint32_t j = 0; j < TOKEN_SIZE; j++, count++) {
+            if (count < capacity) {
+                data[count] = values[j];
+            }
+        }
+    }
+    return count;
+}
+
+static bool output_reserve(Output *self, uint32_t count) {
+    if (count <= self->capacity) {
+        return true;
+    }
+    uint32_t capacity = self->capacity;
+    if (!reserve((void **)&self->starts, &capacity, count, sizeof(uint32_t))) {
+        return false;
+    }
+    uint32_t *data =
+        realloc(self->data, (size_t)capacity * TOKEN_SIZE * sizeof(uint32_t));
+    if (data == NULL) {
+        return false;
+    }
+    self->data = data;
+    self->capacity = capacity;
+    return true;
+}
+
+static bool output_tokens(Output *self, const Token *tokens, uint32_t count) {
+    if (!output_reserve(self, self->count + count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++, self->count++) {
+        self->starts[self->count] = tokens[i].start_byte;
+        encode_token(&tokens[i], &self->last_row, &self->last_column,
+                     &self->data[self->count * TOKEN_SIZE]);
+    }
+    return true;
+}
+
+// Append the already encoded tokens `[start, end)` of `from`.
+static bool output_copy(Output *self, const Output *from, uint32_t start,
+                        uint32_t end) {
+    if (start == end) {
+        return true;
+    }
+    if (!output_reserve(self, self->count + (end - start))) {
+        return false;
+    }
+    memcpy(&self->starts[self->count], &from->starts[start],
+           (end - start) * sizeof(uint32_t));
+    memcpy(&self->data[self->count * TOKEN_SIZE],
+           &from->data[start * TOKEN_SIZE],
+           (end - start) * TOKEN_SIZE * sizeof(uint32_t));
+    self->count += end - start;
+    return true;
+}
+
+static void output_delete(Output *self) {
+    free(self->starts);
+    free(self->data);
+    *self = (Output){0};
+}
+
+TSElmSemanticTokensCache *ts_elm_semantic_tokens_cache_new(void) {
+    return calloc(1, sizeof(TSElmSemanticTokensCache));
+}
+
+void ts_elm_semantic_tokens_cache_delete(TSElmSemanticTokensCache *self) {
+    if (self == NULL) {
+        return;
+    }
+    output_delete(&self->tokens);
+    free(self->edits);
+    free(self->ranges);
+    free(self);
+}
+
+const uint32_t *ts_elm_semantic_tokens_cache_data(
+    const TSElmSemanticTokensCache *self, uint32_t *length) {
+    *length = self->tokens.count * TOKEN_SIZE;
+    return self->tokens.data;
+}
+
+const TSElmSemanticTokensEdit *ts_elm_semantic_tokens_cache_edits(
+    const TSElmSemanticTokensCache *self, uint32_t *count) {
+    *count = self->edit_count;
+    return self->edits;
+}
+
+bool ts_elm_semantic_tokens_cache_reset(TSElmSemanticTokens *self,
+                                        TSElmSemanticTokensCache *cache,
+                                        TSNode root, const char *source,
+                                        uint32_t length) {
+    cache->tokens.count = 0;
+    cache->tokens.last_row = 0;
+    cache->tokens.last_column = 0;
+    cache->edit_count = 0;
+    if (tokenize(self, root, source, 0, length) &&
+        output_tokens(&cache->tokens, self->tokens, self->token_count)) {
+        return true;
+    }
+    cache->tokens.count = 0;
+    return false;
+}
+
+// Where a byte before an edit ends up after it. Bytes in the replaced text
+// move to the start of the edit when they start a range, or to its new end
+// when they end one.
+static inline uint32_t shift_start(uint32_t byte, const TSInputEdit *edit) {
+    if (byte < edit->start_byte) {
+        return byte;
+    }
+    if (byte >= edit->old_end_byte) {
+        return byte - edit->old_end_byte + edit->new_end_byte;
+    }
+    return edit->start_byte;
+}
+
+static inline uint32_t shift_end(uint32_t byte, const TSInputEdit *edit) {
+    if (byte <= edit->start_byte) {
+        return byte;
+    }
+    if (byte >= edit->old_end_byte) {
+        return byte - edit->old_end_byte + edit->new_end_byte;
+    }
+    return edit->new_end_byte;
+}
+
+// Widen a range to the top-level nodes it touches and then to whole lines,
+// so that the tokens outside it keep their positions relative to each other.
+static Range widen(TSNode root, const char *source, uint32_t length,
+                   Range range) {
+    TSNode first = ts_node_first_child_for_byte(root, range.start_byte);
+    if (!ts_node_is_null(first) &&
+        ts_node_start_byte(first) < range.start_byte) {
+        range.start_byte = ts_node_start_byte(first);
+    }
+    TSNode last = ts_node_first_child_for_byte(
+        root, range.end_byte > 0 ? range.end_byte - 1 : 0);
+    if (!ts_node_is_null(last) && ts_node_start_byte(last) < range.end_byte &&
+        ts_node_end_byte(last) > range.end_byte) {
+        range.end_byte = ts_node_end_byte(last);
+    }
+    if (range.end_byte > length) {
+        range.end_byte = length;
+    }
+    while (range.start_byte > 0 && source[range.start_byte - 1] != '\n') {
+        range.start_byte--;
+    }
+    // Text right after an edit can join a token that started in it
+    while (range.end_byte < length && source[range.end_byte] != '\n') {
+        range.end_byte++;
+    }
+    if (range.end_byte < length) {
+        range.end_byte++;
+    }
+    return range;
+}
+
+static int compare_ranges(const void *a, const void *b) {
+    const Range *left = a, *right = b;
+    if (left->start_byte != right->start_byte) {
+        return left->start_byte < right->start_byte ? -1 : 1;
+    }
+    return 0;
+}
+
+// The row and UTF-16 column of a token that starts at `byte`.
+static void locate(TSNode root, const char *source, uint32_t byte,
+                   uint32_t *row, uint32_t *column) {
+    TSNode node = ts_node_descendant_for_byte_range(root, byte, byte);
+    TSPoint point = ts_node_start_point(node);
+    uint32_t line_start = ts_node_start_byte(node) - point.column;
+    *row = point.row;
+    for (uint32_t i = ts_node_start_byte(node); i < byte; i++) {
+        if (source[i] == '\n') {
+            (*row)++;
+            line_start = i + 1;
+        }
+    }
+    *column = 0;
+    for (uint32_t i = line_start; i < byte; i++) {
+        *column += utf16_width((unsigned char)source[i]);
+    }
+}
+
+// Index of the first token from `from` on that starts at or after `byte`.
+static uint32_t lower_bound(const Output *tokens, uint32_t from,
+                            uint32_t byte) {
+    uint32_t low = from, high = tokens->count;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (tokens->starts[middle] < byte) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// Move the cached tokens to the new source and gather the ranges to
+// highlight again, widened, sorted and merged. Returns their count.
+static uint32_t collect_ranges(TSElmSemanticTokensCache *self,
+                               const TSTree *old_tree, const TSTree *new_tree,
+                               const char *source, uint32_t length,
+                               const TSInputEdit *edits, uint32_t edit_count,
+                               bool *ok) {
+    uint32_t changed_count;
+    TSRange *changed =
+        ts_tree_get_changed_ranges(old_tree, new_tree, &changed_count);
+    *ok = reserve((void **)&self->ranges, &self->range_capacity,
+                  edit_count + changed_count, sizeof(Range));
+    if (!*ok) {
+        free(changed);
+        return 0;
+    }
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < edit_count; i++) {
+        const TSInputEdit *edit = &edits[i];
+        for (uint32_t j = 0; j < self->tokens.count; j++) {
+            self->tokens.starts[j] = shift_start(self->tokens.starts[j], edit);
+        }
+        for (uint32_t j = 0; j < count; j++) {
+            self->ranges[j].start_byte =
+                shift_start(self->ranges[j].start_byte, edit);
+            self->ranges[j].end_byte = shift_end(self->ranges[j].end_byte, edit);
+        }
+        self->ranges[count++] = (Range){edit->start_byte, edit->new_end_byte};
+    }
+    for (uint32_t i = 0; i < changed_count; i++) {
+        self->ranges[count++] = (Range){changed[i].start_byte, changed[i].end_byte};
+    }
+    free(changed);
+
+    TSNode root = ts_tree_root_node(new_tree);
+    for (uint32_t i = 0; i < count; i++) {
+        self->ranges[i] = widen(root, source, length, self->ranges[i]);
+    }
+    qsort(self->ranges, count, sizeof(Range), compare_ranges);
+    uint32_t merged = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        Range *previous = merged > 0 ? &self->ranges[merged - 1] : NULL;
+        if (previous != NULL && self->ranges[i].start_byte <= previous->end_byte) {
+            if (self->ranges[i].end_byte > previous->end_byte) {
+                previous->end_byte = self->ranges[i].end_byte;
+            }
+        } else {
+            self->ranges[merged++] = self->ranges[i];
+        }
+    }
+    return merged;
+}
+
+bool ts_elm_semantic_tokens_cache_update(TSElmSemanticTokens *self,
+                                         TSElmSemanticTokensCache *cache,
+                                         const TSTree *old_tree,
+                                         const TSTree *new_tree,
+                                         const char *source, uint32_t length,
+                                         const TSInputEdit *edits,
+                                         uint32_t edit_count) {
+    TSNode root = ts_tree_root_node(new_tree);
+    const Output *old = &cache->tokens;
+    cache->edit_count = 0;
+
+    bool ok;
+    uint32_t range_count = collect_ranges(cache, old_tree, new_tree, source,
+                                          length, edits, edit_count, &ok);
+
+    // Tokens between the ranges are copied as they are, except for the first
+    // one after a range: it is encoded relative to a token that may have
+    // changed, so it becomes part of that range's edit.
+    Output output = {0};
+    uint32_t kept = 0;
+    for (uint32_t i = 0; ok && i < range_count; i++) {
+        const Range *range = &cache->ranges[i];
+        uint32_t first = lower_bound(old, kept, range->start_byte);
+        // Tokens deleted at the end of the source start at its new length
+        uint32_t after = range->end_byte < length
+                             ? lower_bound(old, first, range->end_byte)
+                             : old->count;
+        if (!output_copy(&output, old, kept, first)) {
+            ok = false;
+            break;
+        }
+        if (first > kept) {
+            locate(root, source, output.starts[output.count - 1],
+                   &output.last_row, &output.last_column);
+        }
+
+        uint32_t data_start = output.count;
+        if (!tokenize(self, root, source, range->start_byte, range->end_byte) ||
+            !output_tokens(&output, self->tokens, self->token_count)) {
+            ok = false;
+            break;
+        }
+
+        kept = after;
+        if (after < old->count &&
+            (i + 1 == range_count ||
+             old->starts[after] < cache->ranges[i + 1].start_byte)) {
+            const uint32_t *values = &old->data[after * TOKEN_SIZE];
+            Token token = {
+                .start_byte = old->starts[after],
+                .length = values[2],
+                .type = values[3],
+                .modifiers = values[4],
+            };
+            locate(root, source, token.start_byte, &token.row, &token.column);
+            if (!output_tokens(&output, &token, 1)) {
+                ok = false;
+                break;
+            }
+            kept++;
+        }
+
+        if (kept == first && output.count == data_start) {
+            continue;
+        }
+        if (!reserve((void **)&cache->edits, &cache->edit_capacity,
+                     cache->edit_count + 1, sizeof(TSElmSemanticTokensEdit))) {
+            ok = false;
+            break;
+        }
+        cache->edits[cache->edit_count++] = (TSElmSemanticTokensEdit){
+            .start = first * TOKEN_SIZE,
+            .delete_count = (kept - first) * TOKEN_SIZE,
+            .data_start = data_start * TOKEN_SIZE,
+            .data_count = (output.count - data_start) * TOKEN_SIZE,
+        };
+    }
+    ok = ok && output_copy(&output, old, kept, old->count);
+
+    output_delete(&cache->tokens);
+    if (!ok) {
+        output_delete(&output);
+        cache->edit_count = 0;
+    }
+    cache->tokens = output;
+    return ok;
+}
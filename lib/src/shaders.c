@@ -0,0 +1,233 @@
+#include "tree_sitter/elm/shaders.h"
+#include "symbols.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char OPEN[] = "[glsl|";
+#define OPEN_LENGTH ((uint32_t)sizeof(OPEN) - 1)
+
+// A parsed shader, with a copy of its content to tell hash collisions apart
+typedef struct {
+    uint64_t hash;
+    uint32_t length;
+    char *content;
+    TSTree *tree;
+    bool used;
+} Entry;
+
+struct TSElmShaders {
+    TSParser *parser;
+    const char *source;
+    TSElmShader *shaders;
+    uint32_t shader_count;
+    uint32_t shader_capacity;
+    Entry *entries;
+    uint32_t entry_count;
+    uint32_t entry_capacity;
+};
+
+static bool reserve(void **items, uint32_t *capacity, uint32_t count,
+                    size_t size) {
+    if (count <= *capacity) {
+        return true;
+    }
+    uint32_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < count) {
+        new_capacity *= 2;
+    }
+    void *new_items = realloc(*items, new_capacity * size);
+    if (new_items == NULL) {
+        return false;
+    }
+    *items = new_items;
+    *capacity = new_capacity;
+    return true;
+}
+
+static uint64_t hash(const char *string, uint32_t length) {
+    uint64_t hash = 0xcbf29ce484222325u;
+    for (uint32_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)string[i];
+        hash *= 0x100000001b3u;
+    }
+    return hash;
+}
+
+static Entry *find(const TSElmShaders *self, const TSElmShader *shader) {
+    const char *content = self->source + shader->start_byte;
+    uint32_t length = shader->end_byte - shader->start_byte;
+    for (uint32_t i = 0; i < self->entry_count; i++) {
+        Entry *entry = &self->entries[i];
+        if (entry->hash == shader->hash && entry->length == length &&
+            memcmp(entry->content, content, length) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// The next `[glsl|` at or after `start`, or `length` if there is none.
+static uint32_t find_open(const char *source, uint32_t start, uint32_t length) {
+    while (length - start >= OPEN_LENGTH) {
+        const char *open =
+            memchr(source + start, '[', length - start - OPEN_LENGTH + 1);
+        if (open == NULL) {
+            break;
+        }
+        start = (uint32_t)(open - source);
+        if (memcmp(open, OPEN, OPEN_LENGTH) == 0) {
+            return start;
+        }
+        start++;
+    }
+    return length;
+}
+
+TSElmShaders *ts_elm_shaders_new(const TSLanguage *language) {
+    TSElmShaders *self = calloc(1, sizeof(TSElmShaders));
+    if (self == NULL) {
+        return NULL;
+    }
+    self->parser = ts_parser_new();
+    if (self->parser == NULL || !ts_parser_set_language(self->parser, language)) {
+        ts_elm_shaders_delete(self);
+        return NULL;
+    }
+    return self;
+}
+
+void ts_elm_shaders_delete(TSElmShaders *self) {
+    if (self == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < self->entry_count; i++) {
+        ts_tree_delete(self->entries[i].tree);
+        free(self->entries[i].content);
+    }
+    if (self->parser != NULL) {
+        ts_parser_delete(self->parser);
+    }
+    free(self->entries);
+    free(self->shaders);
+    free(self);
+}
+
+bool ts_elm_shaders_set_tree(TSElmShaders *self, const TSTree *tree,
+                             const char *source, uint32_t length) {
+    self->source = source;
+    self->shader_count = 0;
+    if (tree != NULL) {
+        const ElmSymbols *symbols = elm_symbols();
+        TSNode root = ts_tree_root_node(tree);
+        uint32_t start = find_open(source, 0, length);
+        while (start < length) {
+            // `[glsl|` may as well be in a string or a comment
+            TSNode node = ts_node_descendant_for_byte_range(root, start, start + OPEN_LENGTH);
+            if (ts_node_symbol(node) != symbols->glsl_code_expr) {
+                node = ts_node_parent(node);
+            }
+            TSNode content = ts_node_child_by_field_id(node, symbols->field_content);
+            uint32_t next = start + 1;
+            if (ts_node_symbol(node) == symbols->glsl_code_expr &&
+                ts_node_start_byte(node) == start && !ts_node_is_null(content)) {
+                if (!reserve((void **)&self->shaders, &self->shader_capacity,
+                             self->shader_count + 1, sizeof(TSElmShader))) {
+                    self->shader_count = 0;
+                    return false;
+                }
+                TSElmShader *shader = &self->shaders[self->shader_count++];
+                shader->start_byte = ts_node_start_byte(content);
+                shader->end_byte = ts_node_end_byte(content);
+                shader->start_point = ts_node_start_point(content);
+                shader->end_point = ts_node_end_point(content);
+                shader->hash = hash(source + shader->start_byte,
+                                    shader->end_byte - shader->start_byte);
+                next = ts_node_end_byte(node);
+            }
+            start = find_open(source, next, length);
+        }
+    }
+
+    // Free the trees of shaders that were edited or removed
+    for (uint32_t i = 0; i < self->entry_count; i++) {
+        self->entries[i].used = false;
+    }
+    for (uint32_t i = 0; i < self->shader_count; i++) {
+        Entry *entry = find(self, &self->shaders[i]);
+        if (entry != NULL) {
+            entry->used = true;
+        }
+    }
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < self->entry_count; i++) {
+        if (self->entries[i].used) {
+            self->entries[kept++] = self->entries[i];
+        } else {
+            ts_tree_delete(self->entries[i].tree);
+            free(self->entries[i].content);
+        }
+    }
+    self->entry_count = kept;
+    return true;
+}
+
+const TSElmShader *ts_elm_shaders_ranges(const TSElmShaders *self,
+                                         uint32_t *count) {
+    *count = self->shader_count;
+    return self->shaders;
+}
+
+const TSTree *ts_elm_shaders_tree(TSElmShaders *self, uint32_t index) {
+    if (index >= self->shader_count) {
+        return NULL;
+    }
+    const TSElmShader *shader = &self->shaders[index];
+    Entry *cached = find(self, shader);
+    if (cached != NULL) {
+        return cached->tree;
+    }
+    if (!reserve((void **)&self->entries, &self->entry_capacity,
+                 self->entry_count + 1, sizeof(Entry))) {
+        return NULL;
+    }
+
+    uint32_t length = shader->end_byte - shader->start_byte;
+    char *content = malloc(length + 1);
+    if (content == NULL) {
+        return NULL;
+    }
+    memcpy(content, self->source + shader->start_byte, length);
+    TSTree *tree = ts_parser_parse_string(self->parser, NULL, content, length);
+    if (tree == NULL) {
+        free(content);
+        return NULL;
+    }
+    self->entries[self->entry_count++] = (Entry){
+        .hash = shader->hash,
+        .length = length,
+        .content = content,
+        .tree = tree,
+        .used = true,
+    };
+    return tree;
+}
+
+uint32_t ts_elm_shaders_parse_rows(TSElmShaders *self, uint32_t start_row,
+                                   uint32_t end_row) {
+    uint32_t parsed = 0;
+    for (uint32_t i = 0; i < self->shader_count; i++) {
+        const TSElmShader *shader = &self->shaders[i];
+        if (shader->start_point.row >= end_row) {
+            break;
+        }
+        bool visible = shader->end_point.row > start_row ||
+                       (shader->end_point.row == start_row &&
+                        shader->end_point.column > 0);
+        if (visible && find(self, shader) == NULL &&
+            ts_elm_shaders_tree(self, i) != NULL) {
+            parsed++;
+        }
+    }
+    return parsed;
+}
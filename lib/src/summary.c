@@ -0,0 +1,66 @@
+#include "tree_sitter/elm/summary.h"
+#include "symbols.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+bool ts_elm_summary_build(TSElmSummary *self, TSNode root) {
+    const ElmSymbols *s = elm_symbols();
+    memset(self, 0, sizeof(*self));
+    self->has_error = ts_node_has_error(root);
+
+    uint32_t child_count = ts_node_child_count(root);
+    if (child_count == 0) {
+        return true;
+    }
+
+    // Every top-level child is at most one declaration or import, so the
+    // child count bounds both arrays.
+    self->declarations = malloc(child_count * sizeof(TSElmDeclaration));
+    self->imports = malloc(child_count * sizeof(TSElmImport));
+    if (self->declarations == NULL || self->imports == NULL) {
+        ts_elm_summary_delete(self);
+        return false;
+    }
+
+    // Walk with a cursor, `ts_node_child` rescans the siblings on every call.
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    bool more = ts_tree_cursor_goto_first_child(&cursor);
+    for (; more; more = ts_tree_cursor_goto_next_sibling(&cursor)) {
+        TSNode child = ts_tree_cursor_current_node(&cursor);
+        TSSymbol symbol = ts_node_symbol(child);
+
+        if (symbol == s->import_clause) {
+            TSNode name = ts_node_child_by_field_id(child, s->field_module_name);
+            TSElmImport *import = &self->imports[self->import_count++];
+            import->start_byte = ts_node_start_byte(child);
+            import->end_byte = ts_node_end_byte(child);
+            import->name_start_byte = ts_node_start_byte(name);
+            import->name_end_byte = ts_node_end_byte(name);
+        } else if (elm_is_declaration(s, symbol)) {
+            TSNode name = elm_declaration_name(s, child);
+            TSElmDeclaration *declaration =
+                &self->declarations[self->declaration_count++];
+            declaration->symbol = symbol;
+            declaration->start_byte = ts_node_start_byte(child);
+            declaration->end_byte = ts_node_end_byte(child);
+            declaration->start_point = ts_node_start_point(child);
+            if (ts_node_is_null(name)) {
+                declaration->name_start_byte = declaration->start_byte;
+                declaration->name_end_byte = declaration->start_byte;
+            } else {
+                declaration->name_start_byte = ts_node_start_byte(name);
+                declaration->name_end_byte = ts_node_end_byte(name);
+            }
+        }
+    }
+    ts_tree_cursor_delete(&cursor);
+
+    return true;
+}
+
+void ts_elm_summary_delete(TSElmSummary *self) {
+    free(self->declarations);
+    free(self->imports);
+    memset(self, 0, sizeof(*self));
+}
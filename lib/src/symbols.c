@@ -0,0 +1,77 @@
+#include "symbols.h"
+#include "thread.h"
+#include "tree_sitter/tree-sitter-elm.h"
+
+#include <string.h>
+
+static ElmSymbols symbols;
+static elm_once_t symbols_once = ELM_ONCE_INIT;
+
+static TSSymbol symbol(const char *name) {
+    return ts_language_symbol_for_name(elm_language(), name,
+                                       (uint32_t)strlen(name), true);
+}
+
+static TSFieldId field(const char *name) {
+    return ts_language_field_id_for_name(elm_language(), name,
+                                         (uint32_t)strlen(name));
+}
+
+static void symbols_init(void) {
+    symbols.module_declaration = symbol("module_declaration");
+    symbols.import_clause = symbol("import_clause");
+    symbols.value_declaration = symbol("value_declaration");
+    symbols.function_declaration_left = symbol("function_declaration_left");
+    symbols.type_declaration = symbol("type_declaration");
+    symbols.type_alias_declaration = symbol("type_alias_declaration");
+    symbols.type_annotation = symbol("type_annotation");
+    symbols.port_annotation = symbol("port_annotation");
+    symbols.infix_declaration = symbol("infix_declaration");
+    symbols.glsl_code_expr = symbol("glsl_code_expr");
+    symbols.bin_op_expr = symbol("bin_op_expr");
+    symbols.operator_node = symbol("operator");
+    symbols.block_comment = symbol("block_comment");
+    symbols.union_variant = symbol("union_variant");
+    symbols.record_type = symbol("record_type");
+    symbols.field_type = symbol("field_type");
+    symbols.let_in_expr = symbol("let_in_expr");
+
+    symbols.field_name = field("name");
+    symbols.field_module_name = field("moduleName");
+    symbols.field_function_declaration_left = field("functionDeclarationLeft");
+    symbols.field_pattern = field("pattern");
+    symbols.field_operator = field("operator");
+    symbols.field_content = field("content");
+    symbols.field_associativity = field("associativity");
+    symbols.field_precedence = field("precedence");
+    symbols.field_type_expression = field("typeExpression");
+}
+
+const TSLanguage *elm_language(void) { return tree_sitter_elm(); }
+
+const ElmSymbols *elm_symbols(void) {
+    elm_call_once(&symbols_once, symbols_init);
+    return &symbols;
+}
+
+bool elm_is_declaration(const ElmSymbols *s, TSSymbol symbol) {
+    return symbol == s->value_declaration || symbol == s->type_declaration ||
+           symbol == s->type_alias_declaration ||
+           symbol == s->port_annotation || symbol == s->infix_declaration;
+}
+
+TSNode elm_declaration_name(const ElmSymbols *s, TSNode node) {
+    TSSymbol symbol = ts_node_symbol(node);
+    if (symbol == s->value_declaration) {
+        TSNode left =
+            ts_node_child_by_field_id(node, s->field_function_declaration_left);
+        if (!ts_node_is_null(left)) {
+            return ts_node_named_child(left, 0);
+        }
+        return ts_node_child_by_field_id(node, s->field_pattern);
+    }
+    if (symbol == s->infix_declaration) {
+        return ts_node_child_by_field_id(node, s->field_operator);
+    }
+    return ts_node_child_by_field_id(node, s->field_name);
+}
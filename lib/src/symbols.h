@@ -0,0 +1,51 @@
+#ifndef TREE_SITTER_ELM_SYMBOLS_H_
+#define TREE_SITTER_ELM_SYMBOLS_H_
+
+#include "tree_sitter/api.h"
+
+// Symbol and field ids of the Elm grammar that the helpers look at.
+// They are resolved by name once, so the helpers keep working when the
+// generated parser renumbers its symbols.
+typedef struct {
+    TSSymbol module_declaration;
+    TSSymbol import_clause;
+    TSSymbol value_declaration;
+    TSSymbol function_declaration_left;
+    TSSymbol type_declaration;
+    TSSymbol type_alias_declaration;
+    TSSymbol type_annotation;
+    TSSymbol port_annotation;
+    TSSymbol infix_declaration;
+    TSSymbol glsl_code_expr;
+    TSSymbol bin_op_expr;
+    TSSymbol operator_node;
+    TSSymbol block_comment;
+    TSSymbol union_variant;
+    TSSymbol record_type;
+    TSSymbol field_type;
+    TSSymbol let_in_expr;
+
+    TSFieldId field_name;
+    TSFieldId field_module_name;
+    TSFieldId field_function_declaration_left;
+    TSFieldId field_pattern;
+    TSFieldId field_operator;
+    TSFieldId field_content;
+    TSFieldId field_associativity;
+    TSFieldId field_precedence;
+    TSFieldId field_type_expression;
+} ElmSymbols;
+
+const TSLanguage *elm_language(void);
+
+const ElmSymbols *elm_symbols(void);
+
+// Whether `symbol` is one of the top-level declarations the summaries
+// report: a value, type, type alias, port or infix declaration.
+bool elm_is_declaration(const ElmSymbols *s, TSSymbol symbol);
+
+// The identifier a declaration declares, or the whole pattern of a
+// destructuring value declaration. May be a null node on broken input.
+TSNode elm_declaration_name(const ElmSymbols *s, TSNode node);
+
+#endif // TREE_SITTER_ELM_SYMBOLS_H_
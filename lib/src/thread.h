@@ -0,0 +1,88 @@
+#ifndef TREE_SITTER_ELM_THREAD_H_
+#define TREE_SITTER_ELM_THREAD_H_
+
+// Minimal portable threading used by the batch helpers. Only what the
+// helpers need is wrapped: starting and joining a thread, one-time
+// initialization and the number of online CPUs.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+typedef HANDLE elm_thread_t;
+typedef INIT_ONCE elm_once_t;
+
+#define ELM_ONCE_INIT INIT_ONCE_STATIC_INIT
+#define ELM_THREAD_FN(name, arg) DWORD WINAPI name(LPVOID arg)
+#define ELM_THREAD_RETURN return 0
+
+typedef DWORD(WINAPI *elm_thread_fn)(LPVOID);
+
+static inline bool elm_thread_start(elm_thread_t *thread, elm_thread_fn fn,
+                                    void *arg) {
+    *thread = CreateThread(NULL, 0, fn, arg, 0, NULL);
+    return *thread != NULL;
+}
+
+static inline void elm_thread_join(elm_thread_t thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+static BOOL CALLBACK elm_once_trampoline(PINIT_ONCE once, PVOID fn,
+                                         PVOID *context) {
+    (void)once;
+    (void)context;
+    ((void (*)(void))fn)();
+    return TRUE;
+}
+
+static inline void elm_call_once(elm_once_t *once, void (*fn)(void)) {
+    InitOnceExecuteOnce(once, elm_once_trampoline, (PVOID)fn, NULL);
+}
+
+static inline uint32_t elm_cpu_count(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+}
+
+#else
+
+#include <pthread.h>
+#include <unistd.h>
+
+typedef pthread_t elm_thread_t;
+typedef pthread_once_t elm_once_t;
+
+#define ELM_ONCE_INIT PTHREAD_ONCE_INIT
+#define ELM_THREAD_FN(name, arg) void *name(void *arg)
+#define ELM_THREAD_RETURN return NULL
+
+typedef void *(*elm_thread_fn)(void *);
+
+static inline bool elm_thread_start(elm_thread_t *thread, elm_thread_fn fn,
+                                    void *arg) {
+    return pthread_create(thread, NULL, fn, arg) == 0;
+}
+
+static inline void elm_thread_join(elm_thread_t thread) {
+    pthread_join(thread, NULL);
+}
+
+static inline void elm_call_once(elm_once_t *once, void (*fn)(void)) {
+    pthread_once(once, fn);
+}
+
+static inline uint32_t elm_cpu_count(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (uint32_t)count : 1;
+}
+
+#endif
+
+#endif // TREE_SITTER_ELM_THREAD_H_
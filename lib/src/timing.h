@@ -0,0 +1,35 @@
+#ifndef TREE_SITTER_ELM_TIMING_H_
+#define TREE_SITTER_ELM_TIMING_H_
+
+// The clock of the parse budgets, which they also hand to the external
+// scanner's timing hook in src/scanner_timing.h.
+
+#include "../../src/scanner_timing.h"
+
+#include <stdint.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// A monotonic clock in nanoseconds.
+static inline uint64_t elm_nanos(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000u + (uint64_t)time.tv_nsec;
+#endif
+}
+
+#endif // TREE_SITTER_ELM_TIMING_H_
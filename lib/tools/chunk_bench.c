@@ -0,0 +1,171 @@
+// Measures summarizing large sources in chunks on several threads against a
+// sequential parse, for 1, 2, 4... threads up to the number of online CPUs,
+// and checks that both give the same summary.
+//
+// Usage: tree-sitter-elm-chunk-bench [options] file...
+//   --runs N          timed runs per thread count, 5 by default
+//   --chunk-size N    minimum chunk size in bytes, 64 KiB by default
+//   --check           only compare the summaries, fail on a difference
+// Files ending in .txt are read as test corpus files and each of their
+// examples is summarized, other files are summarized whole.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "tools.h"
+#include "tree_sitter/elm/batch.h"
+#include "tree_sitter/tree-sitter-elm.h"
+
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_THREAD_COUNTS 16
+
+typedef struct {
+    TSParser *parser;
+    int runs;
+    uint32_t chunk_size;
+    bool check;
+    size_t sources;
+    size_t mismatches;
+    size_t bytes;
+    uint32_t thread_counts[MAX_THREAD_COUNTS];
+    uint32_t thread_count_count;
+    double sequential_seconds;
+    double chunked_seconds[MAX_THREAD_COUNTS];
+} Bench;
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+static void summarize(Bench *bench, const char *source, size_t length,
+                      TSElmSummary *summary) {
+    TSTree *tree = ts_parser_parse_string(bench->parser, NULL, source, (uint32_t)length);
+    ts_elm_summary_build(summary, ts_tree_root_node(tree));
+    ts_tree_delete(tree);
+}
+
+static bool same_summary(const TSElmSummary *a, const TSElmSummary *b) {
+    if (a->declaration_count != b->declaration_count ||
+        a->import_count != b->import_count || a->has_error != b->has_error) {
+        return false;
+    }
+    for (uint32_t i = 0; i < a->declaration_count; i++) {
+        const TSElmDeclaration *x = &a->declarations[i];
+        const TSElmDeclaration *y = &b->declarations[i];
+        if (x->symbol != y->symbol || x->start_byte != y->start_byte ||
+            x->end_byte != y->end_byte || x->name_start_byte != y->name_start_byte ||
+            x->name_end_byte != y->name_end_byte || x->start_point.row != y->start_point.row ||
+            x->start_point.column != y->start_point.column) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < a->import_count; i++) {
+        const TSElmImport *x = &a->imports[i];
+        const TSElmImport *y = &b->imports[i];
+        if (x->start_byte != y->start_byte || x->end_byte != y->end_byte ||
+            x->name_start_byte != y->name_start_byte || x->name_end_byte != y->name_end_byte) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void check(Bench *bench, const char *source, size_t length) {
+    TSElmSummary sequential, chunked;
+    summarize(bench, source, length, &sequential);
+    if (!ts_elm_summarize_source(source, (uint32_t)length, 0, bench->chunk_size, &chunked)) {
+        fprintf(stderr, "out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    if (!same_summary(&sequential, &chunked)) {
+        bench->mismatches++;
+        fprintf(stderr, "summaries differ for:\n%.*s\n", (int)length, source);
+    }
+    ts_elm_summary_delete(&sequential);
+    ts_elm_summary_delete(&chunked);
+}
+
+static void run(const char *source, size_t length, void *payload) {
+    Bench *bench = payload;
+    bench->sources++;
+    check(bench, source, length);
+    if (bench->check) {
+        return;
+    }
+
+    bench->bytes += length * (size_t)bench->runs;
+    for (int i = 0; i < bench->runs; i++) {
+        TSElmSummary summary;
+        double start = now();
+        summarize(bench, source, length, &summary);
+        bench->sequential_seconds += now() - start;
+        ts_elm_summary_delete(&summary);
+
+        for (uint32_t j = 0; j < bench->thread_count_count; j++) {
+            start = now();
+            ts_elm_summarize_source(source, (uint32_t)length, bench->thread_counts[j],
+                                    bench->chunk_size, &summary);
+            bench->chunked_seconds[j] += now() - start;
+            ts_elm_summary_delete(&summary);
+        }
+    }
+}
+
+static void print(const char *name, size_t bytes, double seconds, double baseline) {
+    printf("%-12s %10.2f ms %8.2f MB/s %6.2fx\n", name, seconds * 1000,
+           seconds > 0 ? (double)bytes / seconds / 1e6 : 0,
+           seconds > 0 ? baseline / seconds : 0);
+}
+
+int main(int argc, char **argv) {
+    Bench bench = {.runs = 5};
+    int first_file = 1;
+    for (; first_file < argc; first_file++) {
+        if (strcmp(argv[first_file], "--check") == 0) {
+            bench.check = true;
+        } else if (first_file + 1 < argc && strcmp(argv[first_file], "--runs") == 0) {
+            bench.runs = atoi(argv[++first_file]);
+        } else if (first_file + 1 < argc && strcmp(argv[first_file], "--chunk-size") == 0) {
+            bench.chunk_size = (uint32_t)strtoul(argv[++first_file], NULL, 10);
+        } else {
+            break;
+        }
+    }
+    if (first_file >= argc || bench.runs < 0) {
+        fprintf(stderr, "usage: %s [--runs N] [--chunk-size N] [--check] file...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    for (uint32_t threads = 1; bench.thread_count_count < MAX_THREAD_COUNTS; threads *= 2) {
+        if (threads >= (uint32_t)(cpus > 1 ? cpus : 1)) {
+            bench.thread_counts[bench.thread_count_count++] = (uint32_t)(cpus > 1 ? cpus : 1);
+            break;
+        }
+        bench.thread_counts[bench.thread_count_count++] = threads;
+    }
+
+    bench.parser = ts_parser_new();
+    ts_parser_set_language(bench.parser, tree_sitter_elm());
+    for (int i = first_file; i < argc; i++) {
+        if (!for_each_source(argv[i], run, &bench)) {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    ts_parser_delete(bench.parser);
+
+    printf("%zu sources, %zu summaries differ\n", bench.sources, bench.mismatches);
+    if (!bench.check) {
+        print("sequential", bench.bytes, bench.sequential_seconds, bench.sequential_seconds);
+        for (uint32_t i = 0; i < bench.thread_count_count; i++) {
+            char name[32];
+            snprintf(name, sizeof(name), "%u threads", bench.thread_counts[i]);
+            print(name, bench.bytes, bench.chunked_seconds[i], bench.sequential_seconds);
+        }
+    }
+    return bench.mismatches > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+// Compares three ways of handing a file to the parser: reading it whole into
+// a string, mapping it with ts_elm_file_input_map, and reading it in chunks
+// with ts_elm_file_input_stream. Each way runs in its own child process,
+// which reports how long the parse took and its peak resident set size.
+//
+// Usage: tree-sitter-elm-input-bench [--buffer N] [--generate MB] file
+// --buffer sets the chunk size of the stream in bytes, and --generate first
+// writes a module of about MB megabytes to the file.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "tools.h"
+#include "tree_sitter/elm/input.h"
+#include "tree_sitter/tree-sitter-elm.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef enum { STRING, MAP, STREAM } Mode;
+
+static const char *MODE_NAMES[] = {"string", "mmap", "stream"};
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+static bool generate(const char *path, long megabytes) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        return false;
+    }
+    fprintf(file, "module Generated exposing (..)\n\nimport Html exposing (Html, text)\n\n");
+    long target = megabytes * 1024 * 1024;
+    for (long i = 0; ftell(file) < target; i++) {
+        fprintf(file,
+                "{-| Doc comment for the \"é\" function number %ld -}\n"
+                "function%ld : Int -> { name : String, count : Int } -> Html msg\n"
+                "function%ld n record =\n"
+                "    case compare n record.count of\n"
+                "        LT ->\n"
+                "            text (record.name ++ String.fromInt (n * %ld + 1))\n"
+                "\n"
+                "        _ ->\n"
+                "            List.map (\\x -> x + n) [ 1, 2, 3 ]\n"
+                "                |> List.sum\n"
+                "                |> String.fromInt\n"
+                "                |> text\n"
+                "\n\n",
+                i, i, i, i);
+    }
+    return fclose(file) == 0;
+}
+
+static char *read_whole(const char *path, uint32_t *length) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *source = malloc((size_t)size + 1);
+    if (source == NULL || fread(source, 1, (size_t)size, file) != (size_t)size) {
+        free(source);
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+    *length = (uint32_t)size;
+    return source;
+}
+
+// Parse the file one way, print the result and return the exit status of
+// the child.
+static int measure(Mode mode, const char *path, uint32_t buffer_size) {
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_elm());
+
+    double start = now();
+    TSTree *tree = NULL;
+    uint32_t length = 0;
+    int error = 0;
+    if (mode == STRING) {
+        char *source = read_whole(path, &length);
+        if (source == NULL) {
+            error = errno;
+        } else {
+            tree = ts_parser_parse_string(parser, NULL, source, length);
+            free(source);
+        }
+    } else {
+        int fd = mode == STREAM ? open(path, O_RDONLY) : -1;
+        TSElmFileInput *input = mode == MAP ? ts_elm_file_input_map(path, &error)
+                                : fd >= 0   ? ts_elm_file_input_stream(fd, buffer_size, &error)
+                                            : NULL;
+        if (fd < 0 && mode == STREAM) {
+            error = errno;
+        }
+        if (input != NULL) {
+            length = ts_elm_file_input_length(input);
+            tree = ts_parser_parse(parser, NULL, ts_elm_file_input(input));
+            error = ts_elm_file_input_error(input);
+            ts_elm_file_input_delete(input);
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    double seconds = now() - start;
+    if (tree == NULL || error != 0) {
+        fprintf(stderr, "%s: cannot parse %s: %s\n", MODE_NAMES[mode], path,
+                strerror(error));
+        return EXIT_FAILURE;
+    }
+
+    TSNode root = ts_tree_root_node(tree);
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    // ru_maxrss is in kilobytes on Linux and in bytes on macOS
+#ifdef __APPLE__
+    double peak_mb = (double)usage.ru_maxrss / (1024 * 1024);
+#else
+    double peak_mb = (double)usage.ru_maxrss / 1024;
+#endif
+    printf("%-7s %10.2f ms %8.2f MB/s  peak RSS %8.1f MB  end %u%s\n", MODE_NAMES[mode],
+           seconds * 1000, (double)length / seconds / 1e6, peak_mb,
+           ts_node_end_byte(root), ts_node_has_error(root) ? " (with errors)" : "");
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char **argv) {
+    uint32_t buffer_size = 0;
+    long megabytes = 0;
+    int i = 1;
+    for (; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--buffer") == 0) {
+            buffer_size = (uint32_t)strtoul(argv[i + 1], NULL, 10);
+        } else if (strcmp(argv[i], "--generate") == 0) {
+            megabytes = atol(argv[i + 1]);
+        } else {
+            break;
+        }
+    }
+    if (i + 1 != argc) {
+        fprintf(stderr, "usage: %s [--buffer N] [--generate MB] file\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const char *path = argv[i];
+    if (megabytes > 0 && !generate(path, megabytes)) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return EXIT_FAILURE;
+    }
+
+    int status = EXIT_SUCCESS;
+    for (Mode mode = STRING; mode <= STREAM; mode++) {
+        fflush(stdout);
+        pid_t child = fork();
+        if (child == 0) {
+            exit(measure(mode, path, buffer_size));
+        }
+        int child_status;
+        if (child < 0 || waitpid(child, &child_status, 0) < 0 ||
+            !WIFEXITED(child_status) || WEXITSTATUS(child_status) != EXIT_SUCCESS) {
+            status = EXIT_FAILURE;
+        }
+    }
+    return status;
+}
@@ -0,0 +1,121 @@
+// Compares the Elm grammar with its lean variant: nodes per tree, bytes
+// allocated for the trees and the time to walk them with a tree cursor.
+//
+// Usage: tree-sitter-elm-lean-report file...
+// Files ending in .txt are read as test corpus files and each of their
+// examples is parsed, other files are parsed whole.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "tools.h"
+#include "tree_sitter/tree-sitter-elm-lean.h"
+#include "tree_sitter/tree-sitter-elm.h"
+
+#include <time.h>
+
+#define WALKS 100
+
+typedef struct {
+    const char *name;
+    const TSLanguage *language;
+    TSParser *parser;
+    size_t examples;
+    size_t nodes;
+    size_t named_nodes;
+    size_t tree_bytes;
+    double walk_seconds;
+} Variant;
+
+typedef struct {
+    Variant *items;
+    size_t count;
+} Variants;
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+static size_t walk(TSTree *tree, size_t *named) {
+    TSTreeCursor cursor = ts_tree_cursor_new(ts_tree_root_node(tree));
+    size_t count = 0;
+    *named = 0;
+    for (;;) {
+        count++;
+        if (ts_node_is_named(ts_tree_cursor_current_node(&cursor))) {
+            (*named)++;
+        }
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                ts_tree_cursor_delete(&cursor);
+                return count;
+            }
+        }
+    }
+}
+
+static void measure(Variant *variant, const char *source, size_t length) {
+    TSTree *tree = ts_parser_parse_string(variant->parser, NULL, source, (uint32_t)length);
+
+    size_t nodes = 0, named = 0;
+    double start = now();
+    for (int i = 0; i < WALKS; i++) {
+        nodes = walk(tree, &named);
+    }
+    variant->walk_seconds += (now() - start) / WALKS;
+    variant->examples++;
+    variant->nodes += nodes;
+    variant->named_nodes += named;
+    // The tree's size is what deleting it frees, the parser keeps its own
+    // buffers for the next parse
+    size_t before = live_bytes;
+    ts_tree_delete(tree);
+    variant->tree_bytes += before - live_bytes;
+}
+
+static void measure_all(const char *source, size_t length, void *payload) {
+    Variants *variants = payload;
+    for (size_t i = 0; i < variants->count; i++) {
+        measure(&variants->items[i], source, length);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s file...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    count_allocations();
+
+    Variant items[] = {
+        {.name = "elm", .language = tree_sitter_elm()},
+        {.name = "elm_lean", .language = tree_sitter_elm_lean()},
+    };
+    Variants variants = {items, sizeof(items) / sizeof(items[0])};
+    for (size_t i = 0; i < variants.count; i++) {
+        items[i].parser = ts_parser_new();
+        ts_parser_set_language(items[i].parser, items[i].language);
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (!for_each_source(argv[i], measure_all, &variants)) {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("%-10s %8s %10s %10s %12s %10s\n", "variant", "examples", "nodes",
+           "named", "tree bytes", "walk ms");
+    for (size_t i = 0; i < variants.count; i++) {
+        Variant *variant = &items[i];
+        printf("%-10s %8zu %10zu %10zu %12zu %10.3f\n", variant->name,
+               variant->examples, variant->nodes, variant->named_nodes,
+               variant->tree_bytes, variant->walk_seconds * 1000);
+        ts_parser_delete(variant->parser);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+// Measures the generated lexer alone: how fast `ts_lex` splits sources into
+// tokens, without the parser or the external scanner. Most of the bytes of
+// identifier-heavy code go through the identifier character sets, which
+// script/ascii-fast-path tests ASCII first for. tree-sitter-elm-lexer-bench-ranges
+// is the same benchmark built without that fast path, to compare the two.
+//
+// Usage: tree-sitter-elm-lexer-bench [--runs N] file...
+// Files ending in .txt are read as test corpus files and each of their
+// examples is lexed, other files are lexed whole.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "tools.h"
+
+// The lexer is static, so the benchmark compiles the parser into itself
+#include "parser.c"
+
+#include <time.h>
+
+typedef struct {
+    TSLexer lexer;
+    const uint8_t *source;
+    size_t length;
+    size_t position;
+    size_t width;
+    size_t token_end;
+} Lexer;
+
+typedef struct {
+    Lexer lexer;
+    int runs;
+    size_t bytes;
+    size_t tokens;
+    size_t identifiers;
+    double seconds;
+} Bench;
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+// Decode the code point at the lexer's position like the runtime does,
+// invalid sequences lex as one replacement character per byte
+static void decode(Lexer *self) {
+    if (self->position >= self->length) {
+        self->lexer.lookahead = 0;
+        self->width = 0;
+        return;
+    }
+    const uint8_t *bytes = self->source + self->position;
+    size_t available = self->length - self->position;
+    uint8_t first = bytes[0];
+    size_t width = first < 0x80 ? 1 : first >= 0xf0 ? 4 : first >= 0xe0 ? 3 : first >= 0xc0 ? 2 : 0;
+    int32_t code_point = width == 1 ? first : first & (0x7f >> width);
+    for (size_t i = 1; i < width; i++) {
+        if (i >= available || (bytes[i] & 0xc0) != 0x80) {
+            width = 0;
+            break;
+        }
+        code_point = (code_point << 6) | (bytes[i] & 0x3f);
+    }
+    self->lexer.lookahead = width > 0 ? code_point : 0xfffd;
+    self->width = width > 0 ? width : 1;
+}
+
+static void lexer_advance(TSLexer *lexer, bool skip) {
+    (void)skip;
+    Lexer *self = (Lexer *)lexer;
+    self->position += self->width;
+    decode(self);
+}
+
+static void lexer_mark_end(TSLexer *lexer) {
+    Lexer *self = (Lexer *)lexer;
+    self->token_end = self->position;
+}
+
+static uint32_t lexer_get_column(TSLexer *lexer) {
+    (void)lexer;
+    return 0;
+}
+
+static bool lexer_is_at_included_range_start(const TSLexer *lexer) {
+    (void)lexer;
+    return false;
+}
+
+static bool lexer_eof(const TSLexer *lexer) {
+    const Lexer *self = (const Lexer *)lexer;
+    return self->position >= self->length;
+}
+
+static void lexer_log(const TSLexer *lexer, const char *format, ...) {
+    (void)lexer;
+    (void)format;
+}
+
+// Lex the whole source in the lexer's start state, which accepts every
+// token. Bytes no token starts with, like the layout the external scanner
+// handles, are stepped over one character at a time.
+static void lex(Bench *bench, const char *source, size_t length) {
+    Lexer *self = &bench->lexer;
+    self->source = (const uint8_t *)source;
+    self->length = length;
+    self->position = 0;
+    decode(self);
+    while (self->position < length) {
+        size_t start = self->position;
+        self->token_end = start;
+        if (ts_lex(&self->lexer, 0) && self->token_end > start) {
+            bench->tokens++;
+            TSSymbol symbol = self->lexer.result_symbol;
+            if (symbol == sym_lower_case_identifier || symbol == sym_upper_case_identifier) {
+                bench->identifiers++;
+            }
+            self->position = self->token_end;
+        } else {
+            self->position = start;
+            decode(self);
+            self->position += self->width;
+        }
+        decode(self);
+    }
+}
+
+static void run(const char *source, size_t length, void *payload) {
+    Bench *bench = payload;
+    for (int i = 0; i < bench->runs; i++) {
+        double start = now();
+        lex(bench, source, length);
+        bench->seconds += now() - start;
+        bench->bytes += length;
+    }
+}
+
+int main(int argc, char **argv) {
+    Bench bench = {
+        .lexer.lexer =
+            {
+                .advance = lexer_advance,
+                .mark_end = lexer_mark_end,
+                .get_column = lexer_get_column,
+                .is_at_included_range_start = lexer_is_at_included_range_start,
+                .eof = lexer_eof,
+                .log = lexer_log,
+            },
+        .runs = 20,
+    };
+    int first_file = 1;
+    if (argc > 2 && strcmp(argv[1], "--runs") == 0) {
+        bench.runs = atoi(argv[2]);
+        first_file = 3;
+    }
+    if (first_file >= argc || bench.runs < 1) {
+        fprintf(stderr, "usage: %s [--runs N] file...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    for (int i = first_file; i < argc; i++) {
+        if (!for_each_source(argv[i], run, &bench)) {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("lexed %zu bytes into %zu tokens, %.1f%% identifiers\n", bench.bytes / (size_t)bench.runs,
+           bench.tokens / (size_t)bench.runs,
+           bench.tokens > 0 ? 100.0 * (double)bench.identifiers / (double)bench.tokens : 0);
+    printf("%.2f ms, %.2f MB/s\n", bench.seconds * 1000,
+           bench.seconds > 0 ? (double)bench.bytes / bench.seconds / 1e6 : 0);
+    return EXIT_SUCCESS;
+}
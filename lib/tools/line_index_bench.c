@@ -0,0 +1,88 @@
+// Measures the line index: how fast `ts_elm_line_index_reset` finds the
+// newlines and non-ASCII bytes of sources, and how long converting byte
+// offsets to LSP positions and back takes. tree-sitter-elm-line-index-bench-scalar
+// is the same benchmark built without SSE2 or NEON, to compare the two.
+//
+// Usage: tree-sitter-elm-line-index-bench [--runs N] file...
+// Files ending in .txt are read as test corpus files and each of their
+// examples is indexed, other files are indexed whole.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "tools.h"
+#include "tree_sitter/elm/line_index.h"
+
+#include <time.h>
+
+// Positions converted per source, spread over it with a fixed stride.
+#define CONVERSIONS 1000
+
+typedef struct {
+    TSElmLineIndex *index;
+    int runs;
+    size_t bytes;
+    size_t lines;
+    size_t conversions;
+    double index_seconds;
+    double convert_seconds;
+    uint64_t checksum;
+} Bench;
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+static void run(const char *source, size_t length, void *payload) {
+    Bench *bench = payload;
+    if (length == 0) {
+        return;
+    }
+    for (int i = 0; i < bench->runs; i++) {
+        double start = now();
+        ts_elm_line_index_reset(bench->index, source, (uint32_t)length);
+        bench->index_seconds += now() - start;
+        bench->bytes += length;
+    }
+    bench->lines += ts_elm_line_index_line_count(bench->index);
+
+    double start = now();
+    for (uint32_t i = 0; i < CONVERSIONS; i++) {
+        uint32_t byte = (uint32_t)(((uint64_t)i * 2654435761u) % length);
+        TSElmPosition position = ts_elm_line_index_position(bench->index, source, byte);
+        bench->checksum += ts_elm_line_index_byte(bench->index, source, position);
+    }
+    bench->convert_seconds += now() - start;
+    bench->conversions += CONVERSIONS;
+}
+
+int main(int argc, char **argv) {
+    Bench bench = {.runs = 20};
+    int first_file = 1;
+    if (argc > 2 && strcmp(argv[1], "--runs") == 0) {
+        bench.runs = atoi(argv[2]);
+        first_file = 3;
+    }
+    if (first_file >= argc || bench.runs < 1) {
+        fprintf(stderr, "usage: %s [--runs N] file...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    bench.index = ts_elm_line_index_new();
+    for (int i = first_file; i < argc; i++) {
+        if (!for_each_source(argv[i], run, &bench)) {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    ts_elm_line_index_delete(bench.index);
+
+    printf("indexed %zu bytes, %zu lines\n", bench.bytes / (size_t)bench.runs, bench.lines);
+    printf("index    %10.2f ms %8.2f MB/s\n", bench.index_seconds * 1000,
+           bench.index_seconds > 0 ? (double)bench.bytes / bench.index_seconds / 1e6 : 0);
+    printf("convert  %10zu round trips %8.1f ns each (checksum %llu)\n", bench.conversions,
+           bench.conversions > 0 ? bench.convert_seconds * 1e9 / (double)bench.conversions : 0,
+           (unsigned long long)bench.checksum);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,260 @@
+// Reports what Elm trees cost in memory: the bytes the runtime allocates
+// for them, per source byte and per node, the bytes the parser and the
+// external scanner keep between parses, and how many nodes of each symbol
+// the trees contain. Only the totals are measured. The bytes per symbol are
+// an estimate derived from the node counts, see `Estimate`, and are
+// labelled as such in the output.
+//
+// Usage: tree-sitter-elm-memory-report [options] file...
+//   --baseline FILE    fail if bytes per source byte exceed the baseline,
+//                      exits with SKIPPED when FILE does not exist
+//   --threshold N      allowed regression in percent, 5 by default
+//   --update           write the current figure to the baseline instead
+// Files ending in .txt are read as test corpus files and each of their
+// examples is parsed, other files are parsed whole. The tool compiles the
+// grammar in with TREE_SITTER_REUSE_ALLOCATOR, so that the counting
+// allocator sees the external scanner's allocations too.
+
+#include "tools.h"
+#include "tree_sitter/tree-sitter-elm.h"
+
+#define BASELINE_KEY "bytes_per_source_byte"
+
+// The exit code that ctest reports as skipped, for a missing baseline
+#define SKIPPED 77
+
+// A child slot in a parent's child array, the size of the runtime's
+// `Subtree` union
+#define CHILD_SLOT_BYTES 8
+
+typedef struct {
+    TSParser *parser;
+    uint32_t symbol_count;
+    size_t *symbol_nodes;
+    size_t *symbol_parents;
+    size_t examples;
+    size_t source_bytes;
+    size_t nodes;
+    size_t parents;
+    size_t tree_bytes;
+    size_t parser_bytes;
+    size_t scanner_bytes;
+} Report;
+
+static void measure(const char *source, size_t length, void *payload) {
+    Report *report = payload;
+    TSTree *tree = ts_parser_parse_string(report->parser, NULL, source, (uint32_t)length);
+
+    TSTreeCursor cursor = ts_tree_cursor_new(ts_tree_root_node(tree));
+    for (bool done = false; !done;) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        TSSymbol symbol = ts_node_symbol(node);
+        bool parent = ts_node_child_count(node) > 0;
+        if (symbol < report->symbol_count) {
+            report->symbol_nodes[symbol]++;
+            report->symbol_parents[symbol] += parent;
+        }
+        report->nodes++;
+        report->parents += parent;
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                done = true;
+                break;
+            }
+        }
+    }
+    ts_tree_cursor_delete(&cursor);
+
+    // The tree's size is what deleting it frees, the parser keeps its own
+    // buffers for the next parse
+    size_t before = live_bytes;
+    ts_tree_delete(tree);
+    report->tree_bytes += before - live_bytes;
+    report->source_bytes += length;
+    report->examples++;
+}
+
+// The counting allocator only sees the total, so the bytes of a symbol are
+// estimated: every node but the roots takes a child slot, and the rest of
+// the total is shared equally between the nodes with children, which carry
+// the heap data and child array. Leaves are assumed to be stored inline.
+typedef struct {
+    const Report *report;
+    double parent_bytes;
+} Estimate;
+
+static double estimated_bytes(const Estimate *estimate, TSSymbol symbol) {
+    return (double)(CHILD_SLOT_BYTES * estimate->report->symbol_nodes[symbol]) +
+           estimate->parent_bytes * (double)estimate->report->symbol_parents[symbol];
+}
+
+static const Estimate *sorting;
+
+static int compare_symbols(const void *a, const void *b) {
+    double left = estimated_bytes(sorting, *(const TSSymbol *)a);
+    double right = estimated_bytes(sorting, *(const TSSymbol *)b);
+    return left < right ? 1 : left > right ? -1 : 0;
+}
+
+static void print_report(const Report *report, const TSLanguage *language) {
+    double per_source_byte = (double)report->tree_bytes / (double)report->source_bytes;
+    printf("%zu examples, %zu source bytes, %zu nodes, %zu tree bytes\n",
+           report->examples, report->source_bytes, report->nodes, report->tree_bytes);
+    printf("%.3f tree bytes per source byte, %.1f per node\n", per_source_byte,
+           (double)report->tree_bytes / (double)report->nodes);
+    printf("%zu bytes kept by the parser between parses, %zu of them by the external scanner\n",
+           report->parser_bytes, report->scanner_bytes);
+
+    double slot_bytes = (double)(CHILD_SLOT_BYTES * (report->nodes - report->examples));
+    Estimate estimate = {
+        .report = report,
+        .parent_bytes = report->parents > 0 && (double)report->tree_bytes > slot_bytes
+                            ? ((double)report->tree_bytes - slot_bytes) / (double)report->parents
+                            : 0,
+    };
+    printf("\nThe bytes per symbol below are estimated, not measured: %d per child slot\n"
+           "and %.1f per node with children, leaves are assumed to be stored inline\n\n",
+           CHILD_SLOT_BYTES, estimate.parent_bytes);
+
+    TSSymbol *order = malloc(report->symbol_count * sizeof(TSSymbol));
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < report->symbol_count; i++) {
+        if (report->symbol_nodes[i] > 0) {
+            order[count++] = (TSSymbol)i;
+        }
+    }
+    sorting = &estimate;
+    qsort(order, count, sizeof(TSSymbol), compare_symbols);
+
+    printf("%-36s %10s %7s %14s %12s %10s\n", "symbol", "nodes", "share", "per KiB source",
+           "est. bytes", "est. share");
+    for (uint32_t i = 0; i < count; i++) {
+        TSSymbol symbol = order[i];
+        size_t nodes = report->symbol_nodes[symbol];
+        // Anonymous tokens are quoted, like in queries
+        char name[64];
+        snprintf(name, sizeof(name),
+                 ts_language_symbol_type(language, symbol) == TSSymbolTypeRegular ? "%s" : "\"%s\"",
+                 ts_language_symbol_name(language, symbol));
+        double bytes = estimated_bytes(&estimate, symbol);
+        printf("%-36s %10zu %6.2f%% %14.2f %12.0f %9.2f%%\n", name, nodes,
+               100.0 * (double)nodes / (double)report->nodes,
+               1024.0 * (double)nodes / (double)report->source_bytes, bytes,
+               100.0 * bytes / (double)report->tree_bytes);
+    }
+    free(order);
+}
+
+static bool read_baseline(const char *path, double *value, bool *missing) {
+    FILE *file = fopen(path, "r");
+    *missing = file == NULL;
+    if (file == NULL) {
+        return false;
+    }
+    char line[256];
+    bool found = false;
+    while (!found && fgets(line, sizeof(line), file)) {
+        found = sscanf(line, BASELINE_KEY " %lf", value) == 1;
+    }
+    fclose(file);
+    return found;
+}
+
+static bool write_baseline(const char *path, double value) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        return false;
+    }
+    fprintf(file,
+            "# Written by tree-sitter-elm-memory-report --update from the test corpus\n"
+            "%s %.4f\n",
+            BASELINE_KEY, value);
+    return fclose(file) == 0;
+}
+
+int main(int argc, char **argv) {
+    const char *baseline = NULL;
+    double threshold = 5;
+    bool update = false;
+    int first_file = 1;
+    for (; first_file < argc && strncmp(argv[first_file], "--", 2) == 0; first_file++) {
+        if (strcmp(argv[first_file], "--baseline") == 0 && first_file + 1 < argc) {
+            baseline = argv[++first_file];
+        } else if (strcmp(argv[first_file], "--threshold") == 0 && first_file + 1 < argc) {
+            threshold = atof(argv[++first_file]);
+        } else if (strcmp(argv[first_file], "--update") == 0) {
+            update = true;
+        } else {
+            first_file = argc;
+        }
+    }
+    if (first_file >= argc || (update && baseline == NULL)) {
+        fprintf(stderr,
+                "usage: %s [--baseline FILE [--threshold PERCENT] [--update]] file...\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+    count_allocations();
+
+    const TSLanguage *language = tree_sitter_elm();
+    Report report = {
+        .parser = ts_parser_new(),
+        .symbol_count = ts_language_symbol_count(language),
+    };
+    report.symbol_nodes = calloc(report.symbol_count, sizeof(size_t));
+    report.symbol_parents = calloc(report.symbol_count, sizeof(size_t));
+    ts_parser_set_language(report.parser, language);
+    for (int i = first_file; i < argc; i++) {
+        if (!for_each_source(argv[i], measure, &report)) {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    // Every tree is deleted, what is left belongs to the parser. Removing the
+    // language destroys the external scanner and frees its state.
+    report.parser_bytes = live_bytes;
+    ts_parser_set_language(report.parser, NULL);
+    report.scanner_bytes = report.parser_bytes - live_bytes;
+    ts_parser_delete(report.parser);
+    if (report.source_bytes == 0) {
+        fprintf(stderr, "no source to measure\n");
+        return EXIT_FAILURE;
+    }
+    print_report(&report, language);
+    free(report.symbol_nodes);
+    free(report.symbol_parents);
+
+    double current = (double)report.tree_bytes / (double)report.source_bytes;
+    if (update) {
+        if (!write_baseline(baseline, current)) {
+            fprintf(stderr, "cannot write %s\n", baseline);
+            return EXIT_FAILURE;
+        }
+        printf("\nwrote %s\n", baseline);
+    } else if (baseline != NULL) {
+        double expected;
+        bool missing;
+        if (!read_baseline(baseline, &expected, &missing)) {
+            if (missing) {
+                printf("\nno baseline at %s, build the memory-baseline target to write it\n",
+                       baseline);
+                return SKIPPED;
+            }
+            fprintf(stderr,
+                    "cannot read %s from %s, build the memory-baseline target to write it\n",
+                    BASELINE_KEY, baseline);
+            return EXIT_FAILURE;
+        }
+        double change = 100.0 * (current - expected) / expected;
+        printf("\n%.3f bytes per source byte, baseline %.3f (%+.1f%%, %.1f%% allowed)\n",
+               current, expected, change, threshold);
+        if (change > threshold) {
+            fprintf(stderr, "tree memory per source byte regressed by %.1f%%\n", change);
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
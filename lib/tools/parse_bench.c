@@ -0,0 +1,147 @@
+// Measures parsing throughput: full parses of each source, then incremental
+// reparses after inserting and removing a space at spread out positions,
+// the way an editor reparses while typing. script/pgo-build also runs it to
+// train the profile-guided build.
+//
+// Usage: tree-sitter-elm-parse-bench [--runs N] [--edits N] file...
+// Files ending in .txt are read as test corpus files and each of their
+// examples is parsed, other files are parsed whole.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "tools.h"
+#include "tree_sitter/tree-sitter-elm.h"
+
+#include <time.h>
+
+typedef struct {
+    TSParser *parser;
+    int runs;
+    int edits;
+    size_t bytes;
+    size_t reparses;
+    double parse_seconds;
+    double reparse_seconds;
+    char *buffer;
+    size_t buffer_capacity;
+} Bench;
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+static TSPoint point_at(const char *source, uint32_t byte) {
+    TSPoint point = {0, 0};
+    for (uint32_t i = 0; i < byte; i++) {
+        if (source[i] == '\n') {
+            point.row++;
+            point.column = 0;
+        } else {
+            point.column++;
+        }
+    }
+    return point;
+}
+
+// Insert a space at `at` when `insert` is set, otherwise remove the one
+// inserted there before, and reparse.
+static TSTree *edit(Bench *bench, TSTree *tree, size_t *length, uint32_t at,
+                    bool insert) {
+    char *source = bench->buffer;
+    TSInputEdit change = {
+        .start_byte = at,
+        .old_end_byte = insert ? at : at + 1,
+        .new_end_byte = insert ? at + 1 : at,
+        .start_point = point_at(source, at),
+    };
+    change.old_end_point = change.start_point;
+    change.new_end_point = change.start_point;
+    if (insert) {
+        memmove(source + at + 1, source + at, *length - at);
+        source[at] = ' ';
+        (*length)++;
+        change.new_end_point.column++;
+    } else {
+        memmove(source + at, source + at + 1, *length - at - 1);
+        (*length)--;
+        change.old_end_point.column++;
+    }
+    ts_tree_edit(tree, &change);
+
+    double start = now();
+    TSTree *new_tree = ts_parser_parse_string(bench->parser, tree, source, (uint32_t)*length);
+    bench->reparse_seconds += now() - start;
+    bench->reparses++;
+    ts_tree_delete(tree);
+    return new_tree;
+}
+
+static void run(const char *source, size_t length, void *payload) {
+    Bench *bench = payload;
+    if (length == 0) {
+        return;
+    }
+    for (int i = 0; i < bench->runs; i++) {
+        double start = now();
+        TSTree *tree = ts_parser_parse_string(bench->parser, NULL, source, (uint32_t)length);
+        bench->parse_seconds += now() - start;
+        bench->bytes += length;
+        ts_tree_delete(tree);
+    }
+
+    if (bench->buffer_capacity < length + 1) {
+        free(bench->buffer);
+        bench->buffer = malloc(length + 1);
+        bench->buffer_capacity = length + 1;
+    }
+    memcpy(bench->buffer, source, length);
+    size_t current = length;
+    TSTree *tree = ts_parser_parse_string(bench->parser, NULL, bench->buffer, (uint32_t)current);
+    for (int i = 0; i < bench->edits; i++) {
+        // Spread the edits over the source with a fixed stride so that runs
+        // can be compared
+        uint32_t at = (uint32_t)(((uint64_t)i * 2654435761u) % length);
+        tree = edit(bench, tree, &current, at, true);
+        tree = edit(bench, tree, &current, at, false);
+    }
+    ts_tree_delete(tree);
+}
+
+int main(int argc, char **argv) {
+    Bench bench = {.runs = 10, .edits = 20};
+    int first_file = 1;
+    for (; first_file + 1 < argc; first_file += 2) {
+        if (strcmp(argv[first_file], "--runs") == 0) {
+            bench.runs = atoi(argv[first_file + 1]);
+        } else if (strcmp(argv[first_file], "--edits") == 0) {
+            bench.edits = atoi(argv[first_file + 1]);
+        } else {
+            break;
+        }
+    }
+    if (first_file >= argc || bench.runs < 0 || bench.edits < 0) {
+        fprintf(stderr, "usage: %s [--runs N] [--edits N] file...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    bench.parser = ts_parser_new();
+    ts_parser_set_language(bench.parser, tree_sitter_elm());
+    for (int i = first_file; i < argc; i++) {
+        if (!for_each_source(argv[i], run, &bench)) {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    ts_parser_delete(bench.parser);
+    free(bench.buffer);
+
+    printf("parse    %10zu bytes %10.2f ms %8.2f MB/s\n", bench.bytes,
+           bench.parse_seconds * 1000,
+           bench.parse_seconds > 0 ? (double)bench.bytes / bench.parse_seconds / 1e6 : 0);
+    printf("reparse  %10zu edits %10.2f ms %8.2f us per edit\n", bench.reparses,
+           bench.reparse_seconds * 1000,
+           bench.reparses > 0 ? bench.reparse_seconds * 1e6 / (double)bench.reparses : 0);
+    return EXIT_SUCCESS;
+}
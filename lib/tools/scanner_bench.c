@@ -0,0 +1,311 @@
+// Measures the external scanner alone. The sources are parsed once with the
+// runtime to record every call of the scanner: the byte it starts at, the
+// tokens that are valid there and the serialized state it starts from. The
+// calls are then replayed against src/scanner.c through a TSLexer over the
+// sources in memory, like the runtime makes them, and the benchmark reports
+// the time per scan and per serialize/deserialize round trip.
+//
+// Usage: tree-sitter-elm-scanner-bench [--runs N] file...
+// Files ending in .txt are read as test corpus files and each of their
+// examples is recorded, other files are recorded whole.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "tools.h"
+#include "tree_sitter/parser.h"
+
+#include <time.h>
+
+const TSLanguage *tree_sitter_elm(void);
+
+typedef struct {
+    uint32_t source;
+    uint32_t byte;
+    uint32_t state_start;
+    uint32_t state_length;
+    // Points into the external token table of the language, like the
+    // runtime's argument does
+    const bool *valid_symbols;
+    // The token the scan found in the parse, or -1
+    int32_t symbol;
+} Call;
+
+typedef struct {
+    uint32_t start;
+    uint32_t length;
+} Source;
+
+typedef struct {
+    TSLexer lexer;
+    const uint8_t *text;
+    size_t start;
+    size_t end;
+    size_t position;
+    size_t width;
+} Lexer;
+
+typedef struct {
+    char *text;
+    size_t text_length;
+    size_t text_capacity;
+    Source *sources;
+    size_t source_count;
+    size_t source_capacity;
+    uint32_t *lines;
+    size_t line_count;
+    size_t line_capacity;
+    char *states;
+    size_t states_length;
+    size_t states_capacity;
+    Call *calls;
+    size_t call_count;
+    size_t call_capacity;
+    // The start of the next scan, from the parser's log
+    uint32_t pending_byte;
+} Recording;
+
+static Recording recording;
+static TSLanguage recording_language;
+static bool (*scan)(void *, TSLexer *, const bool *);
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+// Make room for `extra` more elements of `size` bytes, exiting when out of
+// memory since the recording is useless without all of its calls.
+static void *reserve(void *data, size_t *capacity, size_t length, size_t extra, size_t size) {
+    if (length + extra <= *capacity) {
+        return data;
+    }
+    size_t new_capacity = *capacity > 0 ? *capacity * 2 : 1024;
+    while (new_capacity < length + extra) {
+        new_capacity *= 2;
+    }
+    data = realloc(data, new_capacity * size);
+    if (data == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    *capacity = new_capacity;
+    return data;
+}
+
+// The runtime logs the row and the byte column of each external scan right
+// before making it
+static void log_scan_start(void *payload, TSLogType type, const char *message) {
+    (void)payload;
+    unsigned state, row, column;
+    if (type == TSLogTypeParse &&
+        sscanf(message, "lex_external state:%u, row:%u, column:%u", &state, &row, &column) == 3) {
+        Source *source = &recording.sources[recording.source_count - 1];
+        uint32_t line = row < recording.line_count ? recording.lines[row] : source->length;
+        recording.pending_byte = source->start + line + column;
+    }
+}
+
+static bool recording_scan(void *payload, TSLexer *lexer, const bool *valid_symbols) {
+    recording.states = reserve(recording.states, &recording.states_capacity, recording.states_length,
+                               TREE_SITTER_SERIALIZATION_BUFFER_SIZE, 1);
+    recording.calls =
+        reserve(recording.calls, &recording.call_capacity, recording.call_count, 1, sizeof(Call));
+    Call *call = &recording.calls[recording.call_count++];
+    call->source = (uint32_t)recording.source_count - 1;
+    call->byte = recording.pending_byte;
+    call->state_start = (uint32_t)recording.states_length;
+    call->state_length = recording_language.external_scanner.serialize(
+        payload, recording.states + recording.states_length);
+    call->valid_symbols = valid_symbols;
+    recording.states_length += call->state_length;
+
+    bool found = scan(payload, lexer, valid_symbols);
+    call->symbol = found ? lexer->result_symbol : -1;
+    return found;
+}
+
+static void record(const char *text, size_t length, void *payload) {
+    TSParser *parser = payload;
+    recording.text = reserve(recording.text, &recording.text_capacity, recording.text_length,
+                             length, 1);
+    memcpy(recording.text + recording.text_length, text, length);
+    recording.sources = reserve(recording.sources, &recording.source_capacity,
+                                recording.source_count, 1, sizeof(Source));
+    recording.sources[recording.source_count++] =
+        (Source){(uint32_t)recording.text_length, (uint32_t)length};
+    recording.text_length += length;
+
+    recording.line_count = 0;
+    for (size_t i = 0; i <= length; i++) {
+        if (i == 0 || text[i - 1] == '\n') {
+            recording.lines = reserve(recording.lines, &recording.line_capacity,
+                                      recording.line_count, 1, sizeof(uint32_t));
+            recording.lines[recording.line_count++] = (uint32_t)i;
+        }
+    }
+    ts_tree_delete(ts_parser_parse_string(parser, NULL, text, (uint32_t)length));
+}
+
+// Decode the code point at the lexer's position like the runtime does,
+// invalid sequences lex as one replacement character per byte
+static void decode(Lexer *self) {
+    if (self->position >= self->end) {
+        self->lexer.lookahead = 0;
+        self->width = 0;
+        return;
+    }
+    const uint8_t *bytes = self->text + self->position;
+    size_t available = self->end - self->position;
+    uint8_t first = bytes[0];
+    size_t width = first < 0x80 ? 1 : first >= 0xf0 ? 4 : first >= 0xe0 ? 3 : first >= 0xc0 ? 2 : 0;
+    int32_t code_point = width == 1 ? first : first & (0x7f >> width);
+    for (size_t i = 1; i < width; i++) {
+        if (i >= available || (bytes[i] & 0xc0) != 0x80) {
+            width = 0;
+            break;
+        }
+        code_point = (code_point << 6) | (bytes[i] & 0x3f);
+    }
+    self->lexer.lookahead = width > 0 ? code_point : 0xfffd;
+    self->width = width > 0 ? width : 1;
+}
+
+static void lexer_advance(TSLexer *lexer, bool skip) {
+    (void)skip;
+    Lexer *self = (Lexer *)lexer;
+    self->position += self->width;
+    decode(self);
+}
+
+static void lexer_mark_end(TSLexer *lexer) { (void)lexer; }
+
+// Count the characters since the start of the line, like the runtime
+static uint32_t lexer_get_column(TSLexer *lexer) {
+    Lexer *self = (Lexer *)lexer;
+    size_t line = self->position;
+    while (line > self->start && self->text[line - 1] != '\n') {
+        line--;
+    }
+    uint32_t column = 0;
+    for (size_t i = line; i < self->position; i++) {
+        column += (self->text[i] & 0xc0) != 0x80;
+    }
+    return column;
+}
+
+static bool lexer_is_at_included_range_start(const TSLexer *lexer) {
+    (void)lexer;
+    return false;
+}
+
+static bool lexer_eof(const TSLexer *lexer) {
+    const Lexer *self = (const Lexer *)lexer;
+    return self->position >= self->end;
+}
+
+static void lexer_log(const TSLexer *lexer, const char *format, ...) {
+    (void)lexer;
+    (void)format;
+}
+
+typedef enum { DESERIALIZE, SCAN, ROUND_TRIP } Replay;
+
+// Replay every call once, returning the number of scans whose result
+// differs from the parse
+static size_t replay(Replay mode, void *scanner, Lexer *lexer) {
+    const TSLanguage *language = &recording_language;
+    char buffer[TREE_SITTER_SERIALIZATION_BUFFER_SIZE];
+    size_t mismatches = 0;
+    for (size_t i = 0; i < recording.call_count; i++) {
+        const Call *call = &recording.calls[i];
+        language->external_scanner.deserialize(scanner, recording.states + call->state_start,
+                                               call->state_length);
+        if (mode == SCAN) {
+            const Source *source = &recording.sources[call->source];
+            lexer->start = source->start;
+            lexer->end = source->start + source->length;
+            lexer->position = call->byte;
+            lexer->lexer.result_symbol = 0;
+            decode(lexer);
+            bool found = scan(scanner, &lexer->lexer, call->valid_symbols);
+            mismatches += (found ? (int32_t)lexer->lexer.result_symbol : -1) != call->symbol;
+        } else if (mode == ROUND_TRIP) {
+            language->external_scanner.serialize(scanner, buffer);
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char **argv) {
+    int runs = 20;
+    int first_file = 1;
+    if (argc > 2 && strcmp(argv[1], "--runs") == 0) {
+        runs = atoi(argv[2]);
+        first_file = 3;
+    }
+    if (first_file >= argc || runs < 1) {
+        fprintf(stderr, "usage: %s [--runs N] file...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    memcpy(&recording_language, tree_sitter_elm(), sizeof(TSLanguage));
+    scan = recording_language.external_scanner.scan;
+    recording_language.external_scanner.scan = recording_scan;
+
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, &recording_language);
+    ts_parser_set_logger(parser, (TSLogger){NULL, log_scan_start});
+    for (int i = first_file; i < argc; i++) {
+        if (!for_each_source(argv[i], record, parser)) {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    ts_parser_delete(parser);
+    if (recording.call_count == 0) {
+        fprintf(stderr, "the sources made no scanner calls\n");
+        return EXIT_FAILURE;
+    }
+
+    Lexer lexer = {
+        .lexer =
+            {
+                .advance = lexer_advance,
+                .mark_end = lexer_mark_end,
+                .get_column = lexer_get_column,
+                .is_at_included_range_start = lexer_is_at_included_range_start,
+                .eof = lexer_eof,
+                .log = lexer_log,
+            },
+        .text = (const uint8_t *)recording.text,
+    };
+    void *scanner = recording_language.external_scanner.create();
+    double seconds[3] = {0};
+    size_t mismatches = 0;
+    for (int run = 0; run < runs; run++) {
+        for (Replay mode = DESERIALIZE; mode <= ROUND_TRIP; mode++) {
+            double start = now();
+            mismatches += replay(mode, scanner, &lexer);
+            seconds[mode] += now() - start;
+        }
+    }
+    recording_language.external_scanner.destroy(scanner);
+
+    size_t found = 0;
+    for (size_t i = 0; i < recording.call_count; i++) {
+        found += recording.calls[i].symbol >= 0;
+    }
+    double calls = (double)recording.call_count * runs;
+    printf("recorded %zu scans over %zu bytes, %.1f%% found a token\n", recording.call_count,
+           recording.text_length, 100.0 * (double)found / (double)recording.call_count);
+    // A scan is replayed after deserializing its state, which is timed alone
+    printf("scan         %8.1f ns\n", (seconds[SCAN] - seconds[DESERIALIZE]) / calls * 1e9);
+    printf("deserialize  %8.1f ns\n", seconds[DESERIALIZE] / calls * 1e9);
+    printf("round trip   %8.1f ns\n", seconds[ROUND_TRIP] / calls * 1e9);
+    if (mismatches > 0) {
+        fprintf(stderr, "%zu replayed scans differ from the parse\n", mismatches / (size_t)runs);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
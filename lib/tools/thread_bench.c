@@ -0,0 +1,269 @@
+// Parses and incrementally reparses the same sources on several threads at
+// once, all sharing tree_sitter_elm() with a parser and a scanner each, and
+// checks every tree against a single-threaded parse. It reports the
+// throughput for 1, 2, 4... threads up to --threads, the number of online
+// CPUs by default, and how it scales against one thread. Each thread does
+// the whole work, so perfect scaling is a throughput N times higher.
+//
+// Usage: tree-sitter-elm-thread-bench [options] file...
+//   --runs N       passes over the sources per thread, 5 by default
+//   --threads N    the most threads to run at once
+//   --check        compare every tree instead of the first pass only, and
+//                  do not time anything
+// Files ending in .txt are read as test corpus files and each of their
+// examples is parsed, other files are parsed whole.
+//
+// The thread_stress test runs it with --check on the test corpus. Shared
+// state in the grammar shows up there as a ThreadSanitizer report when it
+// is built with -DTREE_SITTER_ELM_TSAN=ON, in its own build directory. The
+// tsan preset does that in build-tsan:
+//
+//   cmake --preset tsan && cmake --build --preset tsan && ctest --preset tsan
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "thread.h"
+#include "tools.h"
+#include "tree_sitter/tree-sitter-elm.h"
+
+#include <stdatomic.h>
+#include <time.h>
+
+#define MAX_THREAD_COUNTS 16
+#define MAX_THREADS 256
+
+// A line inserted in the middle of each source before it is reparsed
+static const char EDIT[] = "-- edited\n";
+
+typedef struct {
+    char *text;
+    uint32_t length;
+    uint32_t edit_byte;
+    TSPoint edit_point;
+    char *edited;
+    char *expected;
+    char *expected_edited;
+} Source;
+
+typedef struct {
+    Source *sources;
+    size_t source_count;
+    size_t source_capacity;
+    int runs;
+    bool check;
+    atomic_bool go;
+    atomic_size_t mismatches;
+} Bench;
+
+typedef struct {
+    Bench *bench;
+    elm_thread_t thread;
+} Worker;
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+// Insert the edit into the tree of `source` and reparse the edited source
+static TSTree *reparse(TSParser *parser, TSTree *tree, const Source *source) {
+    uint32_t edit_length = (uint32_t)strlen(EDIT);
+    TSInputEdit edit = {
+        .start_byte = source->edit_byte,
+        .old_end_byte = source->edit_byte,
+        .new_end_byte = source->edit_byte + edit_length,
+        .start_point = source->edit_point,
+        .old_end_point = source->edit_point,
+        .new_end_point = {source->edit_point.row + 1, 0},
+    };
+    ts_tree_edit(tree, &edit);
+    return ts_parser_parse_string(parser, tree, source->edited, source->length + edit_length);
+}
+
+// Parse `source`, then edit it and reparse it, comparing both trees with the
+// expected ones if `check` is set
+static size_t parse_and_reparse(TSParser *parser, const Source *source, bool check) {
+    size_t mismatches = 0;
+    TSTree *tree = ts_parser_parse_string(parser, NULL, source->text, source->length);
+    if (check) {
+        char *actual = ts_node_string(ts_tree_root_node(tree));
+        mismatches += strcmp(actual, source->expected) != 0;
+        free(actual);
+    }
+
+    TSTree *edited = reparse(parser, tree, source);
+    if (check) {
+        char *actual = ts_node_string(ts_tree_root_node(edited));
+        mismatches += strcmp(actual, source->expected_edited) != 0;
+        free(actual);
+    }
+    ts_tree_delete(edited);
+    ts_tree_delete(tree);
+    return mismatches;
+}
+
+static ELM_THREAD_FN(work, arg) {
+    Worker *worker = arg;
+    Bench *bench = worker->bench;
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_elm());
+    while (!atomic_load_explicit(&bench->go, memory_order_acquire)) {
+    }
+    size_t mismatches = 0;
+    for (int run = 0; run < bench->runs; run++) {
+        for (size_t i = 0; i < bench->source_count; i++) {
+            mismatches += parse_and_reparse(parser, &bench->sources[i], bench->check || run == 0);
+        }
+    }
+    atomic_fetch_add(&bench->mismatches, mismatches);
+    ts_parser_delete(parser);
+    ELM_THREAD_RETURN;
+}
+
+// Run `count` workers at once and return how long they took together
+static double run_threads(Bench *bench, uint32_t count) {
+    Worker workers[MAX_THREADS];
+    atomic_store(&bench->go, false);
+    uint32_t started = 0;
+    for (; started < count; started++) {
+        workers[started].bench = bench;
+        if (!elm_thread_start(&workers[started].thread, work, &workers[started])) {
+            fprintf(stderr, "cannot start thread %u\n", started + 1);
+            break;
+        }
+    }
+    double start = now();
+    atomic_store_explicit(&bench->go, true, memory_order_release);
+    for (uint32_t i = 0; i < started; i++) {
+        elm_thread_join(workers[i].thread);
+    }
+    double seconds = now() - start;
+    return started == count ? seconds : -1;
+}
+
+static void add_source(const char *text, size_t length, void *payload) {
+    Bench *bench = payload;
+    if (bench->source_count == bench->source_capacity) {
+        bench->source_capacity = bench->source_capacity ? bench->source_capacity * 2 : 64;
+        bench->sources = realloc(bench->sources, bench->source_capacity * sizeof(Source));
+    }
+    Source *source = &bench->sources[bench->source_count++];
+    source->length = (uint32_t)length;
+    source->text = malloc(length + 1);
+    memcpy(source->text, text, length);
+    source->text[length] = '\0';
+
+    // Insert the edit at the start of the middle line
+    source->edit_byte = 0;
+    source->edit_point = (TSPoint){0, 0};
+    for (uint32_t i = 0; i < length / 2; i++) {
+        if (text[i] == '\n') {
+            source->edit_byte = i + 1;
+            source->edit_point.row++;
+        }
+    }
+    size_t edit_length = strlen(EDIT);
+    source->edited = malloc(length + edit_length + 1);
+    memcpy(source->edited, text, source->edit_byte);
+    memcpy(source->edited + source->edit_byte, EDIT, edit_length);
+    memcpy(source->edited + source->edit_byte + edit_length, text + source->edit_byte,
+           length - source->edit_byte + 1);
+}
+
+// Take the trees of a single-threaded parse and reparse as the expected ones
+static void expect(Bench *bench) {
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_elm());
+    for (size_t i = 0; i < bench->source_count; i++) {
+        Source *source = &bench->sources[i];
+        TSTree *tree = ts_parser_parse_string(parser, NULL, source->text, source->length);
+        source->expected = ts_node_string(ts_tree_root_node(tree));
+        // The edited tree comes from the same incremental reparse the threads
+        // make, which error recovery can make differ from a fresh parse
+        TSTree *edited = reparse(parser, tree, source);
+        source->expected_edited = ts_node_string(ts_tree_root_node(edited));
+        ts_tree_delete(edited);
+        ts_tree_delete(tree);
+    }
+    ts_parser_delete(parser);
+}
+
+int main(int argc, char **argv) {
+    Bench bench = {.runs = 5};
+    uint32_t max_threads = elm_cpu_count();
+    int first_file = 1;
+    for (; first_file < argc; first_file++) {
+        if (strcmp(argv[first_file], "--check") == 0) {
+            bench.check = true;
+        } else if (first_file + 1 < argc && strcmp(argv[first_file], "--runs") == 0) {
+            bench.runs = atoi(argv[++first_file]);
+        } else if (first_file + 1 < argc && strcmp(argv[first_file], "--threads") == 0) {
+            max_threads = (uint32_t)strtoul(argv[++first_file], NULL, 10);
+        } else {
+            break;
+        }
+    }
+    if (first_file >= argc || bench.runs < 1 || max_threads < 1 || max_threads > MAX_THREADS) {
+        fprintf(stderr, "usage: %s [--runs N] [--threads N] [--check] file...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    uint32_t thread_counts[MAX_THREAD_COUNTS];
+    uint32_t thread_count_count = 0;
+    for (uint32_t threads = 1; thread_count_count < MAX_THREAD_COUNTS; threads *= 2) {
+        if (threads >= max_threads) {
+            thread_counts[thread_count_count++] = max_threads;
+            break;
+        }
+        thread_counts[thread_count_count++] = threads;
+    }
+
+    for (int i = first_file; i < argc; i++) {
+        if (!for_each_source(argv[i], add_source, &bench)) {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    expect(&bench);
+
+    size_t bytes = 0;
+    for (size_t i = 0; i < bench.source_count; i++) {
+        bytes += 2 * (size_t)bench.sources[i].length + strlen(EDIT);
+    }
+    bytes *= (size_t)bench.runs;
+
+    if (bench.check) {
+        // Only the most threads, which is where races show
+        thread_counts[0] = max_threads;
+        thread_count_count = 1;
+    }
+    double baseline = 0;
+    for (uint32_t i = 0; i < thread_count_count; i++) {
+        uint32_t threads = thread_counts[i];
+        double seconds = run_threads(&bench, threads);
+        if (seconds < 0) {
+            return EXIT_FAILURE;
+        }
+        double throughput = seconds > 0 ? (double)bytes * threads / seconds : 0;
+        if (i == 0) {
+            baseline = throughput / threads;
+        }
+        if (!bench.check) {
+            printf("%3u threads %10.2f ms %8.2f MB/s %6.2fx %5.0f%% per thread\n", threads,
+                   seconds * 1000, throughput / 1e6, baseline > 0 ? throughput / baseline : 0,
+                   baseline > 0 ? 100 * throughput / baseline / threads : 0);
+        }
+    }
+
+    size_t mismatches = atomic_load(&bench.mismatches);
+    printf("%zu sources, %zu trees differ\n", bench.source_count, mismatches);
+    for (size_t i = 0; i < bench.source_count; i++) {
+        free(bench.sources[i].text);
+        free(bench.sources[i].edited);
+        free(bench.sources[i].expected);
+        free(bench.sources[i].expected_edited);
+    }
+    free(bench.sources);
+    return mismatches > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
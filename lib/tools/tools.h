@@ -0,0 +1,143 @@
+#ifndef TREE_SITTER_ELM_TOOLS_H_
+#define TREE_SITTER_ELM_TOOLS_H_
+
+// Shared by the command line tools: an allocator that counts the bytes the
+// runtime holds, and reading source files or test corpus examples.
+
+#include "tree_sitter/api.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static size_t live_bytes;
+
+typedef union {
+    size_t size;
+    max_align_t align;
+} AllocationHeader;
+
+static inline void *counting_malloc(size_t size) {
+    AllocationHeader *header = malloc(sizeof(AllocationHeader) + size);
+    if (header == NULL) {
+        return NULL;
+    }
+    header->size = size;
+    live_bytes += size;
+    return header + 1;
+}
+
+static inline void *counting_calloc(size_t count, size_t size) {
+    void *result = counting_malloc(count * size);
+    if (result != NULL) {
+        memset(result, 0, count * size);
+    }
+    return result;
+}
+
+static inline void counting_free(void *pointer) {
+    if (pointer != NULL) {
+        AllocationHeader *header = (AllocationHeader *)pointer - 1;
+        live_bytes -= header->size;
+        free(header);
+    }
+}
+
+static inline void *counting_realloc(void *pointer, size_t size) {
+    if (pointer == NULL) {
+        return counting_malloc(size);
+    }
+    AllocationHeader *header = (AllocationHeader *)pointer - 1;
+    size_t old_size = header->size;
+    AllocationHeader *new_header = realloc(header, sizeof(AllocationHeader) + size);
+    if (new_header == NULL) {
+        return NULL;
+    }
+    new_header->size = size;
+    live_bytes = live_bytes - old_size + size;
+    return new_header + 1;
+}
+
+// Count the bytes allocated by the runtime in `live_bytes`. The scanner
+// allocates through `src/tree_sitter/alloc.h` and is only counted when the
+// grammar is built with TREE_SITTER_REUSE_ALLOCATOR, tools that report the
+// scanner's memory compile the grammar in with it.
+static inline void count_allocations(void) {
+    ts_set_allocator(counting_malloc, counting_calloc, counting_realloc,
+                     counting_free);
+}
+
+static inline bool is_line(const char *line, char character) {
+    if (*line != character) {
+        return false;
+    }
+    while (*line == character) {
+        line++;
+    }
+    return *line == '\n' || *line == '\0';
+}
+
+static inline const char *next_line(const char *line) {
+    const char *newline = strchr(line, '\n');
+    return newline ? newline + 1 : line + strlen(line);
+}
+
+typedef void (*SourceCallback)(const char *source, size_t length, void *payload);
+
+// Call `callback` on each example of a corpus file: the lines between the
+// second `===` line of a header and the `---` line.
+static inline void for_each_example(const char *text, SourceCallback callback,
+                                    void *payload) {
+    const char *line = text;
+    while (*line) {
+        if (!is_line(line, '=')) {
+            line = next_line(line);
+            continue;
+        }
+        line = next_line(next_line(line));
+        if (!is_line(line, '=')) {
+            continue;
+        }
+        const char *start = next_line(line);
+        const char *end = start;
+        while (*end && !is_line(end, '-')) {
+            end = next_line(end);
+        }
+        callback(start, (size_t)(end - start), payload);
+        line = end;
+    }
+}
+
+// Call `callback` on a file, or on each example if it is a `.txt` corpus
+// file. Returns false if the file cannot be read.
+static inline bool for_each_source(const char *path, SourceCallback callback,
+                                   void *payload) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *text = size >= 0 ? malloc((size_t)size + 1) : NULL;
+    bool ok = text != NULL && fread(text, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+    if (!ok) {
+        free(text);
+        return false;
+    }
+    text[size] = '\0';
+
+    size_t path_length = strlen(path);
+    if (path_length > 4 && strcmp(path + path_length - 4, ".txt") == 0) {
+        for_each_example(text, callback, payload);
+    } else {
+        callback(text, (size_t)size, payload);
+    }
+    free(text);
+    return true;
+}
+
+#endif // TREE_SITTER_ELM_TOOLS_H_
@@ -1,5 +1,7 @@
-from os import path
+from glob import glob
+from os import environ, path
 from platform import system
+from subprocess import CalledProcessError, check_output
 from sysconfig import get_config_var
 
 from setuptools import Extension, find_packages, setup
@@ -24,7 +26,39 @@ if limited_api := not get_config_var("Py_GIL_DISABLED"):
 if system() != "Windows":
     cflags = ["-std=c11", "-fvisibility=hidden"]
 else:
-    cflags = ["/std:c11", "/utf-8"]
+    # <stdatomic.h>, used by lib/src/batch.c
+    cflags = ["/std:c11", "/utf-8", "/experimental:c11atomics"]
+
+include_dirs = ["src"]
+ldflags: list[str] = []
+
+
+def tree_sitter_runtime():
+    """Compiler and linker flags of libtree-sitter 0.25 or later, if pkg-config finds it."""
+    try:
+        check_output(["pkg-config", "--exists", "tree-sitter >= 0.25"])
+        return (
+            check_output(["pkg-config", "--cflags", "tree-sitter"], text=True).split(),
+            check_output(["pkg-config", "--libs", "tree-sitter"], text=True).split(),
+        )
+    except (OSError, CalledProcessError):
+        return None
+
+
+# The native helpers (`parse_many` and the rest) link the shared libtree-sitter,
+# see script/install-runtime. Without it the build stops, unless
+# TREE_SITTER_ELM_NO_LIB asks for the grammar alone.
+if not environ.get("TREE_SITTER_ELM_NO_LIB"):
+    if not (runtime := tree_sitter_runtime()):
+        raise SystemExit(
+            "libtree-sitter >= 0.25 not found by pkg-config, run script/install-runtime"
+            " or set TREE_SITTER_ELM_NO_LIB=1 to build the grammar alone"
+        )
+    sources += sorted(glob("lib/src/*.c"))
+    macros.append(("TREE_SITTER_ELM_LIB", None))
+    include_dirs += ["lib/include", "bindings/c", "lib/src"]
+    cflags += runtime[0]
+    ldflags += runtime[1]
 
 
 class Build(build):
@@ -48,6 +82,8 @@ class EggInfo(egg_info):
         super().find_sources()
         self.filelist.recursive_include("queries", "*.scm")
         self.filelist.include("src/tree_sitter/*.h")
+        self.filelist.recursive_include("lib", "*.c", "*.h")
+        self.filelist.include("bindings/c/tree_sitter/*.h")
 
 
 setup(
@@ -63,8 +99,9 @@ setup(
             name="_binding",
             sources=sources,
             extra_compile_args=cflags,
+            extra_link_args=ldflags,
             define_macros=macros,
-            include_dirs=["src"],
+            include_dirs=include_dirs,
             py_limited_api=limited_api,
         )
     ],
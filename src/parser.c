@@ -3482,6 +3482,26 @@ static const TSCharacterRange sym_lower_case_identifier_character_set_1[] = {
   {0x1d7cb, 0x1d7cb}, {0x1e922, 0x1e943},
 };
 
+// Added by script/ascii-fast-path: ASCII members of the character sets, tested
+// before searching the ranges
+static const uint64_t sym__upper_case_identifier_without_leading_whitespace_character_set_1_ascii[2] = {0x0000000000000000, 0x0000000007fffffe};
+static const uint64_t sym__upper_case_identifier_without_leading_whitespace_character_set_2_ascii[2] = {0x03ff000000000000, 0x07fffffe87fffffe};
+static const uint64_t sym__lower_case_identifier_without_leading_whitespace_character_set_1_ascii[2] = {0x0000000000000000, 0x07fffffe00000000};
+static const uint64_t sym_upper_case_identifier_character_set_1_ascii[2] = {0x0000000000000000, 0x0000000007fffffe};
+static const uint64_t sym_upper_case_identifier_character_set_2_ascii[2] = {0x03ff000000000000, 0x07fffffe87fffffe};
+static const uint64_t sym_lower_case_identifier_character_set_1_ascii[2] = {0x0000000000000000, 0x07fffffe00000000};
+
+static inline bool set_contains_ascii(const uint64_t *ascii, const TSCharacterRange *ranges, uint32_t len, int32_t lookahead) {
+#ifdef TREE_SITTER_ELM_NO_ASCII_FAST_PATH
+  (void)ascii;
+#else
+  if (lookahead >= 0 && lookahead < 128) {
+    return (ascii[lookahead >> 6] >> (lookahead & 63)) & 1;
+  }
+#endif
+  return set_contains(ranges, len, lookahead);
+}
+
 static bool ts_lex(TSLexer *lexer, TSStateId state) {
   START_LEXER();
   eof = lexer->eof(lexer);
@@ -3540,8 +3560,8 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
           lookahead == 0x10594 ||
           lookahead == 0x10595 ||
           (0x10d50 <= lookahead && lookahead <= 0x10d65)) ADVANCE(77);
-      if (set_contains(sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(76);
-      if (set_contains(sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
+      if (set_contains_ascii(sym_upper_case_identifier_character_set_1_ascii, sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(76);
+      if (set_contains_ascii(sym_lower_case_identifier_character_set_1_ascii, sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
       END_STATE();
     case 1:
       if (lookahead == '\n') SKIP(13);
@@ -3647,8 +3667,8 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
           lookahead == 0x2060 ||
           lookahead == 0xfeff) SKIP(13);
       if (('1' <= lookahead && lookahead <= '9')) ADVANCE(105);
-      if (set_contains(sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
-      if (set_contains(sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
+      if (set_contains_ascii(sym_upper_case_identifier_character_set_1_ascii, sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
+      if (set_contains_ascii(sym_lower_case_identifier_character_set_1_ascii, sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
       END_STATE();
     case 14:
       ADVANCE_MAP(
@@ -3683,8 +3703,8 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
           lookahead == 0x2060 ||
           lookahead == 0xfeff) SKIP(15);
       if (('1' <= lookahead && lookahead <= '9')) ADVANCE(105);
-      if (set_contains(sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
-      if (set_contains(sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
+      if (set_contains_ascii(sym_upper_case_identifier_character_set_1_ascii, sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
+      if (set_contains_ascii(sym_lower_case_identifier_character_set_1_ascii, sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
       END_STATE();
     case 15:
       ADVANCE_MAP(
@@ -3719,8 +3739,8 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
           lookahead == 0x2060 ||
           lookahead == 0xfeff) SKIP(15);
       if (('1' <= lookahead && lookahead <= '9')) ADVANCE(105);
-      if (set_contains(sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
-      if (set_contains(sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
+      if (set_contains_ascii(sym_upper_case_identifier_character_set_1_ascii, sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
+      if (set_contains_ascii(sym_lower_case_identifier_character_set_1_ascii, sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
       END_STATE();
     case 16:
       if (lookahead == '"') ADVANCE(17);
@@ -3793,8 +3813,8 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
           lookahead == 0x200b ||
           lookahead == 0x2060 ||
           lookahead == 0xfeff) SKIP(21);
-      if (set_contains(sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
-      if (set_contains(sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
+      if (set_contains_ascii(sym_upper_case_identifier_character_set_1_ascii, sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
+      if (set_contains_ascii(sym_lower_case_identifier_character_set_1_ascii, sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
       END_STATE();
     case 22:
       ADVANCE_MAP(
@@ -3821,8 +3841,8 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
           lookahead == 0x200b ||
           lookahead == 0x2060 ||
           lookahead == 0xfeff) SKIP(23);
-      if (set_contains(sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
-      if (set_contains(sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
+      if (set_contains_ascii(sym_upper_case_identifier_character_set_1_ascii, sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
+      if (set_contains_ascii(sym_lower_case_identifier_character_set_1_ascii, sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
       END_STATE();
     case 23:
       ADVANCE_MAP(
@@ -3848,8 +3868,8 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
           lookahead == 0x200b ||
           lookahead == 0x2060 ||
           lookahead == 0xfeff) SKIP(23);
-      if (set_contains(sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
-      if (set_contains(sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
+      if (set_contains_ascii(sym_upper_case_identifier_character_set_1_ascii, sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
+      if (set_contains_ascii(sym_lower_case_identifier_character_set_1_ascii, sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
       END_STATE();
     case 24:
       ADVANCE_MAP(
@@ -3878,8 +3898,8 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
           lookahead == 0x200b ||
           lookahead == 0x2060 ||
           lookahead == 0xfeff) SKIP(25);
-      if (set_contains(sym__upper_case_identifier_without_leading_whitespace_character_set_1, 651, lookahead)) ADVANCE(77);
-      if (set_contains(sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
+      if (set_contains_ascii(sym__upper_case_identifier_without_leading_whitespace_character_set_1_ascii, sym__upper_case_identifier_without_leading_whitespace_character_set_1, 651, lookahead)) ADVANCE(77);
+      if (set_contains_ascii(sym_lower_case_identifier_character_set_1_ascii, sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
       END_STATE();
     case 25:
       ADVANCE_MAP(
@@ -3907,7 +3927,7 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
           lookahead == 0x200b ||
           lookahead == 0x2060 ||
           lookahead == 0xfeff) SKIP(25);
-      if (set_contains(sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
+      if (set_contains_ascii(sym_lower_case_identifier_character_set_1_ascii, sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
       END_STATE();
     case 26:
       if (lookahead == '&') ADVANCE(138);
@@ -3963,8 +3983,8 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
           lookahead == 0x200b ||
           lookahead == 0x2060 ||
           lookahead == 0xfeff) SKIP(32);
-      if (set_contains(sym__upper_case_identifier_without_leading_whitespace_character_set_1, 651, lookahead)) ADVANCE(77);
-      if (set_contains(sym__lower_case_identifier_without_leading_whitespace_character_set_1, 662, lookahead)) ADVANCE(78);
+      if (set_contains_ascii(sym__upper_case_identifier_without_leading_whitespace_character_set_1_ascii, sym__upper_case_identifier_without_leading_whitespace_character_set_1, 651, lookahead)) ADVANCE(77);
+      if (set_contains_ascii(sym__lower_case_identifier_without_leading_whitespace_character_set_1_ascii, sym__lower_case_identifier_without_leading_whitespace_character_set_1, 662, lookahead)) ADVANCE(78);
       END_STATE();
     case 34:
       if (lookahead == '.') ADVANCE(114);
@@ -4149,8 +4169,8 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
           lookahead == 0x2060 ||
           lookahead == 0xfeff) SKIP(66);
       if (('1' <= lookahead && lookahead <= '9')) ADVANCE(105);
-      if (set_contains(sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
-      if (set_contains(sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
+      if (set_contains_ascii(sym_upper_case_identifier_character_set_1_ascii, sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
+      if (set_contains_ascii(sym_lower_case_identifier_character_set_1_ascii, sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
       END_STATE();
     case 67:
       if (eof) ADVANCE(69);
@@ -4180,8 +4200,8 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
           lookahead == 0x2060 ||
           lookahead == 0xfeff) SKIP(68);
       if (('1' <= lookahead && lookahead <= '9')) ADVANCE(105);
-      if (set_contains(sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
-      if (set_contains(sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
+      if (set_contains_ascii(sym_upper_case_identifier_character_set_1_ascii, sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
+      if (set_contains_ascii(sym_lower_case_identifier_character_set_1_ascii, sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
       END_STATE();
     case 68:
       if (eof) ADVANCE(69);
@@ -4210,8 +4230,8 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
           lookahead == 0x2060 ||
           lookahead == 0xfeff) SKIP(68);
       if (('1' <= lookahead && lookahead <= '9')) ADVANCE(105);
-      if (set_contains(sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
-      if (set_contains(sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
+      if (set_contains_ascii(sym_upper_case_identifier_character_set_1_ascii, sym_upper_case_identifier_character_set_1, 636, lookahead)) ADVANCE(102);
+      if (set_contains_ascii(sym_lower_case_identifier_character_set_1_ascii, sym_lower_case_identifier_character_set_1, 642, lookahead)) ADVANCE(103);
       END_STATE();
     case 69:
       ACCEPT_TOKEN(ts_builtin_sym_end);
@@ -4351,15 +4371,15 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
           (0x2ebf0 <= lookahead && lookahead <= 0x2ee5d) ||
           (0x30000 <= lookahead && lookahead <= 0x3134a) ||
           (0x31350 <= lookahead && lookahead <= 0x323af)) ADVANCE(77);
-      if (set_contains(sym_upper_case_identifier_character_set_2, 611, lookahead)) ADVANCE(76);
+      if (set_contains_ascii(sym_upper_case_identifier_character_set_2_ascii, sym_upper_case_identifier_character_set_2, 611, lookahead)) ADVANCE(76);
       END_STATE();
     case 77:
       ACCEPT_TOKEN(sym__upper_case_identifier_without_leading_whitespace);
-      if (set_contains(sym__upper_case_identifier_without_leading_whitespace_character_set_2, 679, lookahead)) ADVANCE(77);
+      if (set_contains_ascii(sym__upper_case_identifier_without_leading_whitespace_character_set_2_ascii, sym__upper_case_identifier_without_leading_whitespace_character_set_2, 679, lookahead)) ADVANCE(77);
       END_STATE();
     case 78:
       ACCEPT_TOKEN(sym__lower_case_identifier_without_leading_whitespace);
-      if (set_contains(sym__upper_case_identifier_without_leading_whitespace_character_set_2, 679, lookahead)) ADVANCE(78);
+      if (set_contains_ascii(sym__upper_case_identifier_without_leading_whitespace_character_set_2_ascii, sym__upper_case_identifier_without_leading_whitespace_character_set_2, 679, lookahead)) ADVANCE(78);
       END_STATE();
     case 79:
       ACCEPT_TOKEN(anon_sym_DOT);
@@ -4476,11 +4496,11 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
       END_STATE();
     case 102:
       ACCEPT_TOKEN(sym_upper_case_identifier);
-      if (set_contains(sym_upper_case_identifier_character_set_2, 611, lookahead)) ADVANCE(102);
+      if (set_contains_ascii(sym_upper_case_identifier_character_set_2_ascii, sym_upper_case_identifier_character_set_2, 611, lookahead)) ADVANCE(102);
       END_STATE();
     case 103:
       ACCEPT_TOKEN(sym_lower_case_identifier);
-      if (set_contains(sym_upper_case_identifier_character_set_2, 611, lookahead)) ADVANCE(103);
+      if (set_contains_ascii(sym_upper_case_identifier_character_set_2_ascii, sym_upper_case_identifier_character_set_2, 611, lookahead)) ADVANCE(103);
       END_STATE();
     case 104:
       ACCEPT_TOKEN(sym_number_literal);
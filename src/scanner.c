@@ -1,3 +1,4 @@
+#include "tree_sitter/alloc.h"
 #include "tree_sitter/parser.h"
 #include <assert.h>
 #include <stdint.h>
@@ -10,7 +11,7 @@
 #define MAX_INDENT_DEPTH 256
 
 #define VEC_RESIZE(vec, _cap)                                                  \
-    void *tmp = realloc((vec).data, (_cap) * sizeof((vec).data[0]));           \
+    void *tmp = ts_realloc((vec).data, (_cap) * sizeof((vec).data[0]));        \
     assert(tmp != NULL);                                                       \
     (vec).data = tmp;                                                          \
     assert((vec).data != NULL);                                                \
@@ -34,7 +35,7 @@
 #define VEC_FREE(vec)                                                          \
     {                                                                          \
         if ((vec).data != NULL)                                                \
-            free((vec).data);                                                  \
+            ts_free((vec).data);                                               \
     }
 
 #define VEC_CLEAR(vec) (vec).len = 0;
@@ -72,6 +73,141 @@ typedef struct {
     vec runback;
 } Scanner;
 
+// --------------------------------------------------------------------------------------------------------
+// Tracing
+// --------------------------------------------------------------------------------------------------------
+
+// Opt-in layout events, see bindings/c/tree_sitter/tree-sitter-elm-trace.h.
+// TREE_SITTER_ELM_USDT makes them USDT probes, which are a nop until a
+// tracer attaches, and TREE_SITTER_ELM_TRACE_RING records them into an
+// in-process ring buffer. Without either, TRACE expands to nothing.
+
+#ifdef TREE_SITTER_ELM_USDT
+#include <sys/sdt.h>
+#define TRACE_PROBE(probe, a, b) DTRACE_PROBE2(tree_sitter_elm, probe, a, b)
+#else
+#define TRACE_PROBE(probe, a, b)
+#endif
+
+#ifdef TREE_SITTER_ELM_TRACE_RING
+#include "../bindings/c/tree_sitter/tree-sitter-elm-trace.h"
+#include <stdatomic.h>
+
+// A power of two
+#define TRACE_RING_SIZE 4096
+
+// Fields are atomic so that dumping while other threads parse is not a
+// data race. A slot's sequence is 0 while it is being written.
+typedef struct {
+    atomic_uint_fast64_t sequence;
+    atomic_uint kind;
+    atomic_uint arg0;
+    atomic_uint arg1;
+} TraceSlot;
+
+static TraceSlot trace_ring[TRACE_RING_SIZE];
+static atomic_uint_fast64_t trace_head;
+static atomic_uint_fast64_t trace_floor;
+
+static const char *const TRACE_KIND_NAMES[] = {
+    "scan_start",   "scan_end",    "end_decl",     "open_section", "end_section",
+    "runback_push", "runback_pop", "indent_limit", "serialize",    "deserialize",
+};
+
+static void trace_record(TSElmTraceKind kind, uint32_t arg0, uint32_t arg1) {
+    uint64_t sequence = atomic_fetch_add_explicit(&trace_head, 1, memory_order_relaxed) + 1;
+    TraceSlot *slot = &trace_ring[sequence & (TRACE_RING_SIZE - 1)];
+    atomic_store_explicit(&slot->sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&slot->kind, kind, memory_order_relaxed);
+    atomic_store_explicit(&slot->arg0, arg0, memory_order_relaxed);
+    atomic_store_explicit(&slot->arg1, arg1, memory_order_relaxed);
+    atomic_store_explicit(&slot->sequence, sequence, memory_order_release);
+}
+
+uint32_t tree_sitter_elm_trace_read(TSElmTraceEvent *events, uint32_t capacity) {
+    uint64_t head = atomic_load(&trace_head);
+    uint64_t first = atomic_load(&trace_floor) + 1;
+    if (head >= TRACE_RING_SIZE && first < head - TRACE_RING_SIZE + 1) {
+        first = head - TRACE_RING_SIZE + 1;
+    }
+    if (head >= capacity && first < head - capacity + 1) {
+        first = head - capacity + 1;
+    }
+
+    uint32_t count = 0;
+    for (uint64_t sequence = first; sequence <= head && count < capacity; sequence++) {
+        TraceSlot *slot = &trace_ring[sequence & (TRACE_RING_SIZE - 1)];
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != sequence) {
+            continue;
+        }
+        TSElmTraceEvent event = {
+            sequence,
+            atomic_load_explicit(&slot->kind, memory_order_relaxed),
+            atomic_load_explicit(&slot->arg0, memory_order_relaxed),
+            atomic_load_explicit(&slot->arg1, memory_order_relaxed),
+        };
+        // Skip the slot if a writer took it over while it was copied
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&slot->sequence, memory_order_relaxed) == sequence) {
+            events[count++] = event;
+        }
+    }
+    return count;
+}
+
+void tree_sitter_elm_trace_dump(FILE *file) {
+    TSElmTraceEvent *events = malloc(TRACE_RING_SIZE * sizeof(TSElmTraceEvent));
+    if (events == NULL) {
+        return;
+    }
+    uint32_t count = tree_sitter_elm_trace_read(events, TRACE_RING_SIZE);
+    for (uint32_t i = 0; i < count; i++) {
+        fprintf(file, "%llu %s %u %u\n", (unsigned long long)events[i].sequence,
+                TRACE_KIND_NAMES[events[i].kind], events[i].arg0, events[i].arg1);
+    }
+    free(events);
+}
+
+void tree_sitter_elm_trace_clear(void) {
+    atomic_store(&trace_floor, atomic_load(&trace_head));
+}
+
+#define TRACE_RECORD(kind, a, b) trace_record(kind, (uint32_t)(a), (uint32_t)(b))
+#else
+#define TRACE_RECORD(kind, a, b)
+#endif
+
+#define TRACE(probe, kind, a, b)                                               \
+    do {                                                                       \
+        TRACE_PROBE(probe, a, b);                                              \
+        TRACE_RECORD(kind, a, b);                                              \
+    } while (0)
+
+// --------------------------------------------------------------------------------------------------------
+// Timing
+// --------------------------------------------------------------------------------------------------------
+
+// Scan timing for the parse budgets of the bindings, see scanner_timing.h.
+// Scan calls add to the counters their thread has set, at the cost of a
+// thread-local load when none are set.
+
+#include "scanner_timing.h"
+
+#ifdef _MSC_VER
+#define ELM_THREAD_LOCAL __declspec(thread)
+#else
+#define ELM_THREAD_LOCAL _Thread_local
+#endif
+
+static ELM_THREAD_LOCAL ElmScannerTiming *current_timing;
+
+void tree_sitter_elm_scanner_timing_begin(ElmScannerTiming *timing) {
+    current_timing = timing;
+}
+
+void tree_sitter_elm_scanner_timing_end(void) { current_timing = NULL; }
+
 static inline void advance(TSLexer *lexer) { lexer->advance(lexer, false); }
 
 static inline void skip(TSLexer *lexer) { lexer->advance(lexer, true); }
@@ -162,6 +298,18 @@ static void advance_to_line_end(TSLexer *lexer) {
     }
 }
 
+// Queue a VIRTUAL_END_DECL (0) or VIRTUAL_END_SECTION (1) for later scans.
+static inline void runback_push(Scanner *scanner, uint8_t token) {
+    VEC_PUSH(scanner->runback, token);
+    TRACE(runback_push, TSElmTraceRunbackPush, token, scanner->runback.len);
+}
+
+static inline void runback_pop(Scanner *scanner) {
+    TRACE(runback_pop, TSElmTraceRunbackPop, VEC_BACK(scanner->runback),
+          scanner->runback.len - 1);
+    VEC_POP(scanner->runback);
+}
+
 static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
     if (in_error_recovery(valid_symbols)) {
         return false;
@@ -170,13 +318,13 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
     // First handle eventual runback tokens, we saved on a previous scan op
     if (scanner->runback.len > 0 && VEC_BACK(scanner->runback) == 0 &&
         valid_symbols[VIRTUAL_END_DECL]) {
-        VEC_POP(scanner->runback);
+        runback_pop(scanner);
         lexer->result_symbol = VIRTUAL_END_DECL;
         return true;
     }
     if (scanner->runback.len > 0 && VEC_BACK(scanner->runback) == 1 &&
         valid_symbols[VIRTUAL_END_SECTION]) {
-        VEC_POP(scanner->runback);
+        runback_pop(scanner);
         lexer->result_symbol = VIRTUAL_END_SECTION;
         return true;
     }
@@ -324,6 +472,8 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
     // we go further down in the stack
     if (valid_symbols[VIRTUAL_OPEN_SECTION] && !lexer->eof(lexer)) {
         if (scanner->indents.len >= MAX_INDENT_DEPTH) {
+            TRACE(indent_limit, TSElmTraceIndentLimit, scanner->indents.len,
+                  scanner->indent_length);
             return false;  // Prevent unbounded nesting
         }
         VEC_PUSH(scanner->indents, lexer->get_column(lexer));
@@ -452,7 +602,7 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
             if (scanner->indent_length == VEC_BACK(scanner->indents)) {
                 if (found_in) {
                     VEC_POP(scanner->indents);  // Pop the section we're closing
-                    VEC_PUSH(scanner->runback, 1);
+                    runback_push(scanner, 1);
                     found_in = false;
                     break;
                 }
@@ -473,12 +623,12 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
                         break;
                     }
                 }
-                VEC_PUSH(scanner->runback, 0);
+                runback_push(scanner, 0);
                 break;
             }
             if (scanner->indent_length < VEC_BACK(scanner->indents)) {
                 VEC_POP(scanner->indents);
-                VEC_PUSH(scanner->runback, 1);
+                runback_push(scanner, 1);
                 // If we've popped past the indent_length and found_in is true,
                 // this pop closed the let section. Reset found_in since the let
                 // is now closed. Otherwise keep found_in true to close the let
@@ -494,7 +644,7 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
         // line as everything before the in in the next line
         if (found_in && scanner->indents.len > 0) {
             VEC_POP(scanner->indents);
-            VEC_PUSH(scanner->runback, 1);
+            runback_push(scanner, 1);
             found_in = false;
         }
 
@@ -504,13 +654,13 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
         // they will be handled on the next scan operation
         if (scanner->runback.len > 0 && VEC_BACK(scanner->runback) == 0 &&
             valid_symbols[VIRTUAL_END_DECL]) {
-            VEC_POP(scanner->runback);
+            runback_pop(scanner);
             lexer->result_symbol = VIRTUAL_END_DECL;
             return true;
         }
         if (scanner->runback.len > 0 && VEC_BACK(scanner->runback) == 1 &&
             valid_symbols[VIRTUAL_END_SECTION]) {
-            VEC_POP(scanner->runback);
+            runback_pop(scanner);
             lexer->result_symbol = VIRTUAL_END_SECTION;
             return true;
         }
@@ -556,7 +706,7 @@ static bool scan(Scanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
  * into the other API functions.
  */
 void *tree_sitter_elm_external_scanner_create() {
-    Scanner *scanner = (Scanner *)calloc(1, sizeof(Scanner));
+    Scanner *scanner = (Scanner *)ts_calloc(1, sizeof(Scanner));
     return scanner;
 }
 
@@ -567,7 +717,34 @@ void *tree_sitter_elm_external_scanner_create() {
 bool tree_sitter_elm_external_scanner_scan(void *payload, TSLexer *lexer,
                                            const bool *valid_symbols) {
     Scanner *scanner = (Scanner *)payload;
-    return scan(scanner, lexer, valid_symbols);
+    TRACE(scan_start, TSElmTraceScanStart, scanner->indents.len, scanner->runback.len);
+    ElmScannerTiming *timing = current_timing;
+    uint64_t start = timing != NULL ? timing->clock() : 0;
+    bool found = scan(scanner, lexer, valid_symbols);
+    if (timing != NULL) {
+        timing->nanos += timing->clock() - start;
+        timing->calls++;
+    }
+    TRACE(scan_end, TSElmTraceScanEnd, found, found ? lexer->result_symbol : 0);
+    if (found) {
+        switch (lexer->result_symbol) {
+            case VIRTUAL_END_DECL:
+                TRACE(end_decl, TSElmTraceEndDecl, scanner->indents.len,
+                      scanner->indent_length);
+                break;
+            case VIRTUAL_OPEN_SECTION:
+                TRACE(open_section, TSElmTraceOpenSection, scanner->indents.len,
+                      scanner->indent_length);
+                break;
+            case VIRTUAL_END_SECTION:
+                TRACE(end_section, TSElmTraceEndSection, scanner->indents.len,
+                      scanner->indent_length);
+                break;
+            default:
+                break;
+        }
+    }
+    return found;
 }
 
 /**
@@ -582,6 +759,7 @@ unsigned tree_sitter_elm_external_scanner_serialize(void *payload,
 
     if (3 + scanner->indents.len + scanner->runback.len >=
         TREE_SITTER_SERIALIZATION_BUFFER_SIZE) {
+        TRACE(serialize, TSElmTraceSerialize, 0, scanner->indents.len);
         return 0;
     }
 
@@ -609,6 +787,7 @@ unsigned tree_sitter_elm_external_scanner_serialize(void *payload,
         buffer[size++] = (char)scanner->indents.data[iter];
     }
 
+    TRACE(serialize, TSElmTraceSerialize, size, scanner->indents.len);
     return size;
 }
 
@@ -627,6 +806,7 @@ void tree_sitter_elm_external_scanner_deserialize(void *payload,
     VEC_PUSH(scanner->indents, 0);
 
     if (length == 0) {
+        TRACE(deserialize, TSElmTraceDeserialize, 0, scanner->indents.len);
         return;
     }
 
@@ -649,6 +829,7 @@ void tree_sitter_elm_external_scanner_deserialize(void *payload,
         VEC_PUSH(scanner->indents, (unsigned char)buffer[size]);
     }
     assert(size == length);
+    TRACE(deserialize, TSElmTraceDeserialize, length, scanner->indents.len);
 }
 
 /**
@@ -658,5 +839,5 @@ void tree_sitter_elm_external_scanner_destroy(void *payload) {
     Scanner *scanner = (Scanner *)payload;
     VEC_FREE(scanner->indents);
     VEC_FREE(scanner->runback);
-    free(scanner);
+    ts_free(scanner);
 }
@@ -0,0 +1,26 @@
+#ifndef TREE_SITTER_ELM_SCANNER_TIMING_H_
+#define TREE_SITTER_ELM_SCANNER_TIMING_H_
+
+// Time spent in the external scanner during a parse, for the parse budgets
+// of the bindings. Every build of the grammar has this hook. A thread that
+// calls tree_sitter_elm_scanner_timing_begin adds the time and the number
+// of its scan calls to `timing` until tree_sitter_elm_scanner_timing_end,
+// other threads pay a thread-local load per scan call. The caller supplies
+// the clock, so the grammar needs none of its own. Only the scanner of
+// tree_sitter_elm() is counted, the lean grammar's copy has its own,
+// renamed, functions.
+
+#include <stdint.h>
+
+typedef struct {
+    // A monotonic clock in nanoseconds
+    uint64_t (*clock)(void);
+    uint64_t nanos;
+    uint64_t calls;
+} ElmScannerTiming;
+
+void tree_sitter_elm_scanner_timing_begin(ElmScannerTiming *timing);
+
+void tree_sitter_elm_scanner_timing_end(void);
+
+#endif // TREE_SITTER_ELM_SCANNER_TIMING_H_
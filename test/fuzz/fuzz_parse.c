@@ -0,0 +1,208 @@
+// A libFuzzer target that parses its input, then edits it a few times and
+// reparses it incrementally. Besides crashes, it aborts when a parse is
+// slow or allocates a lot for the length of its input, which is how
+// quadratic cases of the layout scanner show up: runback churn, deeply
+// nested comments, and the lookahead for `in` after a let.
+//
+// The grammar is compiled in with TREE_SITTER_REUSE_ALLOCATOR, so the
+// allocations counted include the external scanner's.
+//
+// Build it with -DTREE_SITTER_ELM_FUZZ=ON and clang, run it on the test
+// corpus, and minimize what it finds into a regression test:
+//
+//   ./tree-sitter-elm-fuzz -max_len=4096 corpus/ ../test/corpus/*.txt
+//   ./tree-sitter-elm-fuzz -minimize_crash=1 -runs=10000 slow-unit-...
+//   cp minimized-from-... ../test/fuzz/regressions/<what-it-is>.elm
+//
+// AFL++ runs the same target through afl-clang-fast -fsanitize=fuzzer.
+// Without libFuzzer the target is linked with a main that runs it once on
+// each file it is given, which the fuzz_inputs test does on
+// test/fuzz/regressions and on the hand-written inputs in test/fuzz/stress.
+//
+// The limits can be set in the environment:
+// TREE_SITTER_ELM_FUZZ_NS_PER_BYTE (20000) and
+// TREE_SITTER_ELM_FUZZ_ALLOCATIONS_PER_BYTE (64), each on top of an
+// allowance of 100 ms and 10000 allocations per parse.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "tree_sitter/api.h"
+#include "tree_sitter/tree-sitter-elm.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define EDITS 3
+#define MAX_SIZE (1024 * 1024)
+#define BASE_NANOS (100 * 1000 * 1000)
+#define BASE_ALLOCATIONS 10000
+
+static size_t allocations;
+static uint64_t nanos_per_byte = 20000;
+static uint64_t allocations_per_byte = 64;
+
+static void *counting_malloc(size_t size) {
+    allocations++;
+    return malloc(size);
+}
+
+static void *counting_calloc(size_t count, size_t size) {
+    allocations++;
+    return calloc(count, size);
+}
+
+static void *counting_realloc(void *pointer, size_t size) {
+    allocations++;
+    return realloc(pointer, size);
+}
+
+static uint64_t now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000 + (uint64_t)time.tv_nsec;
+}
+
+static uint64_t limit(const char *name, uint64_t fallback) {
+    const char *value = getenv(name);
+    return value != NULL ? strtoull(value, NULL, 10) : fallback;
+}
+
+int LLVMFuzzerInitialize(int *argc, char ***argv) {
+    (void)argc;
+    (void)argv;
+    nanos_per_byte = limit("TREE_SITTER_ELM_FUZZ_NS_PER_BYTE", nanos_per_byte);
+    allocations_per_byte =
+        limit("TREE_SITTER_ELM_FUZZ_ALLOCATIONS_PER_BYTE", allocations_per_byte);
+    ts_set_allocator(counting_malloc, counting_calloc, counting_realloc, free);
+    return 0;
+}
+
+// Parse `source`, reusing `old_tree` if it is not NULL, and abort when the
+// parse takes too long or allocates too often for the length of `source`
+static TSTree *parse(TSParser *parser, TSTree *old_tree, const char *source,
+                     uint32_t length) {
+    size_t allocations_before = allocations;
+    uint64_t start = now();
+    TSTree *tree = ts_parser_parse_string(parser, old_tree, source, length);
+    uint64_t nanos = now() - start;
+    size_t count = allocations - allocations_before;
+    if (nanos > BASE_NANOS + nanos_per_byte * length) {
+        fprintf(stderr, "slow %s parse: %.1f ms for %u bytes\n",
+                old_tree ? "incremental" : "full", (double)nanos / 1e6, length);
+        abort();
+    }
+    if (count > BASE_ALLOCATIONS + allocations_per_byte * length) {
+        fprintf(stderr, "%s parse made %zu allocations for %u bytes\n",
+                old_tree ? "incremental" : "full", count, length);
+        abort();
+    }
+    return tree;
+}
+
+static TSPoint point_at(const char *source, uint32_t byte) {
+    TSPoint point = {0, 0};
+    for (uint32_t i = 0; i < byte; i++) {
+        if (source[i] == '\n') {
+            point.row++;
+            point.column = 0;
+        } else {
+            point.column++;
+        }
+    }
+    return point;
+}
+
+// The next value of a xorshift generator, seeded from the input so that
+// every run of an input makes the same edits
+static uint32_t next_random(uint32_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    if (size > MAX_SIZE) {
+        return 0;
+    }
+    uint32_t length = (uint32_t)size;
+    // Each edit at most doubles the source
+    char *source = malloc(((size_t)length << EDITS) + 1);
+    char *edited = malloc(((size_t)length << EDITS) + 1);
+    memcpy(source, data, length);
+
+    uint32_t seed = 2166136261u;
+    for (uint32_t i = 0; i < length; i++) {
+        seed = (seed ^ data[i]) * 16777619u;
+    }
+    seed |= 1;
+
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_elm());
+    TSTree *tree = parse(parser, NULL, source, length);
+
+    // Delete a range and paste another range of the input in its place
+    for (int edit = 0; edit < EDITS && tree != NULL && length > 0; edit++) {
+        uint32_t start = next_random(&seed) % (length + 1);
+        uint32_t removed = next_random(&seed) % (length - start + 1);
+        uint32_t copied_start = next_random(&seed) % (length + 1);
+        uint32_t inserted = next_random(&seed) % (length - copied_start + 1);
+
+        memcpy(edited, source, start);
+        memcpy(edited + start, source + copied_start, inserted);
+        memcpy(edited + start + inserted, source + start + removed, length - start - removed);
+        TSInputEdit input_edit = {
+            .start_byte = start,
+            .old_end_byte = start + removed,
+            .new_end_byte = start + inserted,
+            .start_point = point_at(source, start),
+            .old_end_point = point_at(source, start + removed),
+            .new_end_point = point_at(edited, start + inserted),
+        };
+        length = length - removed + inserted;
+        char *swap = source;
+        source = edited;
+        edited = swap;
+
+        ts_tree_edit(tree, &input_edit);
+        TSTree *new_tree = parse(parser, tree, source, length);
+        ts_tree_delete(tree);
+        tree = new_tree;
+    }
+
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+    free(source);
+    free(edited);
+    return 0;
+}
+
+#ifndef TREE_SITTER_ELM_LIBFUZZER
+
+// Run the target on each file, like libFuzzer does when given files
+int main(int argc, char **argv) {
+    LLVMFuzzerInitialize(&argc, &argv);
+    for (int i = 1; i < argc; i++) {
+        FILE *file = fopen(argv[i], "rb");
+        if (file == NULL) {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        uint8_t *data = malloc(size > 0 ? (size_t)size : 1);
+        size_t read = fread(data, 1, (size_t)size, file);
+        fclose(file);
+        printf("%s\n", argv[i]);
+        LLVMFuzzerTestOneInput(data, read);
+        free(data);
+    }
+    return EXIT_SUCCESS;
+}
+
+#endif
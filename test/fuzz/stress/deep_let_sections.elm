@@ -0,0 +1,305 @@
+-- Hand-written stress input: let blocks nested 300 deep, one column deeper
+-- each time, past the scanner's indent depth limit of 256.
+module Main exposing (..)
+
+f =
+ let
+  let
+   let
+    let
+     let
+      let
+       let
+        let
+         let
+          let
+           let
+            let
+             let
+              let
+               let
+                let
+                 let
+                  let
+                   let
+                    let
+                     let
+                      let
+                       let
+                        let
+                         let
+                          let
+                           let
+                            let
+                             let
+                              let
+                               let
+                                let
+                                 let
+                                  let
+                                   let
+                                    let
+                                     let
+                                      let
+                                       let
+                                        let
+                                         let
+                                          let
+                                           let
+                                            let
+                                             let
+                                              let
+                                               let
+                                                let
+                                                 let
+                                                  let
+                                                   let
+                                                    let
+                                                     let
+                                                      let
+                                                       let
+                                                        let
+                                                         let
+                                                          let
+                                                           let
+                                                            let
+                                                             let
+                                                              let
+                                                               let
+                                                                let
+                                                                 let
+                                                                  let
+                                                                   let
+                                                                    let
+                                                                     let
+                                                                      let
+                                                                       let
+                                                                        let
+                                                                         let
+                                                                          let
+                                                                           let
+                                                                            let
+                                                                             let
+                                                                              let
+                                                                               let
+                                                                                let
+                                                                                 let
+                                                                                  let
+                                                                                   let
+                                                                                    let
+                                                                                     let
+                                                                                      let
+                                                                                       let
+                                                                                        let
+                                                                                         let
+                                                                                          let
+                                                                                           let
+                                                                                            let
+                                                                                             let
+                                                                                              let
+                                                                                               let
+                                                                                                let
+                                                                                                 let
+                                                                                                  let
+                                                                                                   let
+                                                                                                    let
+                                                                                                     let
+                                                                                                      let
+                                                                                                       let
+                                                                                                        let
+                                                                                                         let
+                                                                                                          let
+                                                                                                           let
+                                                                                                            let
+                                                                                                             let
+                                                                                                              let
+                                                                                                               let
+                                                                                                                let
+                                                                                                                 let
+                                                                                                                  let
+                                                                                                                   let
+                                                                                                                    let
+                                                                                                                     let
+                                                                                                                      let
+                                                                                                                       let
+                                                                                                                        let
+                                                                                                                         let
+                                                                                                                          let
+                                                                                                                           let
+                                                                                                                            let
+                                                                                                                             let
+                                                                                                                              let
+                                                                                                                               let
+                                                                                                                                let
+                                                                                                                                 let
+                                                                                                                                  let
+                                                                                                                                   let
+                                                                                                                                    let
+                                                                                                                                     let
+                                                                                                                                      let
+                                                                                                                                       let
+                                                                                                                                        let
+                                                                                                                                         let
+                                                                                                                                          let
+                                                                                                                                           let
+                                                                                                                                            let
+                                                                                                                                             let
+                                                                                                                                              let
+                                                                                                                                               let
+                                                                                                                                                let
+                                                                                                                                                 let
+                                                                                                                                                  let
+                                                                                                                                                   let
+                                                                                                                                                    let
+                                                                                                                                                     let
+                                                                                                                                                      let
+                                                                                                                                                       let
+                                                                                                                                                        let
+                                                                                                                                                         let
+                                                                                                                                                          let
+                                                                                                                                                           let
+                                                                                                                                                            let
+                                                                                                                                                             let
+                                                                                                                                                              let
+                                                                                                                                                               let
+                                                                                                                                                                let
+                                                                                                                                                                 let
+                                                                                                                                                                  let
+                                                                                                                                                                   let
+                                                                                                                                                                    let
+                                                                                                                                                                     let
+                                                                                                                                                                      let
+                                                                                                                                                                       let
+                                                                                                                                                                        let
+                                                                                                                                                                         let
+                                                                                                                                                                          let
+                                                                                                                                                                           let
+                                                                                                                                                                            let
+                                                                                                                                                                             let
+                                                                                                                                                                              let
+                                                                                                                                                                               let
+                                                                                                                                                                                let
+                                                                                                                                                                                 let
+                                                                                                                                                                                  let
+                                                                                                                                                                                   let
+                                                                                                                                                                                    let
+                                                                                                                                                                                     let
+                                                                                                                                                                                      let
+                                                                                                                                                                                       let
+                                                                                                                                                                                        let
+                                                                                                                                                                                         let
+                                                                                                                                                                                          let
+                                                                                                                                                                                           let
+                                                                                                                                                                                            let
+                                                                                                                                                                                             let
+                                                                                                                                                                                              let
+                                                                                                                                                                                               let
+                                                                                                                                                                                                let
+                                                                                                                                                                                                 let
+                                                                                                                                                                                                  let
+                                                                                                                                                                                                   let
+                                                                                                                                                                                                    let
+                                                                                                                                                                                                     let
+                                                                                                                                                                                                      let
+                                                                                                                                                                                                       let
+                                                                                                                                                                                                        let
+                                                                                                                                                                                                         let
+                                                                                                                                                                                                          let
+                                                                                                                                                                                                           let
+                                                                                                                                                                                                            let
+                                                                                                                                                                                                             let
+                                                                                                                                                                                                              let
+                                                                                                                                                                                                               let
+                                                                                                                                                                                                                let
+                                                                                                                                                                                                                 let
+                                                                                                                                                                                                                  let
+                                                                                                                                                                                                                   let
+                                                                                                                                                                                                                    let
+                                                                                                                                                                                                                     let
+                                                                                                                                                                                                                      let
+                                                                                                                                                                                                                       let
+                                                                                                                                                                                                                        let
+                                                                                                                                                                                                                         let
+                                                                                                                                                                                                                          let
+                                                                                                                                                                                                                           let
+                                                                                                                                                                                                                            let
+                                                                                                                                                                                                                             let
+                                                                                                                                                                                                                              let
+                                                                                                                                                                                                                               let
+                                                                                                                                                                                                                                let
+                                                                                                                                                                                                                                 let
+                                                                                                                                                                                                                                  let
+                                                                                                                                                                                                                                   let
+                                                                                                                                                                                                                                    let
+                                                                                                                                                                                                                                     let
+                                                                                                                                                                                                                                      let
+                                                                                                                                                                                                                                       let
+                                                                                                                                                                                                                                        let
+                                                                                                                                                                                                                                         let
+                                                                                                                                                                                                                                          let
+                                                                                                                                                                                                                                           let
+                                                                                                                                                                                                                                            let
+                                                                                                                                                                                                                                             let
+                                                                                                                                                                                                                                              let
+                                                                                                                                                                                                                                               let
+                                                                                                                                                                                                                                                let
+                                                                                                                                                                                                                                                 let
+                                                                                                                                                                                                                                                  let
+                                                                                                                                                                                                                                                   let
+                                                                                                                                                                                                                                                    let
+                                                                                                                                                                                                                                                     let
+                                                                                                                                                                                                                                                      let
+                                                                                                                                                                                                                                                       let
+                                                                                                                                                                                                                                                        let
+                                                                                                                                                                                                                                                         let
+                                                                                                                                                                                                                                                          let
+                                                                                                                                                                                                                                                           let
+                                                                                                                                                                                                                                                            let
+                                                                                                                                                                                                                                                             let
+                                                                                                                                                                                                                                                              let
+                                                                                                                                                                                                                                                               let
+                                                                                                                                                                                                                                                                let
+                                                                                                                                                                                                                                                                 let
+                                                                                                                                                                                                                                                                  let
+                                                                                                                                                                                                                                                                   let
+                                                                                                                                                                                                                                                                    let
+                                                                                                                                                                                                                                                                     let
+                                                                                                                                                                                                                                                                      let
+                                                                                                                                                                                                                                                                       let
+                                                                                                                                                                                                                                                                        let
+                                                                                                                                                                                                                                                                         let
+                                                                                                                                                                                                                                                                          let
+                                                                                                                                                                                                                                                                           let
+                                                                                                                                                                                                                                                                            let
+                                                                                                                                                                                                                                                                             let
+                                                                                                                                                                                                                                                                              let
+                                                                                                                                                                                                                                                                               let
+                                                                                                                                                                                                                                                                                let
+                                                                                                                                                                                                                                                                                 let
+                                                                                                                                                                                                                                                                                  let
+                                                                                                                                                                                                                                                                                   let
+                                                                                                                                                                                                                                                                                    let
+                                                                                                                                                                                                                                                                                     let
+                                                                                                                                                                                                                                                                                      let
+                                                                                                                                                                                                                                                                                       let
+                                                                                                                                                                                                                                                                                        let
+                                                                                                                                                                                                                                                                                         let
+                                                                                                                                                                                                                                                                                          let
+                                                                                                                                                                                                                                                                                           let
+                                                                                                                                                                                                                                                                                            let
+                                                                                                                                                                                                                                                                                             let
+                                                                                                                                                                                                                                                                                              let
+                                                                                                                                                                                                                                                                                               let
+                                                                                                                                                                                                                                                                                                let
+                                                                                                                                                                                                                                                                                                 let
+                                                                                                                                                                                                                                                                                                  let
+                                                                                                                                                                                                                                                                                                   let
+                                                                                                                                                                                                                                                                                                    let
+                                                                                                                                                                                                                                                                                                     let
+                                                                                                                                                                                                                                                                                                      let
+                                                                                                                                                                                                                                                                                                       let
+                                                                                                                                                                                                                                                                                                        let
+                                                                                                                                                                                                                                                                                                         let
+                                                                                                                                                                                                                                                                                                          let
+                                                                                                                                                                                                                                                                                                           let
+                                                                                                                                                                                                                                                                                                            let
@@ -0,0 +1,2009 @@
+-- Hand-written stress input: a let with a thousand bindings whose values
+-- are names starting with "in", so the scanner looks ahead for the `in`
+-- keyword on each of them.
+module Main exposing (..)
+
+f =
+    let
+        i0 =
+            in0
+        i1 =
+            in1
+        i2 =
+            in2
+        i3 =
+            in3
+        i4 =
+            in4
+        i5 =
+            in5
+        i6 =
+            in6
+        i7 =
+            in7
+        i8 =
+            in8
+        i9 =
+            in9
+        i10 =
+            in10
+        i11 =
+            in11
+        i12 =
+            in12
+        i13 =
+            in13
+        i14 =
+            in14
+        i15 =
+            in15
+        i16 =
+            in16
+        i17 =
+            in17
+        i18 =
+            in18
+        i19 =
+            in19
+        i20 =
+            in20
+        i21 =
+            in21
+        i22 =
+            in22
+        i23 =
+            in23
+        i24 =
+            in24
+        i25 =
+            in25
+        i26 =
+            in26
+        i27 =
+            in27
+        i28 =
+            in28
+        i29 =
+            in29
+        i30 =
+            in30
+        i31 =
+            in31
+        i32 =
+            in32
+        i33 =
+            in33
+        i34 =
+            in34
+        i35 =
+            in35
+        i36 =
+            in36
+        i37 =
+            in37
+        i38 =
+            in38
+        i39 =
+            in39
+        i40 =
+            in40
+        i41 =
+            in41
+        i42 =
+            in42
+        i43 =
+            in43
+        i44 =
+            in44
+        i45 =
+            in45
+        i46 =
+            in46
+        i47 =
+            in47
+        i48 =
+            in48
+        i49 =
+            in49
+        i50 =
+            in50
+        i51 =
+            in51
+        i52 =
+            in52
+        i53 =
+            in53
+        i54 =
+            in54
+        i55 =
+            in55
+        i56 =
+            in56
+        i57 =
+            in57
+        i58 =
+            in58
+        i59 =
+            in59
+        i60 =
+            in60
+        i61 =
+            in61
+        i62 =
+            in62
+        i63 =
+            in63
+        i64 =
+            in64
+        i65 =
+            in65
+        i66 =
+            in66
+        i67 =
+            in67
+        i68 =
+            in68
+        i69 =
+            in69
+        i70 =
+            in70
+        i71 =
+            in71
+        i72 =
+            in72
+        i73 =
+            in73
+        i74 =
+            in74
+        i75 =
+            in75
+        i76 =
+            in76
+        i77 =
+            in77
+        i78 =
+            in78
+        i79 =
+            in79
+        i80 =
+            in80
+        i81 =
+            in81
+        i82 =
+            in82
+        i83 =
+            in83
+        i84 =
+            in84
+        i85 =
+            in85
+        i86 =
+            in86
+        i87 =
+            in87
+        i88 =
+            in88
+        i89 =
+            in89
+        i90 =
+            in90
+        i91 =
+            in91
+        i92 =
+            in92
+        i93 =
+            in93
+        i94 =
+            in94
+        i95 =
+            in95
+        i96 =
+            in96
+        i97 =
+            in97
+        i98 =
+            in98
+        i99 =
+            in99
+        i100 =
+            in100
+        i101 =
+            in101
+        i102 =
+            in102
+        i103 =
+            in103
+        i104 =
+            in104
+        i105 =
+            in105
+        i106 =
+            in106
+        i107 =
+            in107
+        i108 =
+            in108
+        i109 =
+            in109
+        i110 =
+            in110
+        i111 =
+            in111
+        i112 =
+            in112
+        i113 =
+            in113
+        i114 =
+            in114
+        i115 =
+            in115
+        i116 =
+            in116
+        i117 =
+            in117
+        i118 =
+            in118
+        i119 =
+            in119
+        i120 =
+            in120
+        i121 =
+            in121
+        i122 =
+            in122
+        i123 =
+            in123
+        i124 =
+            in124
+        i125 =
+            in125
+        i126 =
+            in126
+        i127 =
+            in127
+        i128 =
+            in128
+        i129 =
+            in129
+        i130 =
+            in130
+        i131 =
+            in131
+        i132 =
+            in132
+        i133 =
+            in133
+        i134 =
+            in134
+        i135 =
+            in135
+        i136 =
+            in136
+        i137 =
+            in137
+        i138 =
+            in138
+        i139 =
+            in139
+        i140 =
+            in140
+        i141 =
+            in141
+        i142 =
+            in142
+        i143 =
+            in143
+        i144 =
+            in144
+        i145 =
+            in145
+        i146 =
+            in146
+        i147 =
+            in147
+        i148 =
+            in148
+        i149 =
+            in149
+        i150 =
+            in150
+        i151 =
+            in151
+        i152 =
+            in152
+        i153 =
+            in153
+        i154 =
+            in154
+        i155 =
+            in155
+        i156 =
+            in156
+        i157 =
+            in157
+        i158 =
+            in158
+        i159 =
+            in159
+        i160 =
+            in160
+        i161 =
+            in161
+        i162 =
+            in162
+        i163 =
+            in163
+        i164 =
+            in164
+        i165 =
+            in165
+        i166 =
+            in166
+        i167 =
+            in167
+        i168 =
+            in168
+        i169 =
+            in169
+        i170 =
+            in170
+        i171 =
+            in171
+        i172 =
+            in172
+        i173 =
+            in173
+        i174 =
+            in174
+        i175 =
+            in175
+        i176 =
+            in176
+        i177 =
+            in177
+        i178 =
+            in178
+        i179 =
+            in179
+        i180 =
+            in180
+        i181 =
+            in181
+        i182 =
+            in182
+        i183 =
+            in183
+        i184 =
+            in184
+        i185 =
+            in185
+        i186 =
+            in186
+        i187 =
+            in187
+        i188 =
+            in188
+        i189 =
+            in189
+        i190 =
+            in190
+        i191 =
+            in191
+        i192 =
+            in192
+        i193 =
+            in193
+        i194 =
+            in194
+        i195 =
+            in195
+        i196 =
+            in196
+        i197 =
+            in197
+        i198 =
+            in198
+        i199 =
+            in199
+        i200 =
+            in200
+        i201 =
+            in201
+        i202 =
+            in202
+        i203 =
+            in203
+        i204 =
+            in204
+        i205 =
+            in205
+        i206 =
+            in206
+        i207 =
+            in207
+        i208 =
+            in208
+        i209 =
+            in209
+        i210 =
+            in210
+        i211 =
+            in211
+        i212 =
+            in212
+        i213 =
+            in213
+        i214 =
+            in214
+        i215 =
+            in215
+        i216 =
+            in216
+        i217 =
+            in217
+        i218 =
+            in218
+        i219 =
+            in219
+        i220 =
+            in220
+        i221 =
+            in221
+        i222 =
+            in222
+        i223 =
+            in223
+        i224 =
+            in224
+        i225 =
+            in225
+        i226 =
+            in226
+        i227 =
+            in227
+        i228 =
+            in228
+        i229 =
+            in229
+        i230 =
+            in230
+        i231 =
+            in231
+        i232 =
+            in232
+        i233 =
+            in233
+        i234 =
+            in234
+        i235 =
+            in235
+        i236 =
+            in236
+        i237 =
+            in237
+        i238 =
+            in238
+        i239 =
+            in239
+        i240 =
+            in240
+        i241 =
+            in241
+        i242 =
+            in242
+        i243 =
+            in243
+        i244 =
+            in244
+        i245 =
+            in245
+        i246 =
+            in246
+        i247 =
+            in247
+        i248 =
+            in248
+        i249 =
+            in249
+        i250 =
+            in250
+        i251 =
+            in251
+        i252 =
+            in252
+        i253 =
+            in253
+        i254 =
+            in254
+        i255 =
+            in255
+        i256 =
+            in256
+        i257 =
+            in257
+        i258 =
+            in258
+        i259 =
+            in259
+        i260 =
+            in260
+        i261 =
+            in261
+        i262 =
+            in262
+        i263 =
+            in263
+        i264 =
+            in264
+        i265 =
+            in265
+        i266 =
+            in266
+        i267 =
+            in267
+        i268 =
+            in268
+        i269 =
+            in269
+        i270 =
+            in270
+        i271 =
+            in271
+        i272 =
+            in272
+        i273 =
+            in273
+        i274 =
+            in274
+        i275 =
+            in275
+        i276 =
+            in276
+        i277 =
+            in277
+        i278 =
+            in278
+        i279 =
+            in279
+        i280 =
+            in280
+        i281 =
+            in281
+        i282 =
+            in282
+        i283 =
+            in283
+        i284 =
+            in284
+        i285 =
+            in285
+        i286 =
+            in286
+        i287 =
+            in287
+        i288 =
+            in288
+        i289 =
+            in289
+        i290 =
+            in290
+        i291 =
+            in291
+        i292 =
+            in292
+        i293 =
+            in293
+        i294 =
+            in294
+        i295 =
+            in295
+        i296 =
+            in296
+        i297 =
+            in297
+        i298 =
+            in298
+        i299 =
+            in299
+        i300 =
+            in300
+        i301 =
+            in301
+        i302 =
+            in302
+        i303 =
+            in303
+        i304 =
+            in304
+        i305 =
+            in305
+        i306 =
+            in306
+        i307 =
+            in307
+        i308 =
+            in308
+        i309 =
+            in309
+        i310 =
+            in310
+        i311 =
+            in311
+        i312 =
+            in312
+        i313 =
+            in313
+        i314 =
+            in314
+        i315 =
+            in315
+        i316 =
+            in316
+        i317 =
+            in317
+        i318 =
+            in318
+        i319 =
+            in319
+        i320 =
+            in320
+        i321 =
+            in321
+        i322 =
+            in322
+        i323 =
+            in323
+        i324 =
+            in324
+        i325 =
+            in325
+        i326 =
+            in326
+        i327 =
+            in327
+        i328 =
+            in328
+        i329 =
+            in329
+        i330 =
+            in330
+        i331 =
+            in331
+        i332 =
+            in332
+        i333 =
+            in333
+        i334 =
+            in334
+        i335 =
+            in335
+        i336 =
+            in336
+        i337 =
+            in337
+        i338 =
+            in338
+        i339 =
+            in339
+        i340 =
+            in340
+        i341 =
+            in341
+        i342 =
+            in342
+        i343 =
+            in343
+        i344 =
+            in344
+        i345 =
+            in345
+        i346 =
+            in346
+        i347 =
+            in347
+        i348 =
+            in348
+        i349 =
+            in349
+        i350 =
+            in350
+        i351 =
+            in351
+        i352 =
+            in352
+        i353 =
+            in353
+        i354 =
+            in354
+        i355 =
+            in355
+        i356 =
+            in356
+        i357 =
+            in357
+        i358 =
+            in358
+        i359 =
+            in359
+        i360 =
+            in360
+        i361 =
+            in361
+        i362 =
+            in362
+        i363 =
+            in363
+        i364 =
+            in364
+        i365 =
+            in365
+        i366 =
+            in366
+        i367 =
+            in367
+        i368 =
+            in368
+        i369 =
+            in369
+        i370 =
+            in370
+        i371 =
+            in371
+        i372 =
+            in372
+        i373 =
+            in373
+        i374 =
+            in374
+        i375 =
+            in375
+        i376 =
+            in376
+        i377 =
+            in377
+        i378 =
+            in378
+        i379 =
+            in379
+        i380 =
+            in380
+        i381 =
+            in381
+        i382 =
+            in382
+        i383 =
+            in383
+        i384 =
+            in384
+        i385 =
+            in385
+        i386 =
+            in386
+        i387 =
+            in387
+        i388 =
+            in388
+        i389 =
+            in389
+        i390 =
+            in390
+        i391 =
+            in391
+        i392 =
+            in392
+        i393 =
+            in393
+        i394 =
+            in394
+        i395 =
+            in395
+        i396 =
+            in396
+        i397 =
+            in397
+        i398 =
+            in398
+        i399 =
+            in399
+        i400 =
+            in400
+        i401 =
+            in401
+        i402 =
+            in402
+        i403 =
+            in403
+        i404 =
+            in404
+        i405 =
+            in405
+        i406 =
+            in406
+        i407 =
+            in407
+        i408 =
+            in408
+        i409 =
+            in409
+        i410 =
+            in410
+        i411 =
+            in411
+        i412 =
+            in412
+        i413 =
+            in413
+        i414 =
+            in414
+        i415 =
+            in415
+        i416 =
+            in416
+        i417 =
+            in417
+        i418 =
+            in418
+        i419 =
+            in419
+        i420 =
+            in420
+        i421 =
+            in421
+        i422 =
+            in422
+        i423 =
+            in423
+        i424 =
+            in424
+        i425 =
+            in425
+        i426 =
+            in426
+        i427 =
+            in427
+        i428 =
+            in428
+        i429 =
+            in429
+        i430 =
+            in430
+        i431 =
+            in431
+        i432 =
+            in432
+        i433 =
+            in433
+        i434 =
+            in434
+        i435 =
+            in435
+        i436 =
+            in436
+        i437 =
+            in437
+        i438 =
+            in438
+        i439 =
+            in439
+        i440 =
+            in440
+        i441 =
+            in441
+        i442 =
+            in442
+        i443 =
+            in443
+        i444 =
+            in444
+        i445 =
+            in445
+        i446 =
+            in446
+        i447 =
+            in447
+        i448 =
+            in448
+        i449 =
+            in449
+        i450 =
+            in450
+        i451 =
+            in451
+        i452 =
+            in452
+        i453 =
+            in453
+        i454 =
+            in454
+        i455 =
+            in455
+        i456 =
+            in456
+        i457 =
+            in457
+        i458 =
+            in458
+        i459 =
+            in459
+        i460 =
+            in460
+        i461 =
+            in461
+        i462 =
+            in462
+        i463 =
+            in463
+        i464 =
+            in464
+        i465 =
+            in465
+        i466 =
+            in466
+        i467 =
+            in467
+        i468 =
+            in468
+        i469 =
+            in469
+        i470 =
+            in470
+        i471 =
+            in471
+        i472 =
+            in472
+        i473 =
+            in473
+        i474 =
+            in474
+        i475 =
+            in475
+        i476 =
+            in476
+        i477 =
+            in477
+        i478 =
+            in478
+        i479 =
+            in479
+        i480 =
+            in480
+        i481 =
+            in481
+        i482 =
+            in482
+        i483 =
+            in483
+        i484 =
+            in484
+        i485 =
+            in485
+        i486 =
+            in486
+        i487 =
+            in487
+        i488 =
+            in488
+        i489 =
+            in489
+        i490 =
+            in490
+        i491 =
+            in491
+        i492 =
+            in492
+        i493 =
+            in493
+        i494 =
+            in494
+        i495 =
+            in495
+        i496 =
+            in496
+        i497 =
+            in497
+        i498 =
+            in498
+        i499 =
+            in499
+        i500 =
+            in500
+        i501 =
+            in501
+        i502 =
+            in502
+        i503 =
+            in503
+        i504 =
+            in504
+        i505 =
+            in505
+        i506 =
+            in506
+        i507 =
+            in507
+        i508 =
+            in508
+        i509 =
+            in509
+        i510 =
+            in510
+        i511 =
+            in511
+        i512 =
+            in512
+        i513 =
+            in513
+        i514 =
+            in514
+        i515 =
+            in515
+        i516 =
+            in516
+        i517 =
+            in517
+        i518 =
+            in518
+        i519 =
+            in519
+        i520 =
+            in520
+        i521 =
+            in521
+        i522 =
+            in522
+        i523 =
+            in523
+        i524 =
+            in524
+        i525 =
+            in525
+        i526 =
+            in526
+        i527 =
+            in527
+        i528 =
+            in528
+        i529 =
+            in529
+        i530 =
+            in530
+        i531 =
+            in531
+        i532 =
+            in532
+        i533 =
+            in533
+        i534 =
+            in534
+        i535 =
+            in535
+        i536 =
+            in536
+        i537 =
+            in537
+        i538 =
+            in538
+        i539 =
+            in539
+        i540 =
+            in540
+        i541 =
+            in541
+        i542 =
+            in542
+        i543 =
+            in543
+        i544 =
+            in544
+        i545 =
+            in545
+        i546 =
+            in546
+        i547 =
+            in547
+        i548 =
+            in548
+        i549 =
+            in549
+        i550 =
+            in550
+        i551 =
+            in551
+        i552 =
+            in552
+        i553 =
+            in553
+        i554 =
+            in554
+        i555 =
+            in555
+        i556 =
+            in556
+        i557 =
+            in557
+        i558 =
+            in558
+        i559 =
+            in559
+        i560 =
+            in560
+        i561 =
+            in561
+        i562 =
+            in562
+        i563 =
+            in563
+        i564 =
+            in564
+        i565 =
+            in565
+        i566 =
+            in566
+        i567 =
+            in567
+        i568 =
+            in568
+        i569 =
+            in569
+        i570 =
+            in570
+        i571 =
+            in571
+        i572 =
+            in572
+        i573 =
+            in573
+        i574 =
+            in574
+        i575 =
+            in575
+        i576 =
+            in576
+        i577 =
+            in577
+        i578 =
+            in578
+        i579 =
+            in579
+        i580 =
+            in580
+        i581 =
+            in581
+        i582 =
+            in582
+        i583 =
+            in583
+        i584 =
+            in584
+        i585 =
+            in585
+        i586 =
+            in586
+        i587 =
+            in587
+        i588 =
+            in588
+        i589 =
+            in589
+        i590 =
+            in590
+        i591 =
+            in591
+        i592 =
+            in592
+        i593 =
+            in593
+        i594 =
+            in594
+        i595 =
+            in595
+        i596 =
+            in596
+        i597 =
+            in597
+        i598 =
+            in598
+        i599 =
+            in599
+        i600 =
+            in600
+        i601 =
+            in601
+        i602 =
+            in602
+        i603 =
+            in603
+        i604 =
+            in604
+        i605 =
+            in605
+        i606 =
+            in606
+        i607 =
+            in607
+        i608 =
+            in608
+        i609 =
+            in609
+        i610 =
+            in610
+        i611 =
+            in611
+        i612 =
+            in612
+        i613 =
+            in613
+        i614 =
+            in614
+        i615 =
+            in615
+        i616 =
+            in616
+        i617 =
+            in617
+        i618 =
+            in618
+        i619 =
+            in619
+        i620 =
+            in620
+        i621 =
+            in621
+        i622 =
+            in622
+        i623 =
+            in623
+        i624 =
+            in624
+        i625 =
+            in625
+        i626 =
+            in626
+        i627 =
+            in627
+        i628 =
+            in628
+        i629 =
+            in629
+        i630 =
+            in630
+        i631 =
+            in631
+        i632 =
+            in632
+        i633 =
+            in633
+        i634 =
+            in634
+        i635 =
+            in635
+        i636 =
+            in636
+        i637 =
+            in637
+        i638 =
+            in638
+        i639 =
+            in639
+        i640 =
+            in640
+        i641 =
+            in641
+        i642 =
+            in642
+        i643 =
+            in643
+        i644 =
+            in644
+        i645 =
+            in645
+        i646 =
+            in646
+        i647 =
+            in647
+        i648 =
+            in648
+        i649 =
+            in649
+        i650 =
+            in650
+        i651 =
+            in651
+        i652 =
+            in652
+        i653 =
+            in653
+        i654 =
+            in654
+        i655 =
+            in655
+        i656 =
+            in656
+        i657 =
+            in657
+        i658 =
+            in658
+        i659 =
+            in659
+        i660 =
+            in660
+        i661 =
+            in661
+        i662 =
+            in662
+        i663 =
+            in663
+        i664 =
+            in664
+        i665 =
+            in665
+        i666 =
+            in666
+        i667 =
+            in667
+        i668 =
+            in668
+        i669 =
+            in669
+        i670 =
+            in670
+        i671 =
+            in671
+        i672 =
+            in672
+        i673 =
+            in673
+        i674 =
+            in674
+        i675 =
+            in675
+        i676 =
+            in676
+        i677 =
+            in677
+        i678 =
+            in678
+        i679 =
+            in679
+        i680 =
+            in680
+        i681 =
+            in681
+        i682 =
+            in682
+        i683 =
+            in683
+        i684 =
+            in684
+        i685 =
+            in685
+        i686 =
+            in686
+        i687 =
+            in687
+        i688 =
+            in688
+        i689 =
+            in689
+        i690 =
+            in690
+        i691 =
+            in691
+        i692 =
+            in692
+        i693 =
+            in693
+        i694 =
+            in694
+        i695 =
+            in695
+        i696 =
+            in696
+        i697 =
+            in697
+        i698 =
+            in698
+        i699 =
+            in699
+        i700 =
+            in700
+        i701 =
+            in701
+        i702 =
+            in702
+        i703 =
+            in703
+        i704 =
+            in704
+        i705 =
+            in705
+        i706 =
+            in706
+        i707 =
+            in707
+        i708 =
+            in708
+        i709 =
+            in709
+        i710 =
+            in710
+        i711 =
+            in711
+        i712 =
+            in712
+        i713 =
+            in713
+        i714 =
+            in714
+        i715 =
+            in715
+        i716 =
+            in716
+        i717 =
+            in717
+        i718 =
+            in718
+        i719 =
+            in719
+        i720 =
+            in720
+        i721 =
+            in721
+        i722 =
+            in722
+        i723 =
+            in723
+        i724 =
+            in724
+        i725 =
+            in725
+        i726 =
+            in726
+        i727 =
+            in727
+        i728 =
+            in728
+        i729 =
+            in729
+        i730 =
+            in730
+        i731 =
+            in731
+        i732 =
+            in732
+        i733 =
+            in733
+        i734 =
+            in734
+        i735 =
+            in735
+        i736 =
+            in736
+        i737 =
+            in737
+        i738 =
+            in738
+        i739 =
+            in739
+        i740 =
+            in740
+        i741 =
+            in741
+        i742 =
+            in742
+        i743 =
+            in743
+        i744 =
+            in744
+        i745 =
+            in745
+        i746 =
+            in746
+        i747 =
+            in747
+        i748 =
+            in748
+        i749 =
+            in749
+        i750 =
+            in750
+        i751 =
+            in751
+        i752 =
+            in752
+        i753 =
+            in753
+        i754 =
+            in754
+        i755 =
+            in755
+        i756 =
+            in756
+        i757 =
+            in757
+        i758 =
+            in758
+        i759 =
+            in759
+        i760 =
+            in760
+        i761 =
+            in761
+        i762 =
+            in762
+        i763 =
+            in763
+        i764 =
+            in764
+        i765 =
+            in765
+        i766 =
+            in766
+        i767 =
+            in767
+        i768 =
+            in768
+        i769 =
+            in769
+        i770 =
+            in770
+        i771 =
+            in771
+        i772 =
+            in772
+        i773 =
+            in773
+        i774 =
+            in774
+        i775 =
+            in775
+        i776 =
+            in776
+        i777 =
+            in777
+        i778 =
+            in778
+        i779 =
+            in779
+        i780 =
+            in780
+        i781 =
+            in781
+        i782 =
+            in782
+        i783 =
+            in783
+        i784 =
+            in784
+        i785 =
+            in785
+        i786 =
+            in786
+        i787 =
+            in787
+        i788 =
+            in788
+        i789 =
+            in789
+        i790 =
+            in790
+        i791 =
+            in791
+        i792 =
+            in792
+        i793 =
+            in793
+        i794 =
+            in794
+        i795 =
+            in795
+        i796 =
+            in796
+        i797 =
+            in797
+        i798 =
+            in798
+        i799 =
+            in799
+        i800 =
+            in800
+        i801 =
+            in801
+        i802 =
+            in802
+        i803 =
+            in803
+        i804 =
+            in804
+        i805 =
+            in805
+        i806 =
+            in806
+        i807 =
+            in807
+        i808 =
+            in808
+        i809 =
+            in809
+        i810 =
+            in810
+        i811 =
+            in811
+        i812 =
+            in812
+        i813 =
+            in813
+        i814 =
+            in814
+        i815 =
+            in815
+        i816 =
+            in816
+        i817 =
+            in817
+        i818 =
+            in818
+        i819 =
+            in819
+        i820 =
+            in820
+        i821 =
+            in821
+        i822 =
+            in822
+        i823 =
+            in823
+        i824 =
+            in824
+        i825 =
+            in825
+        i826 =
+            in826
+        i827 =
+            in827
+        i828 =
+            in828
+        i829 =
+            in829
+        i830 =
+            in830
+        i831 =
+            in831
+        i832 =
+            in832
+        i833 =
+            in833
+        i834 =
+            in834
+        i835 =
+            in835
+        i836 =
+            in836
+        i837 =
+            in837
+        i838 =
+            in838
+        i839 =
+            in839
+        i840 =
+            in840
+        i841 =
+            in841
+        i842 =
+            in842
+        i843 =
+            in843
+        i844 =
+            in844
+        i845 =
+            in845
+        i846 =
+            in846
+        i847 =
+            in847
+        i848 =
+            in848
+        i849 =
+            in849
+        i850 =
+            in850
+        i851 =
+            in851
+        i852 =
+            in852
+        i853 =
+            in853
+        i854 =
+            in854
+        i855 =
+            in855
+        i856 =
+            in856
+        i857 =
+            in857
+        i858 =
+            in858
+        i859 =
+            in859
+        i860 =
+            in860
+        i861 =
+            in861
+        i862 =
+            in862
+        i863 =
+            in863
+        i864 =
+            in864
+        i865 =
+            in865
+        i866 =
+            in866
+        i867 =
+            in867
+        i868 =
+            in868
+        i869 =
+            in869
+        i870 =
+            in870
+        i871 =
+            in871
+        i872 =
+            in872
+        i873 =
+            in873
+        i874 =
+            in874
+        i875 =
+            in875
+        i876 =
+            in876
+        i877 =
+            in877
+        i878 =
+            in878
+        i879 =
+            in879
+        i880 =
+            in880
+        i881 =
+            in881
+        i882 =
+            in882
+        i883 =
+            in883
+        i884 =
+            in884
+        i885 =
+            in885
+        i886 =
+            in886
+        i887 =
+            in887
+        i888 =
+            in888
+        i889 =
+            in889
+        i890 =
+            in890
+        i891 =
+            in891
+        i892 =
+            in892
+        i893 =
+            in893
+        i894 =
+            in894
+        i895 =
+            in895
+        i896 =
+            in896
+        i897 =
+            in897
+        i898 =
+            in898
+        i899 =
+            in899
+        i900 =
+            in900
+        i901 =
+            in901
+        i902 =
+            in902
+        i903 =
+            in903
+        i904 =
+            in904
+        i905 =
+            in905
+        i906 =
+            in906
+        i907 =
+            in907
+        i908 =
+            in908
+        i909 =
+            in909
+        i910 =
+            in910
+        i911 =
+            in911
+        i912 =
+            in912
+        i913 =
+            in913
+        i914 =
+            in914
+        i915 =
+            in915
+        i916 =
+            in916
+        i917 =
+            in917
+        i918 =
+            in918
+        i919 =
+            in919
+        i920 =
+            in920
+        i921 =
+            in921
+        i922 =
+            in922
+        i923 =
+            in923
+        i924 =
+            in924
+        i925 =
+            in925
+        i926 =
+            in926
+        i927 =
+            in927
+        i928 =
+            in928
+        i929 =
+            in929
+        i930 =
+            in930
+        i931 =
+            in931
+        i932 =
+            in932
+        i933 =
+            in933
+        i934 =
+            in934
+        i935 =
+            in935
+        i936 =
+            in936
+        i937 =
+            in937
+        i938 =
+            in938
+        i939 =
+            in939
+        i940 =
+            in940
+        i941 =
+            in941
+        i942 =
+            in942
+        i943 =
+            in943
+        i944 =
+            in944
+        i945 =
+            in945
+        i946 =
+            in946
+        i947 =
+            in947
+        i948 =
+            in948
+        i949 =
+            in949
+        i950 =
+            in950
+        i951 =
+            in951
+        i952 =
+            in952
+        i953 =
+            in953
+        i954 =
+            in954
+        i955 =
+            in955
+        i956 =
+            in956
+        i957 =
+            in957
+        i958 =
+            in958
+        i959 =
+            in959
+        i960 =
+            in960
+        i961 =
+            in961
+        i962 =
+            in962
+        i963 =
+            in963
+        i964 =
+            in964
+        i965 =
+            in965
+        i966 =
+            in966
+        i967 =
+            in967
+        i968 =
+            in968
+        i969 =
+            in969
+        i970 =
+            in970
+        i971 =
+            in971
+        i972 =
+            in972
+        i973 =
+            in973
+        i974 =
+            in974
+        i975 =
+            in975
+        i976 =
+            in976
+        i977 =
+            in977
+        i978 =
+            in978
+        i979 =
+            in979
+        i980 =
+            in980
+        i981 =
+            in981
+        i982 =
+            in982
+        i983 =
+            in983
+        i984 =
+            in984
+        i985 =
+            in985
+        i986 =
+            in986
+        i987 =
+            in987
+        i988 =
+            in988
+        i989 =
+            in989
+        i990 =
+            in990
+        i991 =
+            in991
+        i992 =
+            in992
+        i993 =
+            in993
+        i994 =
+            in994
+        i995 =
+            in995
+        i996 =
+            in996
+        i997 =
+            in997
+        i998 =
+            in998
+        i999 =
+            in999
+    in
+    i0
@@ -0,0 +1,208 @@
+-- Hand-written stress input: nested case branches that dedent together,
+-- which queues many end-of-section tokens in the scanner's runback.
+module Main exposing (..)
+
+f x =
+    case x of
+      _ ->
+      case x of
+        _ ->
+        case x of
+          _ ->
+          case x of
+            _ ->
+            case x of
+              _ ->
+              case x of
+                _ ->
+                case x of
+                  _ ->
+                  case x of
+                    _ ->
+                    case x of
+                      _ ->
+                      case x of
+                        _ ->
+                        case x of
+                          _ ->
+                          case x of
+                            _ ->
+                            case x of
+                              _ ->
+                              case x of
+                                _ ->
+                                case x of
+                                  _ ->
+                                  case x of
+                                    _ ->
+                                    case x of
+                                      _ ->
+                                      case x of
+                                        _ ->
+                                        case x of
+                                          _ ->
+                                          case x of
+                                            _ ->
+                                            case x of
+                                              _ ->
+                                              case x of
+                                                _ ->
+                                                case x of
+                                                  _ ->
+                                                  case x of
+                                                    _ ->
+                                                    case x of
+                                                      _ ->
+                                                      case x of
+                                                        _ ->
+                                                        case x of
+                                                          _ ->
+                                                          case x of
+                                                            _ ->
+                                                            case x of
+                                                              _ ->
+                                                              case x of
+                                                                _ ->
+                                                                case x of
+                                                                  _ ->
+                                                                  case x of
+                                                                    _ ->
+                                                                    case x of
+                                                                      _ ->
+                                                                      case x of
+                                                                        _ ->
+                                                                        case x of
+                                                                          _ ->
+                                                                          case x of
+                                                                            _ ->
+                                                                            case x of
+                                                                              _ ->
+                                                                              case x of
+                                                                                _ ->
+                                                                                case x of
+                                                                                  _ ->
+                                                                                  case x of
+                                                                                    _ ->
+                                                                                    case x of
+                                                                                      _ ->
+                                                                                      case x of
+                                                                                        _ ->
+                                                                                        case x of
+                                                                                          _ ->
+                                                                                          case x of
+                                                                                            _ ->
+                                                                                            case x of
+                                                                                              _ ->
+                                                                                              case x of
+                                                                                                _ ->
+                                                                                                case x of
+                                                                                                  _ ->
+                                                                                                  case x of
+                                                                                                    _ ->
+                                                                                                    case x of
+                                                                                                      _ ->
+                                                                                                      case x of
+                                                                                                        _ ->
+                                                                                                        case x of
+                                                                                                          _ ->
+                                                                                                          case x of
+                                                                                                            _ ->
+                                                                                                            case x of
+                                                                                                              _ ->
+                                                                                                              case x of
+                                                                                                                _ ->
+                                                                                                                case x of
+                                                                                                                  _ ->
+                                                                                                                  case x of
+                                                                                                                    _ ->
+                                                                                                                    case x of
+                                                                                                                      _ ->
+                                                                                                                      case x of
+                                                                                                                        _ ->
+                                                                                                                        case x of
+                                                                                                                          _ ->
+                                                                                                                          case x of
+                                                                                                                            _ ->
+                                                                                                                            case x of
+                                                                                                                              _ ->
+                                                                                                                              case x of
+                                                                                                                                _ ->
+                                                                                                                                case x of
+                                                                                                                                  _ ->
+                                                                                                                                  case x of
+                                                                                                                                    _ ->
+                                                                                                                                    case x of
+                                                                                                                                      _ ->
+                                                                                                                                      case x of
+                                                                                                                                        _ ->
+                                                                                                                                        case x of
+                                                                                                                                          _ ->
+                                                                                                                                          case x of
+                                                                                                                                            _ ->
+                                                                                                                                            case x of
+                                                                                                                                              _ ->
+                                                                                                                                              case x of
+                                                                                                                                                _ ->
+                                                                                                                                                case x of
+                                                                                                                                                  _ ->
+                                                                                                                                                  case x of
+                                                                                                                                                    _ ->
+                                                                                                                                                    case x of
+                                                                                                                                                      _ ->
+                                                                                                                                                      case x of
+                                                                                                                                                        _ ->
+                                                                                                                                                        case x of
+                                                                                                                                                          _ ->
+                                                                                                                                                          case x of
+                                                                                                                                                            _ ->
+                                                                                                                                                            case x of
+                                                                                                                                                              _ ->
+                                                                                                                                                              case x of
+                                                                                                                                                                _ ->
+                                                                                                                                                                case x of
+                                                                                                                                                                  _ ->
+                                                                                                                                                                  case x of
+                                                                                                                                                                    _ ->
+                                                                                                                                                                    case x of
+                                                                                                                                                                      _ ->
+                                                                                                                                                                      case x of
+                                                                                                                                                                        _ ->
+                                                                                                                                                                        case x of
+                                                                                                                                                                          _ ->
+                                                                                                                                                                          case x of
+                                                                                                                                                                            _ ->
+                                                                                                                                                                            case x of
+                                                                                                                                                                              _ ->
+                                                                                                                                                                              case x of
+                                                                                                                                                                                _ ->
+                                                                                                                                                                                case x of
+                                                                                                                                                                                  _ ->
+                                                                                                                                                                                  case x of
+                                                                                                                                                                                    _ ->
+                                                                                                                                                                                    case x of
+                                                                                                                                                                                      _ ->
+                                                                                                                                                                                      case x of
+                                                                                                                                                                                        _ ->
+                                                                                                                                                                                        case x of
+                                                                                                                                                                                          _ ->
+                                                                                                                                                                                          case x of
+                                                                                                                                                                                            _ ->
+                                                                                                                                                                                            case x of
+                                                                                                                                                                                              _ ->
+                                                                                                                                                                                              case x of
+                                                                                                                                                                                                _ ->
+                                                                                                                                                                                                case x of
+                                                                                                                                                                                                  _ ->
+                                                                                                                                                                                                  case x of
+                                                                                                                                                                                                    _ ->
+                                                                                                                                                                                                    case x of
+                                                                                                                                                                                                      _ ->
+                                                                                                                                                                                                      case x of
+                                                                                                                                                                                                        _ ->
+                                                                                                                                                                                                        case x of
+                                                                                                                                                                                                          _ ->
+                                                                                                                                                                                                          case x of
+                                                                                                                                                                                                            _ ->
+                                                                                                                                                                                                              x
+
+g = 1
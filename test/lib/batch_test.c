@@ -0,0 +1,91 @@
+#include "test.h"
+#include "tree_sitter/elm/batch.h"
+
+static const char *SOURCE = "module Main exposing (..)\n"
+                            "\n"
+                            "import Html\n"
+                            "\n"
+                            "a = 1\n"
+                            "\n"
+                            "{- x\n"
+                            "b = 2\n"
+                            "-}\n"
+                            "c = \"\"\"\n"
+                            "d = 3\n"
+                            "\"\"\"\n"
+                            "\n"
+                            "e = '\"'\n"
+                            "\n"
+                            "f = [glsl|\n"
+                            "g = 4\n"
+                            "|]\n"
+                            "\n"
+                            "h : Int\n"
+                            "h = 5\n"
+                            "-- i = 6\n"
+                            "j = \"\n"
+                            "k = 7\n";
+
+static void test_chunk_source(void) {
+    uint32_t starts[16];
+    uint32_t count = ts_elm_chunk_source(SOURCE, (uint32_t)strlen(SOURCE), 16, starts);
+    const char *expected[] = {"module", "a =", "c =", "e =", "f =", "h :", "h =", "j =", "k ="};
+    EXPECT(count == sizeof(expected) / sizeof(expected[0]));
+    for (uint32_t i = 0; i < count && i < sizeof(expected) / sizeof(expected[0]); i++) {
+        EXPECT_SLICE(SOURCE, starts[i], starts[i] + strlen(expected[i]), expected[i]);
+    }
+
+    // Boundaries are spread out when fewer chunks are asked for
+    count = ts_elm_chunk_source(SOURCE, (uint32_t)strlen(SOURCE), 2, starts);
+    EXPECT(count == 2);
+    EXPECT(starts[0] == 0 && starts[1] >= strlen(SOURCE) / 2);
+    EXPECT(ts_elm_chunk_source(SOURCE, (uint32_t)strlen(SOURCE), 0, starts) == 0);
+}
+
+static void expect_same_summary(const char *source) {
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, source);
+    TSElmSummary sequential, chunked;
+    EXPECT(ts_elm_summary_build(&sequential, ts_tree_root_node(tree)));
+    EXPECT(ts_elm_summarize_source(source, (uint32_t)strlen(source), 4, 64, &chunked));
+
+    EXPECT(sequential.has_error == chunked.has_error);
+    EXPECT(sequential.import_count == chunked.import_count);
+    EXPECT(sequential.declaration_count == chunked.declaration_count);
+    for (uint32_t i = 0; i < sequential.declaration_count && i < chunked.declaration_count; i++) {
+        const TSElmDeclaration *x = &sequential.declarations[i];
+        const TSElmDeclaration *y = &chunked.declarations[i];
+        EXPECT(x->symbol == y->symbol);
+        EXPECT(x->start_byte == y->start_byte && x->end_byte == y->end_byte);
+        EXPECT(x->name_start_byte == y->name_start_byte);
+        EXPECT(x->start_point.row == y->start_point.row);
+        EXPECT(x->start_point.column == y->start_point.column);
+    }
+
+    ts_elm_summary_delete(&sequential);
+    ts_elm_summary_delete(&chunked);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+}
+
+static void test_summarize_source(void) {
+    char source[16384];
+    size_t length = (size_t)sprintf(source, "module Main exposing (..)\n\nimport Html\n");
+    for (int i = 0; i < 100; i++) {
+        length += (size_t)sprintf(source + length,
+                                  "\n{-| f%d\n\nf = 0\n-}\nf%d : Int -> String\nf%d n =\n"
+                                  "    \"\"\"\nx = %d\n\"\"\" ++ String.fromInt n\n",
+                                  i, i, i, i);
+    }
+    expect_same_summary(source);
+
+    // An error in a chunk falls back to a whole-file parse
+    strcat(source, "\nimport Dict\n");
+    expect_same_summary(source);
+}
+
+int main(void) {
+    test_chunk_source();
+    test_summarize_source();
+    return test_result("batch_test");
+}
@@ -0,0 +1,145 @@
+#include "test.h"
+#include "tree_sitter/elm/bin_op.h"
+
+static TSNode find_bin_op(TSNode node) {
+    const char *name = "bin_op_expr";
+    TSSymbol symbol = ts_language_symbol_for_name(
+        tree_sitter_elm(), name, (uint32_t)strlen(name), true);
+    TSTreeCursor cursor = ts_tree_cursor_new(node);
+    for (;;) {
+        TSNode current = ts_tree_cursor_current_node(&cursor);
+        if (ts_node_symbol(current) == symbol) {
+            ts_tree_cursor_delete(&cursor);
+            return current;
+        }
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                ts_tree_cursor_delete(&cursor);
+                return (TSNode){0};
+            }
+        }
+    }
+}
+
+// Print the tree with every operator application in parentheses.
+static void render(const TSElmBinOpNode *nodes, uint32_t index, TSNode expr,
+                   const char *source, char *out, size_t *length) {
+    const TSElmBinOpNode *node = &nodes[index];
+    if (node->left == TS_ELM_BIN_OP_NONE) {
+        uint32_t size = node->end_byte - node->start_byte;
+        memcpy(out + *length, source + node->start_byte, size);
+        *length += size;
+        return;
+    }
+    TSNode operator_node = ts_node_child(expr, node->child);
+    out[(*length)++] = '(';
+    render(nodes, node->left, expr, source, out, length);
+    *length += (size_t)sprintf(out + *length, " %.*s ",
+                               (int)(ts_node_end_byte(operator_node) -
+                                     ts_node_start_byte(operator_node)),
+                               source + ts_node_start_byte(operator_node));
+    render(nodes, node->right, expr, source, out, length);
+    out[(*length)++] = ')';
+}
+
+// Build the tree of the first `bin_op_expr` in `source` and compare it with
+// `expected`, or expect it to be rejected if `expected` is NULL.
+static void expect_tree(TSElmOperators *operators, const char *source,
+                        const char *expected) {
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, source);
+    TSNode expr = find_bin_op(ts_tree_root_node(tree));
+    EXPECT(!ts_node_is_null(expr));
+
+    TSElmBinOpNode nodes[32];
+    uint32_t count = ts_elm_bin_op_tree(operators, expr, source, nodes, 32);
+    if (expected == NULL) {
+        EXPECT(count == 0);
+    } else {
+        EXPECT(count > 0);
+        char out[256];
+        size_t length = 0;
+        if (count > 0) {
+            render(nodes, count - 1, expr, source, out, &length);
+        }
+        out[length] = '\0';
+        if (strcmp(out, expected) != 0) {
+            fprintf(stderr, "expected %s, got %s\n", expected, out);
+            test_failures++;
+        }
+    }
+
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+}
+
+static void test_core_operators(void) {
+    TSElmOperators *operators = ts_elm_operators_new();
+    expect_tree(operators, "x = a + b * c - d\n", "((a + (b * c)) - d)");
+    expect_tree(operators, "x = f <| g <| y\n", "(f <| (g <| y))");
+    expect_tree(operators, "x = y |> f |> g\n", "((y |> f) |> g)");
+    expect_tree(operators, "x = a :: b ++ c\n", "(a :: (b ++ c))");
+    expect_tree(operators, "x = a || b && c == d + e * f ^ g ^ h\n",
+                "(a || (b && (c == (d + (e * (f ^ (g ^ h)))))))");
+    expect_tree(operators, "x = f a + g b {- note -} * 2\n", "(f a + (g b * 2))");
+    expect_tree(operators, "x = a == b == c\n", NULL);
+    expect_tree(operators, "x = f << g >> h\n", NULL);
+
+    TSElmAssociativity associativity;
+    uint32_t precedence;
+    EXPECT(ts_elm_operators_get(operators, "^", 1, &associativity, &precedence));
+    EXPECT(associativity == TSElmAssociativityRight && precedence == 8);
+    EXPECT(!ts_elm_operators_get(operators, "<*>", 3, &associativity, &precedence));
+    EXPECT(associativity == TSElmAssociativityLeft && precedence == 9);
+    ts_elm_operators_delete(operators);
+}
+
+static void test_declarations(void) {
+    const char *source = "module Basics exposing (..)\n"
+                         "\n"
+                         "infix right 6 (+) = add\n"
+                         "infix non 4 (|>) = apR\n"
+                         "\n"
+                         "x = a + b + c\n";
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, source);
+    TSElmOperators *operators = ts_elm_operators_new();
+    EXPECT(ts_elm_operators_read_declarations(operators, ts_tree_root_node(tree),
+                                              source) == 2);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+
+    expect_tree(operators, source, "(a + (b + c))");
+    expect_tree(operators, "x = a |> b |> c\n", NULL);
+    ts_elm_operators_delete(operators);
+}
+
+static void test_capacity(void) {
+    const char *source = "x = a + b * c\n";
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, source);
+    TSNode expr = find_bin_op(ts_tree_root_node(tree));
+    TSElmOperators *operators = ts_elm_operators_new();
+
+    TSElmBinOpNode nodes[5];
+    EXPECT(ts_elm_bin_op_tree(operators, expr, source, nodes, 4) == 0);
+    EXPECT(ts_elm_bin_op_tree(operators, expr, source, nodes, 5) == 5);
+    EXPECT(nodes[4].start_byte == 4 && nodes[4].end_byte == 13);
+    EXPECT(nodes[4].child == 1);
+    EXPECT(ts_elm_bin_op_tree(operators, ts_tree_root_node(tree), source,
+                              nodes, 5) == 0);
+
+    ts_elm_operators_delete(operators);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+}
+
+int main(void) {
+    test_core_operators();
+    test_declarations();
+    test_capacity();
+    return test_result("bin_op_test");
+}
@@ -0,0 +1,114 @@
+#include "test.h"
+#include "tree_sitter/elm/budget.h"
+
+// A stress input: unclosed brackets that keep error recovery busy, far
+// more than any deadline below allows.
+static char *stress_source(uint32_t *length) {
+    const char *header = "module Main exposing (..)\n\nmain =\n";
+    const char *line = "    ( [ { x | y = f (g [ 1, \"a\", 'b' ] \n";
+    uint32_t lines = 40000;
+    size_t size = strlen(header) + strlen(line) * lines;
+    char *source = malloc(size + 1);
+    strcpy(source, header);
+    char *end = source + strlen(header);
+    for (uint32_t i = 0; i < lines; i++) {
+        memcpy(end, line, strlen(line));
+        end += strlen(line);
+    }
+    *end = '\0';
+    *length = (uint32_t)size;
+    return source;
+}
+
+static void test_completed(void) {
+    const char *source = "module Main exposing (..)\n\n"
+                         "{-| Docs -}\n"
+                         "main =\n"
+                         "    \"\"\"multi\n    line\"\"\" ++ f 1\n";
+    TSParser *parser = NULL;
+    TSTree *expected = parse(&parser, source);
+    char *expected_string = ts_node_string(ts_tree_root_node(expected));
+
+    TSElmParseBudget budget = {.timeout_micros = 10 * 1000 * 1000, .time_scanner = true};
+    TSElmParseMetrics metrics;
+    TSTree *tree = ts_elm_parse_string_with_budget(parser, NULL, source, (uint32_t)strlen(source),
+                                                   &budget, &metrics);
+    EXPECT(tree != NULL);
+    EXPECT(metrics.status == TSElmParseCompleted);
+    EXPECT(metrics.bytes_consumed == strlen(source));
+    EXPECT(metrics.scanner_calls > 0);
+    EXPECT(metrics.scanner_nanos <= metrics.total_nanos);
+    // Timing the scanner leaves the parser and the tree with their language
+    EXPECT(ts_parser_language(parser) == tree_sitter_elm());
+    if (tree != NULL) {
+        EXPECT(ts_tree_language(tree) == tree_sitter_elm());
+        char *actual = ts_node_string(ts_tree_root_node(tree));
+        EXPECT(strcmp(actual, expected_string) == 0);
+        free(actual);
+        ts_tree_delete(tree);
+    }
+
+    free(expected_string);
+    ts_tree_delete(expected);
+    ts_parser_delete(parser);
+}
+
+static void test_timeout(void) {
+    uint32_t length;
+    char *source = stress_source(&length);
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_elm());
+
+    TSElmParseBudget budget = {.timeout_micros = 2000, .time_scanner = true};
+    TSElmParseMetrics metrics;
+    TSTree *tree = ts_elm_parse_string_with_budget(parser, NULL, source, length, &budget, &metrics);
+    EXPECT(tree == NULL);
+    EXPECT(metrics.status == TSElmParseTimedOut);
+    EXPECT(metrics.bytes_consumed < length);
+    // The runtime checks progress every few operations, so the parse stops
+    // shortly after the deadline
+    EXPECT(metrics.total_nanos < 200 * 1000 * 1000);
+    ts_tree_delete(tree);
+
+    // The parser starts over afterwards
+    const char *small = "main = 1\n";
+    TSTree *after = ts_parser_parse_string(parser, NULL, small, (uint32_t)strlen(small));
+    EXPECT(!ts_node_has_error(ts_tree_root_node(after)));
+    ts_tree_delete(after);
+
+    ts_parser_delete(parser);
+    free(source);
+}
+
+static void test_cancelled(void) {
+    uint32_t length;
+    char *source = stress_source(&length);
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_elm());
+
+    size_t cancelled = 1;
+    TSElmParseBudget budget = {.cancellation_flag = &cancelled};
+    TSElmParseMetrics metrics;
+    EXPECT(ts_elm_parse_string_with_budget(parser, NULL, source, length, &budget, &metrics) == NULL);
+    EXPECT(metrics.status == TSElmParseCancelled);
+    EXPECT(metrics.bytes_consumed == 0);
+
+    cancelled = 0;
+    const char *small = "main = 1\n";
+    TSTree *tree = ts_elm_parse_string_with_budget(parser, NULL, small, (uint32_t)strlen(small),
+                                                   &budget, &metrics);
+    EXPECT(tree != NULL && metrics.status == TSElmParseCompleted);
+    EXPECT(metrics.bytes_consumed == strlen(small));
+    EXPECT(metrics.scanner_calls == 0);
+    ts_tree_delete(tree);
+
+    ts_parser_delete(parser);
+    free(source);
+}
+
+int main(void) {
+    test_completed();
+    test_timeout();
+    test_cancelled();
+    return test_result("budget_test");
+}
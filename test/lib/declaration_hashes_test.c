@@ -0,0 +1,182 @@
+#include "test.h"
+#include "tree_sitter/elm/declaration_hashes.h"
+
+static const char *INITIAL = "module Main exposing (..)\n"
+                             "\n"
+                             "type alias Model =\n"
+                             "    { count : Int }\n"
+                             "\n"
+                             "init : Model\n"
+                             "init =\n"
+                             "    { count = 0 }\n"
+                             "\n"
+                             "update : Model -> Model\n"
+                             "update model =\n"
+                             "    { model | count = model.count + 1 }\n"
+                             "\n"
+                             "view model =\n"
+                             "    model.count\n";
+
+static TSPoint point_at(const char *source, uint32_t byte) {
+    TSPoint point = {0, 0};
+    for (uint32_t i = 0; i < byte; i++) {
+        if (source[i] == '\n') {
+            point.row++;
+            point.column = 0;
+        } else {
+            point.column++;
+        }
+    }
+    return point;
+}
+
+// Replace the first `pattern` in `*source` with `text`, reparse and update.
+static void replace(TSElmDeclarationHashes *hashes, TSParser *parser,
+                    TSTree **tree, char **source, const char *pattern,
+                    const char *text) {
+    char *old = *source;
+    uint32_t old_length = (uint32_t)strlen(old);
+    uint32_t start = (uint32_t)(strstr(old, pattern) - old);
+    uint32_t end = start + (uint32_t)strlen(pattern);
+    uint32_t length = old_length - (end - start) + (uint32_t)strlen(text);
+    char *new_source = malloc(length + 1);
+    memcpy(new_source, old, start);
+    strcpy(new_source + start, text);
+    strcat(new_source, old + end);
+
+    TSInputEdit edit = {
+        .start_byte = start,
+        .old_end_byte = end,
+        .new_end_byte = start + (uint32_t)strlen(text),
+        .start_point = point_at(old, start),
+        .old_end_point = point_at(old, end),
+        .new_end_point = point_at(new_source, start + (uint32_t)strlen(text)),
+    };
+    ts_tree_edit(*tree, &edit);
+    TSTree *new_tree = ts_parser_parse_string(parser, *tree, new_source, length);
+    EXPECT(ts_elm_declaration_hashes_update(hashes, *tree, new_tree, new_source,
+                                            &edit, 1));
+    ts_tree_delete(*tree);
+    *tree = new_tree;
+    free(old);
+    *source = new_source;
+}
+
+// Expect the changes of the last update to be exactly `expected`, each
+// written as a kind letter and the declaration's name, like "~update".
+static void expect_changes(const TSElmDeclarationHashes *hashes,
+                           const char *source, const char *previous_source,
+                           const char **expected, uint32_t expected_count) {
+    uint32_t count, item_count, previous_count;
+    const TSElmDeclarationChange *changes = ts_elm_declaration_hashes_changes(hashes, &count);
+    const TSElmDeclarationHash *items = ts_elm_declaration_hashes_items(hashes, &item_count);
+    const TSElmDeclarationHash *previous =
+        ts_elm_declaration_hashes_previous(hashes, &previous_count);
+    EXPECT(count == expected_count);
+    for (uint32_t i = 0; i < count && i < expected_count; i++) {
+        const TSElmDeclarationChange *change = &changes[i];
+        const char *kind = change->kind == TSElmDeclarationAdded     ? "+"
+                           : change->kind == TSElmDeclarationRemoved ? "-"
+                                                                     : "~";
+        EXPECT(strncmp(expected[i], kind, 1) == 0);
+        if (change->kind == TSElmDeclarationRemoved) {
+            EXPECT(change->current == TS_ELM_DECLARATION_NONE);
+            EXPECT(change->previous < previous_count);
+            const TSElmDeclarationHash *item = &previous[change->previous];
+            EXPECT_SLICE(previous_source, item->name_start_byte,
+                         item->name_end_byte, expected[i] + 1);
+        } else {
+            EXPECT(change->current < item_count);
+            EXPECT((change->previous == TS_ELM_DECLARATION_NONE) ==
+                   (change->kind == TSElmDeclarationAdded));
+            const TSElmDeclarationHash *item = &items[change->current];
+            EXPECT_SLICE(source, item->name_start_byte, item->name_end_byte,
+                         expected[i] + 1);
+        }
+    }
+}
+
+static void test_reset(void) {
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, INITIAL);
+    TSElmDeclarationHashes *hashes = ts_elm_declaration_hashes_new();
+    EXPECT(ts_elm_declaration_hashes_reset(hashes, ts_tree_root_node(tree), INITIAL));
+
+    uint32_t count;
+    const TSElmDeclarationHash *items = ts_elm_declaration_hashes_items(hashes, &count);
+    EXPECT(count == 4);
+    EXPECT(ts_elm_declaration_hashes_rehashed(hashes) == 4);
+    if (count == 4) {
+        EXPECT_SLICE(INITIAL, items[0].name_start_byte, items[0].name_end_byte, "Model");
+        EXPECT_SLICE(INITIAL, items[1].start_byte, items[1].end_byte,
+                     "init : Model\ninit =\n    { count = 0 }");
+        EXPECT_SLICE(INITIAL, items[3].name_start_byte, items[3].name_end_byte, "view");
+        EXPECT(items[1].hash != items[2].hash);
+    }
+    ts_elm_declaration_hashes_previous(hashes, &count);
+    EXPECT(count == 0);
+    ts_elm_declaration_hashes_changes(hashes, &count);
+    EXPECT(count == 0);
+
+    ts_elm_declaration_hashes_delete(hashes);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+}
+
+static void test_update(void) {
+    char *source = malloc(strlen(INITIAL) + 1);
+    strcpy(source, INITIAL);
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, source);
+    TSElmDeclarationHashes *hashes = ts_elm_declaration_hashes_new();
+    EXPECT(ts_elm_declaration_hashes_reset(hashes, ts_tree_root_node(tree), source));
+    char *previous = malloc(strlen(INITIAL) * 2);
+
+    // Comments and whitespace leave the hash alone
+    strcpy(previous, source);
+    replace(hashes, parser, &tree, &source, "{ count = 0 }", "{ count = 0 } -- start");
+    expect_changes(hashes, source, previous, NULL, 0);
+    EXPECT(ts_elm_declaration_hashes_rehashed(hashes) == 1);
+
+    strcpy(previous, source);
+    replace(hashes, parser, &tree, &source, "model.count + 1", "model.count  +  1");
+    expect_changes(hashes, source, previous, NULL, 0);
+
+    strcpy(previous, source);
+    replace(hashes, parser, &tree, &source, "model.count + ", "model.count - ");
+    const char *changed[] = {"~update"};
+    expect_changes(hashes, source, previous, changed, 1);
+    EXPECT(ts_elm_declaration_hashes_rehashed(hashes) == 1);
+
+    // The annotation belongs to the declaration after it
+    strcpy(previous, source);
+    replace(hashes, parser, &tree, &source, "init : Model", "init : { count : Int }");
+    const char *annotated[] = {"~init"};
+    expect_changes(hashes, source, previous, annotated, 1);
+
+    strcpy(previous, source);
+    replace(hashes, parser, &tree, &source, "view model", "main =\n    0\n\nview model");
+    const char *added[] = {"+main"};
+    expect_changes(hashes, source, previous, added, 1);
+
+    strcpy(previous, source);
+    replace(hashes, parser, &tree, &source, "update model", "step model");
+    const char *renamed[] = {"-update", "+step"};
+    expect_changes(hashes, source, previous, renamed, 2);
+
+    uint32_t count;
+    ts_elm_declaration_hashes_items(hashes, &count);
+    EXPECT(count == 5);
+
+    free(previous);
+    ts_elm_declaration_hashes_delete(hashes);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+    free(source);
+}
+
+int main(void) {
+    test_reset();
+    test_update();
+    return test_result("declaration_hashes_test");
+}
@@ -0,0 +1,162 @@
+#include "test.h"
+#include "tree_sitter/elm/doc_index.h"
+
+static const char *SOURCE = "module Counter exposing (Model, init, update, view)\n"
+                            "\n"
+                            "{-| A counter.\n"
+                            "\n"
+                            "# Model\n"
+                            "@docs Model, init\n"
+                            "\n"
+                            "# Updating and viewing\n"
+                            "@docs update,view\n"
+                            "-}\n"
+                            "\n"
+                            "import Html exposing (Html, text)\n"
+                            "\n"
+                            "\n"
+                            "{-| The count. -}\n"
+                            "type alias Model =\n"
+                            "    Int\n"
+                            "\n"
+                            "\n"
+                            "{-| Starts at zero. -}\n"
+                            "init : Model\n"
+                            "init =\n"
+                            "    0\n"
+                            "\n"
+                            "\n"
+                            "update : Model -> Model\n"
+                            "update model =\n"
+                            "    model + 1\n"
+                            "\n"
+                            "\n"
+                            "{- Not a doc comment -}\n"
+                            "view : Model -> Html msg\n"
+                            "view model =\n"
+                            "    text (String.fromInt model)\n";
+
+static const TSElmDocEntry *find(const TSElmDocIndex *index, const char *name) {
+    return ts_elm_doc_index_find(index, name, (uint32_t)strlen(name));
+}
+
+static void test_declarations(void) {
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, SOURCE);
+    EXPECT(!ts_node_has_error(ts_tree_root_node(tree)));
+    TSElmDocIndex *index = ts_elm_doc_index_new();
+    EXPECT(ts_elm_doc_index_build(index, ts_tree_root_node(tree), SOURCE));
+
+    uint32_t count;
+    ts_elm_doc_index_entries(index, &count);
+    EXPECT(count == 4);
+
+    const TSElmDocEntry *model = find(index, "Model");
+    EXPECT(model != NULL);
+    if (model != NULL) {
+        EXPECT_SLICE(SOURCE, model->doc_start_byte, model->doc_end_byte, "{-| The count. -}");
+        EXPECT_SLICE(SOURCE, model->name_start_byte, model->name_end_byte, "Model");
+    }
+
+    // The doc comment is above the type annotation, which the declaration
+    // range includes
+    const TSElmDocEntry *init = find(index, "init");
+    EXPECT(init != NULL);
+    if (init != NULL) {
+        EXPECT_SLICE(SOURCE, init->doc_start_byte, init->doc_end_byte,
+                     "{-| Starts at zero. -}");
+        EXPECT_SLICE(SOURCE, init->start_byte, init->start_byte + 4, "init");
+        EXPECT(SOURCE[init->start_byte + 5] == ':');
+    }
+
+    const TSElmDocEntry *update = find(index, "update");
+    EXPECT(update != NULL && update->doc_start_byte == update->doc_end_byte);
+    const TSElmDocEntry *view = find(index, "view");
+    EXPECT(view != NULL && view->doc_start_byte == view->doc_end_byte);
+
+    EXPECT(find(index, "Counter") == NULL);
+    EXPECT(find(index, "initial") == NULL);
+    EXPECT(find(index, "") == NULL);
+
+    ts_elm_doc_index_delete(index);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+}
+
+static void test_module_doc(void) {
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, SOURCE);
+    TSElmDocIndex *index = ts_elm_doc_index_new();
+    EXPECT(ts_elm_doc_index_build(index, ts_tree_root_node(tree), SOURCE));
+
+    uint32_t start, end;
+    EXPECT(ts_elm_doc_index_module_doc(index, &start, &end));
+    EXPECT(strncmp(SOURCE + start, "{-| A counter.", 14) == 0);
+    EXPECT(strncmp(SOURCE + end - 2, "-}", 2) == 0);
+
+    uint32_t group_count, name_count;
+    const TSElmDocGroup *groups = ts_elm_doc_index_groups(index, &group_count);
+    const TSElmDocName *names = ts_elm_doc_index_names(index, &name_count);
+    EXPECT(group_count == 2);
+    EXPECT(name_count == 4);
+    if (group_count == 2 && name_count == 4) {
+        EXPECT_SLICE(SOURCE, groups[0].heading_start_byte, groups[0].heading_end_byte, "Model");
+        EXPECT(groups[0].first_name == 0 && groups[0].name_count == 2);
+        EXPECT_SLICE(SOURCE, groups[1].heading_start_byte, groups[1].heading_end_byte,
+                     "Updating and viewing");
+        EXPECT(groups[1].first_name == 2 && groups[1].name_count == 2);
+        static const char *expected[] = {"Model", "init", "update", "view"};
+        for (uint32_t i = 0; i < 4; i++) {
+            EXPECT_SLICE(SOURCE, names[i].start_byte, names[i].end_byte, expected[i]);
+        }
+    }
+
+    // Rebuilding from a module without docs drops everything
+    const char *plain = "module Main exposing (..)\n\nx = 1\n";
+    TSTree *plain_tree = parse(&parser, plain);
+    EXPECT(ts_elm_doc_index_build(index, ts_tree_root_node(plain_tree), plain));
+    EXPECT(!ts_elm_doc_index_module_doc(index, &start, &end));
+    ts_elm_doc_index_groups(index, &group_count);
+    EXPECT(group_count == 0);
+    EXPECT(find(index, "Model") == NULL);
+    EXPECT(find(index, "x") != NULL);
+
+    ts_tree_delete(plain_tree);
+    ts_elm_doc_index_delete(index);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+}
+
+// Enough declarations to grow the table past its first size
+static void test_many(void) {
+    char *source = malloc(64 * 1024);
+    char *end = source + sprintf(source, "module Main exposing (..)\n\n");
+    for (int i = 0; i < 500; i++) {
+        end += sprintf(end, "{-| Doc %d -}\nvalue%d =\n    %d\n\n\n", i, i, i);
+    }
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, source);
+    TSElmDocIndex *index = ts_elm_doc_index_new();
+    EXPECT(ts_elm_doc_index_build(index, ts_tree_root_node(tree), source));
+    for (int i = 0; i < 500; i++) {
+        char name[16], doc[32];
+        snprintf(name, sizeof(name), "value%d", i);
+        snprintf(doc, sizeof(doc), "{-| Doc %d -}", i);
+        const TSElmDocEntry *entry = find(index, name);
+        EXPECT(entry != NULL);
+        if (entry != NULL) {
+            EXPECT_SLICE(source, entry->doc_start_byte, entry->doc_end_byte, doc);
+        }
+    }
+    ts_elm_doc_index_delete(index);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+    free(source);
+}
+
+int main(void) {
+    test_declarations();
+    test_module_doc();
+    test_many();
+    return test_result("doc_index_test");
+}
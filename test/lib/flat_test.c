@@ -0,0 +1,66 @@
+#include "test.h"
+#include "tree_sitter/elm/flat.h"
+
+static const char *SOURCE = "main =\n"
+                            "    f 1 \"a\"\n";
+
+static const char *symbol_name(const TSElmFlatNode *node) {
+    return ts_language_symbol_name(tree_sitter_elm(), (TSSymbol)node->symbol);
+}
+
+// Check the links against a cursor walk of the same tree.
+static void expect_links(const TSElmFlatNode *nodes, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        const TSElmFlatNode *node = &nodes[i];
+        if (node->first_child != TS_ELM_FLAT_NONE) {
+            EXPECT(node->first_child == i + 1);
+            EXPECT(nodes[node->first_child].parent == i);
+        }
+        if (node->next_sibling != TS_ELM_FLAT_NONE) {
+            EXPECT(node->next_sibling > i);
+            EXPECT(nodes[node->next_sibling].parent == node->parent);
+            EXPECT(nodes[node->next_sibling].start_byte >= node->end_byte);
+        }
+    }
+}
+
+static void test_flatten(void) {
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, SOURCE);
+    TSNode root = ts_tree_root_node(tree);
+
+    uint32_t capacity = ts_node_descendant_count(root);
+    TSElmFlatNode *nodes = calloc(capacity, sizeof(TSElmFlatNode));
+
+    uint32_t count = ts_elm_flatten(root, false, nodes, capacity);
+    EXPECT(count == capacity);
+    EXPECT(strcmp(symbol_name(&nodes[0]), "file") == 0);
+    EXPECT(nodes[0].parent == TS_ELM_FLAT_NONE);
+    EXPECT(nodes[0].end_byte == strlen(SOURCE));
+    EXPECT(strcmp(symbol_name(&nodes[1]), "value_declaration") == 0);
+    EXPECT(strcmp(symbol_name(&nodes[2]), "function_declaration_left") == 0);
+    EXPECT(nodes[2].field_id ==
+           ts_language_field_id_for_name(tree_sitter_elm(),
+                                         "functionDeclarationLeft", 23));
+    expect_links(nodes, count);
+
+    uint32_t named_count = ts_elm_flatten(root, true, nodes, capacity);
+    EXPECT(named_count < count);
+    for (uint32_t i = 0; i < named_count; i++) {
+        EXPECT(ts_language_symbol_type(tree_sitter_elm(),
+                                       (TSSymbol)nodes[i].symbol) ==
+               TSSymbolTypeRegular);
+    }
+    expect_links(nodes, named_count);
+
+    EXPECT(ts_elm_flatten(root, false, nodes, 3) == 3);
+
+    free(nodes);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+}
+
+int main(void) {
+    test_flatten();
+    return test_result("flat_test");
+}
@@ -0,0 +1,209 @@
+#include "test.h"
+#include "tree_sitter/elm/highlight.h"
+
+static const char *HIGHLIGHTS = "(line_comment) @comment\n"
+                                "(block_comment) @comment\n"
+                                "(function_declaration_left\n"
+                                "  (lower_case_identifier) @function)\n"
+                                "(string_constant_expr) @string\n"
+                                "(number_constant_expr) @number\n";
+
+static const char *INJECTIONS = "((glsl_content) @injection.content\n"
+                                " (#set! injection.language \"glsl\"))\n";
+
+static TSQuery *query(const char *source) {
+    uint32_t error_offset;
+    TSQueryError error_type;
+    TSQuery *query = ts_query_new(tree_sitter_elm(), source, (uint32_t)strlen(source),
+                                  &error_offset, &error_type);
+    EXPECT(query != NULL);
+    return query;
+}
+
+// About 500 rows, with a block comment across the first block boundary and
+// a shader further down.
+static char *generate(void) {
+    size_t capacity = 64 * 1024, length = 0;
+    char *source = malloc(capacity);
+    length += (size_t)sprintf(source + length, "module Main exposing (..)\n\n");
+    for (int i = 0; i < 120; i++) {
+        if (i == 62) {
+            length += (size_t)sprintf(source + length, "{- a\n\n\n\n\n\n\n b -}\n");
+        }
+        if (i == 80) {
+            length += (size_t)sprintf(source + length,
+                                      "shader =\n    [glsl|\nvoid main () {}\n|]\n\n");
+        }
+        length += (size_t)sprintf(source + length,
+                                  "f%d =\n    -- %d\n    \"%d\" ++ %d\n\n", i, i, i, i);
+    }
+    return source;
+}
+
+static int compare_highlights(const void *a, const void *b) {
+    const TSElmHighlight *left = a, *right = b;
+    if (left->start_byte != right->start_byte) {
+        return left->start_byte < right->start_byte ? -1 : 1;
+    }
+    if (left->end_byte != right->end_byte) {
+        return left->end_byte < right->end_byte ? -1 : 1;
+    }
+    return (int)left->capture - (int)right->capture;
+}
+
+// The same captures as one query over the whole tree, clipped to the rows
+static uint32_t expected_highlights(TSQuery *highlights, TSTree *tree,
+                                    uint32_t start_row, uint32_t end_row,
+                                    TSElmHighlight *expected) {
+    TSQueryCursor *cursor = ts_query_cursor_new();
+    ts_query_cursor_exec(cursor, highlights, ts_tree_root_node(tree));
+    TSQueryMatch match;
+    uint32_t capture_index, count = 0;
+    while (ts_query_cursor_next_capture(cursor, &match, &capture_index)) {
+        TSNode node = match.captures[capture_index].node;
+        TSPoint end = ts_node_end_point(node);
+        if (ts_node_start_point(node).row < end_row &&
+            (end.row > start_row || (end.row == start_row && end.column > 0))) {
+            expected[count++] = (TSElmHighlight){
+                .start_byte = ts_node_start_byte(node),
+                .end_byte = ts_node_end_byte(node),
+                .start_point = ts_node_start_point(node),
+                .end_point = end,
+                .capture = match.captures[capture_index].index,
+            };
+        }
+    }
+    ts_query_cursor_delete(cursor);
+    return count;
+}
+
+static void expect_rows(TSElmHighlighter *highlighter, TSQuery *highlights,
+                        TSTree *tree, uint32_t start_row, uint32_t end_row) {
+    static TSElmHighlight expected[4096], actual[4096];
+    EXPECT(ts_elm_highlighter_highlight_rows(highlighter, start_row, end_row));
+    uint32_t count;
+    const TSElmHighlight *result = ts_elm_highlighter_highlights(highlighter, &count);
+    for (uint32_t i = 1; i < count; i++) {
+        EXPECT(result[i - 1].start_byte <= result[i].start_byte);
+    }
+    memcpy(actual, result, count * sizeof(TSElmHighlight));
+    uint32_t expected_count =
+        expected_highlights(highlights, tree, start_row, end_row, expected);
+    qsort(actual, count, sizeof(TSElmHighlight), compare_highlights);
+    qsort(expected, expected_count, sizeof(TSElmHighlight), compare_highlights);
+    EXPECT(count == expected_count);
+    EXPECT(count == expected_count &&
+           memcmp(actual, expected, count * sizeof(TSElmHighlight)) == 0);
+}
+
+static TSPoint point_at(const char *source, uint32_t byte) {
+    TSPoint point = {0, 0};
+    for (uint32_t i = 0; i < byte; i++) {
+        if (source[i] == '\n') {
+            point.row++;
+            point.column = 0;
+        } else {
+            point.column++;
+        }
+    }
+    return point;
+}
+
+// Replace `pattern` in `*source` with `text`, reparse and hand the new tree
+// to the highlighter, which keeps the blocks away from the edit.
+static void replace(TSElmHighlighter *highlighter, TSParser *parser, TSTree **tree,
+                    char **source, const char *pattern, const char *text) {
+    char *old = *source;
+    uint32_t start = (uint32_t)(strstr(old, pattern) - old);
+    uint32_t end = start + (uint32_t)strlen(pattern);
+    uint32_t length = (uint32_t)strlen(old) - (end - start) + (uint32_t)strlen(text);
+    char *new_source = malloc(length + 1);
+    memcpy(new_source, old, start);
+    strcpy(new_source + start, text);
+    strcat(new_source, old + end);
+
+    TSInputEdit edit = {
+        .start_byte = start,
+        .old_end_byte = end,
+        .new_end_byte = start + (uint32_t)strlen(text),
+        .start_point = point_at(old, start),
+        .old_end_point = point_at(old, end),
+        .new_end_point = point_at(new_source, start + (uint32_t)strlen(text)),
+    };
+    ts_tree_edit(*tree, &edit);
+    TSTree *new_tree = ts_parser_parse_string(parser, *tree, new_source, length);
+    ts_elm_highlighter_edit_tree(highlighter, *tree, new_tree, &edit, 1);
+    ts_tree_delete(*tree);
+    free(old);
+    *tree = new_tree;
+    *source = new_source;
+}
+
+int main(void) {
+    char *source = generate();
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, source);
+    TSQuery *highlights = query(HIGHLIGHTS);
+    TSQuery *injections = query(INJECTIONS);
+    TSElmHighlighter *highlighter = ts_elm_highlighter_new(highlights, injections);
+
+    uint32_t length;
+    EXPECT(ts_elm_highlighter_injection_language_count(highlighter) == 1);
+    const char *language = ts_elm_highlighter_injection_language(highlighter, 0, &length);
+    EXPECT(length == 4 && memcmp(language, "glsl", 4) == 0);
+
+    ts_elm_highlighter_set_tree(highlighter, tree);
+    expect_rows(highlighter, highlights, tree, 0, UINT32_MAX);
+    expect_rows(highlighter, highlights, tree, 250, 262);
+    expect_rows(highlighter, highlights, tree, 254, 600);
+    expect_rows(highlighter, highlights, tree, 10, 20);
+    expect_rows(highlighter, highlights, tree, 700, 710);
+
+    uint32_t count;
+    EXPECT(ts_elm_highlighter_highlight_rows(highlighter, 0, UINT32_MAX));
+    const TSElmInjection *injection = ts_elm_highlighter_injections(highlighter, &count);
+    EXPECT(count == 1);
+    if (count == 1) {
+        EXPECT(injection->language == 0);
+        EXPECT_SLICE(source, injection->start_byte, injection->end_byte,
+                     "\nvoid main () {}\n");
+    }
+
+    const char *string = strstr(source, "\"7\"");
+    uint32_t start = (uint32_t)(string - source);
+    EXPECT(ts_elm_highlighter_highlight_bytes(highlighter, start, start + 3));
+    const TSElmHighlight *highlight = ts_elm_highlighter_highlights(highlighter, &count);
+    EXPECT(count == 1);
+    if (count == 1) {
+        EXPECT_SLICE(source, highlight->start_byte, highlight->end_byte, "\"7\"");
+    }
+
+    // Kept blocks match a fresh query after edits that keep the line count,
+    // add lines, and turn the rest of the file into a comment
+    const char *edits[][2] = {
+        {"\"7\"", "\"seven\" ++ f6"},
+        {"f100 =", "f100 x ="},
+        {"-- 20\n", "-- 20\n    -- and more\n"},
+        {"f110 =", "{- f110 ="},
+    };
+    for (size_t i = 0; i < sizeof(edits) / sizeof(edits[0]); i++) {
+        expect_rows(highlighter, highlights, tree, 0, UINT32_MAX);
+        replace(highlighter, parser, &tree, &source, edits[i][0], edits[i][1]);
+        expect_rows(highlighter, highlights, tree, 0, UINT32_MAX);
+        expect_rows(highlighter, highlights, tree, 250, 262);
+        expect_rows(highlighter, highlights, tree, 400, 500);
+    }
+
+    ts_elm_highlighter_set_tree(highlighter, NULL);
+    EXPECT(ts_elm_highlighter_highlight_rows(highlighter, 0, 10));
+    ts_elm_highlighter_highlights(highlighter, &count);
+    EXPECT(count == 0);
+
+    ts_elm_highlighter_delete(highlighter);
+    ts_query_delete(highlights);
+    ts_query_delete(injections);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+    free(source);
+    return test_result("highlight_test");
+}
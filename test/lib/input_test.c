@@ -0,0 +1,114 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "test.h"
+#include "tree_sitter/elm/input.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Multi-byte characters fall across the 7-byte chunks of the stream.
+static const char *SOURCE = "module Main exposing (..)\n"
+                            "\n"
+                            "{-| Élm 𝔼 -}\n"
+                            "greeting : String\n"
+                            "greeting =\n"
+                            "    \"héllo 𝔼 wörld\" ++ \"ünïcödé\"\n";
+
+// Parse `input` and compare the tree with the one of the string.
+static void expect_same_tree(TSParser *parser, TSElmFileInput *input,
+                             const char *expected) {
+    TSTree *tree = ts_parser_parse(parser, NULL, ts_elm_file_input(input));
+    EXPECT(tree != NULL);
+    if (tree == NULL) {
+        return;
+    }
+    char *actual = ts_node_string(ts_tree_root_node(tree));
+    EXPECT(strcmp(actual, expected) == 0);
+    EXPECT(ts_node_end_byte(ts_tree_root_node(tree)) == strlen(SOURCE));
+    EXPECT(ts_elm_file_input_error(input) == 0);
+    free(actual);
+    ts_tree_delete(tree);
+}
+
+static void test_file_inputs(void) {
+    char path[] = "/tmp/tree-sitter-elm-input-XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT(fd >= 0);
+    if (fd < 0) {
+        return;
+    }
+    EXPECT(write(fd, SOURCE, strlen(SOURCE)) == (ssize_t)strlen(SOURCE));
+
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, SOURCE);
+    char *expected = ts_node_string(ts_tree_root_node(tree));
+    EXPECT(!ts_node_has_error(ts_tree_root_node(tree)));
+
+    int error = 0;
+    TSElmFileInput *mapped = ts_elm_file_input_map(path, &error);
+    EXPECT(mapped != NULL && error == 0);
+    if (mapped != NULL) {
+        EXPECT(ts_elm_file_input_length(mapped) == strlen(SOURCE));
+        EXPECT(memcmp(ts_elm_file_input_data(mapped), SOURCE, strlen(SOURCE)) == 0);
+        expect_same_tree(parser, mapped, expected);
+        ts_elm_file_input_delete(mapped);
+    }
+
+    TSElmFileInput *stream = ts_elm_file_input_stream(fd, 7, &error);
+    EXPECT(stream != NULL && error == 0);
+    if (stream != NULL) {
+        EXPECT(ts_elm_file_input_data(stream) == NULL);
+        expect_same_tree(parser, stream, expected);
+        ts_elm_file_input_delete(stream);
+    }
+
+    EXPECT(ts_elm_file_input_map("/nonexistent/Main.elm", &error) == NULL);
+    EXPECT(error == ENOENT);
+
+    free(expected);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+    close(fd);
+    unlink(path);
+}
+
+static void test_empty_file(void) {
+    char path[] = "/tmp/tree-sitter-elm-input-XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT(fd >= 0);
+    if (fd < 0) {
+        return;
+    }
+    int error = 0;
+    TSElmFileInput *mapped = ts_elm_file_input_map(path, &error);
+    EXPECT(mapped != NULL && ts_elm_file_input_length(mapped) == 0);
+    if (mapped != NULL) {
+        TSParser *parser = ts_parser_new();
+        ts_parser_set_language(parser, tree_sitter_elm());
+        TSTree *tree = ts_parser_parse(parser, NULL, ts_elm_file_input(mapped));
+        EXPECT(tree != NULL && ts_node_end_byte(ts_tree_root_node(tree)) == 0);
+        ts_tree_delete(tree);
+        ts_parser_delete(parser);
+        ts_elm_file_input_delete(mapped);
+    }
+    close(fd);
+    unlink(path);
+}
+
+static void test_pipe(void) {
+    int fds[2];
+    EXPECT(pipe(fds) == 0);
+    int error = 0;
+    EXPECT(ts_elm_file_input_stream(fds[0], 0, &error) == NULL);
+    EXPECT(error == ESPIPE);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+int main(void) {
+    test_file_inputs();
+    test_empty_file();
+    test_pipe();
+    return test_result("input_test");
+}
@@ -0,0 +1,107 @@
+#include "test.h"
+#include "tree_sitter/elm/line_index.h"
+
+// "é" takes two bytes and one UTF-16 unit, "𝔼" four bytes and two units.
+static const char *SOURCE = "module Main exposing (..)\r\n"
+                            "\n"
+                            "name =\n"
+                            "    \"Élm 𝔼 and a line long enough to fill a few blocks\" -- é\n"
+                            "\n"
+                            "plain =\n"
+                            "    \"only ASCII here, but more than sixteen bytes\"\n";
+
+static void expect_position(const TSElmLineIndex *index, const char *source,
+                            uint32_t byte, uint32_t line, uint32_t character) {
+    TSElmPosition position = ts_elm_line_index_position(index, source, byte);
+    EXPECT(position.line == line && position.character == character);
+    EXPECT(ts_elm_line_index_byte(index, source, position) == byte);
+}
+
+static void test_positions(void) {
+    TSElmLineIndex *index = ts_elm_line_index_new();
+    EXPECT(ts_elm_line_index_reset(index, SOURCE, (uint32_t)strlen(SOURCE)));
+    EXPECT(ts_elm_line_index_line_count(index) == 8);
+
+    const char *e = strstr(SOURCE, "É");
+    const char *double_struck = strstr(SOURCE, "𝔼");
+    uint32_t line_start = (uint32_t)(strstr(SOURCE, "    \"É") - SOURCE);
+    expect_position(index, SOURCE, 0, 0, 0);
+    expect_position(index, SOURCE, (uint32_t)(e - SOURCE), 3, 5);
+    expect_position(index, SOURCE, (uint32_t)(e - SOURCE) + 2, 3, 6);
+    expect_position(index, SOURCE, (uint32_t)(double_struck - SOURCE), 3, 9);
+    expect_position(index, SOURCE, (uint32_t)(double_struck - SOURCE) + 4, 3, 11);
+    expect_position(index, SOURCE, (uint32_t)(strstr(SOURCE, "plain") - SOURCE), 5, 0);
+
+    TSPoint point = ts_elm_line_index_point(index, (uint32_t)(double_struck - SOURCE));
+    EXPECT(point.row == 3 && point.column == (uint32_t)(double_struck - SOURCE) - line_start);
+
+    // Past the end of a line, before its "\r\n", and past the last line
+    TSElmPosition past = {0, 100};
+    EXPECT(ts_elm_line_index_byte(index, SOURCE, past) == 25);
+    past = (TSElmPosition){3, 1000};
+    EXPECT(ts_elm_line_index_byte(index, SOURCE, past) ==
+           (uint32_t)(strstr(SOURCE, "é\n") - SOURCE) + 2);
+    past = (TSElmPosition){20, 0};
+    EXPECT(ts_elm_line_index_byte(index, SOURCE, past) == strlen(SOURCE));
+
+    ts_elm_line_index_delete(index);
+}
+
+// Apply an LSP change to `*source` and the index, and compare the index
+// with one built from scratch.
+static void change(TSElmLineIndex *index, char **source, TSElmPosition start,
+                   TSElmPosition end, const char *text) {
+    uint32_t length = (uint32_t)strlen(*source);
+    uint32_t text_length = (uint32_t)strlen(text);
+    TSInputEdit edit = ts_elm_line_index_change(index, *source, start, end, text, text_length);
+
+    char *new_source = malloc(length + text_length + 1);
+    memcpy(new_source, *source, edit.start_byte);
+    memcpy(new_source + edit.start_byte, text, text_length);
+    strcpy(new_source + edit.new_end_byte, *source + edit.old_end_byte);
+    free(*source);
+    *source = new_source;
+    length = (uint32_t)strlen(new_source);
+    EXPECT(ts_elm_line_index_edit(index, new_source, length, &edit));
+
+    TSElmLineIndex *expected = ts_elm_line_index_new();
+    ts_elm_line_index_reset(expected, new_source, length);
+    EXPECT(ts_elm_line_index_line_count(index) == ts_elm_line_index_line_count(expected));
+    TSPoint end_point = ts_elm_line_index_point(expected, edit.new_end_byte);
+    EXPECT(end_point.row == edit.new_end_point.row &&
+           end_point.column == edit.new_end_point.column);
+    for (uint32_t byte = 0; byte <= length; byte++) {
+        TSElmPosition a = ts_elm_line_index_position(index, new_source, byte);
+        TSElmPosition b = ts_elm_line_index_position(expected, new_source, byte);
+        if (a.line != b.line || a.character != b.character) {
+            fprintf(stderr, "position of byte %u differs after an edit\n", byte);
+            test_failures++;
+            break;
+        }
+    }
+    ts_elm_line_index_delete(expected);
+}
+
+static void test_changes(void) {
+    char *source = malloc(strlen(SOURCE) + 1);
+    strcpy(source, SOURCE);
+    TSElmLineIndex *index = ts_elm_line_index_new();
+    EXPECT(ts_elm_line_index_reset(index, source, (uint32_t)strlen(source)));
+
+    change(index, &source, (TSElmPosition){3, 6}, (TSElmPosition){3, 6}, "ü");
+    change(index, &source, (TSElmPosition){2, 0}, (TSElmPosition){4, 0}, "");
+    change(index, &source, (TSElmPosition){0, 7}, (TSElmPosition){0, 11},
+           "Main\n\nimport Html\n\nx =\n    \"𝔼\"\n");
+    change(index, &source, (TSElmPosition){5, 0}, (TSElmPosition){9, 2}, "é");
+    change(index, &source, (TSElmPosition){0, 0}, (TSElmPosition){100, 0},
+           "only\nthis\n");
+
+    ts_elm_line_index_delete(index);
+    free(source);
+}
+
+int main(void) {
+    test_positions();
+    test_changes();
+    return test_result("line_index_test");
+}
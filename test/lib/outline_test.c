@@ -0,0 +1,105 @@
+#include "test.h"
+#include "tree_sitter/elm/outline.h"
+
+static const char *SOURCE = "port module Main exposing (..)\n"
+                            "\n"
+                            "\n"
+                            "port send : String -> Cmd msg\n"
+                            "\n"
+                            "\n"
+                            "type Msg\n"
+                            "    = Increment\n"
+                            "    | Set Int\n"
+                            "\n"
+                            "\n"
+                            "type alias Model =\n"
+                            "    { count : Int\n"
+                            "    , nested : { inner : Int }\n"
+                            "    }\n"
+                            "\n"
+                            "\n"
+                            "type alias Pair =\n"
+                            "    ( Int, Int )\n"
+                            "\n"
+                            "\n"
+                            "update : Msg -> Model -> Model\n"
+                            "update msg model =\n"
+                            "    let\n"
+                            "        step n =\n"
+                            "            let\n"
+                            "                double x =\n"
+                            "                    x * 2\n"
+                            "            in\n"
+                            "            double n\n"
+                            "\n"
+                            "        ( a, b ) =\n"
+                            "            ( 1, 2 )\n"
+                            "    in\n"
+                            "    { model | count = step model.count }\n";
+
+typedef struct {
+    TSElmOutlineKind kind;
+    uint32_t parent;
+    const char *name;
+} Expected;
+
+static void test_outline(void) {
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, SOURCE);
+    EXPECT(!ts_node_has_error(ts_tree_root_node(tree)));
+
+    TSElmOutline outline = {0};
+    EXPECT(ts_elm_outline_build(&outline, ts_tree_root_node(tree)));
+
+    static const Expected expected[] = {
+        {TSElmOutlinePort, TS_ELM_OUTLINE_NONE, "send"},
+        {TSElmOutlineType, TS_ELM_OUTLINE_NONE, "Msg"},
+        {TSElmOutlineVariant, 1, "Increment"},
+        {TSElmOutlineVariant, 1, "Set"},
+        {TSElmOutlineTypeAlias, TS_ELM_OUTLINE_NONE, "Model"},
+        {TSElmOutlineField, 4, "count"},
+        {TSElmOutlineField, 4, "nested"},
+        {TSElmOutlineTypeAlias, TS_ELM_OUTLINE_NONE, "Pair"},
+        {TSElmOutlineFunction, TS_ELM_OUTLINE_NONE, "update"},
+        {TSElmOutlineLetFunction, 8, "step"},
+        {TSElmOutlineLetFunction, 9, "double"},
+    };
+    uint32_t count = sizeof(expected) / sizeof(expected[0]);
+    EXPECT(outline.count == count);
+    for (uint32_t i = 0; i < count && i < outline.count; i++) {
+        const TSElmOutlineSymbol *symbol = &outline.symbols[i];
+        EXPECT(symbol->kind == (uint32_t)expected[i].kind);
+        EXPECT(symbol->parent == expected[i].parent);
+        EXPECT_SLICE(SOURCE, symbol->name_start_byte, symbol->name_end_byte,
+                     expected[i].name);
+        EXPECT(symbol->start_byte <= symbol->name_start_byte &&
+               symbol->name_end_byte <= symbol->end_byte);
+    }
+    if (outline.count == count) {
+        EXPECT_SLICE(SOURCE, outline.symbols[3].start_byte, outline.symbols[3].end_byte,
+                     "Set Int");
+        EXPECT_SLICE(SOURCE, outline.symbols[5].start_byte, outline.symbols[5].end_byte,
+                     "count : Int");
+        EXPECT_SLICE(SOURCE, outline.symbols[10].start_byte, outline.symbols[10].end_byte,
+                     "double x =\n                    x * 2");
+    }
+
+    // Rebuilding reuses the array
+    const char *plain = "module Main exposing (..)\n\nmain =\n    0\n";
+    TSTree *plain_tree = parse(&parser, plain);
+    TSElmOutlineSymbol *symbols = outline.symbols;
+    EXPECT(ts_elm_outline_build(&outline, ts_tree_root_node(plain_tree)));
+    EXPECT(outline.count == 1 && outline.symbols == symbols);
+    EXPECT(outline.count == 1 && outline.symbols[0].kind == TSElmOutlineFunction);
+
+    ts_elm_outline_delete(&outline);
+    EXPECT(outline.symbols == NULL && outline.count == 0);
+    ts_tree_delete(plain_tree);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+}
+
+int main(void) {
+    test_outline();
+    return test_result("outline_test");
+}
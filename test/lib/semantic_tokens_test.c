@@ -0,0 +1,223 @@
+#include "test.h"
+#include "tree_sitter/elm/semantic_tokens.h"
+
+static const char *QUERY =
+    "(module) @keyword.other.elm\n"
+    "(exposing) @keyword.other.elm\n"
+    "(function_declaration_left (lower_case_identifier) @function.elm)\n"
+    "(line_comment) @comment.elm\n"
+    "(block_comment) @comment.elm\n"
+    "(string_constant_expr) @string.elm\n"
+    "(string_escape) @character.escape.elm\n"
+    "(number_constant_expr) @constant.numeric.elm\n";
+
+enum { KEYWORD, FUNCTION, COMMENT, STRING, ESCAPE };
+
+static const TSElmTokenMapping MAPPINGS[] = {
+    {"keyword", KEYWORD, 0},
+    {"function", FUNCTION, 0},
+    {"comment", COMMENT, 0},
+    {"string", STRING, 0},
+    {"character.escape", ESCAPE, 1},
+};
+
+static uint32_t encode(TSElmSemanticTokens *tokens, const char *source,
+                       uint32_t start_byte, uint32_t end_byte, uint32_t *data,
+                       uint32_t capacity) {
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, source);
+    uint32_t count =
+        ts_elm_semantic_tokens_encode(tokens, ts_tree_root_node(tree), source,
+                                      start_byte, end_byte, data, capacity);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+    return count;
+}
+
+static void expect_tokens(const uint32_t *data, uint32_t count,
+                          const uint32_t *expected, uint32_t expected_count) {
+    EXPECT(count == expected_count);
+    for (uint32_t i = 0; i < count && i < expected_count; i++) {
+        if (data[i] != expected[i]) {
+            fprintf(stderr, "token %u value %u: expected %u, got %u\n", i / 5,
+                    i % 5, expected[i], data[i]);
+            test_failures++;
+        }
+    }
+}
+
+static void test_encode(TSElmSemanticTokens *tokens) {
+    // "é" is one UTF-16 unit and "😀" two, the block comment spans two lines
+    // and the escape is nested in its string.
+    const char *source = "module Main exposing (..)\n"
+                         "\n"
+                         "-- \xC3\xA9\n"
+                         "main =\n"
+                         "    \"\xF0\x9F\x98\x80\\nb\" {- a\n"
+                         "  b -}\n";
+    const uint32_t expected[] = {
+        0, 0,  6, KEYWORD,  0, //
+        0, 12, 8, KEYWORD,  0, //
+        2, 0,  4, COMMENT,  0, //
+        1, 0,  4, FUNCTION, 0, //
+        1, 4,  3, STRING,   0, //
+        0, 3,  2, ESCAPE,   1, //
+        0, 2,  2, STRING,   0, //
+        0, 3,  4, COMMENT,  0, //
+        1, 0,  6, COMMENT,  0, //
+    };
+    uint32_t data[64];
+    uint32_t count = encode(tokens, source, 0, (uint32_t)strlen(source), data, 64);
+    expect_tokens(data, count, expected, sizeof(expected) / sizeof(uint32_t));
+
+    // Too small a buffer reports the size needed
+    EXPECT(encode(tokens, source, 0, (uint32_t)strlen(source), data, 5) == count);
+    EXPECT(data[0] == 0 && data[2] == 6);
+
+    // A range keeps document-relative positions and clips the tokens in it
+    uint32_t start = (uint32_t)(strstr(source, "main") - source);
+    uint32_t end = (uint32_t)(strstr(source, "{-") - source + 4);
+    const uint32_t expected_range[] = {
+        3, 0, 4, FUNCTION, 0, //
+        1, 4, 3, STRING,   0, //
+        0, 3, 2, ESCAPE,   1, //
+        0, 2, 2, STRING,   0, //
+        0, 3, 4, COMMENT,  0, //
+    };
+    count = encode(tokens, source, start, end, data, 64);
+    expect_tokens(data, count, expected_range,
+                  sizeof(expected_range) / sizeof(uint32_t));
+}
+
+static TSPoint point_at(const char *source, uint32_t byte) {
+    TSPoint point = {0, 0};
+    for (uint32_t i = 0; i < byte; i++) {
+        if (source[i] == '\n') {
+            point.row++;
+            point.column = 0;
+        } else {
+            point.column++;
+        }
+    }
+    return point;
+}
+
+// Replace `[start, end)` of `*source` with `text`, reparse, update the cache
+// and check that its edits turn the previous data into a full encoding.
+static void replace(TSElmSemanticTokens *tokens, TSElmSemanticTokensCache *cache,
+                    TSParser *parser, TSTree **tree, char **source,
+                    const char *pattern, const char *text) {
+    char *old = *source;
+    uint32_t old_length = (uint32_t)strlen(old);
+    uint32_t start = (uint32_t)(strstr(old, pattern) - old);
+    uint32_t end = start + (uint32_t)strlen(pattern);
+    uint32_t length = old_length - (end - start) + (uint32_t)strlen(text);
+    char *new_source = malloc(length + 1);
+    memcpy(new_source, old, start);
+    strcpy(new_source + start, text);
+    strcat(new_source, old + end);
+
+    uint32_t previous_length;
+    const uint32_t *data = ts_elm_semantic_tokens_cache_data(cache, &previous_length);
+    uint32_t *previous = malloc((previous_length + 1) * sizeof(uint32_t));
+    memcpy(previous, data, previous_length * sizeof(uint32_t));
+
+    TSInputEdit edit = {
+        .start_byte = start,
+        .old_end_byte = end,
+        .new_end_byte = start + (uint32_t)strlen(text),
+        .start_point = point_at(old, start),
+        .old_end_point = point_at(old, end),
+        .new_end_point = point_at(new_source, start + (uint32_t)strlen(text)),
+    };
+    ts_tree_edit(*tree, &edit);
+    TSTree *new_tree = ts_parser_parse_string(parser, *tree, new_source, length);
+    EXPECT(ts_elm_semantic_tokens_cache_update(tokens, cache, *tree, new_tree,
+                                               new_source, length, &edit, 1));
+    ts_tree_delete(*tree);
+    *tree = new_tree;
+    free(old);
+    *source = new_source;
+
+    uint32_t current_length, edit_count;
+    const uint32_t *current = ts_elm_semantic_tokens_cache_data(cache, &current_length);
+    const TSElmSemanticTokensEdit *edits = ts_elm_semantic_tokens_cache_edits(cache, &edit_count);
+    uint32_t *applied = malloc((previous_length + current_length + 1) * sizeof(uint32_t));
+    uint32_t count = 0, position = 0, changed = 0;
+    for (uint32_t i = 0; i < edit_count; i++) {
+        EXPECT(edits[i].start >= position);
+        while (position < edits[i].start) {
+            applied[count++] = previous[position++];
+        }
+        position += edits[i].delete_count;
+        changed += edits[i].data_count;
+        for (uint32_t j = 0; j < edits[i].data_count; j++) {
+            applied[count++] = current[edits[i].data_start + j];
+        }
+    }
+    while (position < previous_length) {
+        applied[count++] = previous[position++];
+    }
+
+    uint32_t expected[256];
+    uint32_t expected_count = ts_elm_semantic_tokens_encode(
+        tokens, ts_tree_root_node(*tree), *source, 0, length, expected, 256);
+    expect_tokens(applied, count, expected, expected_count);
+    expect_tokens(current, current_length, expected, expected_count);
+    // Declarations away from the edit are not sent again
+    EXPECT(changed < expected_count);
+
+    free(applied);
+    free(previous);
+}
+
+static void test_update(TSElmSemanticTokens *tokens) {
+    const char *initial = "module Main exposing (..)\n"
+                          "\n"
+                          "a =\n"
+                          "    \"a\"\n"
+                          "\n"
+                          "{- b -}\n"
+                          "b =\n"
+                          "    \"b\"\n"
+                          "\n"
+                          "c =\n"
+                          "    \"c\"\n";
+    char *source = malloc(strlen(initial) + 1);
+    strcpy(source, initial);
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, source);
+    TSElmSemanticTokensCache *cache = ts_elm_semantic_tokens_cache_new();
+    EXPECT(ts_elm_semantic_tokens_cache_reset(tokens, cache, ts_tree_root_node(tree),
+                                              source, (uint32_t)strlen(source)));
+
+    replace(tokens, cache, parser, &tree, &source, "\"b\"", "\"\xC3\xA9\\n\" -- x");
+    replace(tokens, cache, parser, &tree, &source, "b =", "bb =");
+    replace(tokens, cache, parser, &tree, &source, "    \"a\"\n", "    \"a\"\n\n");
+    replace(tokens, cache, parser, &tree, &source, "-- x", "");
+
+    ts_elm_semantic_tokens_cache_delete(cache);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+    free(source);
+}
+
+int main(void) {
+    uint32_t error_offset;
+    TSQueryError error_type;
+    TSElmSemanticTokens *tokens = ts_elm_semantic_tokens_new(
+        QUERY, (uint32_t)strlen(QUERY), MAPPINGS,
+        sizeof(MAPPINGS) / sizeof(MAPPINGS[0]), &error_offset, &error_type);
+    EXPECT(tokens != NULL);
+    if (tokens != NULL) {
+        test_encode(tokens);
+        test_update(tokens);
+        ts_elm_semantic_tokens_delete(tokens);
+    }
+
+    EXPECT(ts_elm_semantic_tokens_new("(nope) @x", 9, MAPPINGS, 1,
+                                      &error_offset, &error_type) == NULL);
+    EXPECT(error_type == TSQueryErrorNodeType);
+
+    return test_result("semantic_tokens_test");
+}
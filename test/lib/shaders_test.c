@@ -0,0 +1,83 @@
+#include "test.h"
+#include "tree_sitter/elm/shaders.h"
+
+// The tests parse shaders with the Elm grammar, the only one at hand. The
+// trees are full of errors, but the driver does not look into them.
+int main(void) {
+    const char *source = "module Main exposing (..)\n"
+                         "\n"
+                         "text =\n"
+                         "    \"[glsl| not a shader |]\"\n"
+                         "\n"
+                         "vertex =\n"
+                         "    [glsl|\n"
+                         "void main () {}\n"
+                         "|]\n"
+                         "\n"
+                         "fragment =\n"
+                         "    [glsl|\n"
+                         "uniform float t;\n"
+                         "|]\n"
+                         "\n"
+                         "same =\n"
+                         "    [glsl|\n"
+                         "void main () {}\n"
+                         "|]\n";
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, source);
+    TSElmShaders *shaders = ts_elm_shaders_new(tree_sitter_elm());
+    EXPECT(shaders != NULL);
+
+    uint32_t count;
+    EXPECT(ts_elm_shaders_set_tree(shaders, tree, source, (uint32_t)strlen(source)));
+    const TSElmShader *ranges = ts_elm_shaders_ranges(shaders, &count);
+    EXPECT(count == 3);
+    if (count == 3) {
+        EXPECT_SLICE(source, ranges[0].start_byte, ranges[0].end_byte,
+                     "\nvoid main () {}\n");
+        EXPECT(ranges[0].start_point.row == 6);
+        EXPECT_SLICE(source, ranges[1].start_byte, ranges[1].end_byte,
+                     "\nuniform float t;\n");
+        EXPECT(ranges[0].hash == ranges[2].hash);
+        EXPECT(ranges[0].hash != ranges[1].hash);
+    }
+
+    // Only the visible shader is parsed, and identical content is shared
+    EXPECT(ts_elm_shaders_parse_rows(shaders, 0, 8) == 1);
+    EXPECT(ts_elm_shaders_parse_rows(shaders, 0, 8) == 0);
+    const TSTree *vertex = ts_elm_shaders_tree(shaders, 0);
+    EXPECT(vertex != NULL);
+    EXPECT(ts_elm_shaders_tree(shaders, 2) == vertex);
+    EXPECT(ts_elm_shaders_parse_rows(shaders, 8, 100) == 1);
+    EXPECT(ts_elm_shaders_tree(shaders, 3) == NULL);
+
+    // Editing the file keeps the trees of unchanged shaders
+    const char *edited = "module Main exposing (..)\n"
+                         "\n"
+                         "vertex =\n"
+                         "    [glsl|\n"
+                         "void main () {}\n"
+                         "|]\n"
+                         "\n"
+                         "fragment =\n"
+                         "    [glsl|\n"
+                         "uniform float u;\n"
+                         "|]\n";
+    TSTree *edited_tree = parse(&parser, edited);
+    EXPECT(ts_elm_shaders_set_tree(shaders, edited_tree, edited,
+                                   (uint32_t)strlen(edited)));
+    ts_elm_shaders_ranges(shaders, &count);
+    EXPECT(count == 2);
+    EXPECT(ts_elm_shaders_tree(shaders, 0) == vertex);
+    EXPECT(ts_elm_shaders_parse_rows(shaders, 0, 100) == 1);
+
+    EXPECT(ts_elm_shaders_set_tree(shaders, NULL, NULL, 0));
+    ts_elm_shaders_ranges(shaders, &count);
+    EXPECT(count == 0);
+
+    ts_elm_shaders_delete(shaders);
+    ts_tree_delete(edited_tree);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+    return test_result("shaders_test");
+}
@@ -0,0 +1,103 @@
+#include "test.h"
+#include "tree_sitter/elm/batch.h"
+#include "tree_sitter/elm/summary.h"
+
+static const char *SOURCE =
+    "module Main exposing (main, Model)\n"
+    "\n"
+    "import Html exposing (text)\n"
+    "import Json.Decode as Decode\n"
+    "\n"
+    "type alias Model =\n"
+    "    { count : Int }\n"
+    "\n"
+    "type Msg\n"
+    "    = Increment\n"
+    "    | Decrement\n"
+    "\n"
+    "port save : String -> Cmd msg\n"
+    "\n"
+    "main : Html.Html msg\n"
+    "main =\n"
+    "    text \"hello\"\n";
+
+static void test_summary(void) {
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, SOURCE);
+    const TSLanguage *language = tree_sitter_elm();
+
+    TSElmSummary summary;
+    EXPECT(ts_elm_summary_build(&summary, ts_tree_root_node(tree)));
+    EXPECT(!summary.has_error);
+
+    EXPECT(summary.import_count == 2);
+    EXPECT_SLICE(SOURCE, summary.imports[0].name_start_byte,
+                 summary.imports[0].name_end_byte, "Html");
+    EXPECT_SLICE(SOURCE, summary.imports[1].name_start_byte,
+                 summary.imports[1].name_end_byte, "Json.Decode");
+
+    static const char *kinds[] = {"type_alias_declaration", "type_declaration",
+                                  "port_annotation", "value_declaration"};
+    static const char *names[] = {"Model", "Msg", "save", "main"};
+    EXPECT(summary.declaration_count == 4);
+    for (uint32_t i = 0; i < summary.declaration_count && i < 4; i++) {
+        TSElmDeclaration *declaration = &summary.declarations[i];
+        EXPECT(strcmp(ts_language_symbol_name(language, declaration->symbol),
+                      kinds[i]) == 0);
+        EXPECT_SLICE(SOURCE, declaration->name_start_byte,
+                     declaration->name_end_byte, names[i]);
+    }
+    EXPECT(summary.declarations[3].start_point.row == 15);
+
+    ts_elm_summary_delete(&summary);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+}
+
+static void test_summary_error(void) {
+    TSParser *parser = NULL;
+    TSTree *tree = parse(&parser, "module Main exposing (..)\n\nmain = (\n");
+
+    TSElmSummary summary;
+    EXPECT(ts_elm_summary_build(&summary, ts_tree_root_node(tree)));
+    EXPECT(summary.has_error);
+
+    ts_elm_summary_delete(&summary);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+}
+
+static void test_summarize_files(void) {
+    char path[] = "summary_test.elm";
+    FILE *file = fopen(path, "wb");
+    EXPECT(file != NULL);
+    if (file == NULL) {
+        return;
+    }
+    fputs(SOURCE, file);
+    fclose(file);
+
+    const char *paths[] = {path, "does-not-exist.elm", path, path};
+    TSElmFileSummary results[4];
+    ts_elm_summarize_files(paths, 4, 3, results);
+
+    EXPECT(results[1].error != 0);
+    EXPECT(results[1].summary.declaration_count == 0);
+    for (int i = 0; i < 4; i++) {
+        if (i != 1) {
+            EXPECT(results[i].error == 0);
+            EXPECT(results[i].length == strlen(SOURCE));
+            EXPECT(results[i].summary.declaration_count == 4);
+            EXPECT(results[i].summary.import_count == 2);
+        }
+        ts_elm_file_summary_delete(&results[i]);
+    }
+    remove(path);
+}
+
+int main(void) {
+    test_summary();
+    test_summary_error();
+    test_summarize_files();
+    return test_result("summary_test");
+}
@@ -0,0 +1,52 @@
+#ifndef TREE_SITTER_ELM_TEST_H_
+#define TREE_SITTER_ELM_TEST_H_
+
+#include "tree_sitter/api.h"
+#include "tree_sitter/tree-sitter-elm.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int test_failures = 0;
+
+#define EXPECT(condition)                                                      \
+    do {                                                                       \
+        if (!(condition)) {                                                    \
+            fprintf(stderr, "%s:%d: expected %s\n", __FILE__, __LINE__,        \
+                    #condition);                                               \
+            test_failures++;                                                   \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_SLICE(source, start, end, expected)                             \
+    do {                                                                       \
+        const char *expected_ = (expected);                                    \
+        size_t length_ = (size_t)((end) - (start));                            \
+        if (length_ != strlen(expected_) ||                                    \
+            memcmp((source) + (start), expected_, length_) != 0) {             \
+            fprintf(stderr, "%s:%d: expected \"%s\", got \"%.*s\"\n",         \
+                    __FILE__, __LINE__, expected_, (int)length_,               \
+                    (source) + (start));                                       \
+            test_failures++;                                                   \
+        }                                                                      \
+    } while (0)
+
+static inline TSTree *parse(TSParser **parser, const char *source) {
+    if (*parser == NULL) {
+        *parser = ts_parser_new();
+        ts_parser_set_language(*parser, tree_sitter_elm());
+    }
+    return ts_parser_parse_string(*parser, NULL, source,
+                                  (uint32_t)strlen(source));
+}
+
+static inline int test_result(const char *name) {
+    if (test_failures > 0) {
+        fprintf(stderr, "%s: %d failure(s)\n", name, test_failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+#endif // TREE_SITTER_ELM_TEST_H_
@@ -0,0 +1,80 @@
+#include "test.h"
+#include "tree_sitter/tree-sitter-elm-trace.h"
+
+#define CAPACITY 4096
+
+static TSElmTraceEvent events[CAPACITY];
+
+static uint32_t count_kind(uint32_t count, TSElmTraceKind kind) {
+    uint32_t matches = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        matches += events[i].kind == (uint32_t)kind;
+    }
+    return matches;
+}
+
+static void test_layout_events(void) {
+    TSParser *parser = NULL;
+    tree_sitter_elm_trace_clear();
+    TSTree *tree = parse(&parser, "module Main exposing (..)\n"
+                                  "\n"
+                                  "f x =\n"
+                                  "    let\n"
+                                  "        y = x\n"
+                                  "    in\n"
+                                  "    case y of\n"
+                                  "        _ ->\n"
+                                  "            y\n"
+                                  "\n"
+                                  "g = 1\n");
+    EXPECT(!ts_node_has_error(ts_tree_root_node(tree)));
+
+    uint32_t count = tree_sitter_elm_trace_read(events, CAPACITY);
+    EXPECT(count > 0);
+    EXPECT(count_kind(count, TSElmTraceScanStart) > 0);
+    EXPECT(count_kind(count, TSElmTraceScanEnd) == count_kind(count, TSElmTraceScanStart));
+    EXPECT(count_kind(count, TSElmTraceEndDecl) > 0);
+    EXPECT(count_kind(count, TSElmTraceOpenSection) > 0);
+    EXPECT(count_kind(count, TSElmTraceEndSection) > 0);
+    EXPECT(count_kind(count, TSElmTraceRunbackPush) > 0);
+    EXPECT(count_kind(count, TSElmTraceRunbackPop) > 0);
+    EXPECT(count_kind(count, TSElmTraceSerialize) > 0);
+    EXPECT(count_kind(count, TSElmTraceIndentLimit) == 0);
+    for (uint32_t i = 1; i < count; i++) {
+        EXPECT(events[i].sequence > events[i - 1].sequence);
+    }
+
+    // A cleared ring reads back empty
+    tree_sitter_elm_trace_clear();
+    EXPECT(tree_sitter_elm_trace_read(events, CAPACITY) == 0);
+
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+}
+
+static void test_indent_limit(void) {
+    // Each `let` opens a section one column deeper than the last
+    enum { DEPTH = 300 };
+    char *source = malloc(64 + DEPTH * (DEPTH + 8));
+    char *end = source + sprintf(source, "module Main exposing (..)\n\nf =\n");
+    for (int i = 0; i < DEPTH; i++) {
+        end += sprintf(end, "%*slet\n", i + 1, "");
+    }
+    *end = '\0';
+
+    TSParser *parser = NULL;
+    tree_sitter_elm_trace_clear();
+    TSTree *tree = parse(&parser, source);
+    uint32_t count = tree_sitter_elm_trace_read(events, CAPACITY);
+    EXPECT(count_kind(count, TSElmTraceIndentLimit) > 0);
+
+    free(source);
+    ts_tree_delete(tree);
+    ts_parser_delete(parser);
+}
+
+int main(void) {
+    test_layout_events();
+    test_indent_limit();
+    return test_result("trace_test");
+}